@@ -0,0 +1,270 @@
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "coders/json.hpp"
+#include "common.hpp"
+
+namespace fs = std::filesystem;
+
+using namespace vctest;
+
+inline fs::path BENCH_DIR = fs::u8path(".vcbench");
+inline const std::string BENCH_PREFIX = "[bench] ";
+
+struct Config {
+    fs::path executable;
+    fs::path directory {"dev/bench"};
+    fs::path resDir {"res"};
+    fs::path workingDir {"."};
+    fs::path output;
+    fs::path baseline;
+    /// @brief Max allowed median time growth relative to baseline (percents)
+    double threshold = 10.0;
+    std::vector<std::string> filter;
+};
+
+struct Result {
+    std::string scenario;
+    std::string name;
+    int samples = 0;
+    double median = 0.0;
+    double min = 0.0;
+    double max = 0.0;
+};
+
+static bool perform_keyword(
+    util::ArgsReader& reader, const std::string& keyword, Config& config
+) {
+    if (keyword == "--help" || keyword == "-h") {
+        std::cout << "Options\n\n";
+        std::cout << "  --help, -h                      = show help\n";
+        std::cout << "  --exe <path>, -e <path>         = VoxelCore executable path\n";
+        std::cout << "  --scenarios <path>, -d <path>   = scenarios directory path\n";
+        std::cout << "  --res <path>, -r <path>         = 'res' directory path\n";
+        std::cout << "  --user <path>, -u <path>        = user directory path\n";
+        std::cout << "  --only <name>                   = run only the scenario (repeatable)\n";
+        std::cout << "  --output <path>, -o <path>      = write results to json file\n";
+        std::cout << "  --baseline <path>, -b <path>    = compare with results file\n";
+        std::cout << "  --threshold <percents>          = max allowed regression (10)\n";
+        std::cout << std::endl;
+        return false;
+    } else if (keyword == "--exe" || keyword == "-e") {
+        config.executable = fs::path(reader.next());
+    } else if (keyword == "--scenarios" || keyword == "-d") {
+        config.directory = fs::path(reader.next());
+    } else if (keyword == "--res" || keyword == "-r") {
+        config.resDir = fs::path(reader.next());
+    } else if (keyword == "--user" || keyword == "-u") {
+        config.workingDir = fs::path(reader.next());
+    } else if (keyword == "--only") {
+        config.filter.push_back(reader.next());
+    } else if (keyword == "--output" || keyword == "-o") {
+        config.output = fs::path(reader.next());
+    } else if (keyword == "--baseline" || keyword == "-b") {
+        config.baseline = fs::path(reader.next());
+    } else if (keyword == "--threshold") {
+        config.threshold = std::stod(reader.next());
+    } else {
+        std::cerr << "unknown argument " << keyword << std::endl;
+        return false;
+    }
+    return true;
+}
+
+static bool check_config(const Config& config) {
+    if (!check_file(config.executable)) {
+        return true;
+    }
+    for (const auto& dir :
+         {config.directory, config.resDir, config.workingDir}) {
+        if (!check_dir(dir)) {
+            return true;
+        }
+    }
+    if (!config.baseline.empty() && !check_file(config.baseline)) {
+        return true;
+    }
+    return false;
+}
+
+/// @brief Parse '[bench] <name> <samples> <median> <min> <max>' lines
+static std::vector<Result> parse_output(
+    std::istream& stream, const std::string& scenario
+) {
+    std::vector<Result> results;
+    std::string line;
+    while (std::getline(stream, line)) {
+        size_t pos = line.find(BENCH_PREFIX);
+        if (pos == std::string::npos) {
+            continue;
+        }
+        std::istringstream ss(line.substr(pos + BENCH_PREFIX.length()));
+        Result result;
+        result.scenario = scenario;
+        if (ss >> result.name >> result.samples >> result.median >>
+            result.min >> result.max) {
+            results.push_back(std::move(result));
+        }
+    }
+    return results;
+}
+
+static bool run_scenario(
+    const Config& config, const fs::path& path, std::vector<Result>& results
+) {
+    auto outputFile = config.workingDir / "output.txt";
+    auto name = path.stem().u8string();
+
+    auto command = headless_command(
+        config.executable, path, config.resDir, config.workingDir, outputFile
+    );
+
+    std::cout << "running scenario " << name << std::endl;
+    int code = system(command.c_str());
+
+    std::ifstream output(outputFile);
+    if (code) {
+        std::cerr << "[OUTPUT] " << name << std::endl;
+        std::cerr << output.rdbuf();
+        std::cerr << "[FAILED] " << name << " (code=" << code << ")"
+                  << std::endl;
+        return false;
+    }
+    auto scenarioResults = parse_output(output, name);
+    for (const auto& result : scenarioResults) {
+        std::cout << "  " << std::left << std::setw(32) << result.name
+                  << std::right << std::fixed << std::setprecision(3)
+                  << std::setw(12) << result.median << " ms (min "
+                  << result.min << ", max " << result.max << ")\n";
+    }
+    std::cout << std::flush;
+    results.insert(results.end(), scenarioResults.begin(), scenarioResults.end());
+    return true;
+}
+
+static void write_results(const fs::path& file, const std::vector<Result>& results) {
+    auto root = dv::object();
+    auto& list = root.list("results");
+    for (const auto& result : results) {
+        auto& entry = list.object();
+        entry["scenario"] = result.scenario;
+        entry["name"] = result.name;
+        entry["samples"] = result.samples;
+        entry["median_ms"] = result.median;
+        entry["min_ms"] = result.min;
+        entry["max_ms"] = result.max;
+    }
+    std::ofstream stream(file);
+    stream << json::stringify(root, true) << std::endl;
+}
+
+/// @return median times by case name
+/// @throws std::runtime_error if the file is not a valid results file
+static std::map<std::string, double> read_baseline(const fs::path& file) {
+    std::ifstream stream(file);
+    std::stringstream ss;
+    ss << stream.rdbuf();
+    auto root = json::parse(file.u8string(), ss.str());
+    const auto& list = root["results"];
+    if (!list.isList()) {
+        throw std::runtime_error("'results' list expected in " + file.u8string());
+    }
+    std::map<std::string, double> medians;
+    for (const auto& entry : list) {
+        medians[entry["name"].asString()] = entry["median_ms"].asNumber();
+    }
+    return medians;
+}
+
+/// @return number of regressions
+static size_t compare(const Config& config, const std::vector<Result>& results) {
+    auto baseline = read_baseline(config.baseline);
+    std::cout << "comparing with baseline " << config.baseline << std::endl;
+    size_t regressions = 0;
+    for (const auto& result : results) {
+        const auto& found = baseline.find(result.name);
+        if (found == baseline.end()) {
+            std::cout << "  " << result.name << ": not in baseline\n";
+            continue;
+        }
+        double change = (result.median / found->second - 1.0) * 100.0;
+        bool regressed = change > config.threshold;
+        regressions += regressed;
+        std::cout << "  " << std::left << std::setw(32) << result.name
+                  << std::right << std::showpos << std::fixed
+                  << std::setprecision(1) << std::setw(8) << change
+                  << std::noshowpos << "%"
+                  << (regressed ? " [REGRESSION]" : "") << "\n";
+    }
+    std::cout << std::flush;
+    return regressions;
+}
+
+int main(int argc, char** argv) {
+    Config config;
+    try {
+        if (!parse_cmdline(argc, argv, config, perform_keyword)) {
+            return 0;
+        }
+    } catch (const std::exception& err) {
+        std::cerr << err.what() << std::endl;
+        return 1;
+    }
+    if (check_config(config)) {
+        return 1;
+    }
+    std::vector<fs::path> scenarios;
+    for (const auto& entry : fs::directory_iterator(config.directory)) {
+        auto path = entry.path();
+        if (path.extension().string() != ".lua") {
+            continue;
+        }
+        const auto& filter = config.filter;
+        if (!filter.empty() && std::find(filter.begin(), filter.end(),
+                                         path.stem().u8string()) == filter.end()) {
+            continue;
+        }
+        scenarios.push_back(path);
+    }
+    // stable order for comparable output
+    std::sort(scenarios.begin(), scenarios.end());
+
+    config.workingDir /= BENCH_DIR;
+    if (fs::is_directory(config.workingDir)) {
+        fs::remove_all(config.workingDir);
+    }
+    fs::create_directories(config.workingDir);
+
+    std::vector<Result> results;
+    size_t failed = 0;
+    for (const auto& path : scenarios) {
+        failed += !run_scenario(config, path, results);
+        fs::remove_all(config.workingDir / fs::u8path("worlds"));
+    }
+    fs::remove_all(config.workingDir);
+
+    if (!config.output.empty()) {
+        write_results(config.output, results);
+        std::cout << "results written to " << config.output << std::endl;
+    }
+    size_t regressions = 0;
+    if (!config.baseline.empty()) {
+        try {
+            regressions = compare(config, results);
+        } catch (const std::exception& err) {
+            std::cerr << "could not read baseline: " << err.what() << std::endl;
+            return 1;
+        }
+    }
+    std::cout << results.size() << " case(s) measured, " << failed
+              << " scenario(s) failed, " << regressions
+              << " regression(s)" << std::endl;
+    return failed || regressions ? 1 : 0;
+}
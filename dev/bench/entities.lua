@@ -0,0 +1,31 @@
+-- Entities physics and scripts update
+local bench = require "core:bench"
+local base_util = require "base:util"
+
+local COUNT = 256
+local TICKS = 20
+
+bench.create_world("base:demo")
+bench.load_area(0, 100, 0, 4)
+
+local spawned = {}
+local itemid = item.index("base:stone.item")
+
+bench.run("entities.physics", function()
+    for _ = 1, TICKS do
+        app.tick()
+    end
+end, {samples = 5, setup = function()
+    for _, entity in ipairs(spawned) do
+        entity:despawn()
+    end
+    spawned = {}
+    for i = 1, COUNT do
+        local x = math.random(-24, 24)
+        local z = math.random(-24, 24)
+        local y = bench.surface(x, z) + math.random(2, 20)
+        table.insert(spawned, base_util.drop({x, y, z}, itemid, 1))
+    end
+end})
+
+bench.close_world()
@@ -0,0 +1,20 @@
+-- Lua events dispatching
+local bench = require "core:bench"
+
+local HANDLERS = 8
+local EMITS = 100000
+
+local counter = 0
+for _ = 1, HANDLERS do
+    events.on("core:bench_event", function(a, b)
+        counter = counter + a + b
+    end)
+end
+
+bench.run("events.emit", function()
+    for i = 1, EMITS do
+        events.emit("core:bench_event", i, 1)
+    end
+end)
+assert(counter > 0)
+events.reset("core:bench_event")
@@ -0,0 +1,13 @@
+-- Chunks generation (prototypes, generation, encoding and region writes)
+local bench = require "core:bench"
+
+for _, generator in ipairs({"base:demo", "core:default"}) do
+    bench.create_world(generator)
+    local name = generator:gsub(":", "_")
+    -- every sample generates a separate 8x8 chunks area
+    bench.run("generation." .. name, function(i)
+        local stats = world.pregenerate(i * 16, 0, 8, 8)
+        assert(stats.generated == 64)
+    end, {samples = 8})
+    bench.close_world()
+end
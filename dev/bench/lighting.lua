@@ -0,0 +1,40 @@
+-- Light solving on light sources placing and removal
+local bench = require "core:bench"
+
+bench.create_world("base:demo")
+bench.load_area(0, 100, 0, 4)
+
+local lamps = {
+    block.index("base:lamp"),
+    block.index("base:red_lamp"),
+    block.index("base:green_lamp"),
+    block.index("base:blue_lamp"),
+}
+local positions = {}
+for i = 1, 64 do
+    local x = math.random(-32, 32)
+    local z = math.random(-32, 32)
+    table.insert(positions, {x, bench.surface(x, z) + 1, z})
+end
+
+bench.run("lighting.place", function(i)
+    for j, pos in ipairs(positions) do
+        block.set(pos[1], pos[2], pos[3], lamps[j % #lamps + 1])
+    end
+end, {setup = function()
+    for _, pos in ipairs(positions) do
+        block.set(pos[1], pos[2], pos[3], 0)
+    end
+end})
+
+bench.run("lighting.remove", function()
+    for _, pos in ipairs(positions) do
+        block.set(pos[1], pos[2], pos[3], 0)
+    end
+end, {setup = function()
+    for j, pos in ipairs(positions) do
+        block.set(pos[1], pos[2], pos[3], lamps[j % #lamps + 1])
+    end
+end})
+
+bench.close_world()
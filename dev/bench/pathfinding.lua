@@ -0,0 +1,27 @@
+-- Synchronous routes building
+local bench = require "core:bench"
+
+bench.create_world("base:demo")
+bench.load_area(0, 100, 0, 4)
+
+local agent = pathfinding.create_agent()
+pathfinding.set_max_visited(agent, 1e5)
+
+local routes = {}
+for i = 1, 16 do
+    local x1, z1 = math.random(-40, 40), math.random(-40, 40)
+    local x2, z2 = math.random(-40, 40), math.random(-40, 40)
+    table.insert(routes, {
+        {x1, bench.surface(x1, z1) + 1, z1},
+        {x2, bench.surface(x2, z2) + 1, z2},
+    })
+end
+
+bench.run("pathfinding.make_route", function()
+    for _, route in ipairs(routes) do
+        pathfinding.make_route(agent, route[1], route[2])
+    end
+end)
+
+pathfinding.remove_agent(agent)
+bench.close_world()
@@ -0,0 +1,33 @@
+-- Voxel rays casting from the surface in random directions
+local bench = require "core:bench"
+
+bench.create_world("base:demo")
+bench.load_area(0, 100, 0, 4)
+
+local RAYS = 2000
+local origin = {0, bench.surface(0, 0) + 2, 0}
+local starts = {}
+local dirs = {}
+for i = 1, RAYS do
+    local z = math.random() * 2.0 - 1.0
+    local phi = math.random() * math.pi * 2.0
+    local r = math.sqrt(1.0 - z * z)
+    table.insert(starts, origin)
+    table.insert(dirs, {r * math.cos(phi), r * math.sin(phi), z})
+end
+
+local dest = {}
+local median = bench.run("block.raycast_batch", function()
+    block.raycast_batch(starts, dirs, 40.0, dest)
+end)
+print(string.format("%d rays/s", RAYS / median * 1000.0))
+
+local single = {}
+median = bench.run("block.raycast", function()
+    for _, dir in ipairs(dirs) do
+        block.raycast(origin, dir, 40.0, single)
+    end
+end)
+print(string.format("%d rays/s (single)", RAYS / median * 1000.0))
+
+bench.close_world()
@@ -0,0 +1,33 @@
+-- Regions saving and loading
+local bench = require "core:bench"
+
+local RADIUS = 8
+
+bench.create_world()
+world.pregenerate(0, 0, RADIUS)
+app.close_world(true)
+
+bench.run("regions.load", function()
+    app.open_world(bench.WORLD)
+    bench.load_area(0, 100, 0, RADIUS)
+end, {samples = 5, setup = function(i)
+    -- the world is closed before warmup, then opened by every run
+    if i >= 1 then
+        app.close_world(false)
+    end
+end})
+
+local stone = block.index("base:stone")
+local surface = bench.surface(0, 0) + 1
+bench.run("regions.save", function()
+    app.save_world()
+end, {samples = 10, setup = function(i)
+    -- modify every loaded chunk to make them dirty
+    for cz = -RADIUS + 1, RADIUS - 1 do
+        for cx = -RADIUS + 1, RADIUS - 1 do
+            block.set(cx * 16, surface, cz * 16, i % 2 == 0 and stone or 0)
+        end
+    end
+end})
+
+bench.close_world()
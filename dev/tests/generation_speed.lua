@@ -0,0 +1,36 @@
+-- Chunks generation speed for bundled generators
+-- (compare results with different generator region-size values)
+local util = require "core:tests_util"
+
+local generators = {"base:demo", "base:flat_grass", "core:default"}
+local LOAD_DISTANCE = 12
+
+app.set_setting("chunks.load-distance", LOAD_DISTANCE)
+app.set_setting("chunks.load-speed", 32)
+
+for _, generator in ipairs(generators) do
+    util.create_demo_world(generator)
+    local pid = player.create("Xerxes")
+    player.set_pos(pid, 0, 100, 0)
+
+    local start = time.uptime()
+    local count = 0
+    local stable_ticks = 0
+    while stable_ticks < 10 do
+        app.tick()
+        local new_count = world.count_chunks()
+        if new_count == count then
+            stable_ticks = stable_ticks + 1
+        else
+            stable_ticks = 0
+            count = new_count
+        end
+    end
+    local elapsed = time.uptime() - start
+    print(string.format(
+        "%s: %s chunks in %.2f s (%.1f chunks/s)",
+        generator, count, elapsed, count / elapsed
+    ))
+    app.close_world(false)
+    app.delete_world("demo")
+end
@@ -0,0 +1,43 @@
+-- Headless world pregeneration: per-phase speed and resuming
+app.reconfig_packs({"base"}, {})
+app.new_world("demo", "2019", "base:demo")
+
+local RADIUS = 24
+
+local function print_stats(stats)
+    print(string.format(
+        "%s chunks (%s generated, %s skipped) in %.2f s " ..
+        "(%.1f chunks/s, %s threads)",
+        stats.chunks, stats.generated, stats.skipped,
+        stats.time, stats.speed, stats.threads
+    ))
+    for _, name in ipairs({"prototypes", "generate", "encode", "write"}) do
+        local phase = stats.phases[name]
+        print(string.format(
+            "  %-10s %8.3f s %10.1f chunks/s", name, phase.time, phase.speed
+        ))
+    end
+end
+
+local stats = world.pregenerate(0, 0, RADIUS)
+print_stats(stats)
+assert(stats.generated == stats.chunks)
+assert(stats.skipped == 0)
+
+-- Saved chunks are skipped
+local area = world.pregenerate(-RADIUS, -RADIUS, RADIUS * 2 + 1, 8)
+print_stats(area)
+assert(area.chunks == (RADIUS * 2 + 1) * 8)
+assert(area.skipped > 0)
+assert(area.generated + area.skipped == area.chunks)
+
+-- Pregenerated chunks are loaded from the world files
+app.close_world(true)
+app.open_world("demo")
+local pid = player.create("Xerxes")
+player.set_pos(pid, 0, 100, 0)
+app.sleep_until(function () return world.count_chunks() > 0 end, 1000)
+assert(world.pregenerate(0, 0, RADIUS).generated == 0)
+
+app.close_world(false)
+app.delete_world("demo")
@@ -0,0 +1,94 @@
+-- Deterministic benchmarks utilities (used by dev/bench scenarios)
+--
+-- Every measured case prints a machine-readable line:
+-- [bench] <name> <samples> <median ms> <min ms> <max ms>
+local bench = {}
+
+bench.SEED = "2019"
+bench.WORLD = "bench"
+
+--- Create world with fixed seed and packs set
+function bench.create_world(generator)
+    math.randomseed(2019)
+    app.reconfig_packs({"base"}, {})
+    app.new_world(bench.WORLD, bench.SEED, generator or "base:demo")
+end
+
+function bench.close_world(save)
+    app.close_world(save or false)
+    app.delete_world(bench.WORLD)
+end
+
+--- Create player at the given position and wait until chunks around
+--- are loaded (world.count_chunks() is not changed for 10 ticks)
+--- @return number player id
+function bench.load_area(x, y, z, load_distance)
+    app.set_setting("chunks.load-distance", load_distance or 4)
+    app.set_setting("chunks.load-speed", 32)
+    local pid = player.create("bench")
+    player.set_pos(pid, x, y, z)
+    local count = 0
+    local stable_ticks = 0
+    while stable_ticks < 10 do
+        app.tick()
+        local new_count = world.count_chunks()
+        if new_count == count then
+            stable_ticks = stable_ticks + 1
+        else
+            stable_ticks = 0
+            count = new_count
+        end
+    end
+    return pid
+end
+
+--- @return number y of the first non-air block below the given y
+function bench.surface(x, z, top)
+    for y = top or 255, 0, -1 do
+        if block.get(x, y, z) > 0 then
+            return y
+        end
+    end
+    return 0
+end
+
+local function median(sorted)
+    local n = #sorted
+    if n % 2 == 1 then
+        return sorted[(n + 1) / 2]
+    end
+    return (sorted[n / 2] + sorted[n / 2 + 1]) * 0.5
+end
+
+--- Measure func(i) for the given samples count
+--- @param name string case name (no spaces)
+--- @param func function sample function, gets the sample index
+--- @param options table|nil {samples=10, warmup=1, setup=function(i)}
+--- @return number median time in milliseconds
+function bench.run(name, func, options)
+    options = options or {}
+    local samples = options.samples or 10
+    local warmup = options.warmup or 1
+    local setup = options.setup
+
+    for i = 1, warmup do
+        if setup then setup(-i) end
+        func(-i)
+    end
+    local times = {}
+    for i = 1, samples do
+        if setup then setup(i) end
+        local start = time.precise_time()
+        func(i)
+        table.insert(times, (time.precise_time() - start) * 1000.0)
+    end
+    table.sort(times)
+    local result = median(times)
+    print(string.format(
+        "[bench] %s %d %.4f %.4f %.4f",
+        name, samples, result, times[1], times[#times]
+    ))
+    return result
+end
+
+return bench
@@ -10,6 +10,13 @@ FFI.cdef[[
         int size;
         int capacity;
     } bytearray_t;
+    typedef struct {
+        unsigned char* bytes;
+        int size;
+        int capacity;
+        void* owner;
+        void (*release)(void*);
+    } bytearray_view_t;
 ]]
 
 local malloc = FFI.C.malloc
@@ -215,6 +222,48 @@ FFIBytearray = {
 }
 table.merge(FFIBytearray, bytearray_methods)
 
+local bytearray_view_methods = {
+    get_capacity=get_capacity,
+    slice=slice,
+}
+
+-- fixed size view over memory owned by the engine
+local bytearray_view_mt = {
+    __index = function(self, key)
+        if _type(key) == "string" then
+            return bytearray_view_methods[key]
+        end
+        if key <= 0 or key > self.size then
+            return
+        end
+        return self.bytes[key - 1]
+    end,
+    __newindex = function(self, key, value)
+        if key <= 0 or key > self.size then
+            error("bytearray view size is fixed")
+        end
+        self.bytes[key - 1] = value
+    end,
+    __tostring = function(self)
+        return string.format("FFIBytearray_view[%s]{...}", tonumber(self.size))
+    end,
+    __len = bytearray_mt.__len,
+    __gc = function(self)
+        self.release(self.owner)
+    end,
+    __ipairs = bytearray_mt.__ipairs,
+}
+bytearray_view_mt.__pairs = bytearray_view_mt.__ipairs
+
+local bytearray_view_type = FFI.metatype("bytearray_view_t", bytearray_view_mt)
+
+local function FFIBytearray_view(bytes, size, owner, release)
+    return bytearray_view_type(
+        FFI.cast("unsigned char*", bytes), size, size,
+        owner, FFI.cast("void(*)(void*)", release)
+    )
+end
+
 local function FFIBytearray_as_string(bytes)
     local t = type(bytes)
     if t == "cdata" then
@@ -283,6 +332,7 @@ local FFIU32view = create_FFIview_class("FFIU32view", "uint32_t", 4)
 return {
     FFIBytearray = setmetatable(FFIBytearray, FFIBytearray),
     FFIBytearray_as_string = FFIBytearray_as_string,
+    FFIBytearray_view = FFIBytearray_view,
     FFIU16view = FFIU16view,
     FFII16view = FFII16view,
     FFIU32view = FFIU32view,
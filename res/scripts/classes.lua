@@ -83,6 +83,7 @@ local _tcp_client_callbacks = {}
 local _tcp_client_error_callbacks = {}
 
 local _udp_server_callbacks = {}
+local _udp_server_batch_callbacks = {}
 local _udp_client_datagram_callbacks = {}
 local _udp_client_open_callbacks = {}
 local _http_response_callbacks = {}
@@ -151,6 +152,20 @@ network.udp_open = function (port, datagramHandler)
     return socket
 end
 
+network.udp_open_batch = function (port, batchHandler)
+    if type(batchHandler) ~= 'function' then
+        error "udp server cannot be opened without datagrams handler"
+    end
+
+    local socket = setmetatable({id=network.__open_udp(port)}, DatagramServerSocket)
+
+    _udp_server_batch_callbacks[socket.id] = function(data, offsets, addresses, ports)
+        batchHandler(data, offsets, addresses, ports, socket)
+    end
+
+    return socket
+end
+
 network.udp_connect = function (address, port, datagramHandler, openCallback)
     if type(datagramHandler) ~= 'function' then
         error "udp client socket cannot be opened without datagram handler"
@@ -181,6 +196,9 @@ local function clean(iterable, checkFun, ...)
     end
 end
 
+-- event tables are reused between frames
+local _events = nil
+
 network.__process_events = function()
     if not network.is_available() then
         return
@@ -195,9 +213,10 @@ network.__process_events = function()
     local ON_CLIENT = 2
 
     local cleaned = false
-    local events = network.__pull_events()
+    local events = network.__pull_events(_events)
+    _events = events
     for i, event in ipairs(events) do
-        local etype, sid, cid, addr, port, side, data = unpack(event)
+        local etype, sid, cid, addr, port, side, data, offsets = unpack(event)
 
         if etype == CLIENT_CONNECTED then
             local callback = _tcp_server_callbacks[sid]
@@ -218,12 +237,21 @@ network.__process_events = function()
             if side == ON_CLIENT then
                 local callback = _udp_client_datagram_callbacks[cid]
                 if callback then
-                    callback(data)
+                    for j = 1, #offsets - 1 do
+                        callback(data:slice(offsets[j], offsets[j + 1] - offsets[j]))
+                    end
                 end
             elseif side == ON_SERVER then
+                local batch_callback = _udp_server_batch_callbacks[sid]
                 local callback = _udp_server_callbacks[sid]
-                if callback then
-                    callback(addr, port, data)
+                if batch_callback then
+                    batch_callback(data, offsets, addr, port)
+                elseif callback then
+                    for j = 1, #offsets - 1 do
+                        callback(addr[j], port[j], data:slice(
+                            offsets[j], offsets[j + 1] - offsets[j]
+                        ))
+                    end
                 end
             end
         elseif etype == RESPONSE then
@@ -250,6 +278,7 @@ network.__process_events = function()
             clean(_tcp_client_callbacks, network.__is_alive, _tcp_client_callbacks)
 
             clean(_udp_server_callbacks, network.__is_serveropen, _udp_server_callbacks)
+            clean(_udp_server_batch_callbacks, network.__is_serveropen, _udp_server_batch_callbacks)
             clean(_udp_client_datagram_callbacks, network.__is_alive, _udp_client_open_callbacks, _udp_client_datagram_callbacks)
 
             cleaned = true
@@ -317,3 +317,44 @@ console.add_command(
         return "available presets:" .. presets
     end
 )
+
+console.add_command(
+    "world.pregenerate radius:int x:int~pos.x z:int~pos.z",
+    "Generate and save chunks in radius (in chunks) around the position",
+    function(args, kwargs)
+        local radius, x, z = unpack(args)
+        local stats = world.pregenerate(
+            math.floor(x / 16), math.floor(z / 16), radius
+        )
+        local str = string.format(
+            "%s chunks generated, %s skipped in %.2f s (%.1f chunks/s)",
+            stats.generated, stats.skipped, stats.time, stats.speed
+        )
+        for _, name in ipairs({"prototypes", "generate", "encode", "write"}) do
+            local phase = stats.phases[name]
+            str = str .. string.format(
+                "\n%s: %.3f s (%.1f chunks/s)", name, phase.time, phase.speed
+            )
+        end
+        return str
+    end
+)
+
+console.add_command(
+    "profiler action:[start|stop] file:str='export:profile.json'",
+    "Capture profiler zones and write Chrome trace (chrome://tracing) on stop",
+    function(args, kwargs)
+        local action, filename = unpack(args)
+        if action == "start" then
+            debug.profiler_start()
+            return "profiler started"
+        end
+        local zones, dropped = debug.profiler_stop()
+        file.write(filename, debug.profiler_export())
+        local str = string.format("%s zones written to %s", zones, filename)
+        if dropped > 0 then
+            str = str .. string.format(" (%s dropped)", dropped)
+        end
+        return str
+    end
+)
@@ -319,6 +319,26 @@ function console.chat(...)
     events.emit("core:chat", ...)
 end
 
+-- app library is not available in console commands environment
+local __app_get_tick_stats = __app.get_tick_stats
+console.add_command(
+    "tickstats",
+    "Show server ticks timing statistics",
+    function()
+        local stats = __app_get_tick_stats()
+        if not stats then
+            error("command is available in headless mode only")
+        end
+        return string.format(
+            "tps: %.2f/%s\n"..
+            "tick duration p50: %.2f ms, p99: %.2f ms, max: %.2f ms\n"..
+            "ticks: %s, overruns: %s, skipped: %s",
+            stats.tps, stats.target_tps, stats.p50, stats.p99, stats.max,
+            stats.ticks, stats.overruns, stats.skipped
+        )
+    end
+)
+
 function gui.template(name, params)
     local text = file.read(file.find("layouts/templates/"..name..".xml"))
     text = text:gsub("%%{([^}]+)}", function(n) 
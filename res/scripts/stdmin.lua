@@ -305,6 +305,7 @@ I16view = bytearray.FFII16view
 U32view = bytearray.FFIU32view
 I32view = bytearray.FFII32view
 Bytearray_construct = function(...) return Bytearray(...) end
+Bytearray_view = bytearray.FFIBytearray_view
 
 bit.compile = require "core:bitwise/compiler"
 bit.execute = require "core:bitwise/executor"
@@ -101,10 +101,11 @@ static void add_layouts(
     const io::path& folder,
     AssetsLoader& loader
 ) {
-    if (!io::is_directory(folder)) {
+    const auto& paths = loader.getPaths();
+    if (!paths.isDirectory(folder)) {
         return;
     }
-    for (const auto& file : io::directory_iterator(folder)) {
+    for (const auto& file : paths.list(folder)) {
         if (file.extension() != ".xml") continue;
         std::string name = prefix + ":" + file.stem();
         loader.add(
@@ -232,7 +233,7 @@ void AssetsLoader::processPreloadConfig(const io::path& file) {
 
 void AssetsLoader::processPreloadConfigs(const Content* content) {
     io::path preloadFile = "res:preload.json";
-    if (io::exists(preloadFile)) {
+    if (paths.isFile(preloadFile)) {
         processPreloadConfig(preloadFile);
     }
     if (content == nullptr) {
@@ -244,7 +245,7 @@ void AssetsLoader::processPreloadConfigs(const Content* content) {
         }
         const auto& pack = entry.second;
         preloadFile = pack->getInfo().folder / "preload.json";
-        if (io::exists(preloadFile)) {
+        if (paths.isFile(preloadFile)) {
             processPreloadConfig(preloadFile);
         }
     }
@@ -30,6 +30,7 @@
 #include "util/stringutil.hpp"
 #include "Assets.hpp"
 #include "AssetsLoader.hpp"
+#include "assets_cache.hpp"
 
 static debug::Logger logger("assetload-funcs");
 
@@ -147,16 +148,39 @@ assetload::postfunc assetload::posteffect(
     };
 }
 
-static bool append_atlas(AtlasBuilder& atlas, const io::path& file) {
-    std::string name = file.stem();
-    // skip duplicates
-    if (atlas.has(name)) {
-        return false;
+/// @brief Baked atlas key of source images and packing settings
+static uint64_t atlas_key(const std::vector<io::path>& files) {
+    assets_cache::Key key("atlas");
+    key.update(ATLAS_EXTRUSION);
+    key.update(Texture::MAX_RESOLUTION);
+    for (const auto& file : files) {
+        key.updateFile(file);
+    }
+    return key.get();
+}
+
+static void append_atlas(
+    AtlasBuilder& atlas, const std::vector<io::path>& files
+) {
+    std::set<std::string> names;
+    std::vector<io::path> unique;
+    for (const auto& file : files) {
+        // skip duplicates
+        if (names.insert(file.stem()).second) {
+            unique.push_back(file);
+        }
+    }
+    // read in batches to inflate zipped packs images concurrently
+    auto images = io::read_all(unique);
+    for (size_t i = 0; i < unique.size(); i++) {
+        // decoded directly into the atlas raster on build
+        atlas.add(
+            unique[i].stem(),
+            imageio::get_read_format(unique[i]),
+            std::move(images[i]),
+            true
+        );
     }
-    auto image = imageio::read(file);
-    image->fixAlphaColor();
-    atlas.add(name, std::move(image));
-    return true;
 }
 
 assetload::postfunc assetload::atlas(
@@ -179,13 +203,21 @@ assetload::postfunc assetload::atlas(
         }
         return [](auto){};
     }
-    AtlasBuilder builder;
+    std::vector<io::path> files;
     for (const auto& file : paths.listdir(directory)) {
         if (!imageio::is_read_supported(file.extension())) continue;
-        if (!append_atlas(builder, file)) continue;
+        files.push_back(file);
+    }
+    auto key = atlas_key(files);
+    auto builtAtlas = assets_cache::load_atlas(name, key);
+    if (builtAtlas == nullptr) {
+        AtlasBuilder builder;
+        append_atlas(builder, files);
+        builtAtlas = builder.build(ATLAS_EXTRUSION, false);
+        assets_cache::store_atlas(name, key, *builtAtlas);
     }
-    std::set<std::string> names = builder.getNames();
-    Atlas* atlas = builder.build(ATLAS_EXTRUSION, false).release();
+    std::set<std::string> names = builtAtlas->getNames();
+    Atlas* atlas = builtAtlas.release();
     return [=](auto assets) {
         atlas->prepare();
         assets->store(std::unique_ptr<Atlas>(atlas), name);
@@ -218,18 +250,30 @@ assetload::postfunc assetload::font(
         };
     }
 
-    auto pages = std::make_shared<std::vector<std::unique_ptr<ImageData>>>();
+    std::vector<io::path> files;
+    assets_cache::Key key("font");
     for (size_t i = 0; i <= 1024; i++) {
         std::string pagefile = filename + "_" + std::to_string(i) + ".png";
-        auto file = paths.find(pagefile);
-        if (io::exists(file)) {
-            pages->push_back(imageio::read(file));
+        if (paths.exists(pagefile)) {
+            auto file = paths.find(pagefile);
+            key.updateFile(file);
+            files.push_back(std::move(file));
         } else if (i == 0) {
             throw std::runtime_error("font must have page 0");
         } else {
-            pages->push_back(nullptr);
+            key.update(i);
+            files.emplace_back();
         }
     }
+    auto pages = std::make_shared<std::vector<std::unique_ptr<ImageData>>>(
+        assets_cache::load_images(name, key.get())
+    );
+    if (pages->empty()) {
+        for (const auto& file : files) {
+            pages->push_back(file.empty() ? nullptr : imageio::read(file));
+        }
+        assets_cache::store_images(name, key.get(), *pages);
+    }
     return [=](auto assets) {
         assets->store(Font::createBitmapFont(std::move(*pages)), name);
     };
@@ -280,15 +324,15 @@ assetload::postfunc assetload::sound(
     for (size_t i = 0; i < extensions.size(); i++) {
         extension = extensions[i];
         // looking for 'sound_name' as base sound
-        auto soundFile = paths.find(file + extension);
-        if (io::exists(soundFile)) {
-            baseSound = audio::load_sound(soundFile, keepPCM);
+        if (paths.exists(file + extension)) {
+            baseSound =
+                audio::load_sound(paths.find(file + extension), keepPCM);
             break;
         }
         // looking for 'sound_name_0' as base sound
-        auto variantFile = paths.find(file + "_0" + extension);
-        if (io::exists(variantFile)) {
-            baseSound = audio::load_sound(variantFile, keepPCM);
+        if (paths.exists(file + "_0" + extension)) {
+            baseSound =
+                audio::load_sound(paths.find(file + "_0" + extension), keepPCM);
             break;
         }
     }
@@ -298,12 +342,13 @@ assetload::postfunc assetload::sound(
 
     // loading sound variants
     for (uint i = 1;; i++) {
-        auto variantFile =
-            paths.find(file + "_" + std::to_string(i) + extension);
-        if (!io::exists(variantFile)) {
+        auto variantFile = file + "_" + std::to_string(i) + extension;
+        if (!paths.exists(variantFile)) {
             break;
         }
-        baseSound->variants.emplace_back(audio::load_sound(variantFile, keepPCM));
+        baseSound->variants.emplace_back(
+            audio::load_sound(paths.find(variantFile), keepPCM)
+        );
     }
 
     auto sound = baseSound.release();
@@ -371,9 +416,19 @@ assetload::postfunc assetload::model(
     }
     path = paths.find(file + ".obj");
     if (io::exists(path)) {
+        assets_cache::Key key("obj");
+        key.updateFile(path);
+        if (auto cached = assets_cache::load_model(name, key.get())) {
+            auto model = cached.release();
+            return [=](Assets* assets) {
+                request_textures(loader, *model);
+                assets->store(std::unique_ptr<model::Model>(model), name);
+            };
+        }
         auto text = io::read_string(path);
         try {
             auto model = obj::parse(path.string(), text).release();
+            assets_cache::store_model(name, key.get(), *model);
             return [=](Assets* assets) {
                 request_textures(loader, *model);
                 assets->store(std::unique_ptr<model::Model>(model), name);
@@ -401,6 +456,19 @@ assetload::postfunc assetload::model(
         throw std::runtime_error("could not to find model " + util::quote(file));
     }
 
+    assets_cache::Key key("vcm");
+    key.updateFile(path);
+    key.update(cfg && cfg->squashed);
+    // only single-part models are baked, skeletons are always parsed
+    if (auto cached = assets_cache::load_model(name, key.get())) {
+        auto modelPtr = cached.release();
+        return [=](Assets* assets) {
+            auto model = std::unique_ptr<model::Model>(modelPtr);
+            request_textures(loader, *model);
+            assets->store(std::move(model), name);
+            logger.info() << "store model " << util::quote(name);
+        };
+    }
     auto text = io::read_string(path);
     try {
         auto vcmModel = vcm::parse(path.string(), text, path.extension() == ".xml");
@@ -409,6 +477,7 @@ assetload::postfunc assetload::model(
 
         if (vcmModel.parts.size() == 1 || (cfg && cfg->squashed)) {
             auto modelPtr = std::make_unique<model::Model>(std::move(vcmModel.squash())).release();
+            assets_cache::store_model(name, key.get(), *modelPtr);
             return [=](Assets* assets) {
                 auto model = std::unique_ptr<model::Model>(modelPtr);
                 request_textures(loader, *model);
@@ -567,9 +636,9 @@ static bool load_animation(
         if (folder.name() != name) continue;
         //FIXME: if (fs::is_empty(folder)) continue;
 
-        AtlasBuilder builder;
-        append_atlas(builder, paths.find(directory + "/" + name + ".png"));
-
+        std::vector<io::path> files {
+            paths.find(directory + "/" + name + ".png")
+        };
         std::vector<std::pair<std::string, int>> frameList;
         std::string animFile = folder.string() + "/animation.json";
         if (io::exists(animFile)) {
@@ -580,20 +649,28 @@ static bool load_animation(
                 !contains(frameList, file.stem())) {
                 continue;
             }
-            if (!append_atlas(builder, file)) continue;
+            files.push_back(file);
         }
-        auto srcAtlas = builder.build(ATLAS_EXTRUSION, true);
+        auto animAtlasName = atlasName + "/" + name + "_animation";
+        auto key = atlas_key(files);
+        auto srcAtlas = assets_cache::load_atlas(animAtlasName, key);
+        if (srcAtlas == nullptr) {
+            AtlasBuilder builder;
+            append_atlas(builder, files);
+            srcAtlas = builder.build(ATLAS_EXTRUSION, false);
+            assets_cache::store_atlas(animAtlasName, key, *srcAtlas);
+        }
+        srcAtlas->prepare();
+        auto frameNames = srcAtlas->getNames();
         if (frameList.empty()) {
-            for (const auto& frameName : builder.getNames()) {
+            for (const auto& frameName : frameNames) {
                 frameList.emplace_back(frameName, 0);
             }
         }
         auto animation = create_animation(
-            srcAtlas.get(), dstAtlas, name, builder.getNames(), frameList
-        );
-        assets->store(
-            std::move(srcAtlas), atlasName + "/" + name + "_animation"
+            srcAtlas.get(), dstAtlas, name, frameNames, frameList
         );
+        assets->store(std::move(srcAtlas), animAtlasName);
         assets->store(animation);
         return true;
     }
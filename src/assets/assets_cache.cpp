@@ -0,0 +1,387 @@
+#include "assets_cache.hpp"
+
+#include <zlib.h>
+
+#include <cctype>
+#include <cstring>
+#include <stdexcept>
+
+#include "coders/byte_utils.hpp"
+#include "debug/Logger.hpp"
+#include "graphics/commons/Model.hpp"
+#include "graphics/core/Atlas.hpp"
+#include "graphics/core/ImageData.hpp"
+#include "util/stringutil.hpp"
+
+static debug::Logger logger("assets-cache");
+
+static_assert(sizeof(model::Vertex) == sizeof(float) * 8);
+
+static constexpr char MAGIC[] = "VCBK";
+static constexpr size_t MAGIC_SIZE = 4;
+static constexpr size_t HEADER_SIZE = 32;
+/// @brief Raw pixels and vertices are aligned to allow direct access
+/// when the entry is memory-mapped
+static constexpr size_t DATA_ALIGNMENT = 16;
+
+static io::path folder = assets_cache::DEFAULT_FOLDER;
+
+using namespace assets_cache;
+
+Key::Key(std::string_view kind) {
+    update(VERSION);
+    update(kind);
+}
+
+void Key::update(const void* data, size_t size) {
+    auto bytes = static_cast<const ubyte*>(data);
+    uint64_t hash = value;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ULL;
+    }
+    value = hash;
+}
+
+void Key::update(std::string_view str) {
+    update(static_cast<uint64_t>(str.size()));
+    update(str.data(), str.size());
+}
+
+void Key::update(uint64_t number) {
+    ubyte bytes[8];
+    for (int i = 0; i < 8; i++) {
+        bytes[i] = (number >> (i * 8)) & 0xFF;
+    }
+    update(bytes, sizeof(bytes));
+}
+
+void Key::updateFile(const io::path& file) {
+    update(file.string());
+    auto bytes = io::read_bytes(file);
+    update(static_cast<uint64_t>(bytes.size()));
+    update(bytes.data(), bytes.size());
+}
+
+void assets_cache::set_folder(io::path newFolder) {
+    folder = std::move(newFolder);
+}
+
+bool assets_cache::is_enabled() {
+    return !folder.empty() && io::get_device(folder.entryPoint()) != nullptr;
+}
+
+static uint32_t checksum(const ubyte* data, size_t size) {
+    return crc32(crc32(0L, Z_NULL, 0), data, size);
+}
+
+std::vector<ubyte> assets_cache::pack(
+    uint64_t key, const std::vector<ubyte>& payload
+) {
+    ByteBuilder builder(HEADER_SIZE + payload.size());
+    builder.put(reinterpret_cast<const ubyte*>(MAGIC), MAGIC_SIZE);
+    builder.putInt32(VERSION);
+    builder.putInt64(key);
+    builder.putInt64(payload.size());
+    builder.putInt32(checksum(payload.data(), payload.size()));
+    builder.putInt32(0);  // reserved
+    builder.put(payload.data(), payload.size());
+    return builder.build();
+}
+
+std::vector<ubyte> assets_cache::unpack(
+    uint64_t key, const std::vector<ubyte>& entry
+) {
+    if (entry.size() < HEADER_SIZE ||
+        std::memcmp(entry.data(), MAGIC, MAGIC_SIZE) != 0) {
+        return {};
+    }
+    ByteReader reader(entry.data() + MAGIC_SIZE, HEADER_SIZE - MAGIC_SIZE);
+    auto version = static_cast<uint32_t>(reader.getInt32());
+    auto entryKey = static_cast<uint64_t>(reader.getInt64());
+    auto size = static_cast<uint64_t>(reader.getInt64());
+    auto crc = static_cast<uint32_t>(reader.getInt32());
+    if (version != VERSION || entryKey != key ||
+        size != entry.size() - HEADER_SIZE ||
+        crc != checksum(entry.data() + HEADER_SIZE, size)) {
+        return {};
+    }
+    return std::vector<ubyte>(entry.begin() + HEADER_SIZE, entry.end());
+}
+
+static void align(ByteBuilder& builder) {
+    while (builder.size() % DATA_ALIGNMENT) {
+        builder.put(0);
+    }
+}
+
+static void align(ByteReader& reader, const std::vector<ubyte>& payload) {
+    size_t offset = reader.pointer() - payload.data();
+    size_t padding = (DATA_ALIGNMENT - offset % DATA_ALIGNMENT) % DATA_ALIGNMENT;
+    if (padding > reader.remaining()) {
+        throw std::runtime_error("buffer underflow");
+    }
+    reader.skip(padding);
+}
+
+static size_t image_size(ImageFormat format, uint width, uint height) {
+    size_t channels = format == ImageFormat::RGBA8888 ? 4 : 3;
+    return channels * width * height;
+}
+
+/// @brief Check that count elements of elementSize bytes are stored
+/// in the payload before allocating them
+static void check_remaining(
+    const ByteReader& reader, uint64_t count, size_t elementSize
+) {
+    if (count > reader.remaining() / elementSize) {
+        throw std::runtime_error("buffer underflow");
+    }
+}
+
+static void put_image(ByteBuilder& builder, const ImageData& image) {
+    builder.putInt32(image.getWidth());
+    builder.putInt32(image.getHeight());
+    builder.putInt32(static_cast<int32_t>(image.getFormat()));
+    align(builder);
+    builder.put(
+        image.getData(),
+        image_size(image.getFormat(), image.getWidth(), image.getHeight())
+    );
+}
+
+static std::unique_ptr<ImageData> get_image(
+    ByteReader& reader, const std::vector<ubyte>& payload
+) {
+    auto width = static_cast<uint>(reader.getInt32());
+    auto height = static_cast<uint>(reader.getInt32());
+    auto formatIndex = reader.getInt32();
+    if (formatIndex != static_cast<int32_t>(ImageFormat::RGB888) &&
+        formatIndex != static_cast<int32_t>(ImageFormat::RGBA8888)) {
+        throw std::runtime_error("invalid image format");
+    }
+    auto format = static_cast<ImageFormat>(formatIndex);
+    align(reader, payload);
+    check_remaining(
+        reader,
+        static_cast<uint64_t>(width) * height,
+        image_size(format, 1, 1)
+    );
+    size_t size = image_size(format, width, height);
+    auto image = std::make_unique<ImageData>(
+        format, width, height, reader.pointer()
+    );
+    reader.skip(size);
+    return image;
+}
+
+std::vector<ubyte> assets_cache::encode_atlas(const Atlas& atlas) {
+    ByteBuilder builder;
+    const auto& regions = atlas.getRegions();
+    builder.putInt32(regions.size());
+    for (const auto& [name, region] : regions) {
+        builder.put(name);
+        builder.putFloat32(region.u1);
+        builder.putFloat32(region.v1);
+        builder.putFloat32(region.u2);
+        builder.putFloat32(region.v2);
+    }
+    put_image(builder, *atlas.getImage());
+    return builder.build();
+}
+
+std::unique_ptr<Atlas> assets_cache::decode_atlas(
+    const std::vector<ubyte>& payload
+) {
+    ByteReader reader(payload.data(), payload.size());
+    auto count = static_cast<uint32_t>(reader.getInt32());
+    std::unordered_map<std::string, UVRegion> regions;
+    for (uint32_t i = 0; i < count; i++) {
+        auto name = reader.getString();
+        float u1 = reader.getFloat32();
+        float v1 = reader.getFloat32();
+        float u2 = reader.getFloat32();
+        float v2 = reader.getFloat32();
+        regions[name] = UVRegion(u1, v1, u2, v2);
+    }
+    auto image = get_image(reader, payload);
+    return std::make_unique<Atlas>(std::move(image), std::move(regions), false);
+}
+
+std::vector<ubyte> assets_cache::encode_images(
+    const std::vector<std::unique_ptr<ImageData>>& images
+) {
+    ByteBuilder builder;
+    builder.putInt32(images.size());
+    for (const auto& image : images) {
+        builder.put(image != nullptr);
+        if (image) {
+            put_image(builder, *image);
+        }
+    }
+    return builder.build();
+}
+
+std::vector<std::unique_ptr<ImageData>> assets_cache::decode_images(
+    const std::vector<ubyte>& payload
+) {
+    ByteReader reader(payload.data(), payload.size());
+    auto count = static_cast<uint32_t>(reader.getInt32());
+    std::vector<std::unique_ptr<ImageData>> images;
+    for (uint32_t i = 0; i < count; i++) {
+        if (reader.get()) {
+            images.push_back(get_image(reader, payload));
+        } else {
+            images.push_back(nullptr);
+        }
+    }
+    return images;
+}
+
+std::vector<ubyte> assets_cache::encode_model(const model::Model& model) {
+    ByteBuilder builder;
+    builder.putInt32(model.meshes.size());
+    for (const auto& mesh : model.meshes) {
+        builder.put(mesh.texture);
+        builder.put(mesh.shading);
+        builder.putInt32(mesh.vertices.size());
+        align(builder);
+        builder.put(
+            reinterpret_cast<const ubyte*>(mesh.vertices.data()),
+            mesh.vertices.size() * sizeof(model::Vertex)
+        );
+    }
+    return builder.build();
+}
+
+std::unique_ptr<model::Model> assets_cache::decode_model(
+    const std::vector<ubyte>& payload
+) {
+    ByteReader reader(payload.data(), payload.size());
+    auto count = static_cast<uint32_t>(reader.getInt32());
+    auto model = std::make_unique<model::Model>();
+    for (uint32_t i = 0; i < count; i++) {
+        auto& mesh = model->meshes.emplace_back();
+        mesh.texture = reader.getString();
+        mesh.shading = reader.get();
+        auto vertices = static_cast<uint32_t>(reader.getInt32());
+        align(reader, payload);
+        check_remaining(reader, vertices, sizeof(model::Vertex));
+        mesh.vertices.resize(vertices);
+        reader.get(
+            reinterpret_cast<char*>(mesh.vertices.data()),
+            vertices * sizeof(model::Vertex)
+        );
+    }
+    return model;
+}
+
+static io::path entry_file(const std::string& kind, const std::string& name) {
+    std::string filename = kind + "_" + name;
+    for (char& c : filename) {
+        if (!std::isalnum(static_cast<unsigned char>(c)) && c != '-' &&
+            c != '.') {
+            c = '_';
+        }
+    }
+    return folder / (filename + ".vcbake");
+}
+
+std::vector<ubyte> assets_cache::read(
+    const std::string& kind, const std::string& name, uint64_t key
+) {
+    if (!is_enabled()) {
+        return {};
+    }
+    auto file = entry_file(kind, name);
+    if (!io::is_regular_file(file)) {
+        return {};
+    }
+    auto payload = unpack(key, io::read_bytes(file));
+    if (payload.empty()) {
+        logger.info() << "outdated " << kind << " " << util::quote(name);
+    }
+    return payload;
+}
+
+void assets_cache::write(
+    const std::string& kind,
+    const std::string& name,
+    uint64_t key,
+    const std::vector<ubyte>& payload
+) {
+    if (!is_enabled()) {
+        return;
+    }
+    try {
+        io::create_directories(folder);
+        auto bytes = pack(key, payload);
+        io::write_bytes(entry_file(kind, name), bytes.data(), bytes.size());
+    } catch (const std::exception& err) {
+        logger.warning() << "could not to write " << kind << " "
+                         << util::quote(name) << ": " << err.what();
+    }
+}
+
+/// @brief Decode cached payload, invalid entries are treated as outdated
+template <typename T, typename Func>
+static T load(
+    const std::string& kind,
+    const std::string& name,
+    uint64_t key,
+    const Func& decode
+) {
+    auto payload = read(kind, name, key);
+    if (payload.empty()) {
+        return T();
+    }
+    try {
+        return decode(payload);
+    } catch (const std::runtime_error& err) {
+        logger.warning() << "invalid " << kind << " " << util::quote(name)
+                         << ": " << err.what();
+        return T();
+    }
+}
+
+std::unique_ptr<Atlas> assets_cache::load_atlas(
+    const std::string& name, uint64_t key
+) {
+    return load<std::unique_ptr<Atlas>>("atlas", name, key, decode_atlas);
+}
+
+void assets_cache::store_atlas(
+    const std::string& name, uint64_t key, const Atlas& atlas
+) {
+    write("atlas", name, key, encode_atlas(atlas));
+}
+
+std::vector<std::unique_ptr<ImageData>> assets_cache::load_images(
+    const std::string& name, uint64_t key
+) {
+    return load<std::vector<std::unique_ptr<ImageData>>>(
+        "images", name, key, decode_images
+    );
+}
+
+void assets_cache::store_images(
+    const std::string& name,
+    uint64_t key,
+    const std::vector<std::unique_ptr<ImageData>>& images
+) {
+    write("images", name, key, encode_images(images));
+}
+
+std::unique_ptr<model::Model> assets_cache::load_model(
+    const std::string& name, uint64_t key
+) {
+    return load<std::unique_ptr<model::Model>>(
+        "model", name, key, decode_model
+    );
+}
+
+void assets_cache::store_model(
+    const std::string& name, uint64_t key, const model::Model& model
+) {
+    write("model", name, key, encode_model(model));
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "io/io.hpp"
+#include "typedefs.hpp"
+
+class Atlas;
+class ImageData;
+
+namespace model {
+    struct Model;
+}
+
+/// @brief On-disk cache of baked assets (packed atlases, decoded font pages,
+/// preprocessed models). Every entry is stored with a key calculated from
+/// the source files contents and paths, so outdated entries are rebuilt.
+namespace assets_cache {
+    inline constexpr uint VERSION = 1;
+    inline const io::path DEFAULT_FOLDER = "user:cache/assets";
+
+    /// @brief Incremental 64 bit FNV-1a hash of baked asset inputs
+    class Key {
+        uint64_t value = 0xcbf29ce484222325ULL;
+    public:
+        /// @param kind asset kind (different kinds never share keys)
+        Key(std::string_view kind);
+
+        void update(const void* data, size_t size);
+        void update(std::string_view str);
+        void update(uint64_t number);
+        /// @brief Update with file path and contents
+        void updateFile(const io::path& file);
+
+        uint64_t get() const {
+            return value;
+        }
+    };
+
+    /// @brief Set cache folder. Empty path disables the cache
+    void set_folder(io::path folder);
+
+    /// @return true if cache folder entry point is available
+    bool is_enabled();
+
+    /// @brief Wrap payload into cache entry (header with key and checksum)
+    std::vector<ubyte> pack(uint64_t key, const std::vector<ubyte>& payload);
+
+    /// @brief Extract payload from cache entry
+    /// @return empty vector if entry is invalid or key does not match
+    std::vector<ubyte> unpack(uint64_t key, const std::vector<ubyte>& entry);
+
+    std::vector<ubyte> encode_atlas(const Atlas& atlas);
+    /// @throws std::runtime_error on invalid data
+    std::unique_ptr<Atlas> decode_atlas(const std::vector<ubyte>& payload);
+
+    /// @param images images list (nullptr elements are allowed)
+    std::vector<ubyte> encode_images(
+        const std::vector<std::unique_ptr<ImageData>>& images
+    );
+    /// @throws std::runtime_error on invalid data
+    std::vector<std::unique_ptr<ImageData>> decode_images(
+        const std::vector<ubyte>& payload
+    );
+
+    std::vector<ubyte> encode_model(const model::Model& model);
+    /// @throws std::runtime_error on invalid data
+    std::unique_ptr<model::Model> decode_model(
+        const std::vector<ubyte>& payload
+    );
+
+    /// @brief Read cached payload of the asset
+    /// @param kind asset kind
+    /// @param name asset name
+    /// @return empty vector if not cached or outdated
+    std::vector<ubyte> read(
+        const std::string& kind, const std::string& name, uint64_t key
+    );
+
+    /// @brief Write payload to the cache. Errors are logged, not thrown
+    void write(
+        const std::string& kind,
+        const std::string& name,
+        uint64_t key,
+        const std::vector<ubyte>& payload
+    );
+
+    /// @return nullptr if not cached or outdated
+    std::unique_ptr<Atlas> load_atlas(const std::string& name, uint64_t key);
+    void store_atlas(const std::string& name, uint64_t key, const Atlas& atlas);
+
+    /// @return empty vector if not cached or outdated
+    std::vector<std::unique_ptr<ImageData>> load_images(
+        const std::string& name, uint64_t key
+    );
+    void store_images(
+        const std::string& name,
+        uint64_t key,
+        const std::vector<std::unique_ptr<ImageData>>& images
+    );
+
+    /// @return nullptr if not cached or outdated
+    std::unique_ptr<model::Model> load_model(
+        const std::string& name, uint64_t key
+    );
+    void store_model(
+        const std::string& name, uint64_t key, const model::Model& model
+    );
+}
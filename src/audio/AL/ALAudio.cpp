@@ -276,7 +276,7 @@ void ALStream::update(double delta) {
     if (speaker->isStopped() && !alspeaker->manuallyStopped) { //TODO: -V560 false-positive?
         if (preloaded) {
             speaker->play();
-        } else if (isStopOnEnd()){
+        } else if (isStopOnEnd() && !source->isBuffering()) {
             speaker->stop();
         }
     }
@@ -0,0 +1,91 @@
+#include "AudioWorker.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+#include "BufferedPCMStream.hpp"
+#include "debug/Logger.hpp"
+
+static debug::Logger logger("audio-worker");
+
+using namespace audio;
+
+/// @brief Idle thread wake-up interval. Consumers notify the worker when
+/// data is read, so it is only used to release unreferenced streams
+static inline constexpr auto IDLE_INTERVAL = std::chrono::milliseconds(100);
+
+AudioWorker::AudioWorker() : thread([this]() { run(); }) {
+}
+
+AudioWorker::~AudioWorker() {
+    running = false;
+    notify();
+    thread.join();
+    for (const auto& stream : streams) {
+        stream->abort();
+    }
+}
+
+void AudioWorker::add(std::shared_ptr<BufferedPCMStream> stream) {
+    stream->setWorker(this);
+    {
+        std::lock_guard lock(mutex);
+        streams.push_back(std::move(stream));
+    }
+    notify();
+}
+
+void AudioWorker::notify() {
+    {
+        std::lock_guard lock(mutex);
+        notified = true;
+    }
+    cond.notify_one();
+}
+
+size_t AudioWorker::count() const {
+    std::lock_guard lock(mutex);
+    return streams.size();
+}
+
+void AudioWorker::run() {
+    std::vector<std::shared_ptr<BufferedPCMStream>> active;
+    while (running) {
+        {
+            std::unique_lock lock(mutex);
+            auto released = std::stable_partition(
+                streams.begin(),
+                streams.end(),
+                [](const auto& stream) {
+                    return stream->isOpen() && stream.use_count() > 1;
+                }
+            );
+            // released streams must not notify the worker anymore
+            for (auto it = released; it != streams.end(); ++it) {
+                (*it)->abort();
+            }
+            streams.erase(released, streams.end());
+            active = streams;
+        }
+        bool decoded = false;
+        // one chunk per stream at a time, so music does not delay
+        // short ambient streams
+        for (const auto& stream : active) {
+            try {
+                decoded |= stream->fill() > 0;
+            } catch (const std::exception& err) {
+                logger.error() << "stream decoding error: " << err.what();
+                stream->close();
+            }
+        }
+        active.clear();
+        if (decoded) {
+            continue;
+        }
+        std::unique_lock lock(mutex);
+        cond.wait_for(lock, IDLE_INTERVAL, [this]() {
+            return notified || !running;
+        });
+        notified = false;
+    }
+}
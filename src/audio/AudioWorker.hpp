@@ -0,0 +1,40 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace audio {
+    class BufferedPCMStream;
+
+    /// @brief Background thread decoding buffered streams ahead of playback
+    class AudioWorker {
+    public:
+        AudioWorker();
+        /// @brief Stops the thread. Streams left are aborted
+        ~AudioWorker();
+
+        /// @brief Start decoding the stream. Stream is released when closed
+        /// or not referenced anywhere else
+        void add(std::shared_ptr<BufferedPCMStream> stream);
+
+        /// @brief Wake up the thread (e.g. when stream data is consumed)
+        void notify();
+
+        /// @brief Get number of decoded streams
+        size_t count() const;
+    private:
+        mutable std::mutex mutex;
+        std::condition_variable cond;
+        std::vector<std::shared_ptr<BufferedPCMStream>> streams;
+        std::atomic<bool> running = true;
+        bool notified = false;
+        /// @brief Declared last to start after other members initialized
+        std::thread thread;
+
+        void run();
+    };
+}
@@ -0,0 +1,180 @@
+#include "BufferedPCMStream.hpp"
+
+#include <algorithm>
+
+#include "AudioWorker.hpp"
+
+using namespace audio;
+
+BufferedPCMStream::BufferedPCMStream(
+    std::unique_ptr<PCMStream> source, size_t capacity
+)
+    : source(std::move(source)),
+      ring(capacity),
+      totalSamples(this->source->getTotalSamples()),
+      totalDuration(this->source->getTotalDuration()),
+      channels(this->source->getChannels()),
+      sampleRate(this->source->getSampleRate()),
+      bitsPerSample(this->source->getBitsPerSample()),
+      seekable(this->source->isSeekable()),
+      frameSize(std::max<size_t>(1, channels * bitsPerSample / 8)) {
+}
+
+size_t BufferedPCMStream::fill() {
+    std::lock_guard lock(sourceMutex);
+    if (!isStarving()) {
+        return 0;
+    }
+    auto span = ring.writable();
+    size_t size = std::min(span.size, CHUNK_SIZE);
+    size_t read = source->read(span.data, size);
+    if ((read == 0 || read == PCMStream::ERROR) && loop && seekable) {
+        source->seek(0);
+        read = source->read(span.data, size);
+    }
+    if (read == 0 || read == PCMStream::ERROR) {
+        ended = true;
+        return 0;
+    }
+    ring.commit(read);
+    return read;
+}
+
+bool BufferedPCMStream::isStarving() const {
+    // not decoding small pieces
+    return !ended && !closed &&
+           ring.freeSpace() >= std::min(CHUNK_SIZE, ring.capacity() / 4);
+}
+
+void BufferedPCMStream::setWorker(AudioWorker* worker) {
+    this->worker = worker;
+}
+
+void BufferedPCMStream::abort() {
+    aborted = true;
+    worker = nullptr;
+}
+
+void BufferedPCMStream::notifyWorker() {
+    if (auto worker = this->worker.load()) {
+        worker->notify();
+    }
+}
+
+void BufferedPCMStream::setLoop(bool flag) {
+    {
+        std::lock_guard lock(sourceMutex);
+        loop = flag;
+        // buffered data ends exactly at the source end, so the source
+        // may be continued from start
+        if (!flag || !ended || !seekable || closed) {
+            return;
+        }
+        source->seek(0);
+        ended = false;
+    }
+    notifyWorker();
+}
+
+size_t BufferedPCMStream::read(
+    char* buffer, size_t bufferSize, bool countUnderrun
+) {
+    // checking the flags before reading to not to count data decoded
+    // right before the source end as underrun
+    bool finished = ended || closed || aborted;
+    size_t size = std::min(bufferSize, ring.size());
+    size_t total = ring.read(buffer, size - size % frameSize);
+    if (total > 0 && isStarving()) {
+        notifyWorker();
+    }
+    if (total < bufferSize && !finished && countUnderrun) {
+        underruns++;
+    }
+    return total;
+}
+
+size_t BufferedPCMStream::readFully(
+    char* buffer, size_t bufferSize, bool loop
+) {
+    if (closed) {
+        return 0;
+    }
+    if (loop != this->loop) {
+        setLoop(loop);
+    }
+    return read(buffer, bufferSize, true);
+}
+
+size_t BufferedPCMStream::read(char* buffer, size_t bufferSize) {
+    if (closed) {
+        return PCMStream::ERROR;
+    }
+    return read(buffer, bufferSize, false);
+}
+
+bool BufferedPCMStream::isBuffering() const {
+    return (!ended && !closed && !aborted) || ring.size() >= frameSize;
+}
+
+void BufferedPCMStream::close() {
+    {
+        std::lock_guard lock(sourceMutex);
+        closed = true;
+        source->close();
+    }
+    // let the worker release the stream
+    notifyWorker();
+}
+
+bool BufferedPCMStream::isOpen() const {
+    return !closed;
+}
+
+size_t BufferedPCMStream::getTotalSamples() const {
+    return totalSamples;
+}
+
+duration_t BufferedPCMStream::getTotalDuration() const {
+    return totalDuration;
+}
+
+uint BufferedPCMStream::getChannels() const {
+    return channels;
+}
+
+uint BufferedPCMStream::getSampleRate() const {
+    return sampleRate;
+}
+
+uint BufferedPCMStream::getBitsPerSample() const {
+    return bitsPerSample;
+}
+
+bool BufferedPCMStream::isSeekable() const {
+    return seekable;
+}
+
+void BufferedPCMStream::seek(size_t position) {
+    if (!seekable) {
+        return;
+    }
+    {
+        std::lock_guard lock(sourceMutex);
+        if (closed) {
+            return;
+        }
+        // producer is blocked by the source mutex
+        ring.discard();
+        source->seek(position);
+        ended = false;
+    }
+    notifyWorker();
+}
+
+size_t BufferedPCMStream::available() const {
+    return ring.size();
+}
+
+size_t BufferedPCMStream::getUnderruns() const {
+    return underruns;
+}
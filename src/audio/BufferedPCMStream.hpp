@@ -0,0 +1,104 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+
+#include "audio.hpp"
+#include "util/SpscRingBuffer.hpp"
+
+namespace audio {
+    class AudioWorker;
+
+    /// @brief PCMStream decorator keeping decoded data ahead of playback.
+    /// Source is decoded by AudioWorker thread (fill) into lock-free ring
+    /// buffer, consumer reads decoded data only and never waits for the
+    /// producer: if not enough is decoded yet, less data is returned.
+    /// Loop mode is handled by the producer, so the source is seeked to
+    /// start without gaps.
+    class BufferedPCMStream : public PCMStream {
+    public:
+        /// @brief Max bytes decoded by single fill call
+        static inline constexpr size_t CHUNK_SIZE = 16384;
+
+        /// @param source decoded stream (not accessed by other threads)
+        /// @param capacity ring buffer capacity in bytes (power of 2)
+        BufferedPCMStream(
+            std::unique_ptr<PCMStream> source, size_t capacity = 262144
+        );
+
+        /// @brief Decode next chunk if there is enough free space.
+        /// Producer (worker) thread only
+        /// @return number of decoded bytes
+        size_t fill();
+
+        /// @brief Check if fill() would decode something
+        bool isStarving() const;
+
+        /// @brief Set worker notified when buffered data is consumed
+        void setWorker(AudioWorker* worker);
+
+        /// @brief Detach from the worker (no more fill calls expected)
+        void abort();
+
+        /// @brief Read buffered data without waiting for the producer.
+        /// Returns less than bufferSize (counted as underrun) if the
+        /// producer lags, use isBuffering() to tell it from the stream end
+        size_t readFully(char* buffer, size_t bufferSize, bool loop) override;
+
+        size_t read(char* buffer, size_t bufferSize) override;
+
+        bool isBuffering() const override;
+
+        void close() override;
+
+        bool isOpen() const override;
+
+        size_t getTotalSamples() const override;
+
+        duration_t getTotalDuration() const override;
+
+        uint getChannels() const override;
+
+        uint getSampleRate() const override;
+
+        uint getBitsPerSample() const override;
+
+        bool isSeekable() const override;
+
+        void seek(size_t position) override;
+
+        /// @brief Get number of buffered bytes
+        size_t available() const;
+
+        /// @brief Get number of reads got less data than requested
+        /// because of the producer lag
+        size_t getUnderruns() const;
+    private:
+        std::unique_ptr<PCMStream> source;
+        util::SpscRingBuffer<char> ring;
+
+        size_t totalSamples;
+        duration_t totalDuration;
+        uint channels;
+        uint sampleRate;
+        uint bitsPerSample;
+        bool seekable;
+        /// @brief Reads are aligned to whole sample frames
+        size_t frameSize;
+
+        /// @brief Guards source access
+        std::mutex sourceMutex;
+        std::atomic<AudioWorker*> worker = nullptr;
+
+        std::atomic<bool> loop = false;
+        /// @brief Source end reached (or error occurred)
+        std::atomic<bool> ended = false;
+        std::atomic<bool> closed = false;
+        std::atomic<bool> aborted = false;
+        std::atomic<size_t> underruns = 0;
+
+        void setLoop(bool loop);
+        void notifyWorker();
+        size_t read(char* buffer, size_t bufferSize, bool countUnderrun);
+    };
+}
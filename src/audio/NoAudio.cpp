@@ -1,26 +1,182 @@
 #include "NoAudio.hpp"
 
+#include <cmath>
+
 using namespace audio;
 
-NoSound::NoSound(const std::shared_ptr<PCM>& pcm, bool keepPCM) {
+NoSound::NoSound(
+    NoAudio* backend, const std::shared_ptr<PCM>& pcm, bool keepPCM
+)
+    : backend(backend) {
     duration = pcm->getDuration();
     if (keepPCM) {
         this->pcm = pcm;
     }
 }
 
+std::unique_ptr<Speaker> NoSound::newInstance(int priority, int channel) const {
+    if (!backend->isDecoding() || !backend->hasFreeSpeaker()) {
+        return nullptr;
+    }
+    auto speaker = std::make_unique<NoSpeaker>(backend, priority, channel);
+    speaker->duration = duration;
+    return speaker;
+}
+
+NoStream::NoStream(
+    NoAudio* backend,
+    const std::shared_ptr<PCMStream>& source,
+    bool keepSource
+)
+    : backend(backend), source(source), keepSource(keepSource) {
+    duration = source->getTotalDuration();
+}
+
+NoStream::~NoStream() {
+    bindSpeaker(0);
+}
+
+void NoStream::bindSpeaker(speakerid_t speakerid) {
+    if (auto sp = dynamic_cast<NoSpeaker*>(audio::get_speaker(this->speaker))) {
+        sp->stop();
+        sp->stream = nullptr;
+    }
+    this->speaker = speakerid;
+    if (auto sp = dynamic_cast<NoSpeaker*>(audio::get_speaker(speakerid))) {
+        sp->stream = this;
+        sp->duration = duration;
+    }
+}
+
+std::unique_ptr<Speaker> NoStream::createSpeaker(bool loop, int channel) {
+    if (!backend->isDecoding() || !backend->hasFreeSpeaker()) {
+        return nullptr;
+    }
+    this->loop = loop;
+    return std::make_unique<NoSpeaker>(backend, PRIORITY_HIGH, channel);
+}
+
+void NoStream::update(double delta) {
+    if (!backend->isDecoding() || speaker == 0) {
+        return;
+    }
+    auto sp = dynamic_cast<NoSpeaker*>(audio::get_speaker(speaker));
+    if (sp == nullptr || sp->isManuallyStopped()) {
+        speaker = 0;
+        return;
+    }
+    if (!sp->isPlaying()) {
+        return;
+    }
+    uint frameSize = source->getChannels() * source->getBitsPerSample() / 8;
+    size_t samples = static_cast<size_t>(
+        delta * source->getSampleRate() * sp->getPitch()
+    );
+    buffer.resize(samples * frameSize);
+    size_t read = source->readFully(buffer.data(), buffer.size(), loop);
+    playedSamples += read / frameSize;
+    if (source->isSeekable() && source->getTotalSamples()) {
+        playedSamples %= source->getTotalSamples();
+    }
+    if (read < buffer.size() && !loop && !source->isBuffering()) {
+        sp->finish();
+    }
+}
+
+duration_t NoStream::getTime() const {
+    return playedSamples / static_cast<duration_t>(source->getSampleRate());
+}
+
+void NoStream::setTime(duration_t time) {
+    if (!source->isSeekable()) {
+        return;
+    }
+    size_t sample = time * source->getSampleRate();
+    source->seek(sample);
+    playedSamples = sample;
+}
+
+NoSpeaker::NoSpeaker(NoAudio* backend, int priority, int channel)
+    : backend(backend), priority(priority), channel(channel) {
+    backend->speakersCount++;
+}
+
+NoSpeaker::~NoSpeaker() {
+    backend->speakersCount--;
+}
+
+State NoSpeaker::getState() const {
+    if (state == State::playing && stream == nullptr && !loop &&
+        getTime() >= duration) {
+        return State::stopped;
+    }
+    return state;
+}
+
+void NoSpeaker::play() {
+    if (state == State::paused) {
+        startTime = backend->getTime() - pausedTime / pitch;
+    } else {
+        startTime = backend->getTime();
+    }
+    state = State::playing;
+    manuallyStopped = false;
+}
+
+void NoSpeaker::pause() {
+    if (state == State::playing) {
+        pausedTime = getTime();
+        state = State::paused;
+    }
+}
+
+void NoSpeaker::stop() {
+    manuallyStopped = true;
+    finish();
+}
+
+void NoSpeaker::finish() {
+    state = State::stopped;
+    pausedTime = 0.0;
+}
+
+duration_t NoSpeaker::getTime() const {
+    if (stream) {
+        return stream->getTime();
+    }
+    if (state != State::playing) {
+        return pausedTime;
+    }
+    duration_t time = (backend->getTime() - startTime) * pitch;
+    if (loop && duration > 0.0) {
+        time = std::fmod(time, duration);
+    }
+    return time;
+}
+
+void NoSpeaker::setTime(duration_t time) {
+    if (stream) {
+        return stream->setTime(time);
+    }
+    if (state == State::playing) {
+        startTime = backend->getTime() - time / pitch;
+    } else {
+        pausedTime = time;
+    }
+}
+
 std::unique_ptr<Sound> NoAudio::createSound(
     std::shared_ptr<PCM> pcm, bool keepPCM
 ) {
-    return std::make_unique<NoSound>(pcm, keepPCM);
+    return std::make_unique<NoSound>(this, pcm, keepPCM);
 }
 
 std::unique_ptr<Stream> NoAudio::openStream(
     std::shared_ptr<PCMStream> stream, bool keepSource
 ) {
-    return std::make_unique<NoStream>(stream, keepSource);
+    return std::make_unique<NoStream>(this, stream, keepSource);
 }
 
-std::unique_ptr<NoAudio> NoAudio::create() {
-    return std::make_unique<NoAudio>();
+std::unique_ptr<NoAudio> NoAudio::create(bool decoding, size_t maxSpeakers) {
+    return std::make_unique<NoAudio>(decoding, maxSpeakers);
 }
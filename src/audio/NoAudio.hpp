@@ -3,11 +3,16 @@
 #include "audio.hpp"
 
 namespace audio {
+    class NoAudio;
+
     class NoSound : public Sound {
+        NoAudio* backend;
         std::shared_ptr<PCM> pcm;
         duration_t duration;
     public:
-        NoSound(const std::shared_ptr<PCM>& pcm, bool keepPCM);
+        NoSound(
+            NoAudio* backend, const std::shared_ptr<PCM>& pcm, bool keepPCM
+        );
         ~NoSound() {
         }
 
@@ -20,61 +25,203 @@ namespace audio {
         }
 
         std::unique_ptr<Speaker> newInstance(int priority, int channel)
-            const override {
-            return nullptr;
-        }
+            const override;
     };
 
     class NoStream : public Stream {
+        NoAudio* backend;
         std::shared_ptr<PCMStream> source;
+        bool keepSource;
         duration_t duration;
+        speakerid_t speaker = 0;
+        bool loop = false;
+        bool stopOnEnd = false;
+        size_t playedSamples = 0;
+        std::vector<char> buffer;
     public:
-        NoStream(const std::shared_ptr<PCMStream>& source, bool keepSource) {
-            duration = source->getTotalDuration();
-            if (keepSource) {
-                this->source = source;
-            }
-        }
+        NoStream(
+            NoAudio* backend,
+            const std::shared_ptr<PCMStream>& source,
+            bool keepSource
+        );
+        ~NoStream();
 
         std::shared_ptr<PCMStream> getSource() const override {
-            return source;
+            return keepSource ? source : nullptr;
         }
 
-        void bindSpeaker(speakerid_t speaker) override {
-        }
+        void bindSpeaker(speakerid_t speaker) override;
 
         std::unique_ptr<Speaker> createSpeaker(bool loop, int channel)
-            override {
-            return nullptr;
-        }
+            override;
 
         speakerid_t getSpeaker() const override {
-            return 0;
+            return speaker;
         }
 
-        void update(double delta) override {
+        /// @brief Consume source data at playback rate (decoding mode only)
+        void update(double delta) override;
+
+        duration_t getTime() const override;
+
+        void setTime(duration_t time) override;
+
+        bool isStopOnEnd() const override {
+            return stopOnEnd;
         }
 
-        duration_t getTime() const override {
-            return 0.0;
+        void setStopOnEnd(bool stopOnEnd) override {
+            this->stopOnEnd = stopOnEnd;
         }
+    };
+
+    /// @brief Speaker playing nothing. Keeps state and tracks time
+    /// (decoding mode only)
+    class NoSpeaker : public Speaker {
+        NoAudio* backend;
+        int priority;
+        int channel;
+        State state = State::stopped;
+        bool manuallyStopped = false;
+        float volume = 1.0f;
+        float pitch = 1.0f;
+        bool loop = false;
+        bool relative = false;
+        glm::vec3 position {};
+        glm::vec3 velocity {};
+        /// @brief Backend time of the playback start (at time = 0)
+        duration_t startTime = 0.0;
+        /// @brief Time position when paused
+        duration_t pausedTime = 0.0;
+    public:
+        /// @brief Bound stream controlling the speaker state and time
+        NoStream* stream = nullptr;
+        duration_t duration = 0.0;
+
+        NoSpeaker(NoAudio* backend, int priority, int channel);
+        ~NoSpeaker();
 
-        void setTime(duration_t time) override {
+        void update(const Channel*) override {
         }
 
-        bool isStopOnEnd() const override {
-            return false;
+        int getChannel() const override {
+            return channel;
         }
 
-        void setStopOnEnd(bool stopOnEnd) override {
+        State getState() const override;
+
+        float getVolume() const override {
+            return volume;
+        }
+
+        void setVolume(float volume) override {
+            this->volume = volume;
+        }
+
+        float getPitch() const override {
+            return pitch;
+        }
+
+        void setPitch(float pitch) override {
+            this->pitch = pitch;
+        }
+
+        bool isLoop() const override {
+            return loop;
+        }
+
+        void setLoop(bool loop) override {
+            this->loop = loop;
+        }
+
+        void play() override;
+        void pause() override;
+        void stop() override;
+
+        /// @brief Stop as audio end reached
+        void finish();
+
+        duration_t getTime() const override;
+
+        duration_t getDuration() const override {
+            return duration;
+        }
+
+        void setTime(duration_t time) override;
+
+        void setPosition(glm::vec3 pos) override {
+            position = pos;
+        }
+
+        glm::vec3 getPosition() const override {
+            return position;
+        }
+
+        void setVelocity(glm::vec3 vel) override {
+            velocity = vel;
+        }
+
+        glm::vec3 getVelocity() const override {
+            return velocity;
+        }
+
+        int getPriority() const override {
+            return priority;
+        }
+
+        void setRelative(bool relative) override {
+            this->relative = relative;
+        }
+
+        bool isRelative() const override {
+            return relative;
+        }
+
+        bool isManuallyStopped() const override {
+            return manuallyStopped;
         }
     };
 
+    /// @brief Backend playing nothing.
+    /// In decoding mode sounds and streams data is decoded the same way as
+    /// with actual audio backend and consumed at playback rate, so audio
+    /// system may be tested and benchmarked headlessly. Otherwise only
+    /// headers are read and speakers are not created.
     class NoAudio : public Backend {
+        bool decoding;
+        /// @brief Max number of speakers existing at the same time
+        /// (like AL sources limit)
+        size_t maxSpeakers;
+        size_t speakersCount = 0;
+        /// @brief Time elapsed since creation
+        duration_t time = 0.0;
+
+        friend class NoSpeaker;
     public:
+        NoAudio(bool decoding = false, size_t maxSpeakers = SIZE_MAX)
+            : decoding(decoding), maxSpeakers(maxSpeakers) {
+        }
+
         ~NoAudio() {
         }
 
+        bool isDecoding() const {
+            return decoding;
+        }
+
+        duration_t getTime() const {
+            return time;
+        }
+
+        /// @brief Check if a speaker may be created
+        bool hasFreeSpeaker() const {
+            return speakersCount < maxSpeakers;
+        }
+
+        size_t getSpeakersCount() const {
+            return speakersCount;
+        }
+
         std::unique_ptr<Sound> createSound(
             std::shared_ptr<PCM> pcm, bool keepPCM
         ) override;
@@ -102,15 +249,18 @@ namespace audio {
         }
 
         void update(double delta) override {
+            time += delta;
         }
 
         void setAcoustics(Acoustics) override {
         }
 
         bool isDummy() const override {
-            return true;
+            return !decoding;
         }
 
-        static std::unique_ptr<NoAudio> create();
+        static std::unique_ptr<NoAudio> create(
+            bool decoding = false, size_t maxSpeakers = SIZE_MAX
+        );
     };
 }
@@ -0,0 +1,92 @@
+#include "PCMCache.hpp"
+
+#include "audio.hpp"
+
+using namespace audio;
+
+PCMCache::PCMCache(size_t capacity) : capacity(capacity) {
+}
+
+std::shared_ptr<PCM> PCMCache::get(
+    const std::string& key, const loader_func& loader
+) {
+    std::unique_lock lock(mutex);
+    while (true) {
+        if (auto pcm = findLocked(key)) {
+            stats.hits++;
+            return pcm;
+        }
+        if (loading.find(key) == loading.end()) {
+            break;
+        }
+        loadedCond.wait(lock);
+    }
+    stats.misses++;
+    loading.insert(key);
+    lock.unlock();
+
+    std::shared_ptr<PCM> pcm;
+    try {
+        pcm = loader();
+    } catch (...) {
+        lock.lock();
+        loading.erase(key);
+        loadedCond.notify_all();
+        throw;
+    }
+    lock.lock();
+    loading.erase(key);
+    store(key, pcm);
+    loadedCond.notify_all();
+    return pcm;
+}
+
+std::shared_ptr<PCM> PCMCache::find(const std::string& key) {
+    std::lock_guard lock(mutex);
+    return findLocked(key);
+}
+
+std::shared_ptr<PCM> PCMCache::findLocked(const std::string& key) {
+    const auto& found = entries.find(key);
+    if (found == entries.end()) {
+        return nullptr;
+    }
+    auto& entry = found->second;
+    order.splice(order.begin(), order, entry.position);
+    return entry.pcm;
+}
+
+void PCMCache::store(const std::string& key, std::shared_ptr<PCM> pcm) {
+    if (pcm == nullptr || pcm->data.size() > capacity) {
+        return;
+    }
+    const auto& found = entries.find(key);
+    if (found != entries.end()) {
+        stats.bytes -= found->second.pcm->data.size();
+        order.erase(found->second.position);
+        entries.erase(found);
+    }
+    stats.bytes += pcm->data.size();
+    order.push_front(key);
+    entries[key] = Entry {std::move(pcm), order.begin()};
+
+    while (stats.bytes > capacity) {
+        const auto& last = entries.find(order.back());
+        stats.bytes -= last->second.pcm->data.size();
+        stats.evictions++;
+        entries.erase(last);
+        order.pop_back();
+    }
+}
+
+void PCMCache::clear() {
+    std::lock_guard lock(mutex);
+    entries.clear();
+    order.clear();
+    stats.bytes = 0;
+}
+
+PCMCache::Stats PCMCache::getStats() const {
+    std::lock_guard lock(mutex);
+    return stats;
+}
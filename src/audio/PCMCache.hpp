@@ -0,0 +1,65 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace audio {
+    struct PCM;
+
+    /// @brief Thread-safe LRU cache of decoded PCM data limited by the
+    /// total data size. Concurrent requests of the same key are decoded once
+    class PCMCache {
+    public:
+        struct Stats {
+            size_t hits = 0;
+            size_t misses = 0;
+            size_t evictions = 0;
+            /// @brief Total cached PCM data size
+            size_t bytes = 0;
+        };
+
+        using loader_func = std::function<std::shared_ptr<PCM>()>;
+
+        /// @param capacity max total PCM data size (bytes)
+        PCMCache(size_t capacity);
+
+        /// @brief Get cached PCM or load it. PCM larger than the cache
+        /// capacity is not stored
+        /// @param key cache key (file path)
+        /// @param loader decoding function (called without lock)
+        /// @throws any exception thrown by the loader
+        std::shared_ptr<PCM> get(const std::string& key, const loader_func& loader);
+
+        /// @brief Get cached PCM without loading
+        /// @return nullptr if not found
+        std::shared_ptr<PCM> find(const std::string& key);
+
+        void clear();
+
+        Stats getStats() const;
+    private:
+        struct Entry {
+            std::shared_ptr<PCM> pcm;
+            std::list<std::string>::iterator position;
+        };
+
+        size_t capacity;
+        mutable std::mutex mutex;
+        std::condition_variable loadedCond;
+        /// @brief Keys ordered from the most recently used
+        std::list<std::string> order;
+        std::unordered_map<std::string, Entry> entries;
+        /// @brief Keys being loaded now
+        std::unordered_set<std::string> loading;
+        Stats stats;
+
+        std::shared_ptr<PCM> findLocked(const std::string& key);
+        void store(const std::string& key, std::shared_ptr<PCM> pcm);
+    };
+}
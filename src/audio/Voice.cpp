@@ -0,0 +1,160 @@
+#include "Voice.hpp"
+
+#include <cmath>
+
+using namespace audio;
+
+Voice::Voice(const Sound* origin, const Sound* sound, int priority, int channel)
+    : origin(origin), sound(sound), priority(priority), channel(channel) {
+}
+
+Voice::~Voice() {
+    if (speaker) {
+        speaker->stop();
+    }
+}
+
+void Voice::bind(std::unique_ptr<Speaker> speaker) {
+    speaker->setPosition(position);
+    speaker->setVelocity(velocity);
+    speaker->setRelative(relative);
+    speaker->setVolume(volume);
+    speaker->setPitch(pitch);
+    speaker->setLoop(loop);
+    speaker->play();
+    if (time > 0.0) {
+        speaker->setTime(time);
+    }
+    if (state == State::paused) {
+        speaker->pause();
+    }
+    this->speaker = std::move(speaker);
+}
+
+void Voice::unbind() {
+    if (speaker == nullptr) {
+        return;
+    }
+    time = speaker->getTime();
+    if (speaker->isStopped()) {
+        state = State::stopped;
+    }
+    speaker->stop();
+    speaker = nullptr;
+}
+
+void Voice::advance(double delta) {
+    if (speaker || state != State::playing) {
+        return;
+    }
+    time += delta * pitch;
+    duration_t duration = sound->getDuration();
+    if (time < duration) {
+        return;
+    }
+    if (loop && duration > 0.0) {
+        time = std::fmod(time, duration);
+    } else {
+        state = State::stopped;
+    }
+}
+
+void Voice::update(const Channel* channel) {
+    if (speaker) {
+        speaker->update(channel);
+    }
+}
+
+State Voice::getState() const {
+    if (speaker) {
+        return speaker->getState();
+    }
+    return state;
+}
+
+void Voice::setVolume(float volume) {
+    this->volume = volume;
+    if (speaker) {
+        speaker->setVolume(volume);
+    }
+}
+
+void Voice::setPitch(float pitch) {
+    this->pitch = pitch;
+    if (speaker) {
+        speaker->setPitch(pitch);
+    }
+}
+
+void Voice::setLoop(bool loop) {
+    this->loop = loop;
+    if (speaker) {
+        speaker->setLoop(loop);
+    }
+}
+
+void Voice::play() {
+    if (state != State::paused) {
+        time = 0.0;
+    }
+    state = State::playing;
+    manuallyStopped = false;
+    if (speaker) {
+        speaker->play();
+    }
+}
+
+void Voice::pause() {
+    state = State::paused;
+    if (speaker) {
+        speaker->pause();
+    }
+}
+
+void Voice::stop() {
+    manuallyStopped = true;
+    state = State::stopped;
+    if (speaker) {
+        speaker->stop();
+        speaker = nullptr;
+    }
+}
+
+duration_t Voice::getTime() const {
+    if (speaker) {
+        return speaker->getTime();
+    }
+    return time;
+}
+
+duration_t Voice::getDuration() const {
+    return sound->getDuration();
+}
+
+void Voice::setTime(duration_t time) {
+    this->time = time;
+    if (speaker) {
+        speaker->setTime(time);
+    }
+}
+
+void Voice::setPosition(glm::vec3 pos) {
+    position = pos;
+    if (speaker) {
+        speaker->setPosition(pos);
+    }
+}
+
+void Voice::setVelocity(glm::vec3 vel) {
+    velocity = vel;
+    if (speaker) {
+        speaker->setVelocity(vel);
+    }
+}
+
+void Voice::setRelative(bool relative) {
+    this->relative = relative;
+    if (speaker) {
+        speaker->setRelative(relative);
+    }
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "audio.hpp"
+
+namespace audio {
+    /// @brief Sound instance which may have no actual speaker (virtual
+    /// voice). Inaudible instances are virtualized: the speaker is released
+    /// and playback position is tracked by the voice, so the instance may be
+    /// resumed at the correct offset when becomes audible again.
+    class Voice : public Speaker {
+        /// @brief Requested sound (used to coalesce identical sounds)
+        const Sound* origin;
+        /// @brief Played sound (origin or its variant)
+        const Sound* sound;
+        std::unique_ptr<Speaker> speaker;
+        int priority;
+        int channel;
+        State state = State::stopped;
+        bool manuallyStopped = false;
+        float volume = 1.0f;
+        float pitch = 1.0f;
+        bool loop = false;
+        bool relative = false;
+        glm::vec3 position {};
+        glm::vec3 velocity {};
+        /// @brief Playback position of the virtual voice
+        duration_t time = 0.0;
+    public:
+        /// @brief Estimated loudness updated by audio::update
+        float audibility = 0.0f;
+
+        Voice(const Sound* origin, const Sound* sound, int priority, int channel);
+        ~Voice();
+
+        const Sound* getOrigin() const {
+            return origin;
+        }
+
+        const Sound* getSound() const {
+            return sound;
+        }
+
+        /// @brief Check if the voice has no actual speaker
+        bool isVirtual() const {
+            return speaker == nullptr;
+        }
+
+        /// @brief Make the voice actual. Speaker is synchronized with the
+        /// voice state and playback position
+        void bind(std::unique_ptr<Speaker> speaker);
+
+        /// @brief Release the speaker keeping the playback position
+        void unbind();
+
+        /// @brief Advance playback position of the virtual voice
+        /// @param delta time elapsed since the last update (seconds)
+        void advance(double delta);
+
+        void update(const Channel* channel) override;
+
+        int getChannel() const override {
+            return channel;
+        }
+
+        State getState() const override;
+
+        float getVolume() const override {
+            return volume;
+        }
+
+        void setVolume(float volume) override;
+
+        float getPitch() const override {
+            return pitch;
+        }
+
+        void setPitch(float pitch) override;
+
+        bool isLoop() const override {
+            return loop;
+        }
+
+        void setLoop(bool loop) override;
+
+        void play() override;
+        void pause() override;
+        void stop() override;
+
+        duration_t getTime() const override;
+        duration_t getDuration() const override;
+        void setTime(duration_t time) override;
+
+        void setPosition(glm::vec3 pos) override;
+
+        glm::vec3 getPosition() const override {
+            return position;
+        }
+
+        void setVelocity(glm::vec3 vel) override;
+
+        glm::vec3 getVelocity() const override {
+            return velocity;
+        }
+
+        int getPriority() const override {
+            return priority;
+        }
+
+        void setRelative(bool relative) override;
+
+        bool isRelative() const override {
+            return relative;
+        }
+
+        bool isManuallyStopped() const override {
+            return manuallyStopped;
+        }
+    };
+}
@@ -1,5 +1,6 @@
 #include "audio.hpp"
 
+#include <algorithm>
 #include <iostream>
 #include <stdexcept>
 #include <utility>
@@ -8,7 +9,11 @@
 #include "coders/ogg.hpp"
 #include "coders/wav.hpp"
 #include "AL/ALAudio.hpp"
+#include "AudioWorker.hpp"
+#include "BufferedPCMStream.hpp"
 #include "NoAudio.hpp"
+#include "PCMCache.hpp"
+#include "Voice.hpp"
 #include "debug/Logger.hpp"
 #include "util/ObjectsKeeper.hpp"
 
@@ -16,6 +21,20 @@ static debug::Logger logger("audio");
 
 using namespace audio;
 
+/// @brief Max total size of decoded sounds kept for reuse (bytes)
+static inline constexpr size_t PCM_CACHE_CAPACITY = 32 * 1024 * 1024;
+
+/// @brief Min sound instance audibility to get an actual speaker
+static inline constexpr float AUDIBILITY_THRESHOLD = 0.01f;
+
+/// @brief Actual speaker is released when audibility falls below
+/// AUDIBILITY_THRESHOLD * VIRTUALIZE_FACTOR (prevents flapping)
+static inline constexpr float VIRTUALIZE_FACTOR = 0.5f;
+
+/// @brief Max distance between identical sounds played in the same frame
+/// to be played as one
+static inline constexpr float COALESCE_DISTANCE = 1.0f;
+
 namespace {
     speakerid_t nextId = 1;
     Backend* backend;
@@ -25,6 +44,12 @@ namespace {
     util::ObjectsKeeper objects_keeper {};
     std::unique_ptr<InputDevice> input_device = nullptr;
     static bool input_enabled = false;
+    /// @brief Decodes file streams in background (if audio data is used)
+    std::unique_ptr<AudioWorker> worker;
+    PCMCache pcm_cache(PCM_CACHE_CAPACITY);
+    glm::vec3 listener_position {};
+    /// @brief Voices started since the last update
+    std::vector<speakerid_t> frame_voices;
 }
 
 Channel::Channel(std::string name, bool effects)
@@ -158,20 +183,49 @@ public:
     }
 };
 
+Sound::~Sound() {
+    if (backend == nullptr) {
+        return;
+    }
+    // voices of the sound may be resumed later
+    for (auto it = speakers.begin(); it != speakers.end();) {
+        auto voice = dynamic_cast<Voice*>(it->second.get());
+        if (voice && (voice->getOrigin() == this || voice->getSound() == this)) {
+            voice->stop();
+            it = speakers.erase(it);
+        } else {
+            it++;
+        }
+    }
+}
+
 void audio::initialize(
-    bool enabled, bool inputEnabled, AudioSettings& settings
+    bool enabled, bool inputEnabled, AudioSettings& settings, bool decoding
 ) {
     enabled = enabled && settings.enabled.get();
+    std::unique_ptr<Backend> selected;
     if (enabled) {
         logger.info() << "initializing ALAudio backend";
-        backend = ALAudio::create(settings).release();
+        selected = ALAudio::create(settings);
     }
-    if (backend == nullptr) {
+    if (selected == nullptr) {
         if (enabled) {
             std::cerr << "could not to initialize audio" << std::endl;
         }
         logger.info() << "initializing NoAudio backend";
-        backend = NoAudio::create().release();
+        selected = NoAudio::create(decoding);
+    }
+    initialize(std::move(selected), inputEnabled, settings);
+}
+
+void audio::initialize(
+    std::unique_ptr<Backend> selected,
+    bool inputEnabled,
+    AudioSettings& settings
+) {
+    backend = selected.release();
+    if (!backend->isDummy()) {
+        worker = std::make_unique<AudioWorker>();
     }
     struct {
         std::string name;
@@ -221,11 +275,26 @@ std::unique_ptr<PCM> audio::load_PCM(const io::path& file, bool headerOnly) {
     throw std::runtime_error("unsupported audio format");
 }
 
+/// @brief File size and modification time are included, so files changed
+/// since caching are decoded again on assets reload
+static std::string pcm_cache_key(const io::path& file) {
+    return file.string() + "|" + std::to_string(io::file_size(file)) + "|" +
+           std::to_string(
+               io::last_write_time(file).time_since_epoch().count()
+           );
+}
+
 std::unique_ptr<Sound> audio::load_sound(const io::path& file, bool keepPCM) {
-    std::shared_ptr<PCM> pcm(
-        load_PCM(file, !keepPCM && backend->isDummy()).release()
-    );
-    return create_sound(pcm, keepPCM);
+    if (!keepPCM && backend->isDummy()) {
+        return create_sound(load_PCM(file, true), false);
+    }
+    if (!io::exists(file)) {
+        throw std::runtime_error("file not found '" + file.string() + "'");
+    }
+    auto pcm = pcm_cache.get(pcm_cache_key(file), [&file]() {
+        return std::shared_ptr<PCM>(load_PCM(file, false));
+    });
+    return create_sound(std::move(pcm), keepPCM);
 }
 
 std::unique_ptr<Sound> audio::create_sound(
@@ -257,9 +326,14 @@ std::unique_ptr<Stream> audio::open_stream(
             keepSource
         );
     }
-    return open_stream(
-        std::shared_ptr<PCMStream>(open_PCM_stream(file)), keepSource
-    );
+    if (worker == nullptr) {
+        return open_stream(
+            std::shared_ptr<PCMStream>(open_PCM_stream(file)), keepSource
+        );
+    }
+    auto source = std::make_shared<BufferedPCMStream>(open_PCM_stream(file));
+    worker->add(source);
+    return open_stream(std::move(source), keepSource);
 }
 
 std::unique_ptr<Stream> audio::open_stream(
@@ -315,10 +389,71 @@ void audio::set_input_device(const std::string& deviceName) {
 void audio::set_listener(
     glm::vec3 position, glm::vec3 velocity, glm::vec3 lookAt, glm::vec3 up
 ) {
+    listener_position = position;
     backend->setListener(position, velocity, lookAt, up);
 }
 
+/// @brief Estimate sound instance loudness using AL default distance model
+/// (inverse distance clamped, reference distance and rolloff factor are 1)
+static float calc_audibility(const Voice& voice) {
+    auto channel = get_channel(voice.getChannel());
+    if (channel == nullptr) {
+        return 0.0f;
+    }
+    float gain = voice.getVolume() * channel->getVolume() *
+                 get_channel(0)->getVolume();
+    auto offset = voice.getPosition();
+    if (!voice.isRelative()) {
+        offset -= listener_position;
+    }
+    return gain / std::max(1.0f, glm::length(offset));
+}
+
+/// @brief Take speaker from the least important actual voice having
+/// lower priority or the same priority and lower audibility.
+/// The voice is virtualized
+/// @return true if speaker is released
+static bool steal_speaker(int priority, float audibility) {
+    Voice* victim = nullptr;
+    for (const auto& [_, speaker] : speakers) {
+        auto voice = dynamic_cast<Voice*>(speaker.get());
+        if (voice == nullptr || voice->isVirtual()) {
+            continue;
+        }
+        int voicePriority = voice->getPriority();
+        if (voicePriority > priority ||
+            (voicePriority == priority && voice->audibility >= audibility)) {
+            continue;
+        }
+        if (victim == nullptr || voicePriority < victim->getPriority() ||
+            (voicePriority == victim->getPriority() &&
+             voice->audibility < victim->audibility)) {
+            victim = voice;
+        }
+    }
+    if (victim) {
+        victim->unbind();
+        return true;
+    }
+    return false;
+}
+
+static void allocate_speaker(Voice& voice) {
+    const auto& sound = *voice.getSound();
+    int priority = voice.getPriority();
+    auto speaker = sound.newInstance(priority, voice.getChannel());
+    if (speaker == nullptr && steal_speaker(priority, voice.audibility)) {
+        speaker = sound.newInstance(priority, voice.getChannel());
+    }
+    if (speaker) {
+        voice.bind(std::move(speaker));
+    }
+}
+
 void remove_lower_priority_speaker(int priority) {
+    if (steal_speaker(priority, 0.0f)) {
+        return;
+    }
     for (auto it = speakers.begin(); it != speakers.end();) {
         if (it->second->getPriority() < priority && it->second->isPaused()) {
             it->second->stop();
@@ -337,6 +472,26 @@ void remove_lower_priority_speaker(int priority) {
     }
 }
 
+/// @return id of identical sound instance played in the same frame nearby
+/// or 0
+static speakerid_t find_coalesced(
+    const Sound* sound, glm::vec3 position, bool relative, int channel
+) {
+    for (speakerid_t id : frame_voices) {
+        const auto& found = speakers.find(id);
+        if (found == speakers.end()) {
+            continue;
+        }
+        auto voice = static_cast<Voice*>(found->second.get());
+        if (voice->getOrigin() == sound && voice->getChannel() == channel &&
+            voice->isRelative() == relative && !voice->isLoop() &&
+            glm::distance(voice->getPosition(), position) <= COALESCE_DISTANCE) {
+            return id;
+        }
+    }
+    return 0;
+}
+
 speakerid_t audio::play(
     Sound* sound,
     glm::vec3 position,
@@ -347,32 +502,39 @@ speakerid_t audio::play(
     int priority,
     int channel
 ) {
-    if (sound == nullptr) {
+    if (sound == nullptr || backend->isDummy()) {
         return 0;
     }
+    if (!loop) {
+        if (auto id = find_coalesced(sound, position, relative, channel)) {
+            auto voice = get_speaker(id);
+            voice->setVolume(std::max(voice->getVolume(), volume));
+            return id;
+        }
+    }
+    const Sound* origin = sound;
     if (!sound->variants.empty()) {
         size_t index = rand() % (sound->variants.size() + 1);
         if (index < sound->variants.size()) {
             sound = sound->variants[index].get();
         }
     }
-    auto speaker_ptr = sound->newInstance(priority, channel);
-    if (speaker_ptr == nullptr) {
-        remove_lower_priority_speaker(priority);
-        speaker_ptr = sound->newInstance(priority, channel);
+    auto voice_ptr = std::make_unique<Voice>(origin, sound, priority, channel);
+    auto voice = voice_ptr.get();
+    voice->setPosition(position);
+    voice->setVolume(volume);
+    voice->setPitch(pitch);
+    voice->setLoop(loop);
+    voice->setRelative(relative);
+    voice->play();
+    // inaudible sounds are started virtual
+    voice->audibility = calc_audibility(*voice);
+    if (voice->audibility >= AUDIBILITY_THRESHOLD) {
+        allocate_speaker(*voice);
     }
-    if (speaker_ptr == nullptr) {
-        return 0;
-    }
-    auto speaker = speaker_ptr.get();
     speakerid_t id = nextId++;
-    speakers.try_emplace(id, std::move(speaker_ptr));
-    speaker->setPosition(position);
-    speaker->setVolume(volume);
-    speaker->setPitch(pitch);
-    speaker->setLoop(loop);
-    speaker->setRelative(relative);
-    speaker->play();
+    speakers.try_emplace(id, std::move(voice_ptr));
+    frame_voices.push_back(id);
     return id;
 }
 
@@ -476,12 +638,59 @@ size_t audio::count_streams() {
     return streams.size();
 }
 
+size_t audio::count_virtual_speakers() {
+    size_t count = 0;
+    for (const auto& [_, speaker] : speakers) {
+        auto voice = dynamic_cast<const Voice*>(speaker.get());
+        count += voice && voice->isVirtual();
+    }
+    return count;
+}
+
+/// @brief Virtualize inaudible voices, give speakers to audible ones
+/// in order of importance
+static void update_voices(double delta) {
+    std::vector<Voice*> pending;
+    for (const auto& [_, speaker] : speakers) {
+        auto voice = dynamic_cast<Voice*>(speaker.get());
+        if (voice == nullptr) {
+            continue;
+        }
+        auto channel = get_channel(voice->getChannel());
+        if (channel && !channel->isPaused()) {
+            voice->advance(delta);
+        }
+        voice->audibility = calc_audibility(*voice);
+        if (!voice->isPlaying()) {
+            continue;
+        }
+        if (!voice->isVirtual()) {
+            if (voice->audibility < AUDIBILITY_THRESHOLD * VIRTUALIZE_FACTOR) {
+                voice->unbind();
+            }
+        } else if (voice->audibility >= AUDIBILITY_THRESHOLD) {
+            pending.push_back(voice);
+        }
+    }
+    std::sort(pending.begin(), pending.end(), [](auto a, auto b) {
+        if (a->getPriority() != b->getPriority()) {
+            return a->getPriority() > b->getPriority();
+        }
+        return a->audibility > b->audibility;
+    });
+    for (auto voice : pending) {
+        allocate_speaker(*voice);
+    }
+}
+
 void audio::update(double delta) {
     backend->update(delta);
 
     for (auto& entry : streams) {
         entry.second->update(delta);
     }
+    frame_voices.clear();
+    update_voices(delta);
 
     for (auto it = speakers.begin(); it != speakers.end();) {
         auto speaker = it->second.get();
@@ -542,7 +751,11 @@ void audio::close() {
     if (input_device) {
         input_device->stopCapture();
     }
+    streams.clear();
     speakers.clear();
+    frame_voices.clear();
+    worker = nullptr;
+    pcm_cache.clear();
     delete backend;
     backend = nullptr;
     objects_keeper.clearKeepedObjects();
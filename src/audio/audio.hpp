@@ -188,6 +188,13 @@ namespace audio {
         /// @brief Check if the stream does support seek feature
         virtual bool isSeekable() const = 0;
 
+        /// @brief Check if more data is expected to be read later even if
+        /// the last read returned less than requested (e.g. the stream is
+        /// decoded in background)
+        virtual bool isBuffering() const {
+            return false;
+        }
+
         /// @brief Move playhead to the selected sample number
         /// @param position selected sample number
         virtual void seek(size_t position) = 0;
@@ -246,8 +253,8 @@ namespace audio {
         /// @brief Sound variants will be chosen randomly to play
         std::vector<std::shared_ptr<Sound>> variants;
 
-        virtual ~Sound() {
-        }
+        /// @brief Stops the sound instances
+        virtual ~Sound();
 
         /// @brief Get sound duration
         /// @return duration in seconds (>= 0.0)
@@ -408,7 +415,21 @@ namespace audio {
 
     /// @brief Initialize audio system or use no audio mode
     /// @param enabled try to initialize actual audio
-    void initialize(bool enabled, bool inputEnabled, AudioSettings& settings);
+    /// @param decoding decode audio data in no audio mode the same way as
+    /// with actual audio (used for testing and benchmarking)
+    void initialize(
+        bool enabled,
+        bool inputEnabled,
+        AudioSettings& settings,
+        bool decoding = false
+    );
+
+    /// @brief Initialize audio system with the backend
+    void initialize(
+        std::unique_ptr<Backend> backend,
+        bool inputEnabled,
+        AudioSettings& settings
+    );
 
     /// @brief Load audio file info and PCM data
     /// @param file audio file
@@ -417,7 +438,8 @@ namespace audio {
     /// @return PCM audio data
     std::unique_ptr<PCM> load_PCM(const io::path& file, bool headerOnly);
 
-    /// @brief Load sound from file
+    /// @brief Load sound from file. Decoded data is cached
+    /// (LRU, limited by size) and reused by next loads of the file
     /// @param file audio file path
     /// @param keepPCM store PCM data in sound to make it accessible with
     /// Sound::getPCM
@@ -438,7 +460,8 @@ namespace audio {
     /// @return new PCMStream instance
     std::unique_ptr<PCMStream> open_PCM_stream(const io::path& file);
 
-    /// @brief Open new audio stream from file
+    /// @brief Open new audio stream from file. The file is decoded ahead
+    /// of playback by the audio worker thread
     /// @param file audio file path
     /// @param keepSource store PCMStream in stream to make it accessible with
     /// Stream::getSource
@@ -485,7 +508,10 @@ namespace audio {
         glm::vec3 position, glm::vec3 velocity, glm::vec3 lookAt, glm::vec3 up
     );
 
-    /// @brief Play 3D sound in the world
+    /// @brief Play 3D sound in the world.
+    /// Inaudible (far or quiet) instances are played virtually: speaker is
+    /// taken when the instance becomes audible. Identical non-looped sounds
+    /// played in the same frame nearby are played as one instance
     /// @param sound target sound
     /// @param position sound world position
     /// @param relative position speaker relative to listener
@@ -495,7 +521,7 @@ namespace audio {
     /// @param priority sound priority
     /// (PRIORITY_LOW, PRIORITY_NORMAL, PRIORITY_HIGH)
     /// @param channel channel index
-    /// @return speaker id or 0
+    /// @return speaker id or 0 if no audio is played
     speakerid_t play(
         Sound* sound,
         glm::vec3 position,
@@ -583,6 +609,10 @@ namespace audio {
     /// @brief Get playing streams number (including paused)
     size_t count_streams();
 
+    /// @brief Get number of sound instances having no actual speaker
+    /// (inaudible or evicted by more important ones)
+    size_t count_virtual_speakers();
+
     /// @brief Update audio streams and sound instanced
     /// @param delta time elapsed since the last update (seconds)
     void update(double delta);
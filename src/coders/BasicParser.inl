@@ -467,44 +467,48 @@ template <typename CharT>
 std::basic_string<CharT> BasicParser<CharT>::parseString(
     CharT quote, bool closeRequired
 ) {
-    std::basic_stringstream<CharT> ss;
+    std::basic_string<CharT> str;
+    // characters without escapes are appended by whole runs
+    size_t runStart = pos;
     while (hasNext()) {
         CharT c = source[pos];
         if (c == quote) {
+            str.append(source.data() + runStart, pos - runStart);
             pos++;
-            return ss.str();
+            return str;
         }
         if (c == '\\') {
+            str.append(source.data() + runStart, pos - runStart);
             pos++;
             c = nextChar();
             if (c >= '0' && c <= '7') {
                 pos--;
-                ss << (char)parseSimpleInt(8);
+                str.push_back(static_cast<char>(parseSimpleInt(8)));
+                runStart = pos;
                 continue;
             }
             if (c == 'u' || c == 'x') {
                 int codepoint = parseSimpleInt(16, c == 'u' ? 4 : 2);
                 ubyte bytes[4];
                 int size = util::encode_utf8(codepoint, bytes);
-                CharT chars[4];
-                for (int i = 0; i < 4; i++) {
-                    chars[i] = bytes[i];
+                for (int i = 0; i < size; i++) {
+                    str.push_back(static_cast<CharT>(bytes[i]));
                 }
-                ss.write(chars, size);
+                runStart = pos;
                 continue;
             }
             switch (c) {
-                case 'n': ss << '\n'; break;
-                case 'r': ss << '\r'; break;
-                case 'b': ss << '\b'; break;
-                case 't': ss << '\t'; break;
-                case 'f': ss << '\f'; break;
-                case 'v': ss << '\v'; break;
-                case '\'': ss << '\''; break;
-                case '"': ss << '"'; break;
-                case '\\': ss << '\\'; break;
-                case '/': ss << '/'; break;
-                case '\n': continue;
+                case 'n': str.push_back('\n'); break;
+                case 'r': str.push_back('\r'); break;
+                case 'b': str.push_back('\b'); break;
+                case 't': str.push_back('\t'); break;
+                case 'f': str.push_back('\f'); break;
+                case 'v': str.push_back('\v'); break;
+                case '\'': str.push_back('\''); break;
+                case '"': str.push_back('"'); break;
+                case '\\': str.push_back('\\'); break;
+                case '/': str.push_back('/'); break;
+                case '\n': break;
                 default:
                     throw error(
                         "'\\" +
@@ -512,18 +516,19 @@ std::basic_string<CharT> BasicParser<CharT>::parseString(
                         "' is an illegal escape"
                     );
             }
+            runStart = pos;
             continue;
         }
         if (c == '\n' && closeRequired) {
             throw error("non-closed string literal");
         }
-        ss << c;
         pos++;
     }
     if (closeRequired) {
         throw error("unexpected end");
     }
-    return ss.str();
+    str.append(source.data() + runStart, pos - runStart);
+    return str;
 }
 
 template <>
@@ -68,6 +68,20 @@ void ByteBuilder::putFloat64(double val, bool bigEndian) {
     putInt64(i64_val, bigEndian);
 }
 
+void ByteBuilder::putVarUInt(uint64_t val) {
+    while (val >= 0x80) {
+        buffer.push_back(static_cast<ubyte>(val | 0x80));
+        val >>= 7;
+    }
+    buffer.push_back(static_cast<ubyte>(val));
+}
+
+void ByteBuilder::putVarInt(int64_t val) {
+    putVarUInt(
+        (static_cast<uint64_t>(val) << 1) ^ static_cast<uint64_t>(val >> 63)
+    );
+}
+
 void ByteBuilder::set(size_t position, ubyte val) {
     buffer[position] = val;
 }
@@ -187,6 +201,23 @@ double ByteReader::getFloat64(bool bigEndian) {
     return val;
 }
 
+uint64_t ByteReader::getVarUInt() {
+    uint64_t value = 0;
+    for (uint shift = 0; shift < 64; shift += 7) {
+        ubyte b = get();
+        value |= static_cast<uint64_t>(b & 0x7F) << shift;
+        if ((b & 0x80) == 0) {
+            return value;
+        }
+    }
+    throw std::runtime_error("varint is too long");
+}
+
+int64_t ByteReader::getVarInt() {
+    uint64_t value = getVarUInt();
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
 const char* ByteReader::getCString() {
     const char* cstr = reinterpret_cast<const char*>(data + pos);
     pos += std::strlen(cstr) + 1;
@@ -0,0 +1,278 @@
+#include "compact_binary.hpp"
+
+#include <cstring>
+#include <stdexcept>
+
+#include "gzip.hpp"
+#include "util/Buffer.hpp"
+
+using namespace compact;
+
+enum ValueTag : ubyte {
+    TAG_NULL = 0,
+    TAG_FALSE,
+    TAG_TRUE,
+    TAG_INTEGER,
+    TAG_FLOAT32,
+    TAG_FLOAT64,
+    TAG_STRING,
+    TAG_BYTES,
+    TAG_LIST,
+    TAG_OBJECT,
+    /// @brief List of numbers exactly representable as float32
+    /// (vectors, matrices)
+    TAG_FLOAT32_LIST,
+};
+
+static bool is_float32(double value) {
+    return static_cast<double>(static_cast<float>(value)) == value;
+}
+
+static bool is_float32_list(const dv::value& list) {
+    if (list.size() == 0) {
+        return false;
+    }
+    for (const auto& element : list) {
+        if (!element.isNumber() || !is_float32(element.asNumber())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void Encoder::put(ubyte b) {
+    body.put(b);
+}
+
+void Encoder::putVarUInt(uint64_t value) {
+    body.putVarUInt(value);
+}
+
+void Encoder::putVarInt(int64_t value) {
+    body.putVarInt(value);
+}
+
+void Encoder::putString(const std::string& str) {
+    const auto& found = stringIndices.find(str);
+    if (found != stringIndices.end()) {
+        body.putVarUInt(found->second);
+        return;
+    }
+    uint index = strings.size();
+    strings.push_back(str);
+    stringIndices[str] = index;
+    body.putVarUInt(index);
+}
+
+void Encoder::putValue(const dv::value& value) {
+    switch (value.getType()) {
+        case dv::value_type::none:
+            body.put(TAG_NULL);
+            break;
+        case dv::value_type::boolean:
+            body.put(value.asBoolean() ? TAG_TRUE : TAG_FALSE);
+            break;
+        case dv::value_type::integer:
+            body.put(TAG_INTEGER);
+            body.putVarInt(value.asInteger());
+            break;
+        case dv::value_type::number: {
+            double number = value.asNumber();
+            if (is_float32(number)) {
+                body.put(TAG_FLOAT32);
+                body.putFloat32(static_cast<float>(number));
+            } else {
+                body.put(TAG_FLOAT64);
+                body.putFloat64(number);
+            }
+            break;
+        }
+        case dv::value_type::string:
+            body.put(TAG_STRING);
+            putString(value.asString());
+            break;
+        case dv::value_type::bytes: {
+            const auto& bytes = value.asBytes();
+            body.put(TAG_BYTES);
+            body.putVarUInt(bytes.size());
+            body.put(bytes.data(), bytes.size());
+            break;
+        }
+        case dv::value_type::list:
+            if (is_float32_list(value)) {
+                body.put(TAG_FLOAT32_LIST);
+                body.putVarUInt(value.size());
+                for (const auto& element : value) {
+                    body.putFloat32(static_cast<float>(element.asNumber()));
+                }
+                break;
+            }
+            body.put(TAG_LIST);
+            body.putVarUInt(value.size());
+            for (const auto& element : value) {
+                putValue(element);
+            }
+            break;
+        case dv::value_type::object: {
+            const auto& map = value.asObject();
+            body.put(TAG_OBJECT);
+            body.putVarUInt(map.size());
+            for (const auto& [key, element] : map) {
+                putString(key);
+                putValue(element);
+            }
+            break;
+        }
+    }
+}
+
+std::vector<ubyte> Encoder::build() const {
+    ByteBuilder builder(body.size() + strings.size() * 8);
+    builder.putVarUInt(strings.size());
+    for (const auto& str : strings) {
+        builder.putVarUInt(str.length());
+        builder.put(reinterpret_cast<const ubyte*>(str.data()), str.length());
+    }
+    builder.put(body.data(), body.size());
+
+    auto compressed = gzip::compress(builder.data(), builder.size());
+    std::vector<ubyte> bytes;
+    bytes.reserve(sizeof(SIGNATURE) + 1 + compressed.size());
+    bytes.insert(bytes.end(), std::begin(SIGNATURE), std::end(SIGNATURE));
+    bytes.push_back(VERSION);
+    bytes.insert(bytes.end(), compressed.begin(), compressed.end());
+    return bytes;
+}
+
+static std::vector<ubyte> decompress_body(const ubyte* src, size_t size) {
+    if (!is_compact(src, size)) {
+        throw std::runtime_error("invalid compact binary signature");
+    }
+    ubyte version = src[sizeof(SIGNATURE)];
+    if (version != VERSION) {
+        throw std::runtime_error(
+            "unsupported compact binary version " + std::to_string(version)
+        );
+    }
+    size_t offset = sizeof(SIGNATURE) + 1;
+    return gzip::decompress(src + offset, size - offset);
+}
+
+Decoder::Decoder(const ubyte* src, size_t size)
+    : body(decompress_body(src, size)), reader(body) {
+    size_t count = reader.getVarUInt();
+    if (count > reader.remaining()) {
+        throw std::runtime_error("invalid strings table size");
+    }
+    strings.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        size_t length = reader.getVarUInt();
+        if (length > reader.remaining()) {
+            throw std::runtime_error("buffer underflow");
+        }
+        strings.emplace_back(
+            reinterpret_cast<const char*>(reader.pointer()), length
+        );
+        reader.skip(length);
+    }
+}
+
+ubyte Decoder::get() {
+    return reader.get();
+}
+
+uint64_t Decoder::getVarUInt() {
+    return reader.getVarUInt();
+}
+
+int64_t Decoder::getVarInt() {
+    return reader.getVarInt();
+}
+
+const std::string& Decoder::getString() {
+    uint64_t index = reader.getVarUInt();
+    if (index >= strings.size()) {
+        throw std::runtime_error(
+            "invalid string index " + std::to_string(index)
+        );
+    }
+    return strings[index];
+}
+
+dv::value Decoder::getValue() {
+    ubyte tag = reader.get();
+    switch (tag) {
+        case TAG_NULL:
+            return nullptr;
+        case TAG_FALSE:
+        case TAG_TRUE:
+            return tag == TAG_TRUE;
+        case TAG_INTEGER:
+            return reader.getVarInt();
+        case TAG_FLOAT32:
+            return static_cast<double>(reader.getFloat32());
+        case TAG_FLOAT64:
+            return reader.getFloat64();
+        case TAG_STRING:
+            return getString();
+        case TAG_BYTES: {
+            size_t size = reader.getVarUInt();
+            if (size > reader.remaining()) {
+                throw std::runtime_error("buffer underflow");
+            }
+            auto bytes = std::make_shared<util::Buffer<ubyte>>(
+                reader.pointer(), size
+            );
+            reader.skip(size);
+            return bytes;
+        }
+        case TAG_FLOAT32_LIST: {
+            size_t size = reader.getVarUInt();
+            auto list = dv::list();
+            for (size_t i = 0; i < size; i++) {
+                list.add(static_cast<double>(reader.getFloat32()));
+            }
+            return list;
+        }
+        case TAG_LIST: {
+            size_t size = reader.getVarUInt();
+            auto list = dv::list();
+            for (size_t i = 0; i < size; i++) {
+                list.add(getValue());
+            }
+            return list;
+        }
+        case TAG_OBJECT: {
+            size_t size = reader.getVarUInt();
+            auto object = dv::object();
+            for (size_t i = 0; i < size; i++) {
+                const auto& key = getString();
+                object[key] = getValue();
+            }
+            return object;
+        }
+    }
+    throw std::runtime_error(
+        "unknown compact binary tag " + std::to_string(tag)
+    );
+}
+
+bool Decoder::hasNext() const {
+    return reader.hasNext();
+}
+
+bool compact::is_compact(const ubyte* src, size_t size) {
+    return size > sizeof(SIGNATURE) &&
+           std::memcmp(src, SIGNATURE, sizeof(SIGNATURE)) == 0;
+}
+
+std::vector<ubyte> compact::to_binary(const dv::value& value) {
+    Encoder encoder;
+    encoder.putValue(value);
+    return encoder.build();
+}
+
+dv::value compact::from_binary(const ubyte* src, size_t size) {
+    Decoder decoder(src, size);
+    return decoder.getValue();
+}
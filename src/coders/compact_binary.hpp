@@ -0,0 +1,72 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "byte_utils.hpp"
+#include "data/dv.hpp"
+#include "typedefs.hpp"
+
+/// @brief Compact typed binary format used for chunk layers records
+/// (block inventories, entities).
+///
+/// Layout: signature, version byte, then gzip-compressed body:
+/// strings table (varuint count, strings as varuint length + bytes)
+/// followed by records written by the schema code.
+/// Integers are varints, strings (including object keys) are stored once
+/// in the table and referenced by index, numbers exactly representable as
+/// float32 take 4 bytes. The whole body is compressed in one pass.
+///
+/// Signature can't be a start of binary json or gzip data and, read as
+/// little-endian int32, exceeds any legacy inventories count, so old
+/// records are detected with is_compact.
+namespace compact {
+    inline constexpr ubyte SIGNATURE[] {0xFF, 'V', 'C', 'B'};
+    inline constexpr ubyte VERSION = 1;
+
+    class Encoder {
+        ByteBuilder body;
+        std::vector<std::string> strings;
+        std::unordered_map<std::string, uint> stringIndices;
+    public:
+        void put(ubyte b);
+        void putVarUInt(uint64_t value);
+        void putVarInt(int64_t value);
+        /// @brief Write string as index in the strings table
+        void putString(const std::string& str);
+        /// @brief Write any dv value
+        void putValue(const dv::value& value);
+
+        /// @brief Build signed and compressed data
+        std::vector<ubyte> build() const;
+    };
+
+    class Decoder {
+        std::vector<ubyte> body;
+        ByteReader reader;
+        std::vector<std::string> strings;
+    public:
+        /// @throws std::runtime_error if data is not in compact format
+        /// or has unsupported version
+        Decoder(const ubyte* src, size_t size);
+
+        ubyte get();
+        uint64_t getVarUInt();
+        int64_t getVarInt();
+        const std::string& getString();
+        dv::value getValue();
+
+        bool hasNext() const;
+    };
+
+    /// @return true if data starts with the compact format signature
+    bool is_compact(const ubyte* src, size_t size);
+
+    /// @brief Encode single dv value
+    std::vector<ubyte> to_binary(const dv::value& value);
+
+    /// @brief Decode single dv value
+    dv::value from_binary(const ubyte* src, size_t size);
+}
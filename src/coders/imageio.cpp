@@ -30,20 +30,30 @@ bool imageio::is_write_supported(const std::string& extension) {
     return extension == ".png";
 }
 
-std::unique_ptr<ImageData> imageio::read(const io::path& file) {
+ImageFileFormat imageio::get_read_format(const io::path& file) {
     ImageFileFormat format;
     if (!ImageFileFormatMeta.getItem(file.extension().substr(1), format)) {
         throw std::runtime_error("unsupported image format");
     }
-    auto found = readers.find(format);
-    if (found == readers.end()) {
+    if (readers.find(format) == readers.end()) {
         throw std::runtime_error(
             "file format is not supported (read): " + file.string()
         );
     }
-    auto bytes = io::read_bytes_buffer(file);
+    return format;
+}
+
+std::unique_ptr<ImageData> imageio::read(const io::path& file) {
+    auto found = readers.find(get_read_format(file));
+    // stored entries of zipped packs are decoded without copying
+    auto view = io::view(file);
+    util::Buffer<ubyte> bytes;
+    if (!view) {
+        bytes = io::read_bytes_buffer(file);
+        view = util::span<ubyte>(bytes.data(), bytes.size());
+    }
     try {
-        return std::unique_ptr<ImageData>(found->second(bytes.data(), bytes.size()));
+        return std::unique_ptr<ImageData>(found->second(view->data(), view->size()));
     } catch (const std::runtime_error& err) {
         throw std::runtime_error(
             "could not to load image " + file.string() + ": " + err.what()
@@ -64,6 +74,39 @@ std::unique_ptr<ImageData> imageio::decode(
     }
 }
 
+glm::uvec2 imageio::decode_size(
+    ImageFileFormat format, util::span<ubyte> src
+) {
+    switch (format) {
+        case ImageFileFormat::PNG:
+            return png::read_size(src.data(), src.size());
+        default:
+            throw std::runtime_error("file format is not supported");
+    }
+}
+
+void imageio::decode_into(
+    ImageFileFormat format,
+    util::span<ubyte> src,
+    ubyte* dst,
+    size_t stride,
+    const glm::uvec2& size
+) {
+    try {
+        switch (format) {
+            case ImageFileFormat::PNG:
+                png::decode_rgba(src.data(), src.size(), dst, stride, size);
+                break;
+            default:
+                throw std::runtime_error("file format is not supported");
+        }
+    } catch (const std::runtime_error& err) {
+        throw std::runtime_error(
+            "could not to decode image: " + std::string(err.what())
+        );
+    }
+}
+
 void imageio::write(const io::path& file, const ImageData* image) {
     ImageFileFormat format;
     if (!ImageFileFormatMeta.getItem(file.extension().substr(1), format)) {
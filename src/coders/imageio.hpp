@@ -1,5 +1,6 @@
 #pragma once
 
+#include <glm/vec2.hpp>
 #include <memory>
 #include <string>
 
@@ -25,8 +26,26 @@ namespace imageio {
     bool is_read_supported(const std::string& extension);
     bool is_write_supported(const std::string& extension);
 
+    /// @throws std::runtime_error if file format is not supported
+    ImageFileFormat get_read_format(const io::path& file);
+
     std::unique_ptr<ImageData> read(const io::path& file);
     void write(const io::path& file, const ImageData* image);
     std::unique_ptr<ImageData> decode(ImageFileFormat format, util::span<ubyte> src);
+
+    /// @brief Read image size from the encoded image header
+    glm::uvec2 decode_size(ImageFileFormat format, util::span<ubyte> src);
+
+    /// @brief Decode image as RGBA8888 directly into external raster
+    /// @param dst destination of the image first row (ImageData layout)
+    /// @param stride destination row size in bytes
+    /// @param size image size returned by decode_size
+    void decode_into(
+        ImageFileFormat format,
+        util::span<ubyte> src,
+        ubyte* dst,
+        size_t stride,
+        const glm::uvec2& size
+    );
     util::Buffer<unsigned char> encode(ImageFileFormat format, const ImageData& image);
 }
@@ -2,9 +2,8 @@
 
 #include <math.h>
 
-#include <iomanip>
+#include <cstdio>
 #include <memory>
-#include <sstream>
 
 #include "util/stringutil.hpp"
 #include "BasicParser.hpp"
@@ -25,21 +24,21 @@ namespace {
 }
 
 inline void newline(
-    std::stringstream& ss, bool nice, uint indent, const std::string& indentstr
+    std::string& out, bool nice, uint indent, const std::string& indentstr
 ) {
     if (nice) {
-        ss << "\n";
+        out += '\n';
         for (uint i = 0; i < indent; i++) {
-            ss << indentstr;
+            out += indentstr;
         }
     } else {
-        ss << ' ';
+        out += ' ';
     }
 }
 
 void stringifyObj(
     const dv::value& obj,
-    std::stringstream& ss,
+    std::string& out,
     int indent,
     const std::string& indentstr,
     bool nice,
@@ -48,16 +47,22 @@ void stringifyObj(
 
 void stringifyList(
     const dv::value& list,
-    std::stringstream& ss,
+    std::string& out,
     int indent,
     const std::string& indentstr,
     bool nice,
     bool escapeUtf8
 );
 
+static void stringify_number(std::string& out, dv::number_t number) {
+    char buffer[32];
+    int length = std::snprintf(buffer, sizeof(buffer), "%.15g", number);
+    out.append(buffer, length);
+}
+
 void stringifyValue(
     const dv::value& value,
-    std::stringstream& ss,
+    std::string& out,
     int indent,
     const std::string& indentstr,
     bool nice,
@@ -67,93 +72,95 @@ void stringifyValue(
 
     switch (value.getType()) {
         case value_type::object:
-            stringifyObj(value, ss, indent, indentstr, nice, escapeUtf8);
+            stringifyObj(value, out, indent, indentstr, nice, escapeUtf8);
             break;
         case value_type::list:
-            stringifyList(value, ss, indent, indentstr, nice, escapeUtf8);
+            stringifyList(value, out, indent, indentstr, nice, escapeUtf8);
             break;
         case value_type::bytes: {
             const auto& bytes = value.asBytes();
-            ss << "\"" << util::base64_encode(bytes.data(), bytes.size());
-            ss << "\"";
+            out += '"';
+            out += util::base64_encode(bytes.data(), bytes.size());
+            out += '"';
             break;
         }
         case value_type::string:
-            ss << util::escape(value.asString(), escapeUtf8);
+            out += util::escape(value.asString(), escapeUtf8);
             break;
         case value_type::number:
-            ss << std::setprecision(15) << value.asNumber();
+            stringify_number(out, value.asNumber());
             break;
         case value_type::integer:
-            ss << value.asInteger();
+            out += std::to_string(value.asInteger());
             break;
         case value_type::boolean:
-            ss << (value.asBoolean() ? "true" : "false");
+            out += value.asBoolean() ? "true" : "false";
             break;
         case value_type::none:
-            ss << "null";
+            out += "null";
             break; 
     }
 }
 
 void stringifyList(
     const dv::value& list,
-    std::stringstream& ss,
+    std::string& out,
     int indent,
     const std::string& indentstr,
     bool nice,
     bool escapeUtf8
 ) {
     if (list.empty()) {
-        ss << "[]";
+        out += "[]";
         return;
     }
-    ss << "[";
+    out += '[';
     for (size_t i = 0; i < list.size(); i++) {
         if (i > 0 || nice) {
-            newline(ss, nice, indent, indentstr);
+            newline(out, nice, indent, indentstr);
         }
         const auto& value = list[i];
-        stringifyValue(value, ss, indent + 1, indentstr, nice, escapeUtf8);
+        stringifyValue(value, out, indent + 1, indentstr, nice, escapeUtf8);
         if (i + 1 < list.size()) {
-            ss << ',';
+            out += ',';
         }
     }
     if (nice) {
-        newline(ss, true, indent - 1, indentstr);
+        newline(out, true, indent - 1, indentstr);
     }
-    ss << ']';
+    out += ']';
 }
 
 void stringifyObj(
     const dv::value& obj,
-    std::stringstream& ss,
+    std::string& out,
     int indent,
     const std::string& indentstr,
     bool nice,
     bool escapeUtf8
 ) {
     if (obj.empty()) {
-        ss << "{}";
+        out += "{}";
         return;
     }
-    ss << "{";
+    out += '{';
     size_t index = 0;
     for (auto& [key, value] : obj.asObject()) {
         if (index > 0 || nice) {
-            newline(ss, nice, indent, indentstr);
+            newline(out, nice, indent, indentstr);
         }
-        ss << util::escape(key) << ": ";
-        stringifyValue(value, ss, indent + 1, indentstr, nice, escapeUtf8);
+        out += util::escape(key);
+        out += ": ";
+        stringifyValue(value, out, indent + 1, indentstr, nice, escapeUtf8);
         index++;
         if (index < obj.size()) {
-            ss << ',';
+            out += ',';
         }
     }
     if (nice) {
-        newline(ss, true, indent - 1, indentstr);
+        newline(out, true, indent - 1, indentstr);
     }
-    ss << '}';
+    out += '}';
 }
 
 std::string json::stringify(
@@ -162,9 +169,9 @@ std::string json::stringify(
     const std::string& indent,
     bool escapeUtf8
 ) {
-    std::stringstream ss;
-    stringifyValue(value, ss, 1, indent, nice, escapeUtf8);
-    return ss.str();
+    std::string out;
+    stringifyValue(value, out, 1, indent, nice, escapeUtf8);
+    return out;
 }
 
 Parser::Parser(std::string_view filename, std::string_view source)
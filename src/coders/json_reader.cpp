@@ -0,0 +1,454 @@
+#include "json_reader.hpp"
+
+#include <math.h>
+
+#include <cstring>
+#include <stdexcept>
+
+#include "BasicParser.hpp"
+#include "binary_json.hpp"
+#include "byte_utils.hpp"
+#include "gzip.hpp"
+#include "util/Buffer.hpp"
+
+using namespace json;
+
+namespace {
+    class TextReader : public Reader, BasicParser<char> {
+        /// @brief true for objects, false for lists
+        std::vector<bool> stack;
+        bool first = true;
+        bool afterKey = false;
+        bool started = false;
+        std::string keyBuffer;
+        std::string stringBuffer;
+
+        char peekElement() {
+            char c = peek();
+            while (c == '#') {
+                skipLine();
+                c = peek();
+            }
+            return c;
+        }
+
+        token readValue() {
+            char next = peek();
+            if (next == '{' || next == '[') {
+                pos++;
+                stack.push_back(next == '{');
+                first = true;
+                return current = next == '{' ? token::object_begin
+                                             : token::list_begin;
+            }
+            current = token::value;
+            if (next == '-' || next == '+' || is_digit(next)) {
+                auto numeric = parseNumber();
+                if (numeric.isInteger()) {
+                    valueType = dv::value_type::integer;
+                    integer = numeric.asInteger();
+                } else {
+                    valueType = dv::value_type::number;
+                    number = numeric.asNumber();
+                }
+                return current;
+            }
+            if (is_identifier_start(next)) {
+                std::string literal = parseName();
+                if (literal == "true" || literal == "false") {
+                    valueType = dv::value_type::boolean;
+                    integer = literal == "true";
+                } else if (literal == "inf" || literal == "nan") {
+                    valueType = dv::value_type::number;
+                    number = literal == "inf" ? INFINITY : NAN;
+                } else if (literal == "null") {
+                    valueType = dv::value_type::none;
+                } else {
+                    throw error("invalid keyword " + literal);
+                }
+                return current;
+            }
+            if (next == '"' || next == '\'') {
+                pos++;
+                stringBuffer = parseString(next);
+                string = stringBuffer;
+                valueType = dv::value_type::string;
+                return current;
+            }
+            throw error("unexpected character '" + std::string({next}) + "'");
+        }
+    public:
+        TextReader(std::string_view filename, std::string_view source)
+            : BasicParser(filename, source) {
+        }
+
+        token next() override {
+            if (afterKey) {
+                afterKey = false;
+                return readValue();
+            }
+            if (stack.empty()) {
+                if (started) {
+                    return current = token::end;
+                }
+                started = true;
+                char c = peek();
+                if (c != '{' && c != '[') {
+                    throw error("'{' or '[' expected");
+                }
+                return readValue();
+            }
+            bool object = stack.back();
+            char close = object ? '}' : ']';
+            char c = peekElement();
+            if (!first && c != close) {
+                if (c != ',') {
+                    throw error("',' expected");
+                }
+                pos++;
+                c = peekElement();
+            }
+            if (c == close) {
+                pos++;
+                stack.pop_back();
+                first = false;
+                return current = object ? token::object_end : token::list_end;
+            }
+            first = false;
+            if (!object) {
+                return readValue();
+            }
+            expect('"');
+            keyBuffer = parseString('"');
+            key = keyBuffer;
+            if (peek() != ':') {
+                throw error("':' expected");
+            }
+            pos++;
+            afterKey = true;
+            return current = token::key;
+        }
+    };
+
+    class BinaryReader : public Reader {
+        std::vector<ubyte> buffer;
+        ByteReader reader;
+        /// @brief true for documents, false for lists
+        std::vector<bool> stack;
+        bool afterKey = false;
+        bool started = false;
+
+        static ByteReader create_byte_reader(
+            std::vector<ubyte>& buffer, const ubyte* src, size_t size
+        ) {
+            if (size >= 2 && src[0] == gzip::MAGIC[0] &&
+                src[1] == gzip::MAGIC[1]) {
+                buffer = gzip::decompress(src, size);
+                return ByteReader(buffer.data(), buffer.size());
+            }
+            return ByteReader(src, size);
+        }
+
+        std::string_view readBytes(size_t size) {
+            if (size > reader.remaining()) {
+                throw std::runtime_error("buffer underflow");
+            }
+            std::string_view view(
+                reinterpret_cast<const char*>(reader.pointer()), size
+            );
+            reader.skip(size);
+            return view;
+        }
+
+        token readValue() {
+            ubyte typecode = reader.get();
+            current = token::value;
+            switch (typecode) {
+                case BJSON_TYPE_DOCUMENT:
+                    reader.getInt32();
+                    stack.push_back(true);
+                    return current = token::object_begin;
+                case BJSON_TYPE_LIST:
+                    stack.push_back(false);
+                    return current = token::list_begin;
+                case BJSON_TYPE_BYTE:
+                    valueType = dv::value_type::integer;
+                    integer = reader.get();
+                    break;
+                case BJSON_TYPE_INT16:
+                    valueType = dv::value_type::integer;
+                    integer = reader.getInt16();
+                    break;
+                case BJSON_TYPE_INT32:
+                    valueType = dv::value_type::integer;
+                    integer = reader.getInt32();
+                    break;
+                case BJSON_TYPE_INT64:
+                    valueType = dv::value_type::integer;
+                    integer = reader.getInt64();
+                    break;
+                case BJSON_TYPE_NUMBER:
+                    valueType = dv::value_type::number;
+                    number = reader.getFloat64();
+                    break;
+                case BJSON_TYPE_FALSE:
+                case BJSON_TYPE_TRUE:
+                    valueType = dv::value_type::boolean;
+                    integer = typecode == BJSON_TYPE_TRUE;
+                    break;
+                case BJSON_TYPE_STRING:
+                    valueType = dv::value_type::string;
+                    string = readBytes(static_cast<uint32_t>(reader.getInt32()));
+                    break;
+                case BJSON_TYPE_BYTES: {
+                    int32_t size = reader.getInt32();
+                    if (size < 0) {
+                        throw std::runtime_error(
+                            "invalid byte-buffer size " + std::to_string(size)
+                        );
+                    }
+                    valueType = dv::value_type::bytes;
+                    string = readBytes(size);
+                    break;
+                }
+                case BJSON_TYPE_NULL:
+                    valueType = dv::value_type::none;
+                    break;
+                default:
+                    throw std::runtime_error(
+                        "type support not implemented for <" +
+                        std::to_string(typecode) + ">"
+                    );
+            }
+            return current;
+        }
+    public:
+        BinaryReader(const ubyte* src, size_t size)
+            : reader(create_byte_reader(buffer, src, size)) {
+        }
+
+        token next() override {
+            if (afterKey) {
+                afterKey = false;
+                return readValue();
+            }
+            if (stack.empty()) {
+                if (started) {
+                    return current = token::end;
+                }
+                started = true;
+                return readValue();
+            }
+            bool object = stack.back();
+            if (reader.peek() == BJSON_END) {
+                reader.get();
+                stack.pop_back();
+                return current = object ? token::object_end : token::list_end;
+            }
+            if (!object) {
+                return readValue();
+            }
+            auto start = reinterpret_cast<const char*>(reader.pointer());
+            auto terminator = std::memchr(start, 0, reader.remaining());
+            if (terminator == nullptr) {
+                throw std::runtime_error("buffer underflow");
+            }
+            key = readBytes(static_cast<const char*>(terminator) - start);
+            reader.skip(1);
+            afterKey = true;
+            return current = token::key;
+        }
+    };
+}
+
+std::string_view Reader::getString() const {
+    if (valueType != dv::value_type::bytes) {
+        dv::check_type(valueType, dv::value_type::string);
+    }
+    return string;
+}
+
+dv::integer_t Reader::getInteger() const {
+    if (valueType == dv::value_type::number) {
+        return static_cast<dv::integer_t>(number);
+    }
+    dv::check_type(valueType, dv::value_type::integer);
+    return integer;
+}
+
+dv::number_t Reader::getNumber() const {
+    if (valueType == dv::value_type::integer) {
+        return static_cast<dv::number_t>(integer);
+    }
+    dv::check_type(valueType, dv::value_type::number);
+    return number;
+}
+
+bool Reader::getBoolean() const {
+    dv::check_type(valueType, dv::value_type::boolean);
+    return integer != 0;
+}
+
+void Reader::skip() {
+    if (current == token::key) {
+        next();
+    }
+    if (current != token::object_begin && current != token::list_begin) {
+        return;
+    }
+    int depth = 1;
+    while (depth) {
+        switch (next()) {
+            case token::object_begin:
+            case token::list_begin:
+                depth++;
+                break;
+            case token::object_end:
+            case token::list_end:
+                depth--;
+                break;
+            case token::end:
+                throw std::runtime_error("unexpected end");
+            default:
+                break;
+        }
+    }
+}
+
+dv::value Reader::read() {
+    switch (current) {
+        case token::key:
+            next();
+            return read();
+        case token::value:
+            switch (valueType) {
+                case dv::value_type::none:
+                    return nullptr;
+                case dv::value_type::boolean:
+                    return integer != 0;
+                case dv::value_type::integer:
+                    return integer;
+                case dv::value_type::number:
+                    return number;
+                case dv::value_type::string:
+                    return std::string(string);
+                case dv::value_type::bytes:
+                    return std::make_shared<util::Buffer<ubyte>>(
+                        reinterpret_cast<const ubyte*>(string.data()),
+                        string.size()
+                    );
+                default:
+                    break;
+            }
+            break;
+        case token::object_begin: {
+            auto object = dv::object();
+            while (next() == token::key) {
+                std::string name(key);
+                next();
+                object[name] = read();
+            }
+            return object;
+        }
+        case token::list_begin: {
+            auto list = dv::list();
+            while (next() != token::list_end) {
+                list.add(read());
+            }
+            return list;
+        }
+        default:
+            break;
+    }
+    throw std::runtime_error("value expected");
+}
+
+namespace {
+    /// @brief Builds document nodes keeping children of unfinished
+    /// containers in reused per-depth buffers
+    class DocumentBuilder {
+        Reader& reader;
+        dv::document& document;
+        std::vector<std::vector<dv::node>> items;
+        std::vector<std::vector<dv::member>> members;
+    public:
+        DocumentBuilder(Reader& reader, dv::document& document)
+            : reader(reader), document(document) {
+        }
+
+        dv::node build(size_t depth) {
+            switch (reader.getToken()) {
+                case token::key:
+                    reader.next();
+                    return build(depth);
+                case token::value:
+                    return buildValue();
+                case token::object_begin: {
+                    if (members.size() <= depth) {
+                        members.resize(depth + 1);
+                    }
+                    members[depth].clear();
+                    while (reader.next() == token::key) {
+                        auto key = document.internKey(reader.getKey());
+                        reader.next();
+                        auto value = build(depth + 1);
+                        members[depth].push_back(dv::member {key, value});
+                    }
+                    auto& entries = members[depth];
+                    return document.makeObject(entries.data(), entries.size());
+                }
+                case token::list_begin: {
+                    if (items.size() <= depth) {
+                        items.resize(depth + 1);
+                    }
+                    items[depth].clear();
+                    while (reader.next() != token::list_end) {
+                        auto value = build(depth + 1);
+                        items[depth].push_back(value);
+                    }
+                    auto& list = items[depth];
+                    return document.makeList(list.data(), list.size());
+                }
+                default:
+                    break;
+            }
+            throw std::runtime_error("value expected");
+        }
+
+        dv::node buildValue() {
+            switch (reader.getType()) {
+                case dv::value_type::boolean:
+                    return document.makeBoolean(reader.getBoolean());
+                case dv::value_type::integer:
+                    return document.makeInteger(reader.getInteger());
+                case dv::value_type::number:
+                    return document.makeNumber(reader.getNumber());
+                case dv::value_type::string:
+                    return document.makeString(reader.getString());
+                case dv::value_type::bytes:
+                    return document.makeBytes(reader.getString());
+                default:
+                    return document.makeNone();
+            }
+        }
+    };
+}
+
+dv::document Reader::readDocument() {
+    dv::document document;
+    DocumentBuilder builder(*this, document);
+    document.setRoot(builder.build(0));
+    return document;
+}
+
+std::unique_ptr<Reader> json::create_reader(
+    std::string_view filename, std::string_view source
+) {
+    return std::make_unique<TextReader>(filename, source);
+}
+
+std::unique_ptr<Reader> json::create_binary_reader(
+    const ubyte* src, size_t size
+) {
+    return std::make_unique<BinaryReader>(src, size);
+}
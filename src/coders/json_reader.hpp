@@ -0,0 +1,93 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "data/dv.hpp"
+#include "data/dv_document.hpp"
+#include "typedefs.hpp"
+
+namespace json {
+    enum class token {
+        /// @brief '{' or binary document start
+        object_begin,
+        object_end,
+        /// @brief '[' or binary list start
+        list_begin,
+        list_end,
+        /// @brief Object entry key, value follows
+        key,
+        /// @brief Scalar value
+        value,
+        /// @brief End of document
+        end
+    };
+
+    /// @brief Pull (SAX-style) reader of JSON and Binary JSON documents.
+    /// Reads document token by token without building dv trees.
+    /// Key and string views are valid until the next call of next().
+    class Reader {
+    protected:
+        token current = token::end;
+        dv::value_type valueType = dv::value_type::none;
+        dv::integer_t integer = 0;
+        dv::number_t number = 0.0;
+        std::string_view key;
+        std::string_view string;
+    public:
+        virtual ~Reader() = default;
+
+        /// @brief Read next token
+        /// @throws parsing_error (JSON) or std::runtime_error (BJSON)
+        virtual token next() = 0;
+
+        token getToken() const {
+            return current;
+        }
+
+        /// @brief Current object entry key (token::key)
+        std::string_view getKey() const {
+            return key;
+        }
+
+        /// @brief Current scalar value type (token::value)
+        dv::value_type getType() const {
+            return valueType;
+        }
+
+        /// @brief Current value as string (string and bytes values)
+        std::string_view getString() const;
+
+        dv::integer_t getInteger() const;
+
+        /// @brief Current value as number (integer values are converted)
+        dv::number_t getNumber() const;
+
+        bool getBoolean() const;
+
+        /// @brief Skip current value. Whole object or list is skipped if
+        /// called on object_begin / list_begin
+        void skip();
+
+        /// @brief Build dv value from current token (value, object_begin
+        /// or list_begin). Reader moves to the end of the value
+        dv::value read();
+
+        /// @brief Build arena document from current token (value,
+        /// object_begin or list_begin). Reader moves to the end of the value
+        dv::document readDocument();
+    };
+
+    /// @brief Create JSON text reader. Source must outlive the reader
+    std::unique_ptr<Reader> create_reader(
+        std::string_view filename, std::string_view source
+    );
+
+    /// @brief Create Binary JSON reader (gzip-compressed data is
+    /// decompressed at once). Source must outlive the reader
+    std::unique_ptr<Reader> create_binary_reader(
+        const ubyte* src, size_t size
+    );
+}
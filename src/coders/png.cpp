@@ -2,6 +2,7 @@
 
 #include <png.h>
 
+#include <cstring>
 #include <iostream>
 
 #include "debug/Logger.hpp"
@@ -172,7 +173,30 @@ void png_error_handler(png_structp pngPtr, png_const_charp errorMessage) {
     abort(); // Should not be reached if longjmp works
 }
 
-std::unique_ptr<ImageData> png::load_image(const ubyte* bytes, size_t size) {
+glm::uvec2 png::read_size(const ubyte* bytes, size_t size) {
+    // signature, IHDR chunk length and type, width, height
+    if (size < 24 || !png_check_sig(bytes, 8)) {
+        throw std::runtime_error("invalid png signature");
+    }
+    if (std::memcmp(bytes + 12, "IHDR", 4) != 0) {
+        throw std::runtime_error("IHDR chunk expected");
+    }
+    auto read_uint32 = [](const ubyte* src) {
+        return (static_cast<uint>(src[0]) << 24) |
+               (static_cast<uint>(src[1]) << 16) |
+               (static_cast<uint>(src[2]) << 8) | static_cast<uint>(src[3]);
+    };
+    return {read_uint32(bytes + 16), read_uint32(bytes + 20)};
+}
+
+/// @brief Decode PNG as RGBA8888 raster
+/// @param getRaster (width, height) -> pointer to the first row of the
+/// destination raster. Rows are stored bottom-up as in ImageData
+/// @param stride destination row size in bytes (0 - width * 4)
+template <typename Func>
+static void read_rgba(
+    const ubyte* bytes, size_t size, size_t stride, const Func& getRaster
+) {
     if (size < 8 || !png_check_sig(bytes, 8)) {
         throw std::runtime_error("invalid png signature");
     }
@@ -237,41 +261,59 @@ std::unique_ptr<ImageData> png::load_image(const ubyte* bytes, size_t size) {
     }
     png_read_update_info(pngPtr, infoPtr);
 
-    int rowBytes = png_get_rowbytes(pngPtr, infoPtr);
-
-    //  png_get_color_type returns 2 (RGB) but raster always have alpha channel
-    //  due to PNG_FILLER_AFTER
-    colorType = 6;
-    bitDepth = png_get_bit_depth(pngPtr, infoPtr);
-
-    auto imageData = std::make_unique<png_byte[]>(rowBytes * height);
+    size_t rowBytes = png_get_rowbytes(pngPtr, infoPtr);
+    if (rowBytes != width * 4) {
+        png_destroy_read_struct(&pngPtr, &infoPtr, nullptr);
+        throw std::runtime_error("unexpected png row size");
+    }
+    if (stride == 0) {
+        stride = rowBytes;
+    }
+    ubyte* raster;
+    try {
+        raster = getRaster(width, height);
+    } catch (...) {
+        png_destroy_read_struct(&pngPtr, &infoPtr, nullptr);
+        throw;
+    }
     auto rowPointers = std::make_unique<png_byte*[]>(height);
-    for (int i = 0; i < height; ++i) {
-        rowPointers[height - 1 - i] = imageData.get() + i * rowBytes;
+    for (uint i = 0; i < height; ++i) {
+        rowPointers[height - 1 - i] = raster + i * stride;
     }
     png_read_image(pngPtr, rowPointers.get());
-
-    ImageFormat format = ImageFormat::RGBA8888;
-    switch (colorType) {
-        case PNG_COLOR_TYPE_RGBA:
-            format = ImageFormat::RGBA8888;
-            break;
-        case PNG_COLOR_TYPE_RGB:
-            format = ImageFormat::RGB888;
-            break;
-        default:
-            png_destroy_read_struct(&pngPtr, &infoPtr, nullptr);
-            throw std::runtime_error(
-                "color type " + std::to_string(colorType) + " is not supported!"
-            );
-    }
-    auto image = std::make_unique<ImageData>(
-        format, width, height, std::move(imageData)
-    );
     png_destroy_read_struct(&pngPtr, &infoPtr, nullptr);
+}
+
+std::unique_ptr<ImageData> png::load_image(const ubyte* bytes, size_t size) {
+    std::unique_ptr<ImageData> image;
+    //  raster always have alpha channel due to PNG_FILLER_AFTER
+    read_rgba(bytes, size, 0, [&image](uint width, uint height) {
+        image = std::make_unique<ImageData>(
+            ImageFormat::RGBA8888,
+            width,
+            height,
+            std::make_unique<ubyte[]>(width * height * 4)
+        );
+        return image->getData();
+    });
     return image;
 }
 
+void png::decode_rgba(
+    const ubyte* bytes,
+    size_t size,
+    ubyte* dst,
+    size_t stride,
+    const glm::uvec2& expectedSize
+) {
+    read_rgba(bytes, size, stride, [dst, expectedSize](uint w, uint h) {
+        if (w != expectedSize.x || h != expectedSize.y) {
+            throw std::runtime_error("png size does not match header");
+        }
+        return dst;
+    });
+}
+
 std::unique_ptr<Texture> png::load_texture(const ubyte* bytes, size_t size) {
     auto image = load_image(bytes, size);
     auto texture = Texture::from(image.get());
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <glm/vec2.hpp>
 #include <memory>
 #include <string>
 
@@ -11,6 +12,22 @@ class ImageData;
 
 namespace png {
     std::unique_ptr<ImageData> load_image(const ubyte* bytes, size_t size);
+
+    /// @brief Read image size from the PNG header without decoding
+    glm::uvec2 read_size(const ubyte* bytes, size_t size);
+
+    /// @brief Decode image as RGBA8888 directly into external raster
+    /// (e.g. atlas region). Rows are stored bottom-up as in ImageData
+    /// @param dst destination of the image first row
+    /// @param stride destination row size in bytes
+    /// @param expectedSize image size read with read_size
+    void decode_rgba(
+        const ubyte* bytes,
+        size_t size,
+        ubyte* dst,
+        size_t stride,
+        const glm::uvec2& expectedSize
+    );
     void write_image(const std::string& filename, const ImageData* image);
     util::Buffer<ubyte> encode_image(const ImageData& image);
     std::unique_ptr<Texture> load_texture(const ubyte* bytes, size_t size);
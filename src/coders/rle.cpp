@@ -1,9 +1,107 @@
 #include "rle.hpp"
 
+#include <cstring>
 #include <stdexcept>
 
 #include "util/data_io.hpp"
 
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define VC_RLE_SSE2
+#endif
+
+#ifdef _MSC_VER
+    #include <intrin.h>
+#endif
+
+// Encoders find whole runs at once (SIMD compare of 16 bytes per step),
+// then split them into sequences of the max length supported by the format.
+
+static inline uint count_trailing_zeros(uint value) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, value);
+    return index;
+#else
+    return __builtin_ctz(value);
+#endif
+}
+
+/// @return index of the first element not equal to c in range [i, end)
+/// or end
+static inline size_t find_run_end(
+    const ubyte* src, size_t i, size_t end, ubyte c
+) {
+#ifdef VC_RLE_SSE2
+    const __m128i vc = _mm_set1_epi8(static_cast<char>(c));
+    for (; i + 16 <= end; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        uint mask = _mm_movemask_epi8(_mm_cmpeq_epi8(v, vc));
+        if (mask != 0xFFFF) {
+            return i + count_trailing_zeros(~mask);
+        }
+    }
+#endif
+    while (i < end && src[i] == c) {
+        i++;
+    }
+    return i;
+}
+
+/// @return index of the first element not equal to c in range [i, end)
+/// or end
+static inline size_t find_run_end(
+    const uint16_t* src, size_t i, size_t end, uint16_t c
+) {
+#ifdef VC_RLE_SSE2
+    const __m128i vc = _mm_set1_epi16(static_cast<short>(c));
+    for (; i + 8 <= end; i += 8) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        uint mask = _mm_movemask_epi8(_mm_cmpeq_epi16(v, vc));
+        if (mask != 0xFFFF) {
+            return i + count_trailing_zeros(~mask) / 2;
+        }
+    }
+#endif
+    while (i < end && src[i] == c) {
+        i++;
+    }
+    return i;
+}
+
+static inline void fill16(uint16_t* dst, uint16_t c, size_t count) {
+    size_t i = 0;
+#ifdef VC_RLE_SSE2
+    const __m128i vc = _mm_set1_epi16(static_cast<short>(c));
+    for (; i + 8 <= count; i += 8) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), vc);
+    }
+#endif
+    for (; i < count; i++) {
+        dst[i] = c;
+    }
+}
+
+/// @brief Call func(counter, c) for each sequence of up to maxCounter + 1
+/// equal elements
+template <typename T, typename SeqFunc>
+static inline void for_each_sequence(
+    const T* src, size_t length, size_t maxCounter, const SeqFunc& func
+) {
+    for (size_t i = 0; i < length;) {
+        T c = src[i];
+        size_t end = find_run_end(src, i + 1, length, c);
+        size_t runLength = end - i;
+        while (runLength > maxCounter + 1) {
+            func(maxCounter, c);
+            runLength -= maxCounter + 1;
+        }
+        func(runLength - 1, c);
+        i = end;
+    }
+}
+
 size_t rle::decode(const ubyte* src, size_t srclen, ubyte* dst, size_t dstLength) {
     size_t offset = 0;
     for (size_t i = 0; i < srclen;) {
@@ -12,75 +110,49 @@ size_t rle::decode(const ubyte* src, size_t srclen, ubyte* dst, size_t dstLength
         if (offset + len >= dstLength) {
             throw std::runtime_error("buffer overflow");
         }
-        for (size_t j = 0; j <= len; j++) {
-            dst[offset++] = c;
-        }
+        std::memset(dst + offset, c, len + 1);
+        offset += len + 1;
     }
     return offset;
 }
 
 size_t rle::encode(const ubyte* src, size_t srclen, ubyte* dst) {
-    if (srclen == 0) {
-        return 0;
-    }
     size_t offset = 0;
-    ubyte counter = 0;
-    ubyte c = src[0];
-    for (size_t i = 1; i < srclen; i++) {
-        ubyte cnext = src[i];
-        if (cnext != c || counter == 255) {
-            dst[offset++] = counter;
-            dst[offset++] = c;
-            c = cnext;
-            counter = 0;
-        } else {
-            counter++;
-        }
-    }
-    dst[offset++] = counter;
-    dst[offset++] = c;
+    for_each_sequence(src, srclen, 255, [&](uint counter, ubyte c) {
+        dst[offset++] = counter;
+        dst[offset++] = c;
+    });
     return offset;
 }
 
 size_t rle::decode16(const ubyte* src, size_t srclen, ubyte* dst, size_t dstLength) {
     auto src16 = reinterpret_cast<const uint16_t*>(src);
     auto dst16 = reinterpret_cast<uint16_t*>(dst);
+    size_t dstLength16 = dstLength / 2;
     size_t offset = 0;
     for (size_t i = 0; i < srclen / 2;) {
         uint16_t len = dataio::le2h(src16[i++]);
         uint16_t c = dataio::le2h(src16[i++]);
-        if (offset + len >= dstLength) {
+        if (offset + len >= dstLength16) {
             throw std::runtime_error("buffer overflow");
         }
-        for (size_t j = 0; j <= len; j++) {
-            dst16[offset++] = c;
-        }
+        fill16(dst16 + offset, c, len + 1);
+        offset += len + 1;
     }
     return offset * 2;
 }
 
 size_t rle::encode16(const ubyte* src, size_t srclen, ubyte* dst) {
-    if (srclen == 0) {
-        return 0;
-    }
     auto src16 = reinterpret_cast<const uint16_t*>(src);
     auto dst16 = reinterpret_cast<uint16_t*>(dst);
     size_t offset = 0;
-    uint16_t counter = 0;
-    uint16_t c = src16[0];
-    for (size_t i = 1; i < srclen / 2; i++) {
-        uint16_t cnext = src16[i];
-        if (cnext != c || counter == 0xFFFF) {
-            dst16[offset++] = dataio::h2le(counter);
+    for_each_sequence(
+        src16, srclen / 2, 0xFFFF,
+        [&](uint counter, uint16_t c) {
+            dst16[offset++] = dataio::h2le(static_cast<uint16_t>(counter));
             dst16[offset++] = dataio::h2le(c);
-            c = cnext;
-            counter = 0;
-        } else {
-            counter++;
         }
-    }
-    dst16[offset++] = dataio::h2le(counter);
-    dst16[offset++] = dataio::h2le(c);
+    );
     return offset * 2;
 }
 
@@ -96,23 +168,17 @@ size_t extrle::decode(const ubyte* src, size_t srclen, ubyte* dst, size_t dstLen
         if (offset + len >= dstLength) {
             throw std::runtime_error("buffer overflow");
         }
-        for (size_t j = 0; j <= len; j++) {
-            dst[offset++] = c;
-        }
+        std::memset(dst + offset, c, len + 1);
+        offset += len + 1;
     }
     return offset;
 }
 
 size_t extrle::encode(const ubyte* src, size_t srclen, ubyte* dst) {
-    if (srclen == 0) {
-        return 0;
-    }
     size_t offset = 0;
-    uint counter = 0;
-    ubyte c = src[0];
-    for (size_t i = 1; i < srclen; i++) {
-        ubyte cnext = src[i];
-        if (cnext != c || counter == max_sequence) {
+    for_each_sequence(
+        src, srclen, max_sequence,
+        [&](uint counter, ubyte c) {
             if (counter >= 0x80) {
                 dst[offset++] = 0x80 | (counter & 0x7F);
                 dst[offset++] = counter >> 7;
@@ -120,59 +186,31 @@ size_t extrle::encode(const ubyte* src, size_t srclen, ubyte* dst) {
                 dst[offset++] = counter;
             }
             dst[offset++] = c;
-            c = cnext;
-            counter = 0;
-        } else {
-            counter++;
         }
-    }
-    if (counter >= 0x80) {
-        dst[offset++] = 0x80 | (counter & 0x7F);
-        dst[offset++] = counter >> 7;
-    } else {
-        dst[offset++] = counter;
-    }
-    dst[offset++] = c;
+    );
     return offset;
 }
 
 size_t extrle::decode16(const ubyte* src, size_t srclen, ubyte* dst8, size_t dstLength) {
     auto dst = reinterpret_cast<uint16_t*>(dst8);
-    size_t offset = 0;
-    for (size_t i = 0; i < srclen;) {
-        uint len = src[i++];
-        bool widechar = len & 0x40;
-        if (len & 0x80) {
-            len &= 0x3F;
-            len |= (static_cast<uint>(src[i++])) << 6;
-        } else {
-            len &= 0x3F;
-        }
-        uint16_t c = src[i++];
-        if (widechar) {
-            c |= ((static_cast<uint>(src[i++])) << 8);
-        }
-        if (offset + len >= dstLength) {
-            throw std::runtime_error("buffer overflow");
-        }
-        for (size_t j = 0; j <= len; j++) {
-            dst[offset++] = c;
+    size_t dstLength16 = dstLength / 2;
+    size_t length = for_each_sequence16(
+        src, srclen, [=](size_t offset, size_t count, uint16_t c) {
+            if (offset + count > dstLength16) {
+                throw std::runtime_error("buffer overflow");
+            }
+            fill16(dst + offset, c, count);
         }
-    }
-    return offset * 2;
+    );
+    return length * 2;
 }
 
 size_t extrle::encode16(const ubyte* src8, size_t srclen, ubyte* dst) {
-    if (srclen == 0) {
-        return 0;
-    }
     auto src = reinterpret_cast<const uint16_t*>(src8);
     size_t offset = 0;
-    uint counter = 0;
-    uint16_t c = src[0];
-    for (size_t i = 1; i < srclen/2; i++) {
-        uint16_t cnext = src[i];
-        if (cnext != c || counter == max_sequence16) {
+    for_each_sequence(
+        src, srclen / 2, max_sequence16,
+        [&](uint counter, uint16_t c) {
             if (counter >= 0x40) {
                 dst[offset++] = 0x80 | ((c > 255) << 6) | (counter & 0x3F);
                 dst[offset++] = counter >> 6;
@@ -185,23 +223,7 @@ size_t extrle::encode16(const ubyte* src8, size_t srclen, ubyte* dst) {
             } else {
                 dst[offset++] = c;
             }
-            c = cnext;
-            counter = 0;
-        } else {
-            counter++;
         }
-    }
-    if (counter >= 0x40) {
-        dst[offset++] = 0x80 | ((c > 255) << 6) | (counter & 0x3F);
-        dst[offset++] = counter >> 6;
-    } else {
-        dst[offset++] = counter | ((c > 255) << 6);
-    }
-    if (c > 255) {
-        dst[offset++] = c & 0xFF;
-        dst[offset++] = c >> 8;
-    } else {
-        dst[offset++] = c;
-    }
+    );
     return offset;
 }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <stdexcept>
+
 #include "typedefs.hpp"
 
 namespace rle {
@@ -18,4 +20,34 @@ namespace extrle {
     constexpr uint max_sequence16 = 0x3FFF;
     size_t encode16(const ubyte* src, size_t length, ubyte* dst);
     size_t decode16(const ubyte* src, size_t length, ubyte* dst, size_t dstLength);
+
+    /// @brief Call func(offset, count, value) for each sequence of encode16
+    /// output, where offset is index of the first uint16 element
+    /// @return total number of uint16 elements
+    /// @throws std::runtime_error if data ends unexpectedly
+    template <typename Func>
+    inline size_t for_each_sequence16(
+        const ubyte* src, size_t length, const Func& func
+    ) {
+        size_t offset = 0;
+        for (size_t i = 0; i < length;) {
+            uint len = src[i++];
+            bool widechar = len & 0x40;
+            bool longseq = len & 0x80;
+            if (i + longseq + widechar + 1 > length) {
+                throw std::runtime_error("unexpected end of data");
+            }
+            len &= 0x3F;
+            if (longseq) {
+                len |= (static_cast<uint>(src[i++])) << 6;
+            }
+            uint16_t c = src[i++];
+            if (widechar) {
+                c |= ((static_cast<uint>(src[i++])) << 8);
+            }
+            func(offset, len + 1, c);
+            offset += len + 1;
+        }
+        return offset;
+    }
 }
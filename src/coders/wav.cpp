@@ -65,13 +65,11 @@ public:
             return 0;
         }
         in.read(buffer, bufferSize);
-        if (in.eof()) {
-            return 0;
-        }
-        if (in.fail()) {
+        if (in.bad()) {
             logger.error() << "Wav::load_pcm: I/O error ocurred";
             return -1;
         }
+        // the last piece is read with eof reached
         return in.gcount();
     }
 
@@ -11,6 +11,11 @@
 #include "devtools/Project.hpp"
 #include "logic/scripting/scripting.hpp"
 #include "core_defs.hpp"
+#include "debug/Logger.hpp"
+#include "util/parallel.hpp"
+#include "util/timeutil.hpp"
+
+static debug::Logger logger("content-control");
 
 static void load_configs(Input* input, const io::path& root) {
     auto configFolder = root / "config";
@@ -107,14 +112,28 @@ void ContentControl::loadContent() {
     }
     paths.resPaths = ResPaths(resRoots);
     // Load content
+    timeutil::Timer timer;
+    // Definition files are read in parallel by workers shared by all packs
+    util::ParallelPool pool;
     for (auto& pack : allPacks) {
-        ContentLoader(&pack, contentBuilder, paths.resPaths).load();
+        ContentLoader(&pack, contentBuilder, paths.resPaths, pool).load();
         load_configs(input, pack.folder);
     }
+    int64_t packsTime = timer.stop();
     content = contentBuilder.build();
     scripting::on_content_load(content.get());
+    int64_t buildTime = timer.stop() - packsTime;
 
     ContentLoader::loadScripts(*content);
+    int64_t totalTime = timer.stop();
+    logger.info() << "content loaded in " << totalTime / 1000 << " ms ("
+                  << allPacks.size() << " packs: " << packsTime / 1000
+                  << " ms, build: " << buildTime / 1000 << " ms, scripts: "
+                  << (totalTime - packsTime - buildTime) / 1000 << " ms)";
+    auto pathsStats = paths.resPaths.getStats();
+    logger.info() << "resources lookups: " << pathsStats.lookups
+                  << ", device queries: " << pathsStats.queries << " ("
+                  << pathsStats.legacyQueries << " without index)";
 
     postContent();
 }
@@ -7,18 +7,26 @@
 #include "loading/ContentUnitLoader.hpp"
 #include "ContentBuilder.hpp"
 #include "ContentPack.hpp"
+#include "coders/commons.hpp"
+#include "coders/json_reader.hpp"
+#include "data/dv_document.hpp"
 #include "debug/Logger.hpp"
 #include "logic/scripting/scripting.hpp"
 #include "util/listutil.hpp"
+#include "util/parallel.hpp"
 #include "util/stringutil.hpp"
+#include "util/timeutil.hpp"
 #include "engine/EnginePaths.hpp"
 
 static debug::Logger logger("content-loader");
 
 ContentLoader::ContentLoader(
-    ContentPack* pack, ContentBuilder& builder, const ResPaths& paths
+    ContentPack* pack,
+    ContentBuilder& builder,
+    const ResPaths& paths,
+    util::ParallelPool& pool
 )
-    : pack(pack), builder(builder), paths(paths) {
+    : pack(pack), builder(builder), paths(paths), pool(pool) {
     auto runtime = std::make_unique<ContentPackRuntime>(
         *pack, scripting::create_pack_environment(*pack)
     );
@@ -28,6 +36,30 @@ ContentLoader::ContentLoader(
     builder.add(std::move(runtime));
 }
 
+/// @brief Read JSON file as arena document without building dv tree
+static dv::document read_json_document(const io::path& file) {
+    auto text = io::read_string(file);
+    auto reader = json::create_reader(file.string(), text);
+    reader->next();
+    return reader->readDocument();
+}
+
+/// @brief Check data file syntax. JSON files are only scanned by reader
+static void check_data_file(const io::path& file) {
+    if (file.extension() != ".json") {
+        io::read_object(file);
+        return;
+    }
+    auto text = io::read_string(file);
+    try {
+        auto reader = json::create_reader(file.string(), text);
+        reader->next();
+        reader->skip();
+    } catch (const parsing_error& err) {
+        throw std::runtime_error(err.errorLog());
+    }
+}
+
 static void detect_defs(
     const io::path& folder,
     const std::string& prefix,
@@ -42,7 +74,7 @@ static void detect_defs(
             continue;
         }
         if (io::is_regular_file(file) && io::is_data_file(file)) {
-            auto map = io::read_object(file);
+            check_data_file(file);
             std::string id = prefix.empty() ? name : prefix + ":" + name;
             detected.emplace_back(id);
         } else if (io::is_directory(file) && file.extension() != ".files") {
@@ -144,6 +176,7 @@ void ContentLoader::fixPackIndices() {
     if (modified) {
         // rewrite modified json
         io::write_json(contentFile, root);
+        paths.onModified(contentFile);
     }
 }
 
@@ -172,67 +205,69 @@ void process_method(
     }
 }
 
-template<typename DefT> 
-void ContentUnitLoader<DefT>::loadUnit(
-    DefT& def, const std::string& full, const std::string& name
-) {
-    auto folder = pack.folder;
-    auto configFile = folder / (defsDir + "/" + name + ".json");
-    if (io::exists(configFile)) loadUnit(def, full, configFile);
-}
-
 void ContentLoader::loadBlockMaterial(
-    BlockMaterial& def, const io::path& file
+    BlockMaterial& def, const dv::value& root
 ) {
-    def.deserialize(io::read_json(file));
+    def.deserialize(root);
     if (def.hitSound.empty()) {
         def.hitSound = def.stepsSound;
     }
 }
 
 template <typename DefT>
-void ContentUnitLoader<DefT>::loadDefs(const dv::value& root) {
+void ContentUnitLoader<DefT>::loadDefs(const dv::node& root) {
     auto found = root.at(defsDir);
-    if (!found) {
+    if (found == nullptr) {
         return;
     }
     const auto& defsArr = *found;
 
-    std::vector<std::pair<std::string, std::string>> pendingDefs;
-    auto getJsonParent = [this](const std::string& prefix, const std::string& name) {
-        auto configFile = pack.folder / (prefix + "/" + name + ".json");
+    struct UnitFile {
+        std::string full;
+        std::string name;
+        dv::value root;
         std::string parent;
-        if (io::exists(configFile)) {
-            auto root = io::read_json(configFile);
-            root.at("parent").get(parent);
-        }
-        return parent;
     };
-    auto processName = [this](const std::string& name) {
+    std::vector<UnitFile> units(defsArr.size());
+    for (size_t i = 0; i < defsArr.size(); i++) {
+        std::string name(defsArr[i].asString());
+        auto& unit = units[i];
         auto colon = name.find(':');
-        auto new_name = name;
-        std::string full =
-            colon == std::string::npos ? pack.id + ":" + name : name;
-        if (colon != std::string::npos) new_name[colon] = '/';
+        unit.full = colon == std::string::npos ? pack.id + ":" + name : name;
+        unit.name = name;
+        if (colon != std::string::npos) unit.name[colon] = '/';
+    }
+    // Read and parse definition files in parallel. Definitions are
+    // created below in the listed order, so ids stay stable.
+    pool.run(units.size(), [this, &units](size_t index) {
+        auto& unit = units[index];
+        auto configFile = pack.folder / (defsDir + "/" + unit.name + ".json");
+        if (io::exists(configFile)) {
+            unit.root = io::read_json(configFile);
+            unit.root.at("parent").get(unit.parent);
+        }
+    });
 
-        return std::make_pair(full, new_name);
+    auto loadUnitFile = [this](const UnitFile& unit) {
+        bool created;
+        auto& def = builder.create(unit.full, &created);
+        if (unit.root != nullptr) {
+            loadUnit(def, unit.full, unit.root);
+        }
+        if (postFunc) {
+            postFunc(def);
+        }
     };
 
-    for (size_t i = 0; i < defsArr.size(); i++) {
-        auto [full, name] = processName(defsArr[i].asString());
-        auto parent = getJsonParent(defsDir, name);
-        if (parent.empty() || builder.get(parent)) {
+    std::vector<const UnitFile*> pendingDefs;
+    for (const auto& unit : units) {
+        if (unit.parent.empty() || builder.get(unit.parent)) {
             // No dependency or dependency already loaded/exists in another
             // content pack
-            bool created;
-            auto& def = builder.create(full, &created);
-            loadUnit(def, full, name);
-            if (postFunc) {
-                postFunc(def);
-            }
+            loadUnitFile(unit);
         } else {
             // Dependency not loaded yet, add to pending content units
-            pendingDefs.emplace_back(full, name);
+            pendingDefs.push_back(&unit);
         }
     }
 
@@ -242,16 +277,10 @@ void ContentUnitLoader<DefT>::loadDefs(const dv::value& root) {
         progressMade = false;
 
         for (auto it = pendingDefs.begin(); it != pendingDefs.end();) {
-            auto parent = getJsonParent(defsDir, it->second);
-            if (builder.get(parent)) {
+            if (builder.get((*it)->parent)) {
                 // Dependency resolved or parent exists in another pack,
                 // load the content unit
-                bool created;
-                auto& def = builder.create(it->first, &created);
-                loadUnit(def, it->first, it->second);
-                if (postFunc) {
-                    postFunc(def);
-                }
+                loadUnitFile(**it);
                 it = pendingDefs.erase(it);  // Remove resolved content unit
                 progressMade = true;
             } else {
@@ -269,14 +298,14 @@ void ContentUnitLoader<DefT>::loadDefs(const dv::value& root) {
     }
 }
 
-void ContentLoader::loadContent(const dv::value& root) {
+void ContentLoader::loadContent(const dv::node& root) {
     ContentPackStats prevStats {
         builder.blocks.defs.size(),
         builder.items.defs.size(),
         builder.entities.defs.size(),
     };
 
-    ContentUnitLoader<Block>(*pack, builder.blocks, "blocks", 
+    ContentUnitLoader<Block>(*pack, builder.blocks, "blocks", pool,
         [this](Block& def) {
         if (!def.hidden) {
             bool created;
@@ -295,8 +324,8 @@ void ContentLoader::loadContent(const dv::value& root) {
         }
     }).loadDefs(root);
 
-    ContentUnitLoader(*pack, builder.items, "items").loadDefs(root);
-    ContentUnitLoader(*pack, builder.entities, "entities").loadDefs(root);
+    ContentUnitLoader(*pack, builder.items, "items", pool).loadDefs(root);
+    ContentUnitLoader(*pack, builder.entities, "entities", pool).loadDefs(root);
 
     stats->totalBlocks = builder.blocks.defs.size() - prevStats.totalBlocks;
     stats->totalItems = builder.items.defs.size() - prevStats.totalItems;
@@ -304,19 +333,28 @@ void ContentLoader::loadContent(const dv::value& root) {
 }
 
 static inline void foreach_file(
-    const io::path& dir, std::function<void(const io::path&)> handler
+    const ResPaths& paths,
+    const io::path& dir,
+    std::function<void(const io::path&)> handler
 ) {
-    if (!io::is_directory(dir)) {
+    if (!paths.isDirectory(dir)) {
         return;
     }
-    for (const auto& path : io::directory_iterator(dir)) {
-        if (io::is_directory(path)) {
+    for (const auto& path : paths.list(dir)) {
+        if (paths.isDirectory(path)) {
             continue;
         }
         handler(path);
     }
 }
 
+/// @brief Iterate files directly (without roots index)
+static inline void foreach_file(
+    const io::path& dir, std::function<void(const io::path&)> handler
+) {
+    foreach_file(ResPaths(), dir, std::move(handler));
+}
+
 static std::tuple<std::string, std::string, std::string> create_unit_id(
     const std::string& packid, const std::string& name
 ) {
@@ -331,6 +369,7 @@ static std::tuple<std::string, std::string, std::string> create_unit_id(
 
 void ContentLoader::load() {
     logger.info() << "loading pack [" << pack->id << "]";
+    timeutil::Timer timer;
 
     fixPackIndices();
 
@@ -344,7 +383,7 @@ void ContentLoader::load() {
 
     // Load world generators
     io::path generatorsDir = folder / "generators";
-    foreach_file(generatorsDir, [this](const io::path& file) {
+    foreach_file(paths, generatorsDir, [this](const io::path& file) {
         std::string name = file.stem();
         auto [packid, full, filename] = create_unit_id(pack->id, name);
 
@@ -358,9 +397,9 @@ void ContentLoader::load() {
 
     // Load pack resources.json
     io::path resourcesFile = folder / "resources.json";
-    if (io::exists(resourcesFile)) {
-        auto resRoot = io::read_json(resourcesFile);
-        for (const auto& [key, arr] : resRoot.asObject()) {
+    if (paths.isFile(resourcesFile)) {
+        auto resources = read_json_document(resourcesFile);
+        for (const auto& [key, arr] : resources.root().asObject()) {
             ResourceType type;
             if (ResourceTypeMeta.getItem(key, type)) {
                 loadResources(type, arr);
@@ -373,9 +412,9 @@ void ContentLoader::load() {
 
     // Load pack resources aliases
     io::path aliasesFile = folder / "resource-aliases.json";
-    if (io::exists(aliasesFile)) {
-        auto resRoot = io::read_json(aliasesFile);
-        for (const auto& [key, arr] : resRoot.asObject()) {
+    if (paths.isFile(aliasesFile)) {
+        auto aliases = read_json_document(aliasesFile);
+        for (const auto& [key, arr] : aliases.root().asObject()) {
             ResourceType type;
             if (ResourceTypeMeta.getItem(key, type)) {
                 loadResourceAliases(type, arr);
@@ -388,26 +427,33 @@ void ContentLoader::load() {
 
     // Load block materials
     io::path materialsDir = folder / "block_materials";    
-    if (io::is_directory(materialsDir)) {
-        for (const auto& file : io::directory_iterator(materialsDir)) {
+    if (paths.isDirectory(materialsDir)) {
+        std::vector<std::pair<std::string, io::path>> files;
+        for (const auto& file : paths.list(materialsDir)) {
             auto [packid, full, filename] =
                 create_unit_id(pack->id, file.stem());
+            files.emplace_back(full, materialsDir / (filename + ".json"));
+        }
+        std::vector<dv::value> roots(files.size());
+        pool.run(files.size(), [&files, &roots](size_t index) {
+            roots[index] = io::read_json(files[index].second);
+        });
+        for (size_t i = 0; i < files.size(); i++) {
             loadBlockMaterial(
-                builder.createBlockMaterial(full),
-                materialsDir / (filename + ".json")
+                builder.createBlockMaterial(files[i].first), roots[i]
             );
         }
     }
 
     // Process content.json and load defined content units
     auto contentFile = pack->getContentFile();
-    if (io::exists(contentFile)) {
-        loadContent(io::read_json(contentFile));
+    if (paths.isFile(contentFile)) {
+        loadContent(read_json_document(contentFile).root());
     }
 
     // Load attached tags
     io::path tagsFile = folder / "tags.toml";
-    if (io::exists(tagsFile)) {
+    if (paths.isFile(tagsFile)) {
         auto tagsMap = io::read_object(tagsFile);
         for (const auto& [key, list] : tagsMap.asObject()) {
             for (const auto& id : list) {
@@ -423,6 +469,10 @@ void ContentLoader::load() {
             }
         }
     }
+    logger.info() << "pack [" << pack->id << "] loaded in "
+                  << timer.stop() / 1000 << " ms (" << stats->totalBlocks
+                  << " blocks, " << stats->totalItems << " items, "
+                  << stats->totalEntities << " entities)";
 }
 
 template <class T>
@@ -521,18 +571,18 @@ void ContentLoader::loadScripts(Content& content) {
     scripting::on_content_loaded();
 }
 
-void ContentLoader::loadResources(ResourceType type, const dv::value& list) {
-    for (size_t i = 0; i < list.size(); i++) {
+void ContentLoader::loadResources(ResourceType type, const dv::node& list) {
+    for (const auto& name : list.asList()) {
         builder.resourceIndices[static_cast<size_t>(type)].add(
-            pack->id + ":" + list[i].asString(), nullptr
+            pack->id + ":" + std::string(name.asString()), nullptr
         );
     }
 }
 
-void ContentLoader::loadResourceAliases(ResourceType type, const dv::value& aliases) {
+void ContentLoader::loadResourceAliases(ResourceType type, const dv::node& aliases) {
     for (const auto& [alias, name] : aliases.asObject()) {
         builder.resourceIndices[static_cast<size_t>(type)].addAlias(
-            name.asString(), alias
+            std::string(name.asString()), std::string(alias)
         );
     }
 }
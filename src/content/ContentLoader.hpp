@@ -6,6 +6,7 @@
 #include "io/io.hpp"
 #include "content_fwd.hpp"
 #include "data/dv.hpp"
+#include "data/dv_fwd.hpp"
 
 class Block;
 struct BlockMaterial;
@@ -20,6 +21,10 @@ class ContentBuilder;
 class ContentPackRuntime;
 struct ContentPackStats;
 
+namespace util {
+    class ParallelPool;
+}
+
 class ContentLoader {
     const ContentPack* pack;
     ContentPackRuntime* runtime;
@@ -27,20 +32,22 @@ class ContentLoader {
     ContentBuilder& builder;
     ContentPackStats* stats;
     const ResPaths& paths;
+    util::ParallelPool& pool;
 
     void loadGenerator(
         GeneratorDef& def, const std::string& full, const std::string& name
     );
-    static void loadBlockMaterial(BlockMaterial& def, const io::path& file);
-    void loadResources(ResourceType type, const dv::value& list);
-    void loadResourceAliases(ResourceType type, const dv::value& aliases);
+    static void loadBlockMaterial(BlockMaterial& def, const dv::value& root);
+    void loadResources(ResourceType type, const dv::node& list);
+    void loadResourceAliases(ResourceType type, const dv::node& aliases);
 
-    void loadContent(const dv::value& map);
+    void loadContent(const dv::node& map);
 public:
     ContentLoader(
         ContentPack* pack,
         ContentBuilder& builder,
-        const ResPaths& paths
+        const ResPaths& paths,
+        util::ParallelPool& pool
     );
 
     // Refresh pack content.json
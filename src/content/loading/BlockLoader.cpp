@@ -86,9 +86,8 @@ static void load_variant(
 }
 
 template<> void ContentUnitLoader<Block>::loadUnit(
-    Block& def, const std::string& name, const io::path& file
+    Block& def, const std::string& name, const dv::value& root
 ) {
-    auto root = io::read_json(file);
     process_properties(def, name, root);
     process_tags(def, root);
 
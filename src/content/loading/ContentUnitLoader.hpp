@@ -10,6 +10,10 @@ struct ContentPack;
 
 template<typename T> class ContentUnitBuilder;
 
+namespace util {
+    class ParallelPool;
+}
+
 template <typename DefT>
 class ContentUnitLoader {
 public:
@@ -17,20 +21,23 @@ public:
         const ContentPack& pack,
         ContentUnitBuilder<DefT>& builder,
         const std::string& defsDir,
+        util::ParallelPool& pool,
         std::function<void(DefT&)> postFunc = nullptr
     )
         : pack(pack),
           builder(builder),
           defsDir(defsDir),
+          pool(pool),
           postFunc(std::move(postFunc)) {
     }
-    void loadUnit(DefT& def, const std::string& full, const std::string& name);
-    void loadUnit(DefT& def, const std::string& name, const io::path& file);
-    void loadDefs(const dv::value& root);
+    void loadUnit(DefT& def, const std::string& name, const dv::value& root);
+    void loadDefs(const dv::node& root);
 private:
     const ContentPack& pack;
     ContentUnitBuilder<DefT>& builder;
     std::string defsDir;
+    /// @brief Workers reading definition files
+    util::ParallelPool& pool;
     std::function<void(DefT&)> postFunc;
 };
 
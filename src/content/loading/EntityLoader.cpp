@@ -13,9 +13,8 @@
 static debug::Logger logger("entity-content-loader");
 
 template<> void ContentUnitLoader<EntityDef>::loadUnit(
-    EntityDef& def, const std::string& name, const io::path& file
+    EntityDef& def, const std::string& name, const dv::value& root
 ) {
-    auto root = io::read_json(file);
 
     if (root.has("parent")) {
         const auto& parentName = root["parent"].asString();
@@ -215,6 +215,10 @@ void ContentLoader::loadGenerator(
     InterpolationTypeMeta.getItem(interpName, def.heightsInterpolation);
     map.at("biomes-interpolation").get(interpName);
     InterpolationTypeMeta.getItem(interpName, def.biomesInterpolation);
+    map.at("region-size").get(def.regionSize);
+    if (def.regionSize == 0) {
+        throw std::runtime_error("region-size must be greater than 0");
+    }
 
     map.at("sea-level").get(def.seaLevel);
     map.at("wide-structs-chunks-radius").get(def.wideStructsChunksRadius);
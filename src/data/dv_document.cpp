@@ -0,0 +1,267 @@
+#include "dv_document.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+
+#include "util/Buffer.hpp"
+
+using namespace dv;
+
+inline constexpr size_t MIN_BLOCK_SIZE = 4096;
+inline constexpr size_t MAX_BLOCK_SIZE = 256 * 1024;
+
+std::string_view node::asString() const {
+    check_type(type, value_type::string);
+    return std::string_view(
+        count <= INLINE_LENGTH ? val.inlined : val.chars, count
+    );
+}
+
+std::string_view node::asBytes() const {
+    check_type(type, value_type::bytes);
+    return std::string_view(
+        count <= INLINE_LENGTH ? val.inlined : val.chars, count
+    );
+}
+
+integer_t node::asInteger() const {
+    if (type == value_type::number) {
+        return static_cast<integer_t>(val.number);
+    }
+    check_type(type, value_type::integer);
+    return val.integer;
+}
+
+number_t node::asNumber() const {
+    if (type == value_type::integer) {
+        return static_cast<number_t>(val.integer);
+    }
+    check_type(type, value_type::number);
+    return val.number;
+}
+
+boolean_t node::asBoolean() const {
+    check_type(type, value_type::boolean);
+    return val.boolean;
+}
+
+util::span<node> node::asList() const {
+    check_type(type, value_type::list);
+    return util::span<node>(val.items, count);
+}
+
+util::span<member> node::asObject() const {
+    check_type(type, value_type::object);
+    return util::span<member>(val.members, count);
+}
+
+const node* node::at(std::string_view key) const {
+    check_type(type, value_type::object);
+    auto end = val.members + count;
+    auto found = std::lower_bound(
+        val.members, end, key, [](const member& member, std::string_view key) {
+            return member.key < key;
+        }
+    );
+    if (found == end || found->key != key) {
+        return nullptr;
+    }
+    return &found->value;
+}
+
+const node& node::operator[](std::string_view key) const {
+    if (auto found = at(key)) {
+        return *found;
+    }
+    throw std::out_of_range("missing key '" + std::string(key) + "'");
+}
+
+const node& node::operator[](size_t index) const {
+    return asList().at(index);
+}
+
+size_t node::size() const noexcept {
+    switch (type) {
+        case value_type::string:
+        case value_type::bytes:
+        case value_type::list:
+        case value_type::object:
+            return count;
+        default:
+            return 0;
+    }
+}
+
+value node::toValue() const {
+    switch (type) {
+        case value_type::none:
+            return nullptr;
+        case value_type::boolean:
+            return val.boolean;
+        case value_type::integer:
+            return val.integer;
+        case value_type::number:
+            return val.number;
+        case value_type::string:
+            return std::string(asString());
+        case value_type::bytes: {
+            auto bytes = asBytes();
+            return std::make_shared<objects::Bytes>(
+                reinterpret_cast<const byte_t*>(bytes.data()), bytes.size()
+            );
+        }
+        case value_type::list: {
+            auto list = std::make_shared<objects::List>();
+            list->reserve(count);
+            for (const auto& item : asList()) {
+                list->push_back(item.toValue());
+            }
+            return list;
+        }
+        case value_type::object: {
+            auto object = std::make_shared<objects::Object>(count);
+            for (const auto& member : asObject()) {
+                object->emplace(
+                    std::string(member.key), member.value.toValue()
+                );
+            }
+            return object;
+        }
+    }
+    return nullptr;
+}
+
+void* document::allocate(size_t size, size_t alignment) {
+    if (!blocks.empty()) {
+        auto& last = blocks.back();
+        size_t offset = (blockOffset + alignment - 1) / alignment * alignment;
+        if (offset + size <= last.size) {
+            blockOffset = offset + size;
+            return last.data.get() + offset;
+        }
+    }
+    size_t blockSize = blocks.empty()
+                           ? MIN_BLOCK_SIZE
+                           : std::min(blocks.back().size * 2, MAX_BLOCK_SIZE);
+    // operator new[] memory is aligned for any fundamental type
+    blockSize = std::max(blockSize, size);
+    blocks.push_back(block {std::make_unique<char[]>(blockSize), blockSize});
+    allocated += blockSize;
+    blockOffset = size;
+    return blocks.back().data.get();
+}
+
+const char* document::copyChars(std::string_view chars) {
+    auto dst = static_cast<char*>(allocate(chars.size(), 1));
+    std::copy(chars.begin(), chars.end(), dst);
+    return dst;
+}
+
+size_t document::getArenaSize() const {
+    return allocated;
+}
+
+std::string_view document::internKey(std::string_view key) {
+    auto found = keys.find(key);
+    if (found != keys.end()) {
+        return *found;
+    }
+    std::string_view interned(copyChars(key), key.size());
+    keys.insert(interned);
+    return interned;
+}
+
+node document::makeNone() const {
+    return node();
+}
+
+node document::makeBoolean(boolean_t value) const {
+    dv::node result;
+    result.type = value_type::boolean;
+    result.val.boolean = value;
+    return result;
+}
+
+node document::makeInteger(integer_t value) const {
+    dv::node result;
+    result.type = value_type::integer;
+    result.val.integer = value;
+    return result;
+}
+
+node document::makeNumber(number_t value) const {
+    dv::node result;
+    result.type = value_type::number;
+    result.val.number = value;
+    return result;
+}
+
+static void check_count(size_t count) {
+    if (count > UINT32_MAX) {
+        throw std::length_error("document node is too large");
+    }
+}
+
+node document::makeString(std::string_view string) {
+    check_count(string.size());
+    dv::node result;
+    result.type = value_type::string;
+    result.count = string.size();
+    if (string.size() <= node::INLINE_LENGTH) {
+        std::copy(string.begin(), string.end(), result.val.inlined);
+    } else {
+        result.val.chars = copyChars(string);
+    }
+    return result;
+}
+
+node document::makeBytes(std::string_view bytes) {
+    dv::node result = makeString(bytes);
+    result.type = value_type::bytes;
+    return result;
+}
+
+node document::makeList(const node* items, size_t count) {
+    check_count(count);
+    dv::node result;
+    result.type = value_type::list;
+    result.count = count;
+    if (count) {
+        auto dst = static_cast<node*>(
+            allocate(sizeof(node) * count, alignof(node))
+        );
+        std::uninitialized_copy(items, items + count, dst);
+        result.val.items = dst;
+    }
+    return result;
+}
+
+node document::makeObject(member* members, size_t count) {
+    check_count(count);
+    std::stable_sort(
+        members, members + count, [](const member& a, const member& b) {
+            return a.key < b.key;
+        }
+    );
+    // keep the last of the repeated keys
+    size_t unique = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (unique && members[unique - 1].key == members[i].key) {
+            members[unique - 1] = members[i];
+        } else {
+            members[unique++] = members[i];
+        }
+    }
+    dv::node result;
+    result.type = value_type::object;
+    result.count = unique;
+    if (unique) {
+        auto dst = static_cast<member*>(
+            allocate(sizeof(member) * unique, alignof(member))
+        );
+        std::uninitialized_copy(members, members + unique, dst);
+        result.val.members = dst;
+    }
+    return result;
+}
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <memory>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+#include "dv.hpp"
+#include "util/span.hpp"
+
+namespace dv {
+    struct member;
+
+    /// @brief Immutable value of a document. Strings up to 8 bytes are
+    /// stored inline, other data is stored in the document arena.
+    /// Valid while the document is alive
+    class node {
+        friend class document;
+
+        value_type type = value_type::none;
+        /// @brief String or bytes length, list or object items count
+        uint32_t count = 0;
+        union {
+            integer_t integer;
+            number_t number;
+            boolean_t boolean;
+            const char* chars;
+            char inlined[sizeof(const char*)];
+            const node* items;
+            const member* members;
+        } val {};
+
+        static constexpr size_t INLINE_LENGTH = sizeof(val.inlined);
+    public:
+        inline value_type getType() const {
+            return type;
+        }
+
+        std::string_view asString() const;
+
+        /// @brief Get bytes value data as string view
+        std::string_view asBytes() const;
+
+        integer_t asInteger() const;
+
+        number_t asNumber() const;
+
+        boolean_t asBoolean() const;
+
+        /// @return list items
+        util::span<node> asList() const;
+
+        /// @return object entries sorted by key
+        util::span<member> asObject() const;
+
+        /// @return nullptr if the object has no such key
+        const node* at(std::string_view key) const;
+
+        /// @throws std::out_of_range if the object has no such key
+        const node& operator[](std::string_view key) const;
+
+        const node& operator[](size_t index) const;
+
+        bool has(std::string_view key) const {
+            return at(key) != nullptr;
+        }
+
+        size_t size() const noexcept;
+
+        /// @brief Build dv::value tree of the node
+        value toValue() const;
+
+        bool operator==(std::nullptr_t) const noexcept {
+            return type == value_type::none;
+        }
+
+        bool operator!=(std::nullptr_t) const noexcept {
+            return type != value_type::none;
+        }
+
+        inline bool isString() const noexcept {
+            return type == value_type::string;
+        }
+        inline bool isObject() const noexcept {
+            return type == value_type::object;
+        }
+        inline bool isList() const noexcept {
+            return type == value_type::list;
+        }
+        inline bool isInteger() const noexcept {
+            return type == value_type::integer;
+        }
+        inline bool isNumber() const noexcept {
+            return type == value_type::number;
+        }
+        inline bool isBoolean() const noexcept {
+            return type == value_type::boolean;
+        }
+    };
+
+    struct member {
+        /// @brief Interned key
+        std::string_view key;
+        node value;
+    };
+
+    /// @brief Read-only value tree allocated in a monotonic arena.
+    /// Object keys are interned, so equal keys are stored once.
+    /// Building a document takes few large allocations instead of
+    /// allocation per node, key and string (as dv::value does).
+    /// Use json::Reader::readDocument to parse JSON or Binary JSON
+    class document {
+        struct block {
+            std::unique_ptr<char[]> data;
+            size_t size;
+        };
+        std::vector<block> blocks;
+        size_t blockOffset = 0;
+        size_t allocated = 0;
+        std::unordered_set<std::string_view> keys;
+        node rootNode;
+
+        void* allocate(size_t size, size_t alignment);
+        const char* copyChars(std::string_view chars);
+    public:
+        document() = default;
+        document(document&&) = default;
+        document& operator=(document&&) = default;
+        document(const document&) = delete;
+
+        const node& root() const {
+            return rootNode;
+        }
+
+        /// @return total size of the arena memory blocks (bytes)
+        size_t getArenaSize() const;
+
+        /// @return number of unique keys
+        size_t getKeysCount() const {
+            return keys.size();
+        }
+
+        // Building methods. Nodes made by one document must not be used
+        // in another one
+
+        void setRoot(const node& root) {
+            rootNode = root;
+        }
+
+        /// @return key view owned by the document
+        std::string_view internKey(std::string_view key);
+
+        node makeNone() const;
+        node makeBoolean(boolean_t value) const;
+        node makeInteger(integer_t value) const;
+        node makeNumber(number_t value) const;
+        node makeString(std::string_view string);
+        node makeBytes(std::string_view bytes);
+
+        /// @brief Make list copying items into the arena
+        node makeList(const node* items, size_t count);
+
+        /// @brief Make object copying members into the arena. Keys must be
+        /// interned. If a key is repeated, the last member is kept
+        node makeObject(member* members, size_t count);
+    };
+}
@@ -3,4 +3,6 @@
 namespace dv {
     class value;
     struct optionalvalue;
+    class node;
+    class document;
 }
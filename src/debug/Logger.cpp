@@ -1,87 +1,335 @@
 #include "Logger.hpp"
 
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <ctime>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <mutex>
+#include <thread>
 #include <utility>
 
+#include "util/MpscQueue.hpp"
+
 using namespace debug;
+using namespace std::chrono;
 
-static std::ofstream file;
-static std::mutex mutex;
-static std::string utcOffset = "";
-constexpr unsigned int moduleLen = 20;
+/// @brief Max number of messages waiting to be written
+inline constexpr size_t QUEUE_CAPACITY = 8192;
+inline constexpr unsigned int moduleLen = 20;
+/// @brief Queue cells keep allocated message buffers up to this capacity
+inline constexpr size_t MESSAGE_KEEP_CAPACITY = 16 * 1024;
 
-LogMessage::~LogMessage() {
-    logger->log(level, ss.str());
-}
+#ifdef NDEBUG
+static std::atomic<LogLevel> min_level = LogLevel::info;
+#else
+static std::atomic<LogLevel> min_level = LogLevel::debug;
+#endif
+static std::atomic<size_t> dropped_total = 0;
+static std::atomic<bool> writer_destroyed = false;
 
-static void write(
-    LogLevel level, const std::string& name, const std::string& message
-) {
-    if (level == LogLevel::print) {
-        std::cout << "[" << name << "]    " << message << std::endl;
-        return;
-    }
+namespace {
+    struct LogRecord {
+        LogLevel level;
+        system_clock::time_point time;
+        std::string name;
+        std::string message;
+    };
 
-    using namespace std::chrono;
+    class LogWriter {
+        util::MpscQueue<LogRecord> queue {QUEUE_CAPACITY};
+        /// @brief Held by the consumer (writer thread or flush caller)
+        std::mutex mutex;
+        std::ofstream file;
+        std::string utcOffset;
+        time_t cachedSecond = -1;
+        std::string cachedTime;
+        std::string line;
+        std::atomic<size_t> dropped = 0;
+        std::atomic<bool> working = true;
+        /// @brief Used by the writer thread to wait for messages
+        std::mutex wakeMutex;
+        std::condition_variable wakeCond;
+        std::atomic<bool> sleeping = false;
+        std::thread thread;
 
-    std::stringstream ss;
-    switch (level) {
-        case LogLevel::print:
-        case LogLevel::debug:
-#ifdef NDEBUG
-            return;
-#endif
-            ss << "[D]";
-            break;
-        case LogLevel::info:
-            ss << "[I]";
-            break;
-        case LogLevel::warning:
-            ss << "[W]";
-            break;
-        case LogLevel::error:
-            ss << "[E]";
-            break;
-    }
-    time_t tm = std::time(nullptr);
-    auto ms =
-        duration_cast<milliseconds>(system_clock::now().time_since_epoch()) %
-        1000;
-    ss << " " << std::put_time(std::localtime(&tm), "%Y/%m/%d %T");
-    ss << '.' << std::setfill('0') << std::setw(3) << ms.count();
-    ss << utcOffset << " [" << std::setfill(' ') << std::setw(moduleLen) << name
-       << "] ";
-    ss << message;
-    {
-        std::lock_guard<std::mutex> lock(mutex);
-        auto string = ss.str();
-        if (file.good()) {
-            file << string << '\n';
+        const std::string& formatTime(time_t seconds) {
+            if (seconds != cachedSecond) {
+                std::stringstream ss;
+                ss << std::put_time(std::localtime(&seconds), "%Y/%m/%d %T");
+                cachedTime = ss.str();
+                cachedSecond = seconds;
+            }
+            return cachedTime;
+        }
+
+        void format(const LogRecord& record) {
+            line.clear();
+            if (record.level == LogLevel::print) {
+                line += '[';
+                line += record.name;
+                line += "]    ";
+                line += record.message;
+                return;
+            }
+            switch (record.level) {
+                case LogLevel::print:
+                case LogLevel::debug:
+                    line += "[D] ";
+                    break;
+                case LogLevel::info:
+                    line += "[I] ";
+                    break;
+                case LogLevel::warning:
+                    line += "[W] ";
+                    break;
+                case LogLevel::error:
+                    line += "[E] ";
+                    break;
+            }
+            auto sinceEpoch = record.time.time_since_epoch();
+            line += formatTime(duration_cast<seconds>(sinceEpoch).count());
+
+            char millis[5];
+            std::snprintf(
+                millis,
+                sizeof(millis),
+                ".%03d",
+                static_cast<int>(
+                    duration_cast<milliseconds>(sinceEpoch).count() % 1000
+                )
+            );
+            line += millis;
+            line += utcOffset;
+            line += " [";
+            if (record.name.length() < moduleLen) {
+                line.append(moduleLen - record.name.length(), ' ');
+            }
+            line += record.name;
+            line += "] ";
+            line += record.message;
+        }
+
+        void writeLine(LogLevel level) {
+            // print messages are not written to the log file
+            if (level != LogLevel::print && file.good()) {
+                file << line << '\n';
+            }
+            std::cout << line << '\n';
+        }
+
+        /// @brief Write queued messages. Mutex must be locked
+        /// @return number of written messages
+        size_t drainLocked() {
+            size_t count = 0;
+            LogLevel level;
+            while (queue.pop([this, &level](LogRecord& record) {
+                format(record);
+                level = record.level;
+                if (record.message.capacity() > MESSAGE_KEEP_CAPACITY) {
+                    record.message = {};
+                }
+            })) {
+                writeLine(level);
+                count++;
+            }
+            if (size_t lost = dropped.exchange(0)) {
+                format(LogRecord {
+                    LogLevel::warning,
+                    system_clock::now(),
+                    "logger",
+                    std::to_string(lost) + " message(s) dropped"
+                });
+                writeLine(LogLevel::warning);
+                count++;
+            }
+            if (count) {
+                file.flush();
+                std::cout.flush();
+            }
+            return count;
+        }
+
+        /// @return number of written messages
+        size_t drain() {
+            std::lock_guard lock(mutex);
+            return drainLocked();
+        }
+
+        bool hasQueued() {
+            std::lock_guard lock(mutex);
+            return !queue.empty();
+        }
+
+        /// @brief Wake up the writer thread if it is waiting for messages
+        void wake() {
+            // pairs with the fence in run(): either the writer sees the
+            // pushed message or the producer sees the sleeping flag
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (sleeping) {
+                { std::lock_guard lock(wakeMutex); }
+                wakeCond.notify_one();
+            }
+        }
+
+        void run() {
+            while (working) {
+                if (drain() > 0) {
+                    continue;
+                }
+                std::unique_lock lock(wakeMutex);
+                sleeping = true;
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                wakeCond.wait(lock, [this]() {
+                    return !working || hasQueued();
+                });
+                sleeping = false;
+            }
+        }
+    public:
+        LogWriter() {
+            thread = std::thread([this]() { run(); });
+        }
+
+        ~LogWriter() {
+            writer_destroyed = true;
+            {
+                std::lock_guard lock(wakeMutex);
+                working = false;
+            }
+            wakeCond.notify_one();
+            thread.join();
+            drain();
+        }
+
+        void open(const std::string& filename) {
+            std::lock_guard lock(mutex);
+            file.open(filename);
+
+            time_t tm = std::time(nullptr);
+            std::stringstream ss;
+            ss << std::put_time(std::localtime(&tm), "%z");
+            utcOffset = ss.str();
+        }
+
+        /// @brief Write the message and all queued before it on the calling
+        /// thread
+        void write(
+            LogLevel level, const std::string& name, const std::string& message
+        ) {
+            auto time = system_clock::now();
+            std::lock_guard lock(mutex);
+            drainLocked();
+            format(LogRecord {level, time, name, message});
+            writeLine(level);
             file.flush();
+            std::cout.flush();
+        }
+
+        void push(
+            LogLevel level, const std::string& name, const std::string& message
+        ) {
+            auto time = system_clock::now();
+            auto fill = [&](LogRecord& record) {
+                record.level = level;
+                record.time = time;
+                record.name.assign(name);
+                record.message.assign(message);
+            };
+            if (queue.push(fill)) {
+                wake();
+                return;
+            }
+            if (level < LogLevel::warning) {
+                dropped++;
+                dropped_total++;
+                return;
+            }
+            // warnings are not dropped, making the caller wait for the queue
+            while (!queue.push(fill)) {
+                drain();
+            }
+            wake();
+        }
+
+        void flush() {
+            drain();
         }
-        std::cout << string << std::endl;
+    };
+}
+
+static LogWriter& get_writer() {
+    static LogWriter writer;
+    return writer;
+}
+
+LogMessage::LogMessage(Logger* logger, LogLevel level)
+    : logger(logger), level(level) {
+    if (Logger::isEnabled(level)) {
+        ss.emplace();
     }
 }
 
-void Logger::init(const std::string& filename) {
-    file.open(filename);
+LogMessage::~LogMessage() {
+    if (ss) {
+        logger->log(level, ss->str());
+    }
+}
+
+static std::terminate_handler prev_terminate_handler = nullptr;
 
-    time_t tm = std::time(nullptr);
-    std::stringstream ss;
-    ss << std::put_time(std::localtime(&tm), "%z");
-    utcOffset = ss.str();
+static void terminate_handler() {
+    Logger::flush();
+    if (prev_terminate_handler) {
+        prev_terminate_handler();
+    }
+    std::abort();
+}
+
+void Logger::init(const std::string& filename) {
+    get_writer().open(filename);
+    auto prev = std::set_terminate(terminate_handler);
+    if (prev != terminate_handler) {
+        prev_terminate_handler = prev;
+    }
 }
 
 void Logger::flush() {
-    std::lock_guard<std::mutex> lock(mutex);
-    file.flush();
+    if (!writer_destroyed) {
+        get_writer().flush();
+    }
+}
+
+void Logger::setLevel(LogLevel level) {
+    min_level = level;
+}
+
+bool Logger::isEnabled(LogLevel level) {
+    return level == LogLevel::print || level >= min_level.load();
+}
+
+size_t Logger::getDroppedCount() {
+    return dropped_total;
 }
 
 void Logger::log(LogLevel level, std::string message) {
-    write(level, name, std::move(message));
+    if (!isEnabled(level)) {
+        return;
+    }
+    if (writer_destroyed) {
+        // logging during static destruction
+        std::cout << "[" << name << "] " << message << std::endl;
+        return;
+    }
+    if (level == LogLevel::error) {
+        // errors often precede a crash, so they are written synchronously
+        get_writer().write(level, name, message);
+    } else {
+        get_writer().push(level, name, message);
+    }
 }
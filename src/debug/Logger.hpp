@@ -1,6 +1,7 @@
 #pragma once
 
 #include <sstream>
+#include <optional>
 
 namespace debug {
     enum class LogLevel { print, debug, info, warning, error };
@@ -10,31 +11,53 @@ namespace debug {
     class LogMessage {
         Logger* logger;
         LogLevel level;
-        std::stringstream ss;
+        /// @brief Not constructed if the level is filtered out
+        std::optional<std::stringstream> ss;
     public:
-        LogMessage(Logger* logger, LogLevel level)
-            : logger(logger), level(level) {
-        }
+        LogMessage(Logger* logger, LogLevel level);
         ~LogMessage();
 
         template <class T>
         LogMessage& operator<<(const T& x) {
-            ss << x;
+            if (ss) {
+                *ss << x;
+            }
             return *this;
         }
     };
 
+    /// @brief Messages are written to the log file and stdout
+    /// asynchronously by the logger thread. Errors are written synchronously
+    /// with all messages queued before. Print messages are written to
+    /// stdout only
     class Logger {
         std::string name;
     public:
         static void init(const std::string& filename);
+
+        /// @brief Synchronously write all queued messages
+        /// (use in crash paths)
         static void flush();
 
+        /// @brief Set minimal level of messages to be written
+        /// (print messages are not filtered)
+        static void setLevel(LogLevel level);
+
+        static bool isEnabled(LogLevel level);
+
+        /// @return number of debug and info messages dropped because of
+        /// the queue overflow (warnings and errors are never dropped)
+        static size_t getDroppedCount();
+
         Logger(const std::string& name) : name(name) {
         }
 
         void log(LogLevel level, std::string message);
-        
+
+        const std::string& getName() const {
+            return name;
+        }
+
         LogMessage debug() {
             return LogMessage(this, LogLevel::debug);
         }
@@ -50,7 +73,7 @@ namespace debug {
         LogMessage warning() {
             return LogMessage(this, LogLevel::warning);
         }
-        
+
         /// @brief Print-debugging tool (printed without header)
         LogMessage print() {
             return LogMessage(this, LogLevel::print);
@@ -0,0 +1,185 @@
+#include "Profiler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <cstdio>
+#include <sstream>
+
+#include "util/stringutil.hpp"
+
+using namespace debug;
+
+std::atomic<bool> Profiler::capturing = false;
+
+namespace {
+    struct ZoneRecord {
+        const char* name;
+        int64_t start;
+        int64_t end;
+    };
+
+    /// @brief Zones of a single thread. Written only by the owner thread,
+    /// records before `size` are immutable until the next capture
+    struct ThreadBuffer {
+        uint32_t id;
+        std::string name;
+        std::unique_ptr<ZoneRecord[]> records;
+        std::atomic<size_t> size = 0;
+        std::atomic<size_t> dropped = 0;
+        std::atomic<uint32_t> session = 0;
+        std::atomic<bool> alive = true;
+    };
+
+    /// @brief Keeps the thread buffer registered while the thread is alive
+    struct ThreadBufferHolder {
+        std::shared_ptr<ThreadBuffer> buffer;
+
+        ~ThreadBufferHolder() {
+            if (buffer) {
+                buffer->alive = false;
+            }
+        }
+    };
+}
+
+static std::mutex registry_mutex;
+static std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+static uint32_t next_thread_id = 1;
+static std::atomic<uint32_t> current_session = 0;
+static int64_t session_start = 0;
+
+static ThreadBuffer& get_thread_buffer() {
+    static thread_local ThreadBufferHolder holder;
+    if (holder.buffer == nullptr) {
+        auto buffer = std::make_shared<ThreadBuffer>();
+        std::lock_guard lock(registry_mutex);
+        buffer->id = next_thread_id++;
+        buffer->name = "thread #" + std::to_string(buffer->id);
+        buffers.push_back(buffer);
+        holder.buffer = std::move(buffer);
+    }
+    return *holder.buffer;
+}
+
+int64_t Profiler::now() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(
+        steady_clock::now().time_since_epoch()
+    ).count();
+}
+
+void Profiler::start() {
+    std::lock_guard lock(registry_mutex);
+    // forget finished threads
+    buffers.erase(
+        std::remove_if(
+            buffers.begin(),
+            buffers.end(),
+            [](const auto& buffer) { return !buffer->alive; }
+        ),
+        buffers.end()
+    );
+    session_start = now();
+    current_session++;
+    capturing = true;
+}
+
+void Profiler::stop() {
+    capturing = false;
+}
+
+void Profiler::setThreadName(std::string name) {
+    auto& buffer = get_thread_buffer();
+    std::lock_guard lock(registry_mutex);
+    buffer.name = std::move(name);
+}
+
+void Profiler::addZone(const char* name, int64_t start, int64_t end) {
+    auto& buffer = get_thread_buffer();
+    uint32_t current = current_session.load(std::memory_order_relaxed);
+    if (buffer.session.load(std::memory_order_relaxed) != current) {
+        // first zone of the thread in this capture
+        if (buffer.records == nullptr) {
+            buffer.records = std::make_unique<ZoneRecord[]>(
+                THREAD_BUFFER_CAPACITY
+            );
+        }
+        buffer.size.store(0, std::memory_order_relaxed);
+        buffer.dropped.store(0, std::memory_order_relaxed);
+        buffer.session.store(current, std::memory_order_release);
+    }
+    size_t size = buffer.size.load(std::memory_order_relaxed);
+    if (size == THREAD_BUFFER_CAPACITY) {
+        buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    buffer.records[size] = {name, start, end};
+    buffer.size.store(size + 1, std::memory_order_release);
+}
+
+template <typename Func>
+static void visit_captured(const Func& func) {
+    uint32_t current = current_session.load();
+    for (const auto& buffer : buffers) {
+        if (buffer->session.load(std::memory_order_acquire) == current) {
+            func(*buffer, buffer->size.load(std::memory_order_acquire));
+        }
+    }
+}
+
+size_t Profiler::getZonesCount() {
+    std::lock_guard lock(registry_mutex);
+    size_t count = 0;
+    visit_captured([&count](const ThreadBuffer&, size_t size) {
+        count += size;
+    });
+    return count;
+}
+
+size_t Profiler::getDroppedCount() {
+    std::lock_guard lock(registry_mutex);
+    size_t count = 0;
+    visit_captured([&count](const ThreadBuffer& buffer, size_t) {
+        count += buffer.dropped.load(std::memory_order_relaxed);
+    });
+    return count;
+}
+
+static void write_microseconds(std::stringstream& ss, int64_t nanoseconds) {
+    char buffer[32];
+    std::snprintf(
+        buffer, sizeof(buffer), "%.3f", static_cast<double>(nanoseconds) / 1e3
+    );
+    ss << buffer;
+}
+
+std::string Profiler::exportChromeTrace() {
+    std::lock_guard lock(registry_mutex);
+    std::stringstream ss;
+    ss << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    visit_captured([&](const ThreadBuffer& buffer, size_t size) {
+        if (!first) {
+            ss << ',';
+        }
+        first = false;
+        ss << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+           << buffer.id << ",\"args\":{\"name\":"
+           << util::escape(buffer.name) << "}}";
+        for (size_t i = 0; i < size; i++) {
+            const auto& record = buffer.records[i];
+            ss << ",\n{\"name\":" << util::escape(record.name)
+               << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer.id
+               << ",\"ts\":";
+            write_microseconds(ss, record.start - session_start);
+            ss << ",\"dur\":";
+            write_microseconds(ss, record.end - record.start);
+            ss << '}';
+        }
+    });
+    ss << "\n]}\n";
+    return ss.str();
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <cstdint>
+
+namespace debug {
+    /// @brief Low-overhead scopes profiler.
+    /// Each thread writes completed zones to its own fixed-size buffer
+    /// without locks. Zones are ignored while capture is not started
+    /// (single relaxed atomic load per zone).
+    class Profiler {
+    public:
+        /// @brief Max number of zones stored per thread during a capture
+        static constexpr size_t THREAD_BUFFER_CAPACITY = 256 * 1024;
+
+        /// @brief Start new capture, discarding previous results
+        static void start();
+
+        /// @brief Stop capture. Results are kept until the next start
+        static void stop();
+
+        static bool isCapturing() {
+            return capturing.load(std::memory_order_relaxed);
+        }
+
+        /// @brief Set name of the current thread shown in exported traces
+        static void setThreadName(std::string name);
+
+        /// @brief Export captured zones in Chrome trace event format
+        /// (chrome://tracing, Perfetto)
+        static std::string exportChromeTrace();
+
+        /// @return number of zones captured in the last capture
+        static size_t getZonesCount();
+
+        /// @return number of zones not stored because of the thread
+        /// buffers overflow
+        static size_t getDroppedCount();
+
+        /// @return monotonic time in nanoseconds
+        static int64_t now();
+
+        /// @brief Store completed zone of the current thread
+        /// @param name zone name (must have static storage duration)
+        static void addZone(const char* name, int64_t start, int64_t end);
+    private:
+        static std::atomic<bool> capturing;
+    };
+
+    /// @brief Profiler zone for the current scope
+    class ProfilerZone {
+        const char* name;
+        int64_t start = 0;
+        bool active;
+    public:
+        /// @param name zone name (must have static storage duration)
+        ProfilerZone(const char* name) : name(name) {
+            active = Profiler::isCapturing();
+            if (active) {
+                start = Profiler::now();
+            }
+        }
+
+        ~ProfilerZone() {
+            if (active) {
+                Profiler::addZone(name, start, Profiler::now());
+            }
+        }
+
+        ProfilerZone(const ProfilerZone&) = delete;
+        ProfilerZone& operator=(const ProfilerZone&) = delete;
+    };
+}
+
+#define VC_PROFILE_CONCAT_IMPL(A, B) A##B
+#define VC_PROFILE_CONCAT(A, B) VC_PROFILE_CONCAT_IMPL(A, B)
+
+/// @brief Profile the current scope with the given zone name
+#define VC_PROFILE_SCOPE(NAME) \
+    debug::ProfilerZone VC_PROFILE_CONCAT(__profilerZone, __LINE__)(NAME)
@@ -1,48 +1,52 @@
 #include "SyntaxProcessor.hpp"
 
+#include <algorithm>
+
 #include "coders/commons.hpp"
 #include "coders/syntax_parser.hpp"
 #include "graphics/core/Font.hpp"
 
 using namespace devtools;
 
-static std::unique_ptr<FontStylesScheme> build_styles(
-    const FontStylesScheme& colorScheme,
-    const std::vector<devtools::Token>& tokens
-) {
+static SyntaxStyles get_token_style(devtools::TokenTag tag) {
     using devtools::TokenTag;
+    switch (tag) {
+        case TokenTag::KEYWORD: return SyntaxStyles::KEYWORD;
+        case TokenTag::STRING:
+        case TokenTag::INTEGER:
+        case TokenTag::NUMBER: return SyntaxStyles::LITERAL;
+        case TokenTag::COMMENT: return SyntaxStyles::COMMENT;
+        case TokenTag::UNEXPECTED: return SyntaxStyles::ERROR;
+        default:
+            return SyntaxStyles::DEFAULT;
+    }
+}
+
+static FontStylesScheme create_styles(const FontStylesScheme& colorScheme) {
     FontStylesScheme styles {colorScheme.palette, {}};
     if (styles.palette.empty()) {
         styles.palette.push_back(FontStyle {
             false, false, false, false, glm::vec4(0.8f, 0.8f, 0.8f, 1)});
     }
+    return styles;
+}
+
+static std::unique_ptr<FontStylesScheme> build_styles(
+    const FontStylesScheme& colorScheme,
+    const std::vector<devtools::Token>& tokens
+) {
+    auto styles = create_styles(colorScheme);
     size_t offset = 0;
     for (int i = 0; i < tokens.size(); i++) {
         const auto& token = tokens.at(i);
-        if (token.tag != TokenTag::KEYWORD &&
-            token.tag != TokenTag::STRING &&
-            token.tag != TokenTag::INTEGER &&
-            token.tag != TokenTag::NUMBER &&
-            token.tag != TokenTag::COMMENT &&
-            token.tag != TokenTag::UNEXPECTED) {
+        int styleIndex = get_token_style(token.tag);
+        if (styleIndex == SyntaxStyles::DEFAULT) {
             continue;
         }
         if (token.start.pos > offset) {
             styles.map.insert(styles.map.end(), token.start.pos - offset, 0);
         }
         offset = token.end.pos;
-        int styleIndex;
-        switch (token.tag) {
-            case TokenTag::KEYWORD: styleIndex = SyntaxStyles::KEYWORD; break;
-            case TokenTag::STRING:
-            case TokenTag::INTEGER:
-            case TokenTag::NUMBER: styleIndex = SyntaxStyles::LITERAL; break;
-            case TokenTag::COMMENT: styleIndex = SyntaxStyles::COMMENT; break;
-            case TokenTag::UNEXPECTED: styleIndex = SyntaxStyles::ERROR; break;
-            default:
-                styleIndex = 0;
-                break;
-        }
         if (styleIndex >= styles.palette.size()) {
             styleIndex = 0;
         }
@@ -54,6 +58,171 @@ static std::unique_ptr<FontStylesScheme> build_styles(
     return std::make_unique<FontStylesScheme>(std::move(styles));
 }
 
+static bool ends_with(
+    std::wstring_view source, size_t start, size_t end, std::wstring_view suffix
+) {
+    return end - start >= suffix.length() &&
+           source.substr(end - suffix.length(), suffix.length()) == suffix;
+}
+
+SyntaxHighlighting::SyntaxHighlighting(const Syntax& syntax) : syntax(syntax) {
+}
+
+void SyntaxHighlighting::reset(std::wstring_view source) {
+    lines.clear();
+    lines.push_back(Line {0, LineMode::CODE});
+    for (size_t i = 0; i < source.length(); i++) {
+        if (source[i] == L'\n') {
+            lines.push_back(Line {i + 1, LineMode::UNKNOWN});
+        }
+    }
+    styles.assign(source.length(), SyntaxStyles::DEFAULT);
+    for (size_t i = 0; i < lines.size(); i++) {
+        auto mode = tokenizeLine(source, i);
+        if (i + 1 < lines.size()) {
+            lines[i + 1].mode = mode;
+        }
+    }
+    tokenizedLines = lines.size();
+}
+
+void SyntaxHighlighting::update(
+    std::wstring_view source, size_t position, size_t erased, size_t inserted
+) {
+    if (lines.empty() || position > styles.size() ||
+        erased > styles.size() - position ||
+        styles.size() - erased + inserted != source.length()) {
+        // text has been replaced
+        reset(source);
+        return;
+    }
+    size_t first = getLineAt(position);
+    size_t last = getLineAt(position + erased);
+
+    std::vector<Line> added;
+    for (size_t i = position; i < position + inserted; i++) {
+        if (source[i] == L'\n') {
+            added.push_back(Line {i + 1, LineMode::UNKNOWN});
+        }
+    }
+    for (size_t i = last + 1; i < lines.size(); i++) {
+        lines[i].start = lines[i].start - erased + inserted;
+    }
+    lines.erase(lines.begin() + first + 1, lines.begin() + last + 1);
+    lines.insert(lines.begin() + first + 1, added.begin(), added.end());
+
+    styles.erase(styles.begin() + position, styles.begin() + position + erased);
+    styles.insert(styles.begin() + position, inserted, SyntaxStyles::DEFAULT);
+
+    size_t damagedEnd = first + added.size();
+    tokenizedLines = 0;
+    for (size_t i = first; i < lines.size(); i++) {
+        auto mode = tokenizeLine(source, i);
+        tokenizedLines++;
+        if (i + 1 == lines.size() ||
+            (i >= damagedEnd && lines[i + 1].mode == mode)) {
+            break;
+        }
+        lines[i + 1].mode = mode;
+    }
+}
+
+std::unique_ptr<FontStylesScheme> SyntaxHighlighting::build(
+    const FontStylesScheme& colorScheme
+) const {
+    auto scheme = create_styles(colorScheme);
+    scheme.map.reserve(styles.size() + 1);
+    scheme.map.assign(styles.begin(), styles.end());
+    if (scheme.palette.size() <= SyntaxStyles::ERROR) {
+        for (auto& index : scheme.map) {
+            if (index >= scheme.palette.size()) {
+                index = 0;
+            }
+        }
+    }
+    scheme.map.push_back(0);
+    return std::make_unique<FontStylesScheme>(std::move(scheme));
+}
+
+size_t SyntaxHighlighting::getLineAt(size_t position) const {
+    auto found = std::upper_bound(
+        lines.begin(), lines.end(), position, [](size_t pos, const Line& line) {
+            return pos < line.start;
+        }
+    );
+    return found - lines.begin() - 1;
+}
+
+SyntaxHighlighting::LineMode SyntaxHighlighting::tokenizeLine(
+    std::wstring_view source, size_t index
+) {
+    size_t start = lines[index].start;
+    size_t end = index + 1 < lines.size() ? lines[index + 1].start
+                                          : source.length();
+    // line break is included as tokenizer expects it after some tokens
+    auto line = source.substr(start, end - start);
+    auto dst = styles.data() + start;
+    std::fill(dst, dst + line.length(), SyntaxStyles::DEFAULT);
+
+    auto mode = lines[index].mode;
+    size_t offset = 0;
+    if (mode == LineMode::COMMENT || mode == LineMode::STRING) {
+        // continuation of multiline token
+        const auto& endMarker = mode == LineMode::COMMENT
+                                    ? syntax.multilineCommentEnd
+                                    : syntax.multilineStringEnd;
+        auto style = mode == LineMode::COMMENT ? SyntaxStyles::COMMENT
+                                               : SyntaxStyles::LITERAL;
+        size_t found = line.find(endMarker);
+        if (found == std::wstring::npos) {
+            std::fill(dst, dst + line.length(), style);
+            return mode;
+        }
+        offset = found + endMarker.length();
+        std::fill(dst, dst + offset, style);
+    }
+    auto code = line.substr(offset);
+    try {
+        auto tokens = tokenize(syntax, "<string>", code);
+        for (const auto& token : tokens) {
+            auto style = get_token_style(token.tag);
+            if (style != SyntaxStyles::DEFAULT) {
+                std::fill(
+                    dst + offset + token.start.pos,
+                    dst + offset + token.end.pos,
+                    style
+                );
+            }
+        }
+        if (tokens.empty()) {
+            return LineMode::CODE;
+        }
+        // check if the line ends with not closed multiline token
+        const auto& token = tokens.back();
+        size_t tokenStart = token.start.pos;
+        size_t tokenEnd = token.end.pos;
+        const auto& commentStart = syntax.multilineCommentStart;
+        const auto& stringStart = syntax.multilineStringStart;
+        if (token.tag == TokenTag::COMMENT && !commentStart.empty() &&
+            code.substr(tokenStart, commentStart.length()) == commentStart &&
+            !ends_with(code, tokenStart, tokenEnd, syntax.multilineCommentEnd)) {
+            return LineMode::COMMENT;
+        }
+        if (token.tag == TokenTag::STRING && !stringStart.empty() &&
+            code.substr(tokenStart, stringStart.length()) == stringStart &&
+            !ends_with(
+                code,
+                tokenStart + stringStart.length(),
+                tokenEnd,
+                syntax.multilineStringEnd
+            )) {
+            return LineMode::STRING;
+        }
+    } catch (const parsing_error& err) {
+    }
+    return LineMode::CODE;
+}
+
 void SyntaxProcessor::addSyntax(
     std::unique_ptr<Syntax> syntax
 ) {
@@ -82,3 +251,13 @@ std::unique_ptr<FontStylesScheme> SyntaxProcessor::highlight(
         return nullptr;
     }
 }
+
+std::unique_ptr<SyntaxHighlighting> SyntaxProcessor::createHighlighting(
+    const std::string& ext
+) const {
+    const auto& found = langsExtensions.find(ext);
+    if (found == langsExtensions.end()) {
+        return nullptr;
+    }
+    return std::make_unique<SyntaxHighlighting>(*found->second);
+}
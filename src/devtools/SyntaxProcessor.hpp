@@ -15,6 +15,64 @@ namespace devtools {
         DEFAULT, KEYWORD, LITERAL, COMMENT, ERROR
     };
 
+    /// @brief Syntax highlighting of a text updated incrementally.
+    /// Text is tokenized line by line, so only lines damaged by an edit
+    /// are tokenized again. Following lines are tokenized too while the
+    /// multiline comment/string state at their start changes.
+    class SyntaxHighlighting {
+    public:
+        SyntaxHighlighting(const Syntax& syntax);
+
+        /// @brief Highlight the whole text
+        void reset(std::wstring_view source);
+
+        /// @brief Update highlighting after the text is edited
+        /// @param source text after the edit
+        /// @param position edit position
+        /// @param erased number of characters removed at the position
+        /// @param inserted number of characters inserted at the position
+        void update(
+            std::wstring_view source,
+            size_t position,
+            size_t erased,
+            size_t inserted
+        );
+
+        /// @brief Build styles for the text
+        std::unique_ptr<FontStylesScheme> build(
+            const FontStylesScheme& colorScheme
+        ) const;
+
+        size_t getLinesCount() const {
+            return lines.size();
+        }
+
+        /// @brief Get number of lines tokenized by the last reset or update
+        size_t getTokenizedLines() const {
+            return tokenizedLines;
+        }
+    private:
+        enum class LineMode : unsigned char {
+            CODE, COMMENT, STRING, UNKNOWN
+        };
+        struct Line {
+            size_t start;
+            /// @brief Tokenizer state at the line start
+            LineMode mode;
+        };
+        const Syntax& syntax;
+        std::vector<Line> lines;
+        /// @brief SyntaxStyles value per character
+        std::vector<unsigned char> styles;
+        size_t tokenizedLines = 0;
+
+        size_t getLineAt(size_t position) const;
+
+        /// @brief Tokenize line and write its characters styles
+        /// @return tokenizer state at the next line start
+        LineMode tokenizeLine(std::wstring_view source, size_t index);
+    };
+
     class SyntaxProcessor {
     public:
         std::unique_ptr<FontStylesScheme> highlight(
@@ -23,6 +81,13 @@ namespace devtools {
             std::wstring_view source
         ) const;
 
+        /// @brief Create incremental highlighting for a text
+        /// @param ext file extension defining the syntax
+        /// @return nullptr if no syntax found for the extension
+        std::unique_ptr<SyntaxHighlighting> createHighlighting(
+            const std::string& ext
+        ) const;
+
         void addSyntax(std::unique_ptr<Syntax> syntax);
     private:
         std::vector<std::unique_ptr<Syntax>> langs;
@@ -79,6 +79,12 @@ void AssetsManagement::loadAssets(Content* content) {
     }
     assets->setup();
     engine.getGUI().onAssetsLoad(assets.get());
+
+    auto pathsStats = paths.resPaths.getStats();
+    logger.info() << "assets loaded, total resources lookups: "
+                  << pathsStats.lookups << ", device queries: "
+                  << pathsStats.queries << " (" << pathsStats.legacyQueries
+                  << " without index)";
 }
 
 void AssetsManagement::update() {
@@ -13,6 +13,7 @@
 #include "content/ContentControl.hpp"
 #include "core_defs.hpp"
 #include "debug/Logger.hpp"
+#include "debug/Profiler.hpp"
 #include "devtools/DebuggingServer.hpp"
 #include "devtools/Editor.hpp"
 #include "devtools/Project.hpp"
@@ -34,6 +35,7 @@
 #include "Mainloop.hpp"
 #include "network/Network.hpp"
 #include "ServerMainloop.hpp"
+#include "TickScheduler.hpp"
 #include "util/platform.hpp"
 #include "util/stringutil.hpp"
 #include "window/input.hpp"
@@ -129,6 +131,7 @@ void Engine::initialize(CoreParameters coreParameters) {
     logger.info() << "engine version: " << ENGINE_VERSION_STRING;
     if (params.headless) {
         logger.info() << "engine runs in headless mode";
+        tickScheduler = std::make_unique<TickScheduler>(params.tps);
     }
     if (params.projectFolder.empty()) {
         params.projectFolder = params.resFolder;
@@ -239,6 +242,7 @@ void Engine::updateHotkeys() {
 }
 
 void Engine::run() {
+    debug::Profiler::setThreadName("main");
     if (params.headless) {
         ServerMainloop(*this).run();
     } else {
@@ -269,6 +273,7 @@ void Engine::applicationTick() {
 }
 
 void Engine::updateFrontend() {
+    VC_PROFILE_SCOPE("Engine::updateFrontend");
     double delta = time.getDelta();
     assets->update();
     updateHotkeys();
@@ -306,9 +311,14 @@ void Engine::startPauseLoop() {
     if (initialCursorLocked) {
         input->toggleCursor();
     }
+    if (tickScheduler) {
+        // do not catch up ticks missed while paused
+        tickScheduler->reset(TickScheduler::clock::now());
+    }
 }
 
 void Engine::renderFrame() {
+    VC_PROFILE_SCOPE("Engine::renderFrame");
     if (input->isCursorLocked() != (gui->getActiveFrame() == nullptr)) {
         input->toggleCursor();
     }
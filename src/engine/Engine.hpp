@@ -20,6 +20,7 @@ class Level;
 class ResPaths;
 class Screen;
 class SettingsHandler;
+class TickScheduler;
 class Window;
 class WindowControl;
 struct Project;
@@ -66,6 +67,7 @@ class Engine : public util::ObjectsKeeper {
     std::unique_ptr<devtools::Editor> editor;
     std::unique_ptr<devtools::DebuggingServer> debuggingServer;
     std::unique_ptr<WindowControl> windowControl;
+    std::unique_ptr<TickScheduler> tickScheduler;
     PostRunnables postRunnables;
     Time time;
     OnWorldOpen levelConsumer;
@@ -184,5 +186,10 @@ public:
         return debuggingServer.get();
     }
 
+    /// @brief Get server ticks scheduler (headless mode only)
+    TickScheduler* getTickScheduler() {
+        return tickScheduler.get();
+    }
+
     void detachDebugger();
 };
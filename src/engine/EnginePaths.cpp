@@ -4,6 +4,7 @@
 #include "io/devices/StdfsDevice.hpp"
 #include "io/devices/MemoryDevice.hpp"
 #include "io/devices/ZipFileDevice.hpp"
+#include "io/mapped_file.hpp"
 #include "maths/util.hpp"
 #include "typedefs.hpp"
 #include "devtools/Project.hpp"
@@ -156,10 +157,19 @@ void EnginePaths::setCurrentWorldFolder(io::path folder) {
 
 std::string EnginePaths::mount(const io::path& file) {
     if (file.extension() == ".zip") {
-        auto stream = io::read(file);
-        auto device = std::make_unique<io::ZipFileDevice>(
-            std::move(stream), [file]() { return io::read(file); }
-        );
+        std::unique_ptr<io::ZipFileDevice> device;
+        try {
+            device = std::make_unique<io::ZipFileDevice>(
+                std::make_shared<io::mapped_file>(io::resolve(file))
+            );
+        } catch (const std::exception& err) {
+            // file is not located in the filesystem or could not be mapped
+            logger.debug() << "reading " << file.string() << " to memory: "
+                           << err.what();
+            device = std::make_unique<io::ZipFileDevice>(
+                io::read_bytes_buffer(file)
+            );
+        }
         std::string name;
         do {
             name = std::string("M.") + generate_random_base64<6>();
@@ -268,116 +278,3 @@ std::tuple<std::string, std::string> EnginePaths::parsePath(std::string_view pat
     auto filename = std::string(path.substr(separator + 1));
     return {prefix, filename};
 }
-
-ResPaths::ResPaths(std::vector<PathsRoot> roots)
-    : roots(std::move(roots)) {
-}
-
-io::path ResPaths::find(const std::string& filename) const {
-    if (filename.find(':') != std::string::npos) {
-        return filename;
-    }
-    for (int i = roots.size() - 1; i >= 0; i--) {
-        auto& root = roots[i];
-        auto file = root.path / filename;
-        if (io::exists(file)) {
-            return file;
-        }
-    }
-    return io::path("res:") / filename;
-}
-
-std::string ResPaths::findRaw(const std::string& filename) const {
-    for (int i = roots.size() - 1; i >= 0; i--) {
-        auto& root = roots[i];
-        if (io::exists(root.path / filename)) {
-            return root.name + ":" + filename;
-        }
-    }
-    throw std::runtime_error("could not to find file " + util::quote(filename));
-}
-
-std::vector<std::string> ResPaths::listdirRaw(const std::string& folderName) const {
-    std::vector<std::string> entries;
-    for (int i = roots.size() - 1; i >= 0; i--) {
-        auto& root = roots[i];
-        auto folder = root.path / folderName;
-        if (!io::is_directory(folder)) continue;
-        for (const auto& file : io::directory_iterator(folder)) {
-            entries.emplace_back(root.name + ":" + folderName + "/" + file.name());
-        }
-    }
-    return entries;
-}
-
-std::vector<io::path> ResPaths::listdir(
-    const std::string& folderName
-) const {
-    std::vector<io::path> entries;
-    for (int i = roots.size() - 1; i >= 0; i--) {
-        auto& root = roots[i];
-        io::path folder = root.path / folderName;
-        if (!io::is_directory(folder)) continue;
-        for (const auto& entry : io::directory_iterator(folder)) {
-            entries.push_back(entry);
-        }
-    }
-    return entries;
-}
-
-dv::value ResPaths::readCombinedList(const std::string& filename) const {
-    dv::value list = dv::list();
-    for (const auto& root : roots) {
-        auto path = root.path / filename;
-        if (!io::exists(path)) {
-            continue;
-        }
-        try {
-            auto value = io::read_object(path);
-            if (!value.isList()) {
-                logger.warning() << "reading combined list " << root.name << ":"
-                    << filename << " is not a list (skipped)";
-                continue;
-            }
-            for (const auto& elem : value) {
-                list.add(elem);
-            }
-        } catch (const std::runtime_error& err) {
-            logger.warning() << "reading combined list " << root.name << ":" 
-                << filename << ": " << err.what();
-        }
-    }
-    return list;
-}
-
-dv::value ResPaths::readCombinedObject(const std::string& filename, bool deep) const {
-    dv::value object = dv::object();
-    for (const auto& root : roots) {
-        auto path = root.path / filename;
-        if (!io::exists(path)) {
-            continue;
-        }
-        try {
-            auto value = io::read_object(path);
-            if (!value.isObject()) {
-                logger.warning()
-                    << "reading combined object " << root.name << ": "
-                    << filename << " is not an object (skipped)";
-            }
-            object.merge(std::move(value), deep);
-        } catch (const std::runtime_error& err) {
-            logger.warning() << "reading combined object " << root.name << ":"
-                             << filename << ": " << err.what();
-        }
-    }
-    return object;
-}
-
-std::vector<io::path> ResPaths::collectRoots() {
-    std::vector<io::path> collected;
-    collected.reserve(roots.size());
-    for (const auto& root : roots) {
-        collected.emplace_back(root.path);
-    }
-    return collected;
-}
@@ -3,6 +3,7 @@
 #include "io/io.hpp"
 #include "data/dv.hpp"
 #include "CoreParameters.hpp"
+#include "ResPaths.hpp"
 
 #include <unordered_map>
 #include <optional>
@@ -11,38 +12,6 @@
 #include <tuple>
 #include <set>
 
-struct PathsRoot {
-    std::string name;
-    io::path path;
-
-    PathsRoot(std::string name, io::path path)
-        : name(std::move(name)), path(std::move(path)) {
-    }
-};
-
-class ResPaths {
-public:
-    ResPaths() = default;
-
-    ResPaths(std::vector<PathsRoot> roots);
-
-    io::path find(const std::string& filename) const;
-    std::string findRaw(const std::string& filename) const;
-    std::vector<io::path> listdir(const std::string& folder) const;
-    std::vector<std::string> listdirRaw(const std::string& folder) const;
-
-    /// @brief Read all found list versions from all packs and combine into a
-    /// single list. Invalid versions will be skipped with logging a warning
-    /// @param file *.json file path relative to entry point 
-    dv::value readCombinedList(const std::string& file) const;
-
-    dv::value readCombinedObject(const std::string& file, bool deep=false) const;
-
-    std::vector<io::path> collectRoots();
-private:
-    std::vector<PathsRoot> roots;
-};
-
 struct Project;
 
 class EnginePaths {
@@ -0,0 +1,407 @@
+#include "ResPaths.hpp"
+
+#include "debug/Logger.hpp"
+#include "util/stringutil.hpp"
+#include "util/timeutil.hpp"
+
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+static debug::Logger logger("res-paths");
+
+struct ResPaths::Index {
+    struct Source {
+        size_t root;
+        bool directory;
+        /// @brief Directory entries names in the device listing order
+        std::vector<std::string> children;
+    };
+    /// @brief Sources of every relative path ordered by root index.
+    /// Root directories are stored with empty key
+    std::unordered_map<std::string, std::vector<Source>> entries;
+
+    const std::vector<Source>* find(const std::string& key) const {
+        const auto& found = entries.find(key);
+        if (found == entries.end()) {
+            return nullptr;
+        }
+        return &found->second;
+    }
+
+    const Source* find(const std::string& key, size_t root) const {
+        if (auto sources = find(key)) {
+            for (const auto& source : *sources) {
+                if (source.root == root) {
+                    return &source;
+                }
+            }
+        }
+        return nullptr;
+    }
+};
+
+/// @brief Convert the key to lower case if paths are case-insensitive,
+/// so lookups give the same results as the file system queries
+static void fold_case(std::string& key) {
+    if constexpr (!ResPaths::CASE_SENSITIVE) {
+        for (auto& c : key) {
+            if (c >= 'A' && c <= 'Z') {
+                c += 'a' - 'A';
+            }
+        }
+    }
+}
+
+/// @brief Convert relative path to the index key ('a/./b//c/' -> 'a/b/c')
+/// @return false if path leaves the root
+static bool make_key(std::string_view filename, std::string& key) {
+    key.clear();
+    size_t start = 0;
+    while (start <= filename.length()) {
+        size_t end = filename.find_first_of("/\\", start);
+        if (end == std::string_view::npos) {
+            end = filename.length();
+        }
+        auto part = filename.substr(start, end - start);
+        start = end + 1;
+        if (part.empty() || part == ".") {
+            continue;
+        }
+        if (part == "..") {
+            if (key.empty()) {
+                return false;
+            }
+            size_t slash = key.rfind('/');
+            key.resize(slash == std::string::npos ? 0 : slash);
+            continue;
+        }
+        if (!key.empty()) {
+            key += '/';
+        }
+        key += part;
+    }
+    fold_case(key);
+    return true;
+}
+
+ResPaths::ResPaths() : state(std::make_shared<State>()) {
+}
+
+ResPaths::ResPaths(std::vector<PathsRoot> roots)
+    : roots(std::move(roots)), state(std::make_shared<State>()) {
+}
+
+std::shared_ptr<const ResPaths::Index> ResPaths::getIndex() const {
+    std::lock_guard lock(state->mutex);
+    if (state->index) {
+        return state->index;
+    }
+    timeutil::Timer timer;
+    auto index = std::make_shared<Index>();
+    size_t queries = 0;
+    for (size_t i = 0; i < roots.size(); i++) {
+        const auto& root = roots[i];
+        try {
+            queries++;
+            if (!io::is_directory(root.path)) {
+                continue;
+            }
+            std::vector<std::string> folders {""};
+            index->entries[""].push_back({i, true, {}});
+            while (!folders.empty()) {
+                auto key = std::move(folders.back());
+                folders.pop_back();
+
+                std::vector<std::string> children;
+                io::path folder = key.empty() ? root.path : root.path / key;
+                queries++;
+                for (const auto& file : io::directory_iterator(folder)) {
+                    auto name = file.name();
+                    auto childKey = key.empty() ? name : key + "/" + name;
+                    fold_case(childKey);
+                    queries++;
+                    bool directory = io::is_directory(file);
+                    index->entries[childKey].push_back({i, directory, {}});
+                    if (directory) {
+                        folders.push_back(childKey);
+                    }
+                    children.push_back(std::move(name));
+                }
+                index->entries[key].back().children = std::move(children);
+            }
+        } catch (const std::exception& err) {
+            logger.warning() << "could not to index " << root.name << " ("
+                             << root.path.string() << "): " << err.what();
+        }
+    }
+    state->queries += queries;
+    logger.info() << "indexed " << roots.size() << " root(s): "
+                  << index->entries.size() << " entries in "
+                  << timer.stop() / 1000 << " ms (" << queries << " queries)";
+    state->index = index;
+    return index;
+}
+
+void ResPaths::countLookup(size_t legacyQueries) const {
+    state->lookups++;
+    state->legacyQueries += legacyQueries;
+}
+
+int ResPaths::findRoot(const io::path& path, std::string& relative) const {
+    const auto& str = path.string();
+    for (int i = roots.size() - 1; i >= 0; i--) {
+        const auto& prefix = roots[i].path.string();
+        if (prefix.empty() || str.compare(0, prefix.length(), prefix) != 0) {
+            continue;
+        }
+        auto rest = std::string_view(str).substr(prefix.length());
+        if (prefix.back() == ':' || rest.empty()) {
+            relative = rest;
+            return i;
+        }
+        if (rest[0] == '/') {
+            relative = rest.substr(1);
+            return i;
+        }
+    }
+    return -1;
+}
+
+io::path ResPaths::find(const std::string& filename) const {
+    if (filename.find(':') != std::string::npos) {
+        return filename;
+    }
+    auto index = getIndex();
+    std::string key;
+    if (make_key(filename, key)) {
+        if (auto sources = index->find(key)) {
+            size_t root = sources->back().root;
+            countLookup(roots.size() - root);
+            return roots[root].path / filename;
+        }
+    }
+    countLookup(roots.size());
+    return io::path("res:") / filename;
+}
+
+std::string ResPaths::findRaw(const std::string& filename) const {
+    auto index = getIndex();
+    std::string key;
+    if (make_key(filename, key)) {
+        if (auto sources = index->find(key)) {
+            size_t root = sources->back().root;
+            countLookup(roots.size() - root);
+            return roots[root].name + ":" + filename;
+        }
+    }
+    countLookup(roots.size());
+    throw std::runtime_error("could not to find file " + util::quote(filename));
+}
+
+bool ResPaths::exists(const std::string& filename) const {
+    if (filename.find(':') != std::string::npos) {
+        state->queries++;
+        countLookup(1);
+        return io::exists(filename);
+    }
+    auto index = getIndex();
+    std::string key;
+    if (make_key(filename, key)) {
+        if (auto sources = index->find(key)) {
+            countLookup(roots.size() - sources->back().root);
+            return true;
+        }
+    }
+    countLookup(roots.size());
+    return false;
+}
+
+std::vector<std::string> ResPaths::listdirRaw(const std::string& folderName) const {
+    auto index = getIndex();
+    std::vector<std::string> entries;
+    size_t queries = roots.size();
+    std::string key;
+    const std::vector<Index::Source>* sources = nullptr;
+    if (make_key(folderName, key)) {
+        sources = index->find(key);
+    }
+    if (sources) {
+        for (auto it = sources->rbegin(); it != sources->rend(); ++it) {
+            if (!it->directory) continue;
+            queries++;
+            const auto& root = roots[it->root];
+            for (const auto& name : it->children) {
+                entries.emplace_back(root.name + ":" + folderName + "/" + name);
+            }
+        }
+    }
+    countLookup(queries);
+    return entries;
+}
+
+std::vector<io::path> ResPaths::listdir(
+    const std::string& folderName
+) const {
+    auto index = getIndex();
+    std::vector<io::path> entries;
+    size_t queries = roots.size();
+    std::string key;
+    const std::vector<Index::Source>* sources = nullptr;
+    if (make_key(folderName, key)) {
+        sources = index->find(key);
+    }
+    if (sources) {
+        for (auto it = sources->rbegin(); it != sources->rend(); ++it) {
+            if (!it->directory) continue;
+            queries++;
+            io::path folder = roots[it->root].path / folderName;
+            for (const auto& name : it->children) {
+                entries.push_back(folder / name);
+            }
+        }
+    }
+    countLookup(queries);
+    return entries;
+}
+
+bool ResPaths::isDirectory(const io::path& path) const {
+    std::string relative, key;
+    int root = findRoot(path, relative);
+    if (root == -1 || !make_key(relative, key)) {
+        state->queries++;
+        countLookup(1);
+        return io::is_directory(path);
+    }
+    auto source = getIndex()->find(key, root);
+    countLookup(1);
+    return source && source->directory;
+}
+
+bool ResPaths::isFile(const io::path& path) const {
+    std::string relative, key;
+    int root = findRoot(path, relative);
+    if (root == -1 || !make_key(relative, key)) {
+        state->queries++;
+        countLookup(1);
+        return io::is_regular_file(path);
+    }
+    auto source = getIndex()->find(key, root);
+    countLookup(1);
+    return source && !source->directory;
+}
+
+std::vector<io::path> ResPaths::list(const io::path& folder) const {
+    std::vector<io::path> entries;
+    std::string relative, key;
+    int root = findRoot(folder, relative);
+    if (root == -1 || !make_key(relative, key)) {
+        state->queries++;
+        countLookup(1);
+        for (const auto& file : io::directory_iterator(folder)) {
+            entries.push_back(file);
+        }
+        return entries;
+    }
+    auto source = getIndex()->find(key, root);
+    countLookup(1);
+    if (source && source->directory) {
+        for (const auto& name : source->children) {
+            entries.push_back(folder / name);
+        }
+    }
+    return entries;
+}
+
+dv::value ResPaths::readCombinedList(const std::string& filename) const {
+    auto index = getIndex();
+    std::string key;
+    bool valid = make_key(filename, key);
+    countLookup(roots.size());
+
+    dv::value list = dv::list();
+    for (size_t i = 0; i < roots.size(); i++) {
+        const auto& root = roots[i];
+        if (!valid || index->find(key, i) == nullptr) {
+            continue;
+        }
+        auto path = root.path / filename;
+        try {
+            auto value = io::read_object(path);
+            if (!value.isList()) {
+                logger.warning() << "reading combined list " << root.name << ":"
+                    << filename << " is not a list (skipped)";
+                continue;
+            }
+            for (const auto& elem : value) {
+                list.add(elem);
+            }
+        } catch (const std::runtime_error& err) {
+            logger.warning() << "reading combined list " << root.name << ":"
+                << filename << ": " << err.what();
+        }
+    }
+    return list;
+}
+
+dv::value ResPaths::readCombinedObject(const std::string& filename, bool deep) const {
+    auto index = getIndex();
+    std::string key;
+    bool valid = make_key(filename, key);
+    countLookup(roots.size());
+
+    dv::value object = dv::object();
+    for (size_t i = 0; i < roots.size(); i++) {
+        const auto& root = roots[i];
+        if (!valid || index->find(key, i) == nullptr) {
+            continue;
+        }
+        auto path = root.path / filename;
+        try {
+            auto value = io::read_object(path);
+            if (!value.isObject()) {
+                logger.warning()
+                    << "reading combined object " << root.name << ": "
+                    << filename << " is not an object (skipped)";
+            }
+            object.merge(std::move(value), deep);
+        } catch (const std::runtime_error& err) {
+            logger.warning() << "reading combined object " << root.name << ":"
+                             << filename << ": " << err.what();
+        }
+    }
+    return object;
+}
+
+std::vector<io::path> ResPaths::collectRoots() {
+    std::vector<io::path> collected;
+    collected.reserve(roots.size());
+    for (const auto& root : roots) {
+        collected.emplace_back(root.path);
+    }
+    return collected;
+}
+
+void ResPaths::invalidate() const {
+    std::lock_guard lock(state->mutex);
+    state->index = nullptr;
+}
+
+void ResPaths::onModified(const io::path& path) const {
+    auto entryPoint = path.entryPoint();
+    // writeable pack devices (see EnginePaths::createWriteableDevice)
+    if (entryPoint.rfind("W.", 0) == 0) {
+        invalidate();
+        return;
+    }
+    for (const auto& root : roots) {
+        if (root.name == entryPoint || root.path.entryPoint() == entryPoint) {
+            invalidate();
+            return;
+        }
+    }
+}
+
+ResPaths::Stats ResPaths::getStats() const {
+    return Stats {state->lookups, state->queries, state->legacyQueries};
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "io/io.hpp"
+#include "data/dv.hpp"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+struct PathsRoot {
+    std::string name;
+    io::path path;
+
+    PathsRoot(std::string name, io::path path)
+        : name(std::move(name)), path(std::move(path)) {
+    }
+};
+
+/// @brief Resources lookup over a set of roots (core and content packs).
+/// Later roots override earlier ones.
+///
+/// All roots are indexed once on the first lookup: merged index maps every
+/// relative path to the roots containing it and keeps directories listings,
+/// so lookups do not touch devices. Paths are case-insensitive where the
+/// file system is (see CASE_SENSITIVE). Copies share the index.
+class ResPaths {
+public:
+#if defined(_WIN32) || defined(__APPLE__)
+    static constexpr bool CASE_SENSITIVE = false;
+#else
+    static constexpr bool CASE_SENSITIVE = true;
+#endif
+
+    struct Stats {
+        /// @brief Lookups performed
+        size_t lookups = 0;
+        /// @brief Device queries performed (indexing included)
+        size_t queries = 0;
+        /// @brief Device queries the lookups would take without index
+        size_t legacyQueries = 0;
+    };
+
+    ResPaths();
+
+    ResPaths(std::vector<PathsRoot> roots);
+
+    io::path find(const std::string& filename) const;
+    std::string findRaw(const std::string& filename) const;
+    std::vector<io::path> listdir(const std::string& folder) const;
+    std::vector<std::string> listdirRaw(const std::string& folder) const;
+
+    /// @brief Check if file or directory exists in any root
+    /// @param filename path relative to roots (paths with entry point
+    /// are checked directly)
+    bool exists(const std::string& filename) const;
+
+    /// @brief Check if path is a directory. Paths located in the roots are
+    /// checked using the index
+    /// @param path path with entry point
+    bool isDirectory(const io::path& path) const;
+
+    /// @brief Check if path is a regular file. Paths located in the roots are
+    /// checked using the index
+    /// @param path path with entry point
+    bool isFile(const io::path& path) const;
+
+    /// @brief List directory contents (same as io::directory_iterator).
+    /// Directories located in the roots are listed using the index
+    /// @param folder path with entry point
+    std::vector<io::path> list(const io::path& folder) const;
+
+    /// @brief Read all found list versions from all packs and combine into a
+    /// single list. Invalid versions will be skipped with logging a warning
+    /// @param file *.json file path relative to entry point
+    dv::value readCombinedList(const std::string& file) const;
+
+    dv::value readCombinedObject(const std::string& file, bool deep=false) const;
+
+    std::vector<io::path> collectRoots();
+
+    /// @brief Drop the index. It will be rebuilt on the next lookup
+    void invalidate() const;
+
+    /// @brief Drop the index if the modified path may be located in the roots
+    void onModified(const io::path& path) const;
+
+    Stats getStats() const;
+private:
+    struct Index;
+    struct State {
+        std::mutex mutex;
+        std::shared_ptr<const Index> index;
+        std::atomic<size_t> lookups = 0;
+        std::atomic<size_t> queries = 0;
+        std::atomic<size_t> legacyQueries = 0;
+    };
+
+    std::vector<PathsRoot> roots;
+    std::shared_ptr<State> state;
+
+    std::shared_ptr<const Index> getIndex() const;
+
+    /// @brief Find root containing the path
+    /// @param relative path relative to the root
+    /// @return root index or -1
+    int findRoot(const io::path& path, std::string& relative) const;
+
+    void countLookup(size_t legacyQueries) const;
+};
@@ -1,20 +1,25 @@
 #include "ServerMainloop.hpp"
 
 #include "Engine.hpp"
+#include "TickScheduler.hpp"
 #include "logic/scripting/scripting.hpp"
 #include "logic/LevelController.hpp"
 #include "interfaces/Process.hpp"
 #include "debug/Logger.hpp"
+#include "debug/Profiler.hpp"
 #include "world/Level.hpp"
 #include "world/World.hpp"
-#include "util/platform.hpp"
 
+#include <algorithm>
 #include <chrono>
 
 using namespace std::chrono;
 
 static debug::Logger logger("mainloop");
 
+/// @brief Share of the tick time left reserved for chunks loading and lighting
+inline constexpr double CHUNKS_BUDGET_SHARE = 0.5;
+
 ServerMainloop::ServerMainloop(Engine& engine) : engine(engine) {
 }
 
@@ -22,7 +27,6 @@ ServerMainloop::~ServerMainloop() = default;
 
 void ServerMainloop::run() {
     const auto& coreParams = engine.getCoreParameters();
-    auto& time = engine.getTime();
 
     if (coreParams.scriptFile.empty()) {
         logger.info() << "nothing to do";
@@ -36,10 +40,8 @@ void ServerMainloop::run() {
         "script:" + coreParams.scriptFile.filename().u8string()
     );
 
-    double targetDelta = 1.0 / static_cast<double>(coreParams.tps);
-    double delta = targetDelta;
-    auto begin = system_clock::now();
-    auto startupTime = begin;
+    auto& scheduler = *engine.getTickScheduler();
+    scheduler.reset(TickScheduler::clock::now());
 
     while (process->isActive()) {
         if (engine.isQuitSignal()) {
@@ -47,33 +49,57 @@ void ServerMainloop::run() {
             logger.info() << "script has been terminated due to quit signal";
             break;
         }
-        if (coreParams.testMode) {
-            time.step(delta);
-        } else {
-            auto now = system_clock::now();
-            time.update(
-                duration_cast<microseconds>(now - startupTime).count() / 1e6);
-            delta = time.getDelta();
+        int ticks = 1;
+        if (!coreParams.testMode) {
+            scheduler.wait();
+            ticks = scheduler.poll(TickScheduler::clock::now());
         }
-        process->update();
-        if (controller) {
-            controller->getLevel()->getWorld()->updateTimers(delta);
-            controller->update(glm::min(delta, 0.2), false);
+        for (int i = 0; i < ticks && process->isActive(); i++) {
+            tick(*process, scheduler, i + 1 < ticks);
         }
-        engine.applicationTick();
-        engine.postUpdate();
+    }
+    auto stats = scheduler.getStats();
+    logger.info() << "script finished (ticks: " << stats.ticks
+                  << ", overruns: " << stats.overruns
+                  << ", skipped: " << stats.skipped << ")";
+}
 
-        if (!coreParams.testMode) {
-            auto end = system_clock::now();
-            int64_t millis = targetDelta * 1000 - 
-                duration_cast<microseconds>(end - begin).count() / 1000;
-            if (millis > 0) {
-                platform::sleep(millis);
+void ServerMainloop::tick(
+    Process& process, TickScheduler& scheduler, bool catchingUp
+) {
+    VC_PROFILE_SCOPE("ServerMainloop::tick");
+    auto start = TickScheduler::clock::now();
+    double delta = scheduler.getDelta();
+
+    engine.getTime().step(delta);
+    process.update();
+    if (controller) {
+        controller->getLevel()->getWorld()->updateTimers(delta);
+        // test mode keeps chunks.load-speed setting time per player
+        if (!engine.getCoreParameters().testMode) {
+            // only the minimal chunks work is done while catching up
+            int64_t budget = 0;
+            if (!catchingUp) {
+                // late ticks have less time left than the tick interval
+                auto timeLeft = scheduler.getTimeToNextTick(
+                    TickScheduler::clock::now()
+                );
+                budget = std::min<int64_t>(
+                    engine.getSettings().chunks.loadSpeed.get() * 1000,
+                    static_cast<int64_t>(timeLeft * CHUNKS_BUDGET_SHARE)
+                );
             }
-            begin = system_clock::now();
+            controller->setChunksBudget(std::max<int64_t>(budget, 0));
         }
+        controller->update(std::min(delta, 0.2), false);
     }
-    logger.info() << "script finished";
+    engine.applicationTick();
+    engine.postUpdate();
+
+    scheduler.record(
+        start,
+        duration_cast<microseconds>(TickScheduler::clock::now() - start).count()
+    );
 }
 
 void ServerMainloop::setLevel(std::unique_ptr<Level> level) {
@@ -5,10 +5,16 @@
 class Level;
 class LevelController;
 class Engine;
+class Process;
+class TickScheduler;
 
 class ServerMainloop {
     Engine& engine;
     std::unique_ptr<LevelController> controller;
+
+    /// @brief Perform a fixed timestep tick
+    /// @param catchingUp the tick is not the last one of a catch-up series
+    void tick(Process& process, TickScheduler& scheduler, bool catchingUp);
 public:
     ServerMainloop(Engine& engine);
     ~ServerMainloop();
@@ -0,0 +1,106 @@
+#include "TickScheduler.hpp"
+
+#include "util/platform.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+
+using namespace std::chrono;
+
+/// @brief Number of recent ticks used for the statistics
+inline constexpr size_t STATS_WINDOW = 1024;
+/// @brief Time before the deadline spent spinning instead of sleeping
+inline constexpr auto SPIN_THRESHOLD = milliseconds(2);
+
+TickScheduler::TickScheduler(int tps, int maxCatchUp)
+    : tps(tps), maxCatchUp(maxCatchUp) {
+    if (tps <= 0) {
+        throw std::invalid_argument("tps must be positive");
+    }
+    if (maxCatchUp <= 0) {
+        throw std::invalid_argument("catch-up limit must be positive");
+    }
+    interval = duration_cast<clock::duration>(duration<double>(1.0 / tps));
+    samples.reserve(STATS_WINDOW);
+    reset(clock::now());
+}
+
+void TickScheduler::reset(clock::time_point now) {
+    nextTick = now;
+}
+
+int TickScheduler::poll(clock::time_point now) {
+    if (now < nextTick) {
+        return 0;
+    }
+    int64_t due = (now - nextTick) / interval + 1;
+    int count = static_cast<int>(std::min<int64_t>(due, maxCatchUp));
+    skipped += due - count;
+    nextTick += interval * due;
+    return count;
+}
+
+void TickScheduler::wait() const {
+    auto remaining = nextTick - clock::now();
+    if (remaining > SPIN_THRESHOLD) {
+        platform::sleep(
+            duration_cast<milliseconds>(remaining - SPIN_THRESHOLD).count()
+        );
+    }
+    while (clock::now() < nextTick) {
+        std::this_thread::yield();
+    }
+}
+
+void TickScheduler::record(clock::time_point start, int64_t duration) {
+    ticks++;
+    if (duration > duration_cast<microseconds>(interval).count()) {
+        overruns++;
+    }
+    if (samples.size() < STATS_WINDOW) {
+        samples.push_back(Sample {start, duration});
+    } else {
+        samples[samplesOffset] = Sample {start, duration};
+        samplesOffset = (samplesOffset + 1) % STATS_WINDOW;
+    }
+}
+
+int64_t TickScheduler::getTimeToNextTick(clock::time_point now) const {
+    return duration_cast<microseconds>(nextTick - now).count();
+}
+
+TickStats TickScheduler::getStats() const {
+    TickStats stats;
+    stats.ticks = ticks;
+    stats.overruns = overruns;
+    stats.skipped = skipped;
+    if (samples.empty()) {
+        return stats;
+    }
+    std::vector<int64_t> durations;
+    durations.reserve(samples.size());
+    auto first = samples[0].start;
+    auto last = samples[0].start;
+    for (const auto& sample : samples) {
+        durations.push_back(sample.duration);
+        first = std::min(first, sample.start);
+        last = std::max(last, sample.start);
+    }
+    auto percentile = [&durations](double p) {
+        auto nth = durations.begin() + static_cast<size_t>(
+            (durations.size() - 1) * p
+        );
+        std::nth_element(durations.begin(), nth, durations.end());
+        return *nth;
+    };
+    stats.p50 = percentile(0.5);
+    stats.p99 = percentile(0.99);
+    stats.max = *std::max_element(durations.begin(), durations.end());
+
+    double elapsed = duration<double>(last - first).count();
+    if (elapsed > 0.0) {
+        stats.tps = (samples.size() - 1) / elapsed;
+    }
+    return stats;
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+/// @brief Server ticks timing statistics
+struct TickStats {
+    /// @brief Ticks performed
+    uint64_t ticks = 0;
+    /// @brief Ticks took longer than the tick interval
+    uint64_t overruns = 0;
+    /// @brief Ticks dropped due to the catch-up limit
+    uint64_t skipped = 0;
+    /// @brief Median tick duration over the recent ticks (microseconds)
+    int64_t p50 = 0;
+    /// @brief 99th percentile tick duration over the recent ticks
+    /// (microseconds)
+    int64_t p99 = 0;
+    /// @brief Max tick duration over the recent ticks (microseconds)
+    int64_t max = 0;
+    /// @brief Measured ticks per second over the recent ticks
+    double tps = 0.0;
+};
+
+/// @brief Fixed timestep ticks scheduler.
+/// Ticks missed due to overruns are caught up, but no more than
+/// maxCatchUp at once; the rest are skipped
+class TickScheduler {
+public:
+    using clock = std::chrono::steady_clock;
+
+    /// @param tps target ticks per second
+    /// @param maxCatchUp max number of ticks performed in a row
+    TickScheduler(int tps, int maxCatchUp = 5);
+
+    /// @brief Restart scheduling from the specified time point
+    void reset(clock::time_point now);
+
+    /// @brief Get number of ticks to perform at the time point.
+    /// Ticks over the catch-up limit are counted as skipped
+    int poll(clock::time_point now);
+
+    /// @brief Wait until the next tick. Sleeps with millisecond precision
+    /// and spins for the rest
+    void wait() const;
+
+    /// @brief Record performed tick timing
+    /// @param start tick start time point
+    /// @param duration tick duration (microseconds)
+    void record(clock::time_point start, int64_t duration);
+
+    /// @brief Get time left before the next scheduled tick (microseconds).
+    /// Negative if the next tick is already due
+    /// @param now current time point
+    int64_t getTimeToNextTick(clock::time_point now) const;
+
+    /// @brief Get fixed tick delta (seconds)
+    double getDelta() const {
+        return 1.0 / tps;
+    }
+
+    int getTps() const {
+        return tps;
+    }
+
+    TickStats getStats() const;
+private:
+    struct Sample {
+        clock::time_point start;
+        int64_t duration;
+    };
+
+    int tps;
+    int maxCatchUp;
+    clock::duration interval;
+    clock::time_point nextTick;
+    uint64_t ticks = 0;
+    uint64_t overruns = 0;
+    uint64_t skipped = 0;
+    /// @brief Recent ticks samples ring
+    std::vector<Sample> samples;
+    size_t samplesOffset = 0;
+};
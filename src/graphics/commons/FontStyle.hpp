@@ -28,6 +28,12 @@ struct FontStyle {
           color(std::move(color)) {
     }
 
+    bool operator==(const FontStyle& other) const {
+        return bold == other.bold && italic == other.italic &&
+               strikethrough == other.strikethrough &&
+               underline == other.underline && color == other.color;
+    }
+
     static FontStyle parse(const dv::value& src);
 };
 
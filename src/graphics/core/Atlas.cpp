@@ -3,6 +3,7 @@
 #include "Texture.hpp"
 #include "ImageData.hpp"
 #include "maths/LMPacker.hpp"
+#include "util/parallel.hpp"
 
 #include <stdexcept>
 
@@ -41,6 +42,14 @@ std::optional<UVRegion> Atlas::getIf(const std::string& name) const {
     return found->second;
 }
 
+std::set<std::string> Atlas::getNames() const {
+    std::set<std::string> names;
+    for (const auto& [name, _] : regions) {
+        names.insert(name);
+    }
+    return names;
+}
+
 Texture* Atlas::getTexture() const {
     return texture.get();
 }
@@ -62,6 +71,25 @@ void AtlasBuilder::add(const std::string& name, std::unique_ptr<ImageData> image
     names.insert(name);
 }
 
+void AtlasBuilder::add(
+    const std::string& name,
+    imageio::ImageFileFormat format,
+    util::Buffer<ubyte> bytes,
+    bool fixAlpha
+) {
+    atlasentry entry {name, nullptr};
+    try {
+        entry.size = imageio::decode_size(format, {bytes.data(), bytes.size()});
+    } catch (const std::runtime_error& err) {
+        throw std::runtime_error(name + ": " + err.what());
+    }
+    entry.encoded = std::move(bytes);
+    entry.format = format;
+    entry.fixAlpha = fixAlpha;
+    entries.push_back(std::move(entry));
+    names.insert(name);
+}
+
 bool AtlasBuilder::has(const std::string& name) const {
     return names.find(name) != names.end();
 }
@@ -72,10 +100,16 @@ std::unique_ptr<Atlas> AtlasBuilder::build(uint extrusion, bool prepare, uint ma
     }
     auto sizes = std::make_unique<uint[]>(entries.size() * 2);
     uint index = 0;
+    bool hasEncoded = false;
     for (auto& entry : entries) {
-        auto image = entry.image;
-        sizes[index++] = image->getWidth();
-        sizes[index++] = image->getHeight();
+        if (auto image = entry.image) {
+            sizes[index++] = image->getWidth();
+            sizes[index++] = image->getHeight();
+        } else {
+            sizes[index++] = entry.size.x;
+            sizes[index++] = entry.size.y;
+            hasEncoded = true;
+        }
     }
     LMPacker packer(sizes.get(), entries.size()*2);
     sizes.reset(nullptr);
@@ -98,6 +132,30 @@ std::unique_ptr<Atlas> AtlasBuilder::build(uint extrusion, bool prepare, uint ma
     auto canvas = std::make_unique<ImageData>(ImageFormat::RGBA8888, width, height);
     std::unordered_map<std::string, UVRegion> regions;
     std::vector<rectangle> rects = packer.getResult();
+    // Regions do not overlap, so images are written in parallel
+    // (serially when built by an assets loader worker)
+    util::parallel_for(rects.size(), hasEncoded ? 0 : 1, [&](size_t i) {
+        const rectangle& rect = rects[i];
+        const atlasentry& entry = entries[rect.idx];
+        if (entry.image) {
+            canvas->blit(*entry.image, rect.x, rect.y);
+            return;
+        }
+        try {
+            imageio::decode_into(
+                entry.format,
+                {entry.encoded.data(), entry.encoded.size()},
+                canvas->getData() + (rect.y * width + rect.x) * 4,
+                width * 4,
+                entry.size
+            );
+        } catch (const std::runtime_error& err) {
+            throw std::runtime_error(entry.name + ": " + err.what());
+        }
+        if (entry.fixAlpha) {
+            canvas->fixAlphaColor(rect.x, rect.y, rect.width, rect.height);
+        }
+    });
     for (uint i = 0; i < entries.size(); i++) {
         const rectangle& rect = rects[i];
         const atlasentry& entry = entries[rect.idx];
@@ -105,7 +163,6 @@ std::unique_ptr<Atlas> AtlasBuilder::build(uint extrusion, bool prepare, uint ma
         uint y = rect.y;
         uint w = rect.width;
         uint h = rect.height;
-        canvas->blit(*entry.image, rect.x, rect.y);
         for (uint j = 0; j < extrusion; j++) {
             canvas->extrude(x - j, y - j, w + j*2, h + j*2);
         }
@@ -7,8 +7,10 @@
 #include <optional>
 #include <unordered_map>
 
+#include "coders/imageio.hpp"
 #include "maths/UVRegion.hpp"
 #include "typedefs.hpp"
+#include "util/Buffer.hpp"
 
 class ImageData;
 class Texture;
@@ -33,6 +35,11 @@ public:
     bool has(const std::string& name) const;
     const UVRegion& get(const std::string& name) const;
     std::optional<UVRegion> getIf(const std::string& name) const;
+    std::set<std::string> getNames() const;
+
+    const std::unordered_map<std::string, UVRegion>& getRegions() const {
+        return regions;
+    }
 
     Texture* getTexture() const;
     ImageData* getImage() const;
@@ -44,6 +51,11 @@ public:
 struct atlasentry {
     std::string name;
     std::shared_ptr<ImageData> image;
+    /// @brief Encoded image, decoded directly into the atlas raster
+    util::Buffer<ubyte> encoded = nullptr;
+    imageio::ImageFileFormat format = imageio::ImageFileFormat::PNG;
+    glm::uvec2 size {};
+    bool fixAlpha = false;
 };
 
 class AtlasBuilder {
@@ -52,10 +64,22 @@ class AtlasBuilder {
 public:
     AtlasBuilder() = default;
     void add(const std::string& name, std::unique_ptr<ImageData> image);
+
+    /// @brief Add encoded image. Only the header is read here, the image
+    /// is decoded in place into the atlas raster by build()
+    /// @param fixAlpha fix transparent pixels color after decoding
+    /// (see ImageData::fixAlphaColor)
+    void add(
+        const std::string& name,
+        imageio::ImageFileFormat format,
+        util::Buffer<ubyte> bytes,
+        bool fixAlpha
+    );
     bool has(const std::string& name) const;
     const std::set<std::string>& getNames() { return names; };
 
-    /// @brief Build atlas from all added images
+    /// @brief Build atlas from all added images. Encoded images are
+    /// decoded in parallel
     /// @param extrusion textures extrusion pixels 
     /// (greater is less mip-mapping artifacts)
     /// @param prepare generate atlas texture (calls .prepare()) 
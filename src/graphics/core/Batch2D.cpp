@@ -4,7 +4,9 @@
 #include "gl_util.hpp"
 #include "maths/UVRegion.hpp"
 
+#include <algorithm>
 #include <cmath>
+#include <cstring>
 
 
 Batch2D::Batch2D(size_t capacity) : capacity(capacity), color(1.0f){
@@ -369,6 +371,30 @@ void Batch2D::sprite(
     parallelogram(x, y, w, h, skew, u, v, scale, scale, tint.r, tint.g, tint.b, tint.a);
 }
 
+void Batch2D::triangles(
+    const Batch2DVertex* vertices, size_t count, const glm::vec2& offset
+) {
+    setPrimitive(DrawPrimitive::triangle);
+    while (count > 0) {
+        size_t available = (capacity - index) / 3 * 3;
+        if (available == 0) {
+            flush();
+            continue;
+        }
+        size_t n = std::min(count, available);
+        auto dst = buffer.get() + index;
+        std::memcpy(dst, vertices, n * sizeof(Batch2DVertex));
+        if (offset != glm::vec2(0.0f)) {
+            for (size_t i = 0; i < n; i++) {
+                dst[i].position += offset;
+            }
+        }
+        index += n;
+        vertices += n;
+        count -= n;
+    }
+}
+
 void Batch2D::flush() {
     if (index == 0)
         return;
@@ -119,6 +119,15 @@ public:
 
     void triangle(float x1, float y1, float x2, float y2, float x3, float y3);
 
+    /// @brief Append prepared triangles vertices. Texture coords must be
+    /// already mapped to the current texture region
+    /// @param vertices vertices array
+    /// @param count number of vertices (multiple of 3)
+    /// @param offset translation added to the vertices positions
+    void triangles(
+        const Batch2DVertex* vertices, size_t count, const glm::vec2& offset = {}
+    );
+
     void flush() override;
 
     void lineWidth(float width);
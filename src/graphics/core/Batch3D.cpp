@@ -6,6 +6,9 @@
 #include "typedefs.hpp"
 #include "maths/UVRegion.hpp"
 
+#include <algorithm>
+#include <cstring>
+
 namespace {
     const glm::vec3 SUN_VECTOR(0.528265f, 0.833149f, -0.163704f);
     const float DIRECTIONAL_LIGHT_FACTOR = 0.3f;
@@ -291,6 +294,29 @@ void Batch3D::point(const glm::vec3& coord, const glm::vec4& tint) {
     vertex(coord, {}, tint.r, tint.g, tint.b, tint.a);
 }
 
+void Batch3D::triangles(
+    const Batch3DVertex* vertices, size_t count, const glm::vec3& offset
+) {
+    while (count > 0) {
+        size_t available = (capacity - index) / 3 * 3;
+        if (available == 0) {
+            flush();
+            continue;
+        }
+        size_t n = std::min(count, available);
+        auto dst = buffer.get() + index;
+        std::memcpy(dst, vertices, n * sizeof(Batch3DVertex));
+        if (offset != glm::vec3(0.0f)) {
+            for (size_t i = 0; i < n; i++) {
+                dst[i].position += offset;
+            }
+        }
+        index += n;
+        vertices += n;
+        count -= n;
+    }
+}
+
 void Batch3D::flush() {
     mesh->reload(buffer.get(), index);
     mesh->draw();
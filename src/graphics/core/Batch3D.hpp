@@ -107,6 +107,14 @@ public:
     void vertex(const glm::vec3& pos, const glm::vec2& uv, const glm::vec3& norm);
     void vertex(const glm::vec3& pos, const glm::vec2& uv, const glm::vec4& tint);
     void point(const glm::vec3& pos, const glm::vec4& tint);
+    /// @brief Append prepared triangles vertices. Texture coords must be
+    /// already mapped to the current texture region
+    /// @param vertices vertices array
+    /// @param count number of vertices (multiple of 3)
+    /// @param offset translation added to the vertices positions
+    void triangles(
+        const Batch3DVertex* vertices, size_t count, const glm::vec3& offset = {}
+    );
     void flush() override;
     void flushPoints();
 
@@ -2,6 +2,7 @@
 
 #include "Batch2D.hpp"
 #include "Batch3D.hpp"
+#include "GlyphRun.hpp"
 #include "coders/vector_fonts.hpp"
 #include "Texture.hpp"
 #include "window/Camera.hpp"
@@ -10,8 +11,9 @@
 #include <utility>
 
 inline constexpr uint GLYPH_SIZE = 16;
-inline constexpr uint MAX_CODEPAGES = 10000; // idk ho many codepages unicode has
 inline constexpr glm::vec4 SHADOW_TINT(0.0f, 0.0f, 0.0f, 1.0f);
+/// @brief Max total length of texts kept laid out
+inline constexpr size_t GLYPH_RUNS_CACHE_CAPACITY = 32768;
 
 Font::Font(
     std::vector<std::unique_ptr<Texture>> pages,
@@ -25,7 +27,8 @@ Font::Font(
       glyphInterval(lineHeight / 2),
       pages(std::move(pages)),
       glyphs(std::move(glyphs)),
-      fontFile(std::move(fontFile)) {
+      fontFile(std::move(fontFile)),
+      runs(std::make_unique<GlyphRunCache>(GLYPH_RUNS_CACHE_CAPACITY)) {
 }
 
 Font::~Font() = default;
@@ -38,7 +41,7 @@ int Font::getLineHeight() const {
     return lineHeight;
 }
 
-bool Font::isPrintableChar(uint codepoint) const {
+bool Font::isPrintableChar(uint codepoint) {
     switch (codepoint){
         case ' ':
         case '\t':
@@ -78,157 +81,6 @@ int Font::calcWidth(std::wstring_view text, size_t offset, size_t length) const
     return std::min(text.length()-offset, length) * glyphInterval;
 }
 
-static inline void draw_glyph(
-    Batch2D& batch, 
-    const glm::vec3& pos, 
-    const glm::vec2& offset, 
-    uint c, 
-    const glm::vec3& right,
-    const glm::vec3& up,
-    float glyphInterval,
-    const FontStyle& style
-) {
-    for (int i = 0; i <= style.bold; i++) {
-        glm::vec4 color;
-
-        if (style.color == glm::vec4(1, 1, 1, 1)) {
-            color = batch.getColor();
-        } else {
-            color = style.color;
-        }
-
-        batch.sprite(
-            pos.x + (offset.x + i / (right.x/glyphInterval/2.0f)) * right.x,
-            pos.y + offset.y * up.y,
-            right.x / glyphInterval,
-            up.y,
-            -0.15f * style.italic,
-            16,
-            c,
-            color
-        );
-    }
-}
-
-static inline void draw_glyph(
-    Batch3D& batch, 
-    const glm::vec3& pos, 
-    const glm::vec2& offset, 
-    uint c, 
-    const glm::vec3& right,
-    const glm::vec3& up,
-    float glyphInterval,
-    const FontStyle& style
-) {
-    for (int i = 0; i <= style.bold; i++) {
-        glm::vec4 color;
-
-        if (style.color == glm::vec4(1, 1, 1, 1)) {
-            color = batch.getColor();
-        } else {
-            color = style.color;
-        }
-
-        batch.sprite(
-            pos + right * (offset.x + i) + up * offset.y,
-            up, right / glyphInterval,
-            0.5f,
-            0.5f,
-            16,
-            c,
-            color
-        );
-    }
-}
-
-template <class Batch>
-static inline void draw_text(
-    Font& font,
-    Batch& batch,
-    std::wstring_view text,
-    const glm::vec3& pos,
-    const glm::vec3& right,
-    const glm::vec3& up,
-    float interval,
-    const FontStylesScheme* styles,
-    size_t styleMapOffset
-) {
-    static FontStylesScheme defStyles {{{}}, {0}};
-
-    if (styles == nullptr) {
-        styles = &defStyles;
-    }
-    
-    uint page = 0;
-    uint next = MAX_CODEPAGES;
-    float x = 0;
-    int y = 0;
-    bool hasLines = false;
-
-    float baseAdvance = glm::length(right);
-
-    do {
-        for (size_t i = 0; i < text.length(); i++) {
-            uint c = text[i];
-            size_t styleIndex = styles->map.at(
-                std::min(styles->map.size() - 1, i + styleMapOffset)
-            );
-            const FontStyle& style = styles->palette.at(styleIndex);
-            hasLines |= style.strikethrough;
-            hasLines |= style.underline;
-
-            if (!font.isPrintableChar(c)) {
-                x++;
-                continue;
-            }
-            int yOffset = 0;
-            float advance = baseAdvance;
-            if (auto glyph = font.getGlyph(c)) {
-                yOffset = glyph->yOffset;
-                advance = glyph->xAdvance;
-            }
-            uint charpage = c >> 8;
-            if (charpage == page){
-                batch.texture(font.getPage(charpage));
-                draw_glyph(
-                    batch, pos, glm::vec2(x, y - yOffset / static_cast<float>(font.getLineHeight())), c, right, up, interval, style
-                );
-            }
-            else if (charpage > page && charpage < next){
-                next = charpage;
-            }
-            x += advance / baseAdvance;
-        }
-        page = next;
-        next = MAX_CODEPAGES;
-        x = 0;
-    } while (page < MAX_CODEPAGES);
-
-    if (!hasLines) {
-        return;
-    }
-    batch.texture(font.getPage(0));
-    for (size_t i = 0; i < text.length(); i++) {
-        size_t styleIndex = styles->map.at(
-            std::min(styles->map.size() - 1, i + styleMapOffset)
-        );
-        const FontStyle& style = styles->palette.at(styleIndex);
-        FontStyle lineStyle = style;
-        lineStyle.bold = true;
-        if (style.strikethrough) {
-            draw_glyph(
-                batch, pos, glm::vec2(x, y), '-', right, up, interval, lineStyle
-            );
-        }
-        if (style.underline) {
-            draw_glyph(
-                batch, pos, glm::vec2(x, y), '_', right, up, interval, lineStyle
-            );
-        }
-        x++;
-    }
-}
-
 const Texture* Font::getPage(int charpage) const {
     Texture* texture = nullptr;
     if (charpage < pages.size()) {
@@ -240,6 +92,32 @@ const Texture* Font::getPage(int charpage) const {
     return texture;
 }
 
+/// @brief Get UV regions of the run segments pages
+static std::vector<UVRegion> get_regions(const Font& font, const GlyphRun& run) {
+    std::vector<UVRegion> regions;
+    regions.reserve(run.segments.size());
+    for (const auto& segment : run.segments) {
+        regions.push_back(font.getPage(segment.page)->getUVRegion());
+    }
+    return regions;
+}
+
+template <class Batch, typename Vertex>
+static inline void draw_run(
+    const Font& font,
+    Batch& batch,
+    const GlyphRun& run,
+    const GlyphRunMesh<Vertex>& mesh,
+    const decltype(Vertex::position)& pos
+) {
+    const Vertex* vertices = mesh.vertices.data();
+    for (size_t i = 0; i < run.segments.size(); i++) {
+        batch.texture(font.getPage(run.segments[i].page));
+        batch.triangles(vertices, mesh.counts[i], pos);
+        vertices += mesh.counts[i];
+    }
+}
+
 void Font::draw(
     Batch2D& batch,
     std::wstring_view text,
@@ -249,15 +127,22 @@ void Font::draw(
     size_t styleMapOffset,
     float scale
 ) {
-    draw_text(
-        *this, batch, text,
-        glm::vec3(x, y, 0),
+    auto& run = runs->get(this, text, styles, styleMapOffset);
+    GlyphRunPlacement placement {
         glm::vec3(glyphInterval*scale, 0, 0),
         glm::vec3(0, lineHeight*scale, 0),
-        glyphInterval/static_cast<float>(lineHeight),
-        styles,
-        styleMapOffset
-    );
+        batch.getColor()
+    };
+    if (!run.mesh2D.matches(placement)) {
+        run.build(
+            run.mesh2D,
+            placement,
+            lineHeight,
+            glyphInterval/static_cast<float>(lineHeight),
+            get_regions(*this, run)
+        );
+    }
+    draw_run(*this, batch, run, run.mesh2D, glm::vec2(x, y));
 }
 
 void Font::draw(
@@ -269,14 +154,22 @@ void Font::draw(
     const glm::vec3& right,
     const glm::vec3& up
 ) {
-    draw_text(
-        *this, batch, text, pos,
+    auto& run = runs->get(this, text, styles, styleMapOffset);
+    GlyphRunPlacement placement {
         right * static_cast<float>(glyphInterval),
         up * static_cast<float>(lineHeight),
-        glyphInterval/static_cast<float>(lineHeight),
-        styles,
-        styleMapOffset
-    );
+        batch.getColor()
+    };
+    if (!run.mesh3D.matches(placement)) {
+        run.build(
+            run.mesh3D,
+            placement,
+            lineHeight,
+            glyphInterval/static_cast<float>(lineHeight),
+            get_regions(*this, run)
+        );
+    }
+    draw_run(*this, batch, run, run.mesh3D, pos);
 }
 
 std::unique_ptr<Font> Font::createBitmapFont(
@@ -323,5 +216,7 @@ const Glyph* Font::getGlyph(int codepoint) {
         pages.resize(codepage);
     }
     pages.push_back(fontFile->renderPage(codepage, glyphs, lineHeight));
+    // laid out texts may use glyphs of the new page
+    runs->clear();
     return &glyphs.at(codepoint);
 }
@@ -16,6 +16,7 @@ class Batch2D;
 class Batch3D;
 class Camera;
 class ImageData;
+class GlyphRunCache;
 
 class Font;
 
@@ -57,7 +58,7 @@ public:
 
     /// @brief Check if character is visible (non-whitespace)
     /// @param codepoint character unicode codepoint
-    bool isPrintableChar(uint codepoint) const;
+    static bool isPrintableChar(uint codepoint);
 
     void draw(
         Batch2D& batch,
@@ -97,4 +98,6 @@ private:
     std::vector<std::unique_ptr<Texture>> pages;
     std::vector<Glyph> glyphs;
     std::optional<std::weak_ptr<vector_fonts::FontFile>> fontFile;
+    /// @brief Laid out texts with prepared vertices
+    std::unique_ptr<GlyphRunCache> runs;
 };
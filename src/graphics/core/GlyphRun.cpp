@@ -0,0 +1,298 @@
+#include "GlyphRun.hpp"
+
+#include "Font.hpp"
+#include "FontMetics.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <string_view>
+
+inline constexpr int GLYPHS_ATLAS_RES = 16;
+
+static const FontStylesScheme& get_styles(const FontStylesScheme* styles) {
+    static FontStylesScheme defStyles {{{}}, {0}};
+    return styles ? *styles : defStyles;
+}
+
+static size_t get_style_index(
+    const FontStylesScheme& styles, size_t index
+) {
+    return styles.map.at(std::min(styles.map.size() - 1, index));
+}
+
+GlyphRun GlyphRun::layout(
+    Font* font,
+    std::wstring_view text,
+    const FontStylesScheme* stylesPtr,
+    size_t styleMapOffset
+) {
+    const auto& styles = get_styles(stylesPtr);
+
+    GlyphRun run;
+    run.glyphs.reserve(text.length());
+    int cells = 0;
+    int pixels = 0;
+    bool hasLines = false;
+    for (size_t i = 0; i < text.length(); i++) {
+        uint c = text[i];
+        const FontStyle& style = styles.palette.at(
+            get_style_index(styles, i + styleMapOffset)
+        );
+        hasLines |= style.strikethrough;
+        hasLines |= style.underline;
+
+        if (!Font::isPrintableChar(c)) {
+            cells++;
+            continue;
+        }
+        const Glyph* glyph = font ? font->getGlyph(c) : nullptr;
+        run.glyphs.push_back(
+            PlacedGlyph {c, cells, pixels, glyph ? glyph->yOffset : 0, style}
+        );
+        if (glyph) {
+            pixels += glyph->xAdvance;
+        } else {
+            cells++;
+        }
+    }
+    // codepages are drawn in ascending order
+    std::stable_sort(
+        run.glyphs.begin(),
+        run.glyphs.end(),
+        [](const PlacedGlyph& a, const PlacedGlyph& b) {
+            return (a.codepoint >> 8) < (b.codepoint >> 8);
+        }
+    );
+    for (const auto& glyph : run.glyphs) {
+        uint page = glyph.codepoint >> 8;
+        if (run.segments.empty() || run.segments.back().page != page) {
+            run.segments.push_back(GlyphRunSegment {page, 0});
+        }
+        run.segments.back().count++;
+    }
+    if (!hasLines) {
+        return run;
+    }
+    size_t decorations = 0;
+    for (size_t i = 0; i < text.length(); i++) {
+        FontStyle style = styles.palette.at(
+            get_style_index(styles, i + styleMapOffset)
+        );
+        style.bold = true;
+        int cell = static_cast<int>(i);
+        if (style.strikethrough) {
+            run.glyphs.push_back(PlacedGlyph {'-', cell, 0, 0, style});
+            decorations++;
+        }
+        if (style.underline) {
+            run.glyphs.push_back(PlacedGlyph {'_', cell, 0, 0, style});
+            decorations++;
+        }
+    }
+    run.segments.push_back(GlyphRunSegment {0, decorations});
+    return run;
+}
+
+GlyphRun GlyphRun::layout(
+    const FontMetrics& metrics,
+    std::wstring_view text,
+    const FontStylesScheme* styles,
+    size_t styleMapOffset
+) {
+    auto font = metrics.font.has_value() ? metrics.font->lock() : nullptr;
+    return layout(font.get(), text, styles, styleMapOffset);
+}
+
+static inline glm::vec2 transform_uv(
+    float u, float v, const UVRegion& region
+) {
+    return {
+        u * region.getWidth() + region.u1, v * region.getHeight() + region.v1};
+}
+
+static inline glm::vec4 glyph_color(
+    const FontStyle& style, const GlyphRunPlacement& placement
+) {
+    if (style.color == glm::vec4(1, 1, 1, 1)) {
+        return placement.color;
+    }
+    return style.color;
+}
+
+/// @brief Get glyph texture coords as done by Batch sprite(..., atlasRes,
+/// index, ...) methods
+static inline UVRegion glyph_uv(uint codepoint) {
+    int index = codepoint;
+    float scale = 1.0f / static_cast<float>(GLYPHS_ATLAS_RES);
+    float u = (index % GLYPHS_ATLAS_RES) * scale;
+    float v = 1.0f - ((index / GLYPHS_ATLAS_RES) * scale) - scale;
+    return UVRegion(u, v, u + scale, v + scale);
+}
+
+template <typename Vertex, class Generator>
+static void build_mesh(
+    const GlyphRun& run,
+    GlyphRunMesh<Vertex>& mesh,
+    const GlyphRunPlacement& placement,
+    const std::vector<UVRegion>& regions,
+    const Generator& generator
+) {
+    mesh.placement = placement;
+    mesh.vertices.clear();
+    mesh.counts.clear();
+    mesh.built = true;
+
+    float baseAdvance = glm::length(placement.right);
+    size_t offset = 0;
+    for (size_t s = 0; s < run.segments.size(); s++) {
+        const auto& segment = run.segments[s];
+        size_t start = mesh.vertices.size();
+        for (size_t i = offset; i < offset + segment.count; i++) {
+            const auto& glyph = run.glyphs[i];
+            float x = glyph.cells + glyph.pixels / baseAdvance;
+            generator(glyph, x, regions.at(s));
+        }
+        offset += segment.count;
+        mesh.counts.push_back(mesh.vertices.size() - start);
+    }
+}
+
+void GlyphRun::build(
+    GlyphRunMesh<Batch2DVertex>& mesh,
+    const GlyphRunPlacement& placement,
+    int lineHeight,
+    float glyphInterval,
+    const std::vector<UVRegion>& regions
+) const {
+    const auto& right = placement.right;
+    const auto& up = placement.up;
+    auto& vertices = mesh.vertices;
+    vertices.reserve(glyphs.size() * 6);
+
+    build_mesh(*this, mesh, placement, regions,
+        [&](const PlacedGlyph& glyph, float x, const UVRegion& region) {
+            auto uv = glyph_uv(glyph.codepoint);
+            float y = -glyph.yOffset / static_cast<float>(lineHeight) * up.y;
+            float w = right.x / glyphInterval;
+            float h = up.y;
+            float skew = -0.15f * glyph.style.italic;
+            auto color = glyph_color(glyph.style, placement);
+            for (int i = 0; i <= glyph.style.bold; i++) {
+                float gx = (x + i / (right.x / glyphInterval / 2.0f)) * right.x;
+                vertices.push_back({{gx - skew * w, y}, transform_uv(uv.u1, uv.v2, region), color});
+                vertices.push_back({{gx + (1 + skew) * w, y + h}, transform_uv(uv.u2, uv.v1, region), color});
+                vertices.push_back({{gx + skew * w, y + h}, transform_uv(uv.u1, uv.v1, region), color});
+
+                vertices.push_back({{gx - skew * w, y}, transform_uv(uv.u1, uv.v2, region), color});
+                vertices.push_back({{gx + w - skew * w, y}, transform_uv(uv.u2, uv.v2, region), color});
+                vertices.push_back({{gx + (1 + skew) * w, y + h}, transform_uv(uv.u2, uv.v1, region), color});
+            }
+        }
+    );
+}
+
+void GlyphRun::build(
+    GlyphRunMesh<Batch3DVertex>& mesh,
+    const GlyphRunPlacement& placement,
+    int lineHeight,
+    float glyphInterval,
+    const std::vector<UVRegion>& regions
+) const {
+    const auto& right = placement.right;
+    const auto& up = placement.up;
+    auto& vertices = mesh.vertices;
+    vertices.reserve(glyphs.size() * 6);
+
+    build_mesh(*this, mesh, placement, regions,
+        [&](const PlacedGlyph& glyph, float x, const UVRegion& region) {
+            auto uv = glyph_uv(glyph.codepoint);
+            float y = -glyph.yOffset / static_cast<float>(lineHeight);
+            auto color = glyph_color(glyph.style, placement);
+            // half-size axes of the sprite
+            auto hr = right / glyphInterval * 0.5f;
+            auto hu = up * 0.5f;
+            for (int i = 0; i <= glyph.style.bold; i++) {
+                auto center = right * (x + i) + up * y + hr + hu;
+                vertices.push_back({center - hr - hu, transform_uv(uv.u1, uv.v1, region), color});
+                vertices.push_back({center + hr + hu, transform_uv(uv.u2, uv.v2, region), color});
+                vertices.push_back({center - hr + hu, transform_uv(uv.u1, uv.v2, region), color});
+
+                vertices.push_back({center - hr - hu, transform_uv(uv.u1, uv.v1, region), color});
+                vertices.push_back({center + hr - hu, transform_uv(uv.u2, uv.v1, region), color});
+                vertices.push_back({center + hr + hu, transform_uv(uv.u2, uv.v2, region), color});
+            }
+        }
+    );
+}
+
+GlyphRunCache::GlyphRunCache(size_t capacity) : capacity(capacity) {
+}
+
+static size_t hash_key(std::wstring_view text, const std::vector<ubyte>& styleMap) {
+    size_t hash = std::hash<std::wstring_view>()(text);
+    size_t stylesHash = std::hash<std::string_view>()(std::string_view(
+        reinterpret_cast<const char*>(styleMap.data()), styleMap.size()
+    ));
+    return hash ^ (stylesHash + 0x9e3779b9 + (hash << 6) + (hash >> 2));
+}
+
+GlyphRun& GlyphRunCache::get(
+    Font* font,
+    std::wstring_view text,
+    const FontStylesScheme* stylesPtr,
+    size_t styleMapOffset
+) {
+    if (text.length() > capacity) {
+        misses++;
+        scratch = GlyphRun::layout(font, text, stylesPtr, styleMapOffset);
+        return scratch;
+    }
+    const auto& styles = get_styles(stylesPtr);
+    styleMap.resize(text.length());
+    for (size_t i = 0; i < text.length(); i++) {
+        styleMap[i] = get_style_index(styles, i + styleMapOffset);
+    }
+    size_t hash = hash_key(text, styleMap);
+
+    auto range = index.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+        auto& entry = *it->second;
+        if (entry.text == text && entry.styleMap == styleMap &&
+            entry.palette == styles.palette) {
+            hits++;
+            entries.splice(entries.begin(), entries, it->second);
+            return entry.run;
+        }
+    }
+    misses++;
+    // layout may clear the cache (new codepage rendered)
+    auto run = GlyphRun::layout(font, text, stylesPtr, styleMapOffset);
+
+    while (!entries.empty() && length + text.length() > capacity) {
+        auto last = std::prev(entries.end());
+        auto range = index.equal_range(last->hash);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second == last) {
+                index.erase(it);
+                break;
+            }
+        }
+        length -= last->text.length();
+        entries.erase(last);
+    }
+    entries.push_front(Entry {
+        hash, std::wstring(text), styleMap, styles.palette, std::move(run)});
+    index.emplace(hash, entries.begin());
+    length += text.length();
+    return entries.front().run;
+}
+
+void GlyphRunCache::clear() {
+    entries.clear();
+    index.clear();
+    length = 0;
+}
+
+size_t GlyphRunCache::size() const {
+    return entries.size();
+}
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "typedefs.hpp"
+#include "Batch2D.hpp"
+#include "Batch3D.hpp"
+#include "../commons/FontStyle.hpp"
+
+class Font;
+struct FontMetrics;
+
+/// @brief Glyph positioned relative to the text origin
+struct PlacedGlyph {
+    uint codepoint;
+    /// @brief Number of glyph intervals before the glyph
+    /// (missing and non-printable characters)
+    int cells;
+    /// @brief Sum of glyphs advance before the glyph (pixels)
+    int pixels;
+    /// @brief Glyph vertical offset (pixels)
+    int yOffset;
+    FontStyle style;
+};
+
+/// @brief Glyphs sequence sharing the same codepage texture
+struct GlyphRunSegment {
+    uint page;
+    size_t count;
+};
+
+/// @brief Placement of the text the vertices were generated for.
+/// Vertices are relative to the text origin, so the position is not
+/// a part of the placement (see Batch2D::triangles offset)
+struct GlyphRunPlacement {
+    /// @brief Glyph interval vector
+    glm::vec3 right;
+    /// @brief Line height vector
+    glm::vec3 up;
+    /// @brief Batch color used instead of the white style color
+    glm::vec4 color;
+
+    bool operator==(const GlyphRunPlacement& other) const {
+        return right == other.right && up == other.up &&
+               color == other.color;
+    }
+};
+
+/// @brief Prepared vertices of the run relative to the text origin
+template <typename Vertex>
+struct GlyphRunMesh {
+    GlyphRunPlacement placement {};
+    std::vector<Vertex> vertices;
+    /// @brief Number of vertices of each run segment
+    std::vector<size_t> counts;
+    bool built = false;
+
+    bool matches(const GlyphRunPlacement& placement) const {
+        return built && this->placement == placement;
+    }
+};
+
+/// @brief Laid out text: glyphs grouped by codepage in drawing order.
+/// Decoration glyphs (underline and strikethrough) are placed at the end
+class GlyphRun {
+public:
+    std::vector<PlacedGlyph> glyphs;
+    std::vector<GlyphRunSegment> segments;
+
+    GlyphRunMesh<Batch2DVertex> mesh2D;
+    GlyphRunMesh<Batch3DVertex> mesh3D;
+
+    /// @brief Lay out the text
+    /// @param font font providing glyphs metrics. If nullptr, each
+    /// character takes a glyph interval
+    /// @param text target text
+    /// @param styles text styles scheme (nullable)
+    /// @param styleMapOffset offset of the text in the styles map
+    static GlyphRun layout(
+        Font* font,
+        std::wstring_view text,
+        const FontStylesScheme* styles,
+        size_t styleMapOffset
+    );
+
+    /// @brief Lay out the text using font of the metrics (if set)
+    static GlyphRun layout(
+        const FontMetrics& metrics,
+        std::wstring_view text,
+        const FontStylesScheme* styles,
+        size_t styleMapOffset
+    );
+
+    /// @brief Generate Batch2D vertices (sprites)
+    /// @param placement placement (right and up are axis-aligned)
+    /// @param lineHeight font line height (pixels)
+    /// @param glyphInterval glyph interval to line height ratio
+    /// @param regions UV regions of segments pages textures
+    void build(
+        GlyphRunMesh<Batch2DVertex>& mesh,
+        const GlyphRunPlacement& placement,
+        int lineHeight,
+        float glyphInterval,
+        const std::vector<UVRegion>& regions
+    ) const;
+
+    /// @brief Generate Batch3D vertices (billboard sprites)
+    /// @param placement placement (right and up are arbitrary)
+    /// @param lineHeight font line height (pixels)
+    /// @param glyphInterval glyph interval to line height ratio
+    /// @param regions UV regions of segments pages textures
+    void build(
+        GlyphRunMesh<Batch3DVertex>& mesh,
+        const GlyphRunPlacement& placement,
+        int lineHeight,
+        float glyphInterval,
+        const std::vector<UVRegion>& regions
+    ) const;
+};
+
+/// @brief LRU cache of font glyph runs keyed by text and styles.
+/// Must be cleared when font glyphs metrics change
+class GlyphRunCache {
+public:
+    /// @param capacity max total length of cached texts
+    GlyphRunCache(size_t capacity);
+
+    /// @brief Get cached or lay out a new run
+    /// @return run reference valid until the next get or clear call
+    GlyphRun& get(
+        Font* font,
+        std::wstring_view text,
+        const FontStylesScheme* styles,
+        size_t styleMapOffset
+    );
+
+    void clear();
+
+    /// @brief Get number of cached runs
+    size_t size() const;
+
+    size_t getHits() const {
+        return hits;
+    }
+
+    size_t getMisses() const {
+        return misses;
+    }
+private:
+    struct Entry {
+        size_t hash;
+        std::wstring text;
+        /// @brief Style index of each character
+        std::vector<ubyte> styleMap;
+        std::vector<FontStyle> palette;
+        GlyphRun run;
+    };
+    size_t capacity;
+    /// @brief Total length of cached texts
+    size_t length = 0;
+    size_t hits = 0;
+    size_t misses = 0;
+    /// @brief Entries from most to least recently used
+    std::list<Entry> entries;
+    std::unordered_multimap<size_t, std::list<Entry>::iterator> index;
+    /// @brief Uncacheable (too long) text run
+    GlyphRun scratch;
+    /// @brief Style indices of the requested text (reused buffer)
+    std::vector<ubyte> styleMap;
+};
@@ -389,10 +389,14 @@ void ImageData::extrude(int x, int y, int w, int h) {
 
 // Fixing black transparent pixels for Mip-Mapping
 void ImageData::fixAlphaColor() {
+    fixAlphaColor(0, 0, width, height);
+}
+
+void ImageData::fixAlphaColor(uint x, uint y, uint w, uint h) {
     int samples = 0;
     int sums[3] {};
-    for (uint ly = 0; ly < height; ly++) {
-        for (uint lx = 0; lx < width; lx++) {
+    for (uint ly = y; ly < y + h; ly++) {
+        for (uint lx = x; lx < x + w; lx++) {
             if (data[(ly * width + lx) * 4 + 3] == 0) {
                 continue;
             }
@@ -408,8 +412,8 @@ void ImageData::fixAlphaColor() {
     for (int i = 0; i < 3; i++) {
         sums[i] /= samples;
     }
-    for (uint ly = 0; ly < height; ly++) {
-        for (uint lx = 0; lx < width; lx++) {
+    for (uint ly = y; ly < y + h; ly++) {
+        for (uint lx = x; lx < x + w; lx++) {
             if (data[(ly * width + lx) * 4 + 3] != 0) {
                 continue;
             }
@@ -32,6 +32,8 @@ public:
     void blit(const ImageData& image, int x, int y);
     void extrude(int x, int y, int w, int h);
     void fixAlphaColor();
+    /// @brief Fix transparent pixels color in the RGBA image region
+    void fixAlphaColor(uint x, uint y, uint w, uint h);
     void mulColor(const glm::ivec4& color);
     void mulColor(const ImageData& other);
     void addColor(const glm::ivec4& color, int multiplier);
@@ -1,6 +1,7 @@
 #include "ChunksRenderer.hpp"
 #include "BlocksRenderer.hpp"
 #include "debug/Logger.hpp"
+#include "debug/Profiler.hpp"
 #include "assets/Assets.hpp"
 #include "graphics/core/Mesh.hpp"
 #include "graphics/core/Shader.hpp"
@@ -42,6 +43,7 @@ public:
     RendererResult operator()(const RendererJob& job) override {
         auto chunk = job.chunk;
         auto volume = job.volume;
+        VC_PROFILE_SCOPE("ChunksRenderer::build");
         renderer.build(chunk.get(), *volume);
         if (renderer.isCancelled()) {
             return RendererResult {
@@ -175,6 +177,7 @@ const ChunkMesh* ChunksRenderer::getOrRender(
 }
 
 void ChunksRenderer::update() {
+    VC_PROFILE_SCOPE("ChunksRenderer::update");
     threadPool.pullResults();
     enqueuedInFrame = 0;
 }
@@ -281,6 +284,7 @@ void ChunksRenderer::drawShadowsPass(
 void ChunksRenderer::drawChunks(
     const Camera& camera, Shader& shader
 ) {
+    VC_PROFILE_SCOPE("ChunksRenderer::drawChunks");
     const auto& atlas = assets.require<Atlas>("blocks");
 
     atlas.getTexture()->bind();
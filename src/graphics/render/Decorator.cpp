@@ -20,6 +20,7 @@
 #include "TextsRenderer.hpp"
 #include "util/stringutil.hpp"
 #include "voxels/Block.hpp"
+#include "voxels/blocks_agent.hpp"
 #include "voxels/Chunk.hpp"
 #include "voxels/Chunks.hpp"
 #include "window/Camera.hpp"
@@ -52,6 +53,12 @@ Decorator::Decorator(
       settings(engine.getSettings()),
       player(player),
       renderer(renderer) {
+    const auto& blocks = level.content.getIndices()->blocks;
+    blockMaterials.resize(blocks.count());
+    for (size_t id = 0; id < blocks.count(); id++) {
+        blockMaterials[id] =
+            level.content.findBlockMaterial(blocks.get(id)->material);
+    }
     controller.getBlocksController()->listenBlockInteraction(
     [this](auto player, const auto& pos, const auto& def, BlockInteraction type) {
         if (type == BlockInteraction::placing && def.particles) {
@@ -100,15 +107,15 @@ void Decorator::updateAcoustics(const Camera& camera) {
     const auto& start = camera.position;
     float rayLength = 40.0f;
 
-    auto& blocks = level.content.getIndices()->blocks;
-
     int rays = 100;
     int hit = 0;
     float averageDistance = 0.0f;
     float averageAbsorption = 0.0f;
     float speedOfSound = 300.0f;
     float minDistance = rayLength;
-    for (int i = 0; i < rays; i++) {
+
+    std::vector<blocks_agent::RaycastQuery> queries(rays);
+    for (auto& query : queries) {
         float u1 = random.randFloat();
         float u2 = random.randFloat();
         float z = 2.0f * u1 - 1.0f;
@@ -116,27 +123,26 @@ void Decorator::updateAcoustics(const Camera& camera) {
         float r = std::sqrt(1.0f - z * z);
 
         glm::vec3 dir = { r * std::cos(phi), r * std::sin(phi), z };
+        query = {start, glm::normalize(dir), rayLength};
+    }
+    auto hits = blocks_agent::raycast(chunks, queries);
 
-        dir = glm::normalize(dir);
-        glm::vec3 end;
-        glm::ivec3 norm;
-        glm::ivec3 iend;
-        auto vox = chunks.rayCast(start, dir, rayLength, end, norm, iend);
+    for (const auto& rayHit : hits) {
+        auto vox = rayHit.vox;
         if (vox == nullptr) {
             continue;
         }
-        auto distance = glm::distance(start, end);
+        auto distance = glm::distance(start, rayHit.end);
         if (distance >= rayLength * 0.98f) {
             continue;
         }
         if (distance < minDistance) {
             minDistance = distance;
         }
-        auto def = blocks.get(vox->id);
-        if (def == nullptr) {
+        if (vox->id >= blockMaterials.size()) {
             continue;
         }
-        auto material = level.content.findBlockMaterial(def->material);
+        auto material = blockMaterials[vox->id];
         if (material == nullptr) {
             return;
         }
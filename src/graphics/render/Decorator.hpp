@@ -5,6 +5,7 @@
 #include <glm/gtx/hash.hpp>
 
 #include <unordered_map>
+#include <vector>
 
 #include "typedefs.hpp"
 #include "presets/NotePreset.hpp"
@@ -20,6 +21,7 @@ class LevelController;
 class WorldRenderer;
 struct Weather;
 struct WeatherPreset;
+struct BlockMaterial;
 struct EngineSettings;
 
 class Decorator {
@@ -33,6 +35,8 @@ class Decorator {
     int currentIndex = 0;
     NotePreset playerNamePreset {};
     float thunderTimer = 0.0f;
+    /// @brief Block materials by block id
+    std::vector<const BlockMaterial*> blockMaterials;
 
     void update(
         float delta,
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <cassert>
 #include <memory>
 #include <cstdint>
 #include <glm/glm.hpp>
@@ -55,10 +56,50 @@ public:
     void setTexture(const Texture* texture, const UVRegion& region);
     void flush();
 
+    /// @brief Get number of vertices that can be added without flush
+    size_t available() const {
+        return capacity - index;
+    }
+
+    /// @brief Reserve space for vertices to be written directly
+    /// @param count number of vertices (not greater than available())
+    /// @return pointer to the reserved vertices
+    MainBatchVertex* reserve(size_t count) {
+        assert(count <= available());
+        MainBatchVertex* vertices = buffer.get() + index;
+        index += count;
+        return vertices;
+    }
+
     static glm::vec4 sampleLight(
         const glm::vec3& pos, const Chunks& chunks, bool backlight
     );
 
+    /// @param uv texture coordinates (region applied)
+    static inline void write(
+        MainBatchVertex& dst,
+        const glm::vec3& pos,
+        const glm::vec2& uv,
+        const glm::vec4& light,
+        const glm::vec3& tint,
+        const glm::vec3& normal,
+        float emission
+    ) {
+        dst.position = pos;
+        dst.uv = uv;
+        dst.tint = tint;
+
+        dst.color[0] = static_cast<uint8_t>(light.r * 255);
+        dst.color[1] = static_cast<uint8_t>(light.g * 255);
+        dst.color[2] = static_cast<uint8_t>(light.b * 255);
+        dst.color[3] = static_cast<uint8_t>(light.a * 255);
+
+        dst.normal[0] = static_cast<uint8_t>(normal.x * 127 + 128);
+        dst.normal[1] = static_cast<uint8_t>(normal.y * 127 + 128);
+        dst.normal[2] = static_cast<uint8_t>(normal.z * 127 + 128);
+        dst.normal[3] = static_cast<uint8_t>(emission * 255);
+    }
+
     inline void vertex(
         const glm::vec3& pos,
         const glm::vec2& uv,
@@ -67,21 +108,16 @@ public:
         const glm::vec3& normal,
         float emission
     ) {
-        MainBatchVertex* buffer = this->buffer.get();
-        buffer[index].position = pos;
-        buffer[index].uv = {uv.x * region.getWidth() + region.u1,uv.y * region.getHeight() + region.v1};
-        buffer[index].tint = tint;
-
-        buffer[index].color[0] = static_cast<uint8_t>(light.r * 255);
-        buffer[index].color[1] = static_cast<uint8_t>(light.g * 255);
-        buffer[index].color[2] = static_cast<uint8_t>(light.b * 255);
-        buffer[index].color[3] = static_cast<uint8_t>(light.a * 255);
-
-        buffer[index].normal[0] = static_cast<uint8_t>(normal.x * 127 + 128);
-        buffer[index].normal[1] = static_cast<uint8_t>(normal.y * 127 + 128);
-        buffer[index].normal[2] = static_cast<uint8_t>(normal.z * 127 + 128);
-        buffer[index].normal[3] = static_cast<uint8_t>(emission * 255);
-        index++;
+        write(
+            buffer[index++],
+            pos,
+            {uv.x * region.getWidth() + region.u1,
+             uv.y * region.getHeight() + region.v1},
+            light,
+            tint,
+            normal,
+            emission
+        );
     }
 
     inline void quad(
@@ -10,6 +10,7 @@
 #include "lighting/Lightmap.hpp"
 #include "settings.hpp"
 #include "MainBatch.hpp"
+#include "util/parallel.hpp"
 
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/ext/matrix_transform.hpp>
@@ -18,10 +19,23 @@
 
 #include <algorithm>
 
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <xmmintrin.h>
+    #define VC_MODEL_BATCH_SSE
+#endif
+
 inline constexpr glm::vec3 X(1, 0, 0);
 inline constexpr glm::vec3 Y(0, 1, 0);
 inline constexpr glm::vec3 Z(0, 0, 1);
 
+/// @brief Min number of pending vertices to generate them concurrently
+inline constexpr size_t PARALLEL_MIN_VERTICES = 8192;
+/// @brief Max number of threads generating vertices
+inline constexpr uint MAX_THREADS = 4;
+/// @brief Min number of vertices per slice
+inline constexpr size_t MIN_SLICE_VERTICES = 3 * 256;
+
 struct DecomposedMat4 {
     glm::vec3 scale;
     glm::mat3 rotation;
@@ -57,43 +71,88 @@ ModelBatch::ModelBatch(
 
 ModelBatch::~ModelBatch() = default;
 
-void ModelBatch::draw(
+#ifdef VC_MODEL_BATCH_SSE
+/// @brief Same operations order as in glm operator* for equal results
+static inline glm::vec3 transform(
+    const __m128 (&columns)[4], const glm::vec3& vec
+) {
+    __m128 xy = _mm_add_ps(
+        _mm_mul_ps(columns[0], _mm_set1_ps(vec.x)),
+        _mm_mul_ps(columns[1], _mm_set1_ps(vec.y))
+    );
+    __m128 zw = _mm_add_ps(
+        _mm_mul_ps(columns[2], _mm_set1_ps(vec.z)), columns[3]
+    );
+    alignas(16) float result[4];
+    _mm_store_ps(result, _mm_add_ps(xy, zw));
+    return {result[0], result[1], result[2]};
+}
+
+static inline glm::vec3 rotate(
+    const __m128 (&columns)[3], const glm::vec3& vec
+) {
+    __m128 xy = _mm_add_ps(
+        _mm_mul_ps(columns[0], _mm_set1_ps(vec.x)),
+        _mm_mul_ps(columns[1], _mm_set1_ps(vec.y))
+    );
+    alignas(16) float result[4];
+    _mm_store_ps(
+        result, _mm_add_ps(xy, _mm_mul_ps(columns[2], _mm_set1_ps(vec.z)))
+    );
+    return {result[0], result[1], result[2]};
+}
+#endif
+
+void ModelBatch::generateVertices(
     const model::Mesh& mesh,
+    size_t first,
+    size_t count,
     const glm::mat4& matrix,
     const glm::mat3& rotation,
-    glm::vec3 tint,
-    const texture_names_map* varTextures,
-    bool backlight
+    const glm::vec3& tint,
+    const glm::vec4& lights,
+    const UVRegion& region,
+    MainBatchVertex* dst
 ) {
-    setTexture(mesh.texture, varTextures);
-    size_t vcount = mesh.vertices.size();
-    const auto& vertexData = mesh.vertices.data();
-
-    glm::vec4 lights(1, 1, 1, 0);
-    if (mesh.shading) {
-        glm::vec3 gpos = matrix * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
-        gpos += lightsOffset;
-        lights = MainBatch::sampleLight(gpos, chunks, backlight);
+    const auto vertexData = mesh.vertices.data() + first;
+    float emission = mesh.shading ? 0.0f : 1.0f;
+    float regionWidth = region.getWidth();
+    float regionHeight = region.getHeight();
+#ifdef VC_MODEL_BATCH_SSE
+    __m128 matrixColumns[4];
+    for (int i = 0; i < 4; i++) {
+        matrixColumns[i] = _mm_loadu_ps(&matrix[i][0]);
     }
-    for (size_t i = 0; i < vcount / 3; i++) {
-        batch->prepare(3);
-        for (size_t j = 0; j < 3; j++) {
-            const auto vert = vertexData[i * 3 + j];
-            float d = 1.0f;
-            auto norm = rotation * vert.normal;
-            if (mesh.shading) {
-                d = glm::dot(norm, SUN_VECTOR);
-                d = 0.8f + d * 0.2f;
-            }
-            batch->vertex(
-                matrix * glm::vec4(vert.coord, 1.0f),
-                vert.uv,
-                lights * d,
-                tint,
-                norm,
-                mesh.shading ? 0.0f : 1.0f
-            );
+    __m128 rotationColumns[3];
+    for (int i = 0; i < 3; i++) {
+        const auto& column = rotation[i];
+        rotationColumns[i] = _mm_setr_ps(column.x, column.y, column.z, 0.0f);
+    }
+#endif
+    for (size_t i = 0; i < count; i++) {
+        const auto& vert = vertexData[i];
+#ifdef VC_MODEL_BATCH_SSE
+        auto pos = transform(matrixColumns, vert.coord);
+        auto norm = rotate(rotationColumns, vert.normal);
+#else
+        glm::vec3 pos = matrix * glm::vec4(vert.coord, 1.0f);
+        auto norm = rotation * vert.normal;
+#endif
+        float d = 1.0f;
+        if (mesh.shading) {
+            d = glm::dot(norm, SUN_VECTOR);
+            d = 0.8f + d * 0.2f;
         }
+        MainBatch::write(
+            dst[i],
+            pos,
+            {vert.uv.x * regionWidth + region.u1,
+             vert.uv.y * regionHeight + region.v1},
+            lights * d,
+            tint,
+            norm,
+            emission
+        );
     }
 }
 
@@ -103,46 +162,123 @@ void ModelBatch::draw(glm::mat4 matrix,
                       const texture_names_map* varTextures) {
     for (const auto& mesh : model->meshes) {
         entries.push_back({
-            matrix, extract_rotation(matrix), tint, &mesh, varTextures
+            matrix,
+            extract_rotation(matrix),
+            tint,
+            &mesh,
+            varTextures,
+            nullptr,
+            UVRegion(),
+            0
         });
     }
 }
 
 void ModelBatch::render() {
-    std::sort(entries.begin(), entries.end(), 
+    for (auto& entry : entries) {
+        auto texture = getTexture(entry.mesh->texture, entry.varTextures);
+        entry.texture = texture.texture;
+        entry.region = texture.region;
+        auto found = textureIndices.find(entry.texture);
+        if (found == textureIndices.end()) {
+            uint32_t index = textureIndices.size();
+            found = textureIndices.emplace(entry.texture, index).first;
+        }
+        entry.textureIndex = found->second;
+    }
+    std::stable_sort(entries.begin(), entries.end(),
         [](const DrawEntry& a, const DrawEntry& b) {
-            return a.mesh->texture < b.mesh->texture;
+            return a.textureIndex < b.textureIndex;
         }
     );
     bool backlight = settings.graphics.backlight.get();
-    for (auto& entry : entries) {
-        draw(
-            *entry.mesh,
+    for (size_t i = 0; i < entries.size(); i++) {
+        const auto& entry = entries[i];
+        if (i == 0 || entry.texture != entries[i - 1].texture) {
+            writeSlices(backlight);
+            batch->setTexture(entry.texture);
+        }
+        size_t vcount = entry.mesh->vertices.size() / 3 * 3;
+        for (size_t first = 0; first < vcount;) {
+            size_t count = std::min(vcount - first, batch->available() / 3 * 3);
+            if (count == 0) {
+                writeSlices(backlight);
+                batch->flush();
+                continue;
+            }
+            // big parts are split to be shared between threads
+            if (count > MIN_SLICE_VERTICES * 2) {
+                count = std::max(
+                    MIN_SLICE_VERTICES, count / (MAX_THREADS * 3) * 3
+                );
+            }
+            slices.push_back({&entry, first, count, batch->reserve(count)});
+            first += count;
+        }
+    }
+    writeSlices(backlight);
+    batch->flush();
+    entries.clear();
+    textureIndices.clear();
+}
+
+void ModelBatch::writeSlices(bool backlight) {
+    size_t vertices = 0;
+    for (const auto& slice : slices) {
+        vertices += slice.count;
+    }
+    auto writeSlice = [this, backlight](size_t index) {
+        const auto& slice = slices[index];
+        const auto& entry = *slice.entry;
+        const auto& mesh = *entry.mesh;
+        glm::vec4 lights(1, 1, 1, 0);
+        if (mesh.shading) {
+            glm::vec3 gpos = entry.matrix * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+            gpos += lightsOffset;
+            lights = MainBatch::sampleLight(gpos, chunks, backlight);
+        }
+        generateVertices(
+            mesh,
+            slice.first,
+            slice.count,
             entry.matrix,
             entry.rotation,
             entry.tint,
-            entry.varTextures,
-            backlight
+            lights,
+            entry.region,
+            slice.dst
         );
+    };
+    if (vertices >= PARALLEL_MIN_VERTICES) {
+        if (pool == nullptr) {
+            pool = std::make_unique<util::ParallelPool>(
+                std::min(util::get_hardware_threads(), MAX_THREADS)
+            );
+        }
+        pool->run(slices.size(), writeSlice);
+    } else {
+        for (size_t i = 0; i < slices.size(); i++) {
+            writeSlice(i);
+        }
     }
-    batch->flush();
-    entries.clear();
+    slices.clear();
 }
 
 void ModelBatch::setLightsOffset(const glm::vec3& offset) {
     lightsOffset = offset;
 }
 
-void ModelBatch::setTexture(const std::string& name,
-                            const texture_names_map* varTextures) {
+ModelBatch::TextureRegion ModelBatch::getTexture(
+    const std::string& name, const texture_names_map* varTextures
+) const {
     if (varTextures && !name.empty() && name.at(0) == '$') {
         const auto& found = varTextures->find(name);
         if (found == varTextures->end()) {
-            return batch->setTexture(nullptr);
+            return {nullptr, UVRegion()};
         } else {
-            return setTexture(found->second, varTextures);
+            return getTexture(found->second, varTextures);
         }
     }
     auto region = util::get_texture_region(assets, name, "blocks:notfound");
-    batch->setTexture(region.texture, region.region);
+    return {region.texture, region.region};
 }
@@ -6,18 +6,25 @@
 #include <glm/glm.hpp>
 #include <unordered_map>
 
+#include "maths/UVRegion.hpp"
+
 template<typename VertexStructure> class Mesh;
 class Texture;
 class Chunks;
 class Assets;
 struct EngineSettings;
 class MainBatch;
+struct MainBatchVertex;
 
 namespace model {
     struct Mesh;
     struct Model;
 }
 
+namespace util {
+    class ParallelPool;
+}
+
 using texture_names_map = std::unordered_map<std::string, std::string>;
 
 class ModelBatch {
@@ -31,15 +38,14 @@ class ModelBatch {
 
     std::unique_ptr<MainBatch> batch;
 
-    void draw(const model::Mesh& mesh, 
-              const glm::mat4& matrix, 
-              const glm::mat3& rotation, 
-              glm::vec3 tint,
-              const texture_names_map* varTextures,
-              bool backlight);
+    struct TextureRegion {
+        const Texture* texture;
+        UVRegion region;
+    };
 
-    void setTexture(const std::string& name,
-                    const texture_names_map* varTextures);
+    TextureRegion getTexture(
+        const std::string& name, const texture_names_map* varTextures
+    ) const;
 
     struct DrawEntry {
         glm::mat4 matrix;
@@ -47,8 +53,26 @@ class ModelBatch {
         glm::vec3 tint;
         const model::Mesh* mesh;
         const texture_names_map* varTextures;
+        const Texture* texture;
+        UVRegion region;
+        /// @brief Texture index used to group entries
+        uint32_t textureIndex;
+    };
+    /// @brief Part of entry vertices to be written to the batch buffer
+    struct VerticesSlice {
+        const DrawEntry* entry;
+        size_t first;
+        size_t count;
+        MainBatchVertex* dst;
     };
     std::vector<DrawEntry> entries;
+    std::vector<VerticesSlice> slices;
+    std::unordered_map<const Texture*, uint32_t> textureIndices;
+    /// @brief Vertices generation workers (created on first use)
+    std::unique_ptr<util::ParallelPool> pool;
+
+    /// @brief Generate vertices for all pending slices
+    void writeSlices(bool backlight);
 public:
     ModelBatch(
         size_t capacity,
@@ -65,4 +89,23 @@ public:
     void render();
 
     void setLightsOffset(const glm::vec3& offset);
+
+    /// @brief Generate transformed mesh vertices. Thread-safe
+    /// @param mesh source mesh
+    /// @param first index of the first mesh vertex
+    /// @param count number of vertices
+    /// @param lights mesh light (used if mesh shading is enabled)
+    /// @param region texture region
+    /// @param dst destination vertices
+    static void generateVertices(
+        const model::Mesh& mesh,
+        size_t first,
+        size_t count,
+        const glm::mat4& matrix,
+        const glm::mat3& rotation,
+        const glm::vec3& tint,
+        const glm::vec4& lights,
+        const UVRegion& region,
+        MainBatchVertex* dst
+    );
 };
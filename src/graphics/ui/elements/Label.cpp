@@ -1,5 +1,7 @@
 #include "Label.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <utility>
 
 #include "assets/Assets.hpp"
@@ -29,12 +31,12 @@ size_t LabelCache::getTextLineOffset(size_t line) const {
 }
 
 uint LabelCache::getLineByTextIndex(size_t index) const {
-    for (size_t i = 0; i < lines.size(); i++) {
-        if (lines[i].offset > index) {
-            return i-1;
+    auto found = std::upper_bound(
+        lines.begin(), lines.end(), index, [](size_t index, const auto& line) {
+            return index < line.offset;
         }
-    }
-    return lines.size()-1;
+    );
+    return found - lines.begin() - 1;
 }
 
 void LabelCache::update(std::wstring_view text, bool multiline, bool wrap) {
@@ -48,18 +50,21 @@ void LabelCache::update(std::wstring_view text, bool multiline, bool wrap) {
     }
     
     if (multiline) {
-        size_t lineStart = 0;
+        // width of the current line
+        size_t lineWidth = 0;
         for (size_t i = 0; i < text.length(); i++) {
             if (text[i] == L'\n') {
                 lines.push_back(LineScheme {i + 1, false});
-                lineStart = i + 1;
-            } else if (i + 1 < text.length() && wrap && text[i + 1] != L'\n') {
-                size_t width =
-                    metrics.calcWidth(text, lineStart, i - lineStart + 2);
+                lineWidth = 0;
+                continue;
+            }
+            lineWidth += metrics.calcWidth(text, i, 1);
+            if (i + 1 < text.length() && wrap && text[i + 1] != L'\n') {
+                size_t width = lineWidth + metrics.calcWidth(text, i + 1, 1);
                 if (width >= wrapWidth) {
                     // starting a fake line
                     lines.push_back(LineScheme {i + 1, true});
-                    lineStart = i + 1;
+                    lineWidth = 0;
                 }
             }
         }
@@ -83,7 +88,9 @@ void LabelCache::update(std::wstring_view text, bool multiline, bool wrap) {
             ),
             maxWidth
         );
-        multilineWidth = maxWidth;
+        width = maxWidth;
+    } else {
+        width = metrics.calcWidth(text);
     }
 }
 
@@ -114,15 +121,8 @@ glm::vec2 Label::calcSize() {
     if (cache.lines.size() > 1) {
         lineHeight *= lineInterval;
     }
-    auto view = std::wstring_view(text);
-    if (multiline) {
-        return glm::vec2(
-            cache.multilineWidth,
-            lineHeight * cache.lines.size() + metrics.yoffset
-        );
-    }
-    return glm::vec2 (
-        cache.metrics.calcWidth(view), 
+    return glm::vec2(
+        cache.width,
         lineHeight * cache.lines.size() + metrics.yoffset
     );
 }
@@ -256,8 +256,16 @@ void Label::draw(const DrawContext& pctx, const Assets& assets) {
         bounds.w = std::min(bounds.w, ppos.y + psize.y);
     }
     if (multiline) {
-        // todo: reduce loop range to the actual area
-        for (size_t i = 0; i < cache.lines.size(); i++) {
+        // skip lines out of the bounds without checking each one
+        size_t start = 0;
+        size_t end = cache.lines.size();
+        if (totalLineHeight > 0) {
+            int first = std::floor((bounds.y - pos.y) / totalLineHeight) - 1;
+            int last = std::ceil((bounds.w - pos.y) / totalLineHeight) + 1;
+            start = std::max(first, 0);
+            end = std::min<size_t>(std::max(last, 0), end);
+        }
+        for (size_t i = start; i < end; i++) {
             float y = pos.y + i * totalLineHeight;
             if (y + totalLineHeight < bounds.y || y > bounds.w) {
                 continue;
@@ -21,7 +21,8 @@ namespace gui {
         /// @brief Reset cache flag
         bool resetFlag = true;
         size_t wrapWidth = -1;
-        int multilineWidth = 0;
+        /// @brief Max line width (pixels)
+        int width = 0;
     
         void prepare(const std::shared_ptr<Font>& font, FontMetrics metrics, size_t wrapWidth);
         void update(std::wstring_view text, bool multiline, bool wrap);
@@ -377,7 +377,15 @@ void TextBox::drawBackground(const DrawContext& pctx, const Assets& assets) {
 
     batch->rect(pos.x, pos.y, size.x, size.y);
     if (!isFocused() && supplier) {
-        input = supplier();
+        auto text = supplier();
+        if (text != input) {
+            input = std::move(text);
+            inputRevision++;
+            if (highlighting) {
+                highlighting->reset(input);
+            }
+            refreshSyntax();
+        }
     }
     refreshLabel();
 }
@@ -391,7 +399,7 @@ void TextBox::refreshLabel() {
         rawTextCache.metrics,
         static_cast<size_t>(getSize().x)
     );
-    rawTextCache.update(input, multiline, false);
+    refreshRawTextCache(false);
 
     label->setColor(textColor * glm::vec4(input.empty() ? 0.5f : 1.0f));
 
@@ -456,6 +464,17 @@ void TextBox::refreshLabel() {
     }
 }
 
+void TextBox::refreshRawTextCache(bool wrap) {
+    if (!rawTextCache.resetFlag && rawTextRevision == inputRevision &&
+        rawTextWrap == wrap && rawTextMultiline == multiline) {
+        return;
+    }
+    rawTextCache.update(input, multiline, wrap);
+    rawTextRevision = inputRevision;
+    rawTextWrap = wrap;
+    rawTextMultiline = multiline;
+}
+
 /// @brief Insert text at the caret. Also selected text will be erased
 /// @param text Inserting text
 void TextBox::paste(const std::wstring& text, bool history) {
@@ -465,13 +484,9 @@ void TextBox::paste(const std::wstring& text, bool history) {
         std::remove(inputText.begin(), inputText.end(), '\r'), inputText.end()
     );
     historian->onPaste(caret, inputText);
-    if (caret >= input.length()) {
-        input += inputText;
-    } else {
-        auto left = input.substr(0, caret);
-        auto right = input.substr(caret);
-        input = left + inputText + right;
-    }
+    size_t position = std::min(caret, input.length());
+    input.insert(position, inputText);
+    onTextEdited(position, 0, inputText.length());
     refreshLabel();
     setCaret(caret + inputText.length());
     if (validate()) {
@@ -487,9 +502,9 @@ void TextBox::erase(size_t start, size_t length) {
     if (caret > start) {
         setCaret(caret - length);
     }
-    auto left = input.substr(0, start);
-    auto right = end >= input.length() ? L"" : input.substr(end);
-    input = left + right;
+    size_t erased = std::min(end, input.length()) - start;
+    input.erase(start, erased);
+    onTextEdited(start, erased, 0);
 }
 
 /// @brief Remove all selected text and reset selection
@@ -906,14 +921,19 @@ void TextBox::onTab(bool shiftPressed) {
     historian->sync();
 }
 
+void TextBox::onTextEdited(size_t position, size_t erased, size_t inserted) {
+    inputRevision++;
+    if (highlighting) {
+        highlighting->update(input, position, erased, inserted);
+    }
+}
+
 void TextBox::refreshSyntax() {
-    if (!syntax.empty()) {
-        const auto& processor = gui.getEditor().getSyntaxProcessor();
+    if (highlighting) {
         auto scheme = gui.getSyntaxColorScheme();
-        if (auto styles =
-                processor.highlight(scheme ? *scheme : FontStylesScheme {}, syntax, input)) {
-            label->setStyles(std::move(styles));
-        }
+        label->setStyles(
+            highlighting->build(scheme ? *scheme : FontStylesScheme {})
+        );
     }
 }
 
@@ -942,7 +962,8 @@ void TextBox::performEditingKeyboardEvents(Keycode key) {
                 caret = input.length();
             }
             historian->onErase(caret - 1, input.substr(caret - 1, 1));
-            input = input.substr(0, caret - 1) + input.substr(caret);
+            input.erase(caret - 1, 1);
+            onTextEdited(caret - 1, 1, 0);
             setCaret(caret - 1);
             if (validate()) {
                 onInput();
@@ -951,7 +972,8 @@ void TextBox::performEditingKeyboardEvents(Keycode key) {
     } else if (key == Keycode::DELETE) {
         if (!eraseSelected() && caret < input.length()) {
             historian->onErase(caret, input.substr(caret, 1));
-            input = input.substr(0, caret) + input.substr(caret + 1);
+            input.erase(caret, 1);
+            onTextEdited(caret, 1, 0);
             if (validate()) {
                 onInput();
             }
@@ -1162,9 +1184,13 @@ const std::wstring& TextBox::getText() const {
 void TextBox::setText(const std::wstring& value) {
     this->input = value;
     input.erase(std::remove(input.begin(), input.end(), '\r'), input.end());
+    inputRevision++;
     historian->reset();
     history->clear();
     editedHistorySize = 0;
+    if (highlighting) {
+        highlighting->reset(input);
+    }
     refreshSyntax();
 }
 
@@ -1206,7 +1232,7 @@ void TextBox::setCaret(size_t position) {
     int width = size.x - padding.x - padding.z - LINE_NUMBERS_PANE_WIDTH * showLineNumbers;
 
     rawTextCache.prepare(font, rawTextCache.metrics, width);
-    rawTextCache.update(input, multiline, label->isTextWrapping());
+    refreshRawTextCache(label->isTextWrapping());
 
     caretLastMove = gui.getWindow().time();
 
@@ -1261,8 +1287,14 @@ bool TextBox::isShowLineNumbers() const {
 void TextBox::setSyntax(std::string_view lang) {
     syntax = lang;
     if (syntax.empty()) {
+        highlighting = nullptr;
         label->setStyles(nullptr);
     } else {
+        const auto& processor = gui.getEditor().getSyntaxProcessor();
+        highlighting = processor.createHighlighting(syntax);
+        if (highlighting) {
+            highlighting->reset(input);
+        }
         refreshSyntax();
     }
 }
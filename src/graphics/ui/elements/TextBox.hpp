@@ -6,11 +6,19 @@
 class Font;
 class ActionsHistory;
 
+namespace devtools {
+    class SyntaxHighlighting;
+}
+
 namespace gui {
     class TextBoxHistorian;
     class TextBox : public Container {
         const Input& inputEvents;
         LabelCache rawTextCache;
+        /// @brief Input revision the rawTextCache is built for
+        size_t rawTextRevision = -1;
+        bool rawTextWrap = false;
+        bool rawTextMultiline = false;
         std::shared_ptr<ActionsHistory> history;
         std::unique_ptr<TextBoxHistorian> historian;
         int editedHistorySize = 0;
@@ -23,6 +31,8 @@ namespace gui {
         std::shared_ptr<Label> lineNumbersLabel;
         /// @brief Current user input
         std::wstring input;
+        /// @brief Incremented on every input change
+        size_t inputRevision = 0;
         /// @brief Text will be used if nothing entered
         std::wstring placeholder;
         /// @brief Text will be shown when nothing entered
@@ -65,6 +75,7 @@ namespace gui {
         bool keepLineSelection = false;
         std::string markup;
         std::string syntax;
+        std::unique_ptr<devtools::SyntaxHighlighting> highlighting;
 
         void stepCaret(bool shiftPressed, bool breakSelection, bool right);
         void stepDefaultDown(bool shiftPressed, bool breakSelection);
@@ -90,8 +101,17 @@ namespace gui {
 
         void refreshLabel();
 
+        /// @brief Update rawTextCache if input or layout is changed
+        void refreshRawTextCache(bool wrap);
+
         void onInput();
 
+        /// @brief Update syntax highlighting of the edited text part
+        /// @param position edit position
+        /// @param erased number of characters removed at the position
+        /// @param inserted number of characters inserted at the position
+        void onTextEdited(size_t position, size_t erased, size_t inserted);
+
         void refreshSyntax();
     public:
         explicit TextBox(
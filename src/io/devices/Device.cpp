@@ -1,9 +1,28 @@
 #include "Device.hpp"
 
+#include <stdexcept>
+
 #include "../io.hpp"
 
 using namespace io;
 
+std::vector<util::Buffer<ubyte>> Device::readAll(
+    const std::vector<std::string>& paths
+) {
+    std::vector<util::Buffer<ubyte>> files;
+    files.reserve(paths.size());
+    for (const auto& path : paths) {
+        util::Buffer<ubyte> bytes(size(path));
+        auto stream = read(path);
+        stream->read(reinterpret_cast<char*>(bytes.data()), bytes.size());
+        if (!stream->good()) {
+            throw std::runtime_error("could not to read file " + path);
+        }
+        files.push_back(std::move(bytes));
+    }
+    return files;
+}
+
 SubDevice::SubDevice(
     std::shared_ptr<Device> parent,
     const std::string& path,
@@ -14,3 +33,14 @@ SubDevice::SubDevice(
         this->parent->mkdirs(path);
     }
 }
+
+std::vector<util::Buffer<ubyte>> SubDevice::readAll(
+    const std::vector<std::string>& paths
+) {
+    std::vector<std::string> parentPaths;
+    parentPaths.reserve(paths.size());
+    for (const auto& path : paths) {
+        parentPaths.push_back((root / path).pathPart());
+    }
+    return parent->readAll(parentPaths);
+}
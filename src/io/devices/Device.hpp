@@ -4,8 +4,13 @@
 #include <memory>
 #include <iostream>
 #include <filesystem>
+#include <optional>
+#include <vector>
 
 #include "../path.hpp"
+#include "typedefs.hpp"
+#include "util/Buffer.hpp"
+#include "util/span.hpp"
 
 namespace io {
     /// @brief Device interface for file system operations
@@ -24,6 +29,21 @@ namespace io {
         /// @throw std::runtime_error if file cannot be opened
         virtual std::unique_ptr<std::istream> read(std::string_view path) = 0;
 
+        /// @brief Get file content without copying if the device keeps it
+        /// in memory. Data is valid while the device exists
+        /// @return std::nullopt if not available for the file
+        virtual std::optional<util::span<ubyte>> view(std::string_view path) {
+            return std::nullopt;
+        }
+
+        /// @brief Read whole files content. Devices may read files
+        /// concurrently
+        /// @return files content in the same order
+        /// @throw std::runtime_error if a file cannot be read
+        virtual std::vector<util::Buffer<ubyte>> readAll(
+            const std::vector<std::string>& paths
+        );
+
         /// @brief Get file size in bytes
         virtual size_t size(std::string_view path) = 0;
 
@@ -80,6 +100,14 @@ namespace io {
             return parent->read((root / path).pathPart());
         }
 
+        std::optional<util::span<ubyte>> view(std::string_view path) override {
+            return parent->view((root / path).pathPart());
+        }
+
+        std::vector<util::Buffer<ubyte>> readAll(
+            const std::vector<std::string>& paths
+        ) override;
+
         size_t size(std::string_view path) override {
             return parent->size((root / path).pathPart());
         }
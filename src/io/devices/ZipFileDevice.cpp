@@ -1,14 +1,19 @@
 #include "ZipFileDevice.hpp"
 
+#define ZLIB_CONST
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstring>
 #include <vector>
 
+#include "coders/byte_utils.hpp"
 #include "debug/Logger.hpp"
-#include "io/memory_istream.hpp"
+#include "io/mapped_file.hpp"
 #include "io/memory_ostream.hpp"
 #include "io/deflate_istream.hpp"
 #include "io/deflate_ostream.hpp"
-#include "util/data_io.hpp"
-#include "util/Buffer.hpp"
+#include "util/parallel.hpp"
 
 static debug::Logger logger("zip-file");
 
@@ -20,20 +25,10 @@ static constexpr uint32_t CENTRAL_DIR_SIGNATURE = 0x02014b50;
 static constexpr uint32_t LOCAL_FILE_SIGNATURE = 0x04034b50;
 static constexpr uint32_t COMPRESSION_NONE = 0;
 static constexpr uint32_t COMPRESSION_DEFLATE = 8;
+static constexpr size_t EOCD_SIZE = 22;
+static constexpr size_t LOCAL_HEADER_SIZE = 30;
 
 namespace {
-    template<typename T>
-    T read_int(std::unique_ptr<std::istream>& file) {
-        T value = 0;
-        file->read(reinterpret_cast<char*>(&value), sizeof(value));
-        return dataio::le2h(value);
-    }
-
-    template<typename T>
-    void read_int(std::unique_ptr<std::istream>& file, T& value) {
-        file->read(reinterpret_cast<char*>(&value), sizeof(value));
-        value = dataio::le2h(value);
-    }
     file_time_type msdos_to_file_time(uint16_t date, uint16_t time) {
         uint16_t year = ((date >> 9) & 0x7F) + 1980;
         uint16_t month = (date >> 5) & 0x0F;
@@ -67,33 +62,103 @@ namespace {
         uint16_t time = (tm.tm_hour << 11) | (tm.tm_min << 5) | (tm.tm_sec / 2);
         return (date << 16) | time;
     }
+
+    /// @brief Seekable istream for the part of shared memory
+    class view_streambuf : public std::streambuf {
+    public:
+        view_streambuf(
+            std::shared_ptr<const void> owner, const ubyte* data, size_t size
+        )
+            : owner(std::move(owner)) {
+            char* base = reinterpret_cast<char*>(const_cast<ubyte*>(data));
+            setg(base, base, base + size);
+        }
+    protected:
+        int_type underflow() override {
+            return traits_type::eof();
+        }
+
+        pos_type seekoff(
+            off_type off, std::ios_base::seekdir dir, std::ios_base::openmode
+        ) override {
+            off_type pos = off;
+            if (dir == std::ios_base::cur) {
+                pos += gptr() - eback();
+            } else if (dir == std::ios_base::end) {
+                pos += egptr() - eback();
+            }
+            if (pos < 0 || pos > egptr() - eback()) {
+                return pos_type(off_type(-1));
+            }
+            setg(eback(), eback() + pos, egptr());
+            return pos_type(pos);
+        }
+
+        pos_type seekpos(pos_type pos, std::ios_base::openmode mode) override {
+            return seekoff(off_type(pos), std::ios_base::beg, mode);
+        }
+    private:
+        std::shared_ptr<const void> owner;
+    };
+
+    class view_istream : public std::istream {
+    public:
+        view_istream(
+            std::shared_ptr<const void> owner, const ubyte* data, size_t size
+        )
+            : std::istream(&buf), buf(std::move(owner), data, size) {
+        }
+    private:
+        view_streambuf buf;
+    };
+
+    void inflate_raw(
+        const ubyte* src, size_t srcSize, ubyte* dst, size_t dstSize
+    ) {
+        z_stream zstream {};
+        if (inflateInit2(&zstream, -MAX_WBITS) != Z_OK) {
+            throw std::runtime_error("zlib init failed");
+        }
+        zstream.next_in = src;
+        zstream.avail_in = static_cast<uInt>(srcSize);
+        zstream.next_out = dst;
+        zstream.avail_out = static_cast<uInt>(dstSize);
+        int ret = inflate(&zstream, Z_FINISH);
+        inflateEnd(&zstream);
+        if (ret != Z_STREAM_END || zstream.avail_out != 0) {
+            throw std::runtime_error("could not to inflate zip entry");
+        }
+    }
 }
 
-ZipFileDevice::Entry ZipFileDevice::readEntry() {
+static ZipFileDevice::Entry read_entry(ByteReader& reader) {
     // Read entry info
-    Entry entry {};
-    read_int(file, entry.versionMadeBy);
-    read_int(file, entry.versionNeeded);
-    read_int(file, entry.flags);
-    read_int(file, entry.compressionMethod);
-    read_int(file, entry.modTime);
-    read_int(file, entry.modDate);
-    read_int(file, entry.crc32);
-    read_int(file, entry.compressedSize);
-    read_int(file, entry.uncompressedSize);
-    auto filename_len = read_int<uint16_t>(file);
-    auto extra_field_len = read_int<uint16_t>(file);
-    auto file_comment_len = read_int<uint16_t>(file);
-    read_int(file, entry.diskNumberStart);
-    read_int(file, entry.internalAttributes);
-    read_int(file, entry.externalAttributes);
-    read_int(file, entry.localHeaderOffset);
+    ZipFileDevice::Entry entry {};
+    entry.versionMadeBy = reader.getInt16();
+    entry.versionNeeded = reader.getInt16();
+    entry.flags = reader.getInt16();
+    entry.compressionMethod = reader.getInt16();
+    entry.modTime = reader.getInt16();
+    entry.modDate = reader.getInt16();
+    entry.crc32 = reader.getInt32();
+    entry.compressedSize = reader.getInt32();
+    entry.uncompressedSize = reader.getInt32();
+    auto filename_len = static_cast<uint16_t>(reader.getInt16());
+    auto extra_field_len = static_cast<uint16_t>(reader.getInt16());
+    auto file_comment_len = static_cast<uint16_t>(reader.getInt16());
+    entry.diskNumberStart = reader.getInt16();
+    entry.internalAttributes = reader.getInt16();
+    entry.externalAttributes = reader.getInt32();
+    entry.localHeaderOffset = reader.getInt32();
 
     entry.fileName.resize(filename_len, '\0');
-    file->read(entry.fileName.data(), filename_len);
+    reader.get(entry.fileName.data(), filename_len);
 
     // Skip extra field and file comment
-    file->seekg(extra_field_len + file_comment_len, std::ios::cur);
+    if (extra_field_len + file_comment_len > reader.remaining()) {
+        throw std::runtime_error("buffer underflow");
+    }
+    reader.skip(extra_field_len + file_comment_len);
 
     if (entry.diskNumberStart == 0xFF) {
         throw std::runtime_error("zip64 is not supported");
@@ -104,92 +169,170 @@ ZipFileDevice::Entry ZipFileDevice::readEntry() {
             entry.fileName[i] = '/';
         }
     }
-    if (entry.fileName[entry.fileName.length() - 1] == '/') {
+    // archives written by older versions may contain leading slashes
+    size_t start = entry.fileName.find_first_not_of('/');
+    entry.fileName.erase(0, std::min(start, entry.fileName.length()));
+    if (!entry.fileName.empty() &&
+        entry.fileName[entry.fileName.length() - 1] == '/') {
         entry.isDirectory = true;
         entry.fileName = entry.fileName.substr(0, entry.fileName.length() - 1);
     }
     return entry;
 }
 
-void ZipFileDevice::findBlob(Entry& entry) {
-    file->seekg(entry.localHeaderOffset);
-    if (read_int<uint32_t>(file) != LOCAL_FILE_SIGNATURE) {
+size_t ZipFileDevice::findBlob(const Entry& entry) const {
+    size_t offset = entry.localHeaderOffset;
+    if (offset > length || length - offset < LOCAL_HEADER_SIZE) {
+        throw std::runtime_error("invalid local header offset");
+    }
+    ByteReader reader(bytes + offset, LOCAL_HEADER_SIZE);
+    if (static_cast<uint32_t>(reader.getInt32()) != LOCAL_FILE_SIGNATURE) {
         throw std::runtime_error("invalid local file signature");
     }
-    read_int<uint16_t>(file); // version
-    read_int<uint16_t>(file); // flags
-    read_int<uint16_t>(file); // compression method
-    read_int<uint16_t>(file); // last modification time
-    read_int<uint16_t>(file); // last modification date
-    read_int<uint32_t>(file); // crc32
-    read_int<uint32_t>(file); // compressed size
-    read_int<uint32_t>(file); // uncompressed size
-    auto name_len = read_int<uint16_t>(file);
-    auto extra_field_len = read_int<uint16_t>(file);
+    reader.skip(22); // version, flags, compression, time, date, crc, sizes
+    auto name_len = static_cast<uint16_t>(reader.getInt16());
+    auto extra_field_len = static_cast<uint16_t>(reader.getInt16());
 
-    // Skip extra field and file comment
-    file->seekg(name_len + extra_field_len, std::ios::cur);
-    entry.blobOffset = file->tellg();
+    size_t blobOffset = offset + LOCAL_HEADER_SIZE + name_len + extra_field_len;
+    if (blobOffset > length || length - blobOffset < entry.compressedSize) {
+        throw std::runtime_error("zip entry is out of file bounds");
+    }
+    return blobOffset;
+}
+
+ZipFileDevice::ZipFileDevice(std::shared_ptr<const mapped_file> file)
+    : owner(file), bytes(file->data()), length(file->size()) {
+    readCentralDirectory();
+}
+
+ZipFileDevice::ZipFileDevice(util::Buffer<ubyte> content) {
+    auto buffer = std::make_shared<util::Buffer<ubyte>>(std::move(content));
+    bytes = buffer->data();
+    length = buffer->size();
+    owner = std::move(buffer);
+    readCentralDirectory();
+}
+
+static util::Buffer<ubyte> read_stream(std::istream& stream) {
+    stream.seekg(0, std::ios::end);
+    util::Buffer<ubyte> buffer(static_cast<size_t>(stream.tellg()));
+    stream.seekg(0);
+    stream.read(reinterpret_cast<char*>(buffer.data()), buffer.size());
+    return buffer;
+}
+
+ZipFileDevice::ZipFileDevice(std::unique_ptr<std::istream> file)
+    : ZipFileDevice(read_stream(*file)) {
 }
 
-ZipFileDevice::ZipFileDevice(
-    std::unique_ptr<std::istream> filePtr, FileSeparateFunc separateFunc
-)
-    : file(std::move(filePtr)), separateFunc(std::move(separateFunc)) {
+void ZipFileDevice::readCentralDirectory() {
     // Searching for EOCD
-    file->seekg(0, std::ios::end);
-    std::streampos file_size = file->tellg();
-
-    bool foundEOCD = false;
-    for (int pos = static_cast<int>(file_size)-4; pos >= 0; --pos) {
-        file->seekg(pos);
-        if (read_int<uint32_t>(file) == EOCD_SIGNATURE) {
-            foundEOCD = true;
+    size_t eocdOffset = length;
+    for (size_t pos = length >= EOCD_SIZE ? length - EOCD_SIZE + 1 : 0;
+         pos-- > 0;) {
+        if (ByteReader(bytes + pos, 4).getInt32() ==
+            static_cast<int32_t>(EOCD_SIGNATURE)) {
+            eocdOffset = pos;
             break;
         }
     }
-    if (!foundEOCD) {
+    if (eocdOffset == length) {
         throw std::runtime_error("EOCD not found, ZIP file is invalid");
     }
 
     // Reading EOCD
-    read_int<uint16_t>(file); // diskNumber
-    read_int<uint16_t>(file); // centralDirDisk
-    read_int<uint16_t>(file); // numEntriesThisDisk
-    auto total_entries = read_int<uint16_t>(file);
-    read_int<uint32_t>(file); // centralDirSize
-    auto central_dir_offset = read_int<uint32_t>(file);
-    read_int<uint16_t>(file); // commentLength
-
-    file->seekg(central_dir_offset);
-
-    for (uint16_t i = 0; i < total_entries; i++) {
-        if (read_int<uint32_t>(file) != CENTRAL_DIR_SIGNATURE) {
+    ByteReader eocd(bytes + eocdOffset + 4, EOCD_SIZE - 4);
+    eocd.getInt16(); // diskNumber
+    eocd.getInt16(); // centralDirDisk
+    eocd.getInt16(); // numEntriesThisDisk
+    auto totalEntries = static_cast<uint16_t>(eocd.getInt16());
+    eocd.getInt32(); // centralDirSize
+    auto centralDirOffset = static_cast<uint32_t>(eocd.getInt32());
+    if (centralDirOffset > eocdOffset) {
+        throw std::runtime_error("invalid central directory offset");
+    }
+
+    ByteReader reader(bytes + centralDirOffset, eocdOffset - centralDirOffset);
+    entries.reserve(totalEntries);
+    for (uint16_t i = 0; i < totalEntries; i++) {
+        if (static_cast<uint32_t>(reader.getInt32()) != CENTRAL_DIR_SIGNATURE) {
             logger.error() << "invalid central directory entry";
             break;
         }
-        // Read entry info
-        Entry entry = readEntry();
-        entries[entry.fileName] = std::move(entry);
+        entries.push_back(read_entry(reader));
     }
 
-    for (auto& [name, _] : entries) {
-        io::path path = name;
+    // Add implicit directories
+    std::vector<std::string> folders;
+    for (const auto& entry : entries) {
+        size_t slash = entry.fileName.find('/');
+        while (slash != std::string::npos) {
+            folders.push_back(entry.fileName.substr(0, slash));
+            slash = entry.fileName.find('/', slash + 1);
+        }
+    }
+    std::sort(folders.begin(), folders.end());
+    folders.erase(std::unique(folders.begin(), folders.end()), folders.end());
+    for (auto& folder : folders) {
+        Entry entry {};
+        entry.isDirectory = true;
+        entry.fileName = std::move(folder);
+        entries.push_back(std::move(entry));
+    }
 
-        while (!(path = path.parent()).pathPart().empty()) {
-            if (entries.find(path.pathPart()) != entries.end()) {
-                continue;
-            }
-            Entry entry {};
-            entry.isDirectory = true;
-            entries[path.pathPart()] = entry;
+    // Sort by name keeping the last of duplicates (explicit entries are
+    // placed before implicit directories)
+    std::stable_sort(
+        entries.begin(),
+        entries.end(),
+        [](const auto& a, const auto& b) { return a.fileName < b.fileName; }
+    );
+    auto last = std::unique(
+        entries.rbegin(),
+        entries.rend(),
+        [](const auto& a, const auto& b) { return a.fileName == b.fileName; }
+    );
+    entries.erase(entries.begin(), last.base());
+
+    for (auto& entry : entries) {
+        if (!entry.isDirectory) {
+            entry.blobOffset = findBlob(entry);
         }
-        break;
     }
+}
 
-    for (auto& [_, entry] : entries) {
-        findBlob(entry);
+const ZipFileDevice::Entry* ZipFileDevice::findEntry(
+    std::string_view path
+) const {
+    auto found = std::lower_bound(
+        entries.begin(),
+        entries.end(),
+        path,
+        [](const Entry& entry, std::string_view name) {
+            return entry.fileName < name;
+        }
+    );
+    if (found == entries.end() || found->fileName != path) {
+        return nullptr;
     }
+    return &*found;
+}
+
+const ZipFileDevice::Entry& ZipFileDevice::requireFile(
+    std::string_view path
+) const {
+    auto entry = findEntry(path);
+    if (entry == nullptr) {
+        throw std::runtime_error("could not to open file zip://" + std::string(path));
+    }
+    if (entry->isDirectory) {
+        throw std::runtime_error("zip://" + std::string(path) + " is directory");
+    }
+    return *entry;
+}
+
+util::span<ubyte> ZipFileDevice::getBlob(const Entry& entry) const {
+    return util::span<ubyte>(bytes + entry.blobOffset, entry.compressedSize);
 }
 
 std::filesystem::path ZipFileDevice::resolve(std::string_view path) {
@@ -201,29 +344,10 @@ std::unique_ptr<std::ostream> ZipFileDevice::write(std::string_view path) {
 }
 
 std::unique_ptr<std::istream> ZipFileDevice::read(std::string_view path) {
-    const auto& found = entries.find(std::string(path));
-    if (found == entries.end()) {
-        throw std::runtime_error("could not to open file zip://" + std::string(path));
-    }
-    auto& entry = found->second;
-    if (entry.isDirectory) {
-        throw std::runtime_error("zip://" + std::string(path) + " is directory");
-    }
-    if (entry.blobOffset == 0) {
-        findBlob(entry);
-    }
-    std::unique_ptr<std::istream> src_stream;
-    if (separateFunc) {
-        // Create new istream for concurrent data reading
-        src_stream = separateFunc();
-        src_stream->seekg(entry.blobOffset);
-    } else {
-        // Read compressed data to memory if istream cannot be separated
-        file->seekg(entry.blobOffset);
-        util::Buffer<char> buffer(entry.compressedSize);
-        file->read(buffer.data(), buffer.size());
-        src_stream = std::make_unique<memory_istream>(std::move(buffer));
-    }
+    const auto& entry = requireFile(path);
+    auto blob = getBlob(entry);
+    auto src_stream =
+        std::make_unique<view_istream>(owner, blob.data(), blob.size());
     if (entry.compressionMethod == COMPRESSION_NONE) {
         return src_stream;
     } else if (entry.compressionMethod == COMPRESSION_DEFLATE) {
@@ -236,43 +360,85 @@ std::unique_ptr<std::istream> ZipFileDevice::read(std::string_view path) {
     }
 }
 
+std::optional<util::span<ubyte>> ZipFileDevice::view(std::string_view path) {
+    auto entry = findEntry(path);
+    if (entry == nullptr || entry->isDirectory ||
+        entry->compressionMethod != COMPRESSION_NONE) {
+        return std::nullopt;
+    }
+    return getBlob(*entry);
+}
+
+std::vector<util::Buffer<ubyte>> ZipFileDevice::readAll(
+    const std::vector<std::string>& paths
+) {
+    return readAll(paths, 0);
+}
+
+std::vector<util::Buffer<ubyte>> ZipFileDevice::readAll(
+    const std::vector<std::string>& paths, uint threads
+) const {
+    std::vector<const Entry*> found(paths.size());
+    std::vector<util::Buffer<ubyte>> files;
+    files.reserve(paths.size());
+    for (size_t i = 0; i < paths.size(); i++) {
+        found[i] = &requireFile(paths[i]);
+        if (found[i]->compressionMethod != COMPRESSION_NONE &&
+            found[i]->compressionMethod != COMPRESSION_DEFLATE) {
+            throw std::runtime_error(
+                "unsupported compression method [" +
+                std::to_string(found[i]->compressionMethod) + "]"
+            );
+        }
+        files.emplace_back(found[i]->uncompressedSize);
+    }
+    util::parallel_for(paths.size(), threads, [&](size_t index) {
+        const auto& entry = *found[index];
+        auto blob = getBlob(entry);
+        auto& dst = files[index];
+        if (entry.compressionMethod == COMPRESSION_NONE) {
+            if (blob.size() != dst.size()) {
+                throw std::runtime_error("invalid zip entry size");
+            }
+            std::memcpy(dst.data(), blob.data(), blob.size());
+        } else {
+            inflate_raw(blob.data(), blob.size(), dst.data(), dst.size());
+        }
+    });
+    return files;
+}
+
 size_t ZipFileDevice::size(std::string_view path) {
-    const auto& found = entries.find(std::string(path));
-    if (found == entries.end()) {
+    auto entry = findEntry(path);
+    if (entry == nullptr) {
         return 0;
     }
-    return found->second.uncompressedSize;
+    return entry->uncompressedSize;
 }
 
 file_time_type ZipFileDevice::lastWriteTime(std::string_view path) {
-    const auto& found = entries.find(std::string(path));
-    if (found == entries.end()) {
+    auto entry = findEntry(path);
+    if (entry == nullptr) {
         return file_time_type::min();
     }
-    return msdos_to_file_time(found->second.modDate, found->second.modTime);
+    return msdos_to_file_time(entry->modDate, entry->modTime);
 }
 
 bool ZipFileDevice::exists(std::string_view path) {
-    return entries.find(std::string(path)) != entries.end();
+    return findEntry(path) != nullptr;
 }
 
 bool ZipFileDevice::isdir(std::string_view path) {
     if (path.empty()) {
         return true;
     }
-    const auto& found = entries.find(std::string(path));
-    if (found == entries.end()) {
-        return false;
-    }
-    return found->second.isDirectory;
+    auto entry = findEntry(path);
+    return entry && entry->isDirectory;
 }
 
 bool ZipFileDevice::isfile(std::string_view path) {
-    const auto& found = entries.find(std::string(path));
-    if (found == entries.end()) {
-        return false;
-    }
-    return !found->second.isDirectory;
+    auto entry = findEntry(path);
+    return entry && !entry->isDirectory;
 }
 
 bool ZipFileDevice::mkdir(std::string_view path) {
@@ -309,34 +475,31 @@ private:
 };
 
 std::unique_ptr<PathsGenerator> ZipFileDevice::list(std::string_view path) {
+    std::string folder = path.empty() ? "" : std::string(path) + "/";
     std::vector<std::string> names;
-    if (path.empty()) {
-        for (const auto& [name, entry] : entries) {
-            if (name.find('/') == std::string::npos) {
-                names.push_back(name);
-            }
+    // entries of the folder are placed together in the sorted table
+    auto it = std::lower_bound(
+        entries.begin(),
+        entries.end(),
+        folder,
+        [](const Entry& entry, const std::string& name) {
+            return entry.fileName < name;
         }
-    } else {
-        auto folder = std::string(path) + "/";
-        size_t folder_len = folder.length();
-        for (const auto& [name, entry] : entries) {
-            if (name.find(folder) != 0) {
-                continue;
-            }
-            size_t pos = name.find('/', folder_len);
-            if (pos == std::string::npos) {
-                names.push_back(name.substr(folder_len, pos - folder_len));
-            }
-            if (pos == name.length() - 1) {
-                names.push_back(name.substr(folder_len, pos - folder_len));
-            }
+    );
+    for (; it != entries.end(); ++it) {
+        const auto& name = it->fileName;
+        if (name.compare(0, folder.length(), folder) != 0) {
+            break;
+        }
+        if (name.length() > folder.length() &&
+            name.find('/', folder.length()) == std::string::npos) {
+            names.push_back(name.substr(folder.length()));
         }
     }
     return std::make_unique<ListPathsGenerator>(std::move(names));
 }
 
 #include "io/io.hpp"
-#include "coders/byte_utils.hpp"
 
 static void write_headers(
     std::ostream& file,
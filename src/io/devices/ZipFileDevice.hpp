@@ -1,12 +1,23 @@
 #pragma once
 
-#include <functional>
-#include <unordered_map>
+#include <memory>
+#include <optional>
+#include <vector>
 
 #include "Device.hpp"
+#include "typedefs.hpp"
+#include "util/Buffer.hpp"
+#include "util/span.hpp"
 
 namespace io {
+    class mapped_file;
+
+    /// @brief Read-only device for ZIP file content kept in memory
+    /// (memory-mapped file or buffer). Files are read directly from the
+    /// content, so reading is thread-safe and does not require separate
+    /// file streams.
     class ZipFileDevice : public Device {
+    public:
         struct Entry {
             uint16_t versionMadeBy;
             uint16_t versionNeeded;
@@ -25,16 +36,15 @@ namespace io {
             size_t blobOffset = 0;
             bool isDirectory = false;
         };
-    public:
-        using FileSeparateFunc = std::function<std::unique_ptr<std::istream>()>;
 
-        /// @param file ZIP file seekable istream
-        /// @param separateFunc Optional function that creates new seekable 
-        /// istream for the ZIP file.
-        ZipFileDevice(
-            std::unique_ptr<std::istream> file,
-            FileSeparateFunc separateFunc = nullptr
-        );
+        /// @param file memory-mapped ZIP file
+        ZipFileDevice(std::shared_ptr<const mapped_file> file);
+
+        /// @param bytes ZIP file content
+        ZipFileDevice(util::Buffer<ubyte> bytes);
+
+        /// @param file ZIP file istream (will be read to memory)
+        ZipFileDevice(std::unique_ptr<std::istream> file);
 
         std::filesystem::path resolve(std::string_view path) override;
         std::unique_ptr<std::ostream> write(std::string_view path) override;
@@ -49,13 +59,38 @@ namespace io {
         bool remove(std::string_view path) override;
         uint64_t removeAll(std::string_view path) override;
         std::unique_ptr<PathsGenerator> list(std::string_view path) override;
+
+        /// @brief Get stored (not compressed) file data without copying.
+        /// Data is valid while the device exists
+        /// @return std::nullopt if file not found or compressed
+        std::optional<util::span<ubyte>> view(std::string_view path) override;
+
+        /// @brief Read files, compressed ones are inflated concurrently
+        /// using hardware threads
+        std::vector<util::Buffer<ubyte>> readAll(
+            const std::vector<std::string>& paths
+        ) override;
+
+        /// @brief Read files, compressed ones are inflated concurrently
+        /// @param threads max workers count (0 - hardware threads)
+        /// @return files content in the same order
+        /// @throw std::runtime_error if file not found or could not be read
+        std::vector<util::Buffer<ubyte>> readAll(
+            const std::vector<std::string>& paths, uint threads
+        ) const;
     private:
-        std::unique_ptr<std::istream> file;
-        FileSeparateFunc separateFunc;
-        std::unordered_map<std::string, Entry> entries;
+        /// @brief Keeps content alive (mapping or buffer)
+        std::shared_ptr<const void> owner;
+        const ubyte* bytes = nullptr;
+        size_t length = 0;
+        /// @brief Central directory entries sorted by file name
+        std::vector<Entry> entries;
 
-        Entry readEntry();
-        void findBlob(Entry& entry);
+        void readCentralDirectory();
+        const Entry* findEntry(std::string_view path) const;
+        const Entry& requireFile(std::string_view path) const;
+        size_t findBlob(const Entry& entry) const;
+        util::span<ubyte> getBlob(const Entry& entry) const;
     };
 
     void write_zip(const path& folder, const path& file);
@@ -149,6 +149,36 @@ std::vector<ubyte> io::read_bytes(const path& filename) {
     return data;
 }
 
+std::vector<util::Buffer<ubyte>> io::read_all(const std::vector<path>& files) {
+    std::vector<util::Buffer<ubyte>> result(files.size());
+    // files are grouped by entry-point to be read in one batch
+    std::map<std::string, std::vector<size_t>> groups;
+    for (size_t i = 0; i < files.size(); i++) {
+        groups[files[i].entryPoint()].push_back(i);
+    }
+    for (const auto& [entryPoint, indices] : groups) {
+        auto& device = io::require_device(entryPoint);
+        std::vector<std::string> paths;
+        paths.reserve(indices.size());
+        for (size_t index : indices) {
+            paths.push_back(files[index].pathPart());
+        }
+        auto content = device.readAll(paths);
+        for (size_t i = 0; i < indices.size(); i++) {
+            result[indices[i]] = std::move(content[i]);
+        }
+    }
+    return result;
+}
+
+std::optional<util::span<ubyte>> io::view(const path& file) {
+    auto device = io::get_device(file.entryPoint());
+    if (device == nullptr) {
+        return std::nullopt;
+    }
+    return device->view(file.pathPart());
+}
+
 std::string io::read_string(const path& filename) {
     size_t size;
     auto bytes = read_bytes(filename, size);
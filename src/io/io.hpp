@@ -4,12 +4,14 @@
 #include <iterator>
 #include <fstream>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
 #include "typedefs.hpp"
 #include "data/dv.hpp"
 #include "util/Buffer.hpp"
+#include "util/span.hpp"
 #include "path.hpp"
 
 namespace io {
@@ -156,6 +158,17 @@ namespace io {
     std::unique_ptr<ubyte[]> read_bytes(const path& file, size_t& length);
     std::vector<ubyte> read_bytes(const path& file);
 
+    /// @brief Read files content. Files are read by their devices in
+    /// batches, so ZIP packs entries are inflated concurrently
+    /// @return files content in the same order
+    /// @throw std::runtime_error if a file cannot be read
+    std::vector<util::Buffer<ubyte>> read_all(const std::vector<path>& files);
+
+    /// @brief Get file content without copying if its device keeps it in
+    /// memory (stored entry of a ZIP pack). Valid while the device exists
+    /// @return std::nullopt if not available
+    std::optional<util::span<ubyte>> view(const path& file);
+
     /// @brief Read string from the file
     std::string read_string(const path& file);
 
@@ -0,0 +1,101 @@
+#include "mapped_file.hpp"
+
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace io;
+
+static std::runtime_error mapping_error(const std::filesystem::path& file) {
+    return std::runtime_error("could not to map file " + file.u8string());
+}
+
+#ifdef _WIN32
+mapped_file::mapped_file(const std::filesystem::path& file) {
+    fileHandle = CreateFileW(
+        file.wstring().c_str(),
+        GENERIC_READ,
+        FILE_SHARE_READ,
+        nullptr,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL,
+        nullptr
+    );
+    if (fileHandle == INVALID_HANDLE_VALUE) {
+        fileHandle = nullptr;
+        throw mapping_error(file);
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(fileHandle, &fileSize)) {
+        CloseHandle(fileHandle);
+        throw mapping_error(file);
+    }
+    length = static_cast<size_t>(fileSize.QuadPart);
+    if (length == 0) {
+        return;
+    }
+    mappingHandle =
+        CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mappingHandle == nullptr) {
+        CloseHandle(fileHandle);
+        throw mapping_error(file);
+    }
+    bytes = static_cast<const ubyte*>(
+        MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0)
+    );
+    if (bytes == nullptr) {
+        CloseHandle(mappingHandle);
+        CloseHandle(fileHandle);
+        throw mapping_error(file);
+    }
+}
+
+mapped_file::~mapped_file() {
+    if (bytes) {
+        UnmapViewOfFile(bytes);
+    }
+    if (mappingHandle) {
+        CloseHandle(mappingHandle);
+    }
+    if (fileHandle) {
+        CloseHandle(fileHandle);
+    }
+}
+#else
+mapped_file::mapped_file(const std::filesystem::path& file) {
+    int fd = open(file.c_str(), O_RDONLY);
+    if (fd == -1) {
+        throw mapping_error(file);
+    }
+    struct stat info;
+    if (fstat(fd, &info) == -1) {
+        close(fd);
+        throw mapping_error(file);
+    }
+    length = static_cast<size_t>(info.st_size);
+    if (length == 0) {
+        close(fd);
+        return;
+    }
+    void* address = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    // mapping stays valid after the descriptor is closed
+    close(fd);
+    if (address == MAP_FAILED) {
+        throw mapping_error(file);
+    }
+    bytes = static_cast<const ubyte*>(address);
+}
+
+mapped_file::~mapped_file() {
+    if (bytes) {
+        munmap(const_cast<ubyte*>(bytes), length);
+    }
+}
+#endif
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <filesystem>
+
+#include "typedefs.hpp"
+
+namespace io {
+    /// @brief Read-only memory-mapped file
+    class mapped_file {
+    public:
+        /// @throw std::runtime_error if file could not be mapped
+        mapped_file(const std::filesystem::path& file);
+        ~mapped_file();
+
+        mapped_file(const mapped_file&) = delete;
+        mapped_file& operator=(const mapped_file&) = delete;
+
+        const ubyte* data() const {
+            return bytes;
+        }
+
+        size_t size() const {
+            return length;
+        }
+    private:
+        const ubyte* bytes = nullptr;
+        size_t length = 0;
+#ifdef _WIN32
+        void* fileHandle = nullptr;
+        void* mappingHandle = nullptr;
+#endif
+    };
+}
@@ -9,6 +9,7 @@
 #include "constants.hpp"
 #include "util/timeutil.hpp"
 #include "debug/Logger.hpp"
+#include "debug/Profiler.hpp"
 
 #include <memory>
 
@@ -104,6 +105,7 @@ void Lighting::buildSkyLight(int cx, int cz){
 
 
 void Lighting::onChunkLoaded(int cx, int cz, bool expand) {
+    VC_PROFILE_SCOPE("Lighting::onChunkLoaded");
     auto& solverR = *this->solverR;
     auto& solverG = *this->solverG;
     auto& solverB = *this->solverB;
@@ -173,6 +175,7 @@ void Lighting::onChunkLoaded(int cx, int cz, bool expand) {
 }
 
 void Lighting::onBlockSet(int x, int y, int z, blockid_t id){
+    VC_PROFILE_SCOPE("Lighting::onBlockSet");
     const auto& block = indices.blocks.require(id);
 
     auto chunk = chunks.getChunkByVoxel(glm::ivec3{x, y, z});
@@ -1,6 +1,7 @@
 #include "BlocksController.hpp"
 
 #include "content/Content.hpp"
+#include "debug/Profiler.hpp"
 #include "items/Inventories.hpp"
 #include "items/Inventory.hpp"
 #include "lighting/Lighting.hpp"
@@ -130,6 +131,7 @@ void BlocksController::updateBlock(int x, int y, int z) {
 }
 
 void BlocksController::update(float delta, uint padding) {
+    VC_PROFILE_SCOPE("BlocksController::update");
     if (int parts = randTickClock.update(delta)) {
         for (int i = 0; i < parts; i++) {
             randomTick(randTickClock.convertPart(i), randTickClock.getParts(), padding);
@@ -146,6 +148,7 @@ void BlocksController::update(float delta, uint padding) {
 }
 
 void BlocksController::onBlocksTick(int tickid, int parts) {
+    VC_PROFILE_SCOPE("BlocksController::onBlocksTick");
     const auto& indices = level.content.getIndices()->blocks;
     int tickRate = blocksTickClock.getTickRate();
     for (size_t id = 0; id < indices.count(); id++) {
@@ -203,6 +206,7 @@ void BlocksController::randomTick(
 }
 
 void BlocksController::randomTick(int tickid, int parts, uint padding) {
+    VC_PROFILE_SCOPE("BlocksController::randomTick");
     auto indices = level.content.getIndices();
 
     for (const auto& [pid, player] : *level.players) {
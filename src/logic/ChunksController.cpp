@@ -4,6 +4,7 @@
 #include <memory>
 
 #include "content/Content.hpp"
+#include "debug/Profiler.hpp"
 #include "world/files/WorldFiles.hpp"
 #include "graphics/core/Mesh.hpp"
 #include "lighting/Lighting.hpp"
@@ -32,13 +33,14 @@ ChunksController::ChunksController(Level& level)
 
 ChunksController::~ChunksController() = default;
 
-void ChunksController::update(
+int64_t ChunksController::update(
     int64_t maxDuration,
     int loadDistance,
     uint padding,
     Player& player,
     bool isLocalPlayer
 ) const {
+    VC_PROFILE_SCOPE("ChunksController::update");
     const auto& position = player.getPosition();
     int centerX = floordiv<CHUNK_W>(glm::floor(position.x));
     int centerY = floordiv<CHUNK_D>(glm::floor(position.z));
@@ -47,22 +49,20 @@ void ChunksController::update(
         /// FIXME: one generator for multiple players
         generator->update(centerX, centerY, loadDistance);
     } else {
-        return;
+        return 0;
     }
 
     int64_t mcstotal = 0;
 
     for (uint i = 0; i < MAX_WORK_PER_FRAME; i++) {
         timeutil::Timer timer;
-        if (loadVisible(player, padding, isLocalPlayer)) {
-            int64_t mcs = timer.stop();
-            if (mcstotal + mcs < maxDuration * 1000) {
-                mcstotal += mcs;
-                continue;
-            }
+        bool processed = loadVisible(player, padding, isLocalPlayer);
+        mcstotal += timer.stop();
+        if (!processed || mcstotal >= maxDuration) {
+            break;
         }
-        break;
     }
+    return mcstotal;
 }
 
 bool ChunksController::isInLoadingZone(
@@ -27,8 +27,10 @@ public:
     ChunksController(Level& level);
     ~ChunksController();
 
-    /// @param maxDuration milliseconds reserved for chunks loading
-    void update(
+    /// @param maxDuration microseconds reserved for chunks loading and
+    /// lighting. At least one chunk is processed
+    /// @return time spent (microseconds)
+    int64_t update(
         int64_t maxDuration,
         int loadDistance,
         uint padding,
@@ -4,6 +4,7 @@
 
 #include "content/Content.hpp"
 #include "debug/Logger.hpp"
+#include "debug/Profiler.hpp"
 #include "engine/Engine.hpp"
 #include "engine/EnginePaths.hpp"
 #include "world/files/WorldFiles.hpp"
@@ -34,7 +35,10 @@ LevelController::LevelController(
       clientPlayer(clientPlayer) {
     
     level->events->listen(LevelEventType::CHUNK_PRESENT, [](auto, Chunk* chunk) {
-        scripting::on_chunk_present(*chunk, chunk->flags.loaded);
+        // pregenerated chunks are reported as generated
+        scripting::on_chunk_present(
+            *chunk, chunk->flags.loaded && !chunk->flags.pregenerated
+        );
     });
     level->events->listen(LevelEventType::CHUNK_UNLOAD, [](auto, Chunk* chunk) {
         scripting::on_chunk_remove(*chunk);
@@ -63,7 +67,7 @@ LevelController::LevelController(
             player->chunks->configure(
                 std::floor(position.x), std::floor(position.z), 1
             );
-            chunks->update(16, 1, 0, *player, player.get() == clientPlayer);
+            chunks->update(16000, 1, 0, *player, player.get() == clientPlayer);
             if (player->chunks->get(
                     std::floor(position.x), 0, std::floor(position.z)
                 )) {
@@ -74,9 +78,11 @@ LevelController::LevelController(
 }
 
 void LevelController::update(float delta, bool pause) {
+    VC_PROFILE_SCOPE("LevelController::update");
     level->pathfinding->performAllAsync(
         settings.pathfinding.stepsPerAsyncAgent.get()
     );
+    int64_t chunksTimeLeft = chunksBudget;
     for (const auto& [_, player] : *level->players) {
         if (player->isSuspended()) {
             continue;
@@ -89,13 +95,15 @@ void LevelController::update(float delta, bool pause) {
             glm::floor(position.z),
             settings.chunks.loadDistance.get() + settings.chunks.padding.get()
         );
-        chunks->update(
-            settings.chunks.loadSpeed.get(),
+        int64_t spent = chunks->update(
+            chunksBudget < 0 ? settings.chunks.loadSpeed.get() * 1000
+                             : std::max<int64_t>(chunksTimeLeft, 0),
             settings.chunks.loadDistance.get(),
             settings.chunks.padding.get(),
             *player,
             player.get() == clientPlayer
         );
+        chunksTimeLeft -= spent;
     }
     if (!pause) {
         // update all objects that needed
@@ -129,6 +137,10 @@ void LevelController::update(float delta, bool pause) {
     level->entities->clean();
 }
 
+void LevelController::setChunksBudget(int64_t budget) {
+    chunksBudget = budget;
+}
+
 void LevelController::processBeforeQuit() {
     preQuitCallbacks.notify();
     // todo: move somewhere else
@@ -24,6 +24,11 @@ class LevelController {
     util::Clock playerTickClock;
 
     Player* clientPlayer;
+
+    /// @brief Chunks loading and lighting time per update shared by all
+    /// players (microseconds). Negative value means per player time from
+    /// chunks.load-speed setting
+    int64_t chunksBudget = -1;
 public:
     CallbacksSet<> preQuitCallbacks;
 
@@ -33,6 +38,11 @@ public:
     /// @param pause is world and player simulation paused
     void update(float delta, bool pause);
 
+    /// @brief Set chunks loading and lighting time per update
+    /// @param budget microseconds shared by all players or negative value
+    /// to use chunks.load-speed setting
+    void setChunksBudget(int64_t budget);
+
     void processBeforeQuit();
     void saveWorld();
 
@@ -0,0 +1,221 @@
+#include "WorldPregenerator.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "debug/Logger.hpp"
+#include "debug/Profiler.hpp"
+#include "maths/voxmaths.hpp"
+#include "util/timeutil.hpp"
+#include "voxels/Chunk.hpp"
+#include "world/files/WorldRegions.hpp"
+#include "world/generator/WorldGenerator.hpp"
+
+static debug::Logger logger("pregenerator");
+
+namespace {
+    struct EncodedChunk {
+        int x;
+        int z;
+        std::unique_ptr<ubyte[]> data;
+        size_t size = 0;
+    };
+}
+
+WorldPregenerator::WorldPregenerator(
+    WorldGenerator& generator, WorldRegions& regions, uint threads
+)
+    : generator(generator), regions(regions), threads(threads) {
+    if (this->threads == 0) {
+        this->threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+}
+
+PregenerationStats WorldPregenerator::generateRect(
+    int x, int z, int width, int depth
+) {
+    if (width <= 0 || depth <= 0) {
+        throw std::invalid_argument("invalid area size");
+    }
+    return generate(x, z, x + width - 1, z + depth - 1, [](int, int) {
+        return true;
+    });
+}
+
+PregenerationStats WorldPregenerator::generateRadial(
+    int centerX, int centerZ, int radius
+) {
+    if (radius < 0) {
+        throw std::invalid_argument("negative radius");
+    }
+    return generate(
+        centerX - radius,
+        centerZ - radius,
+        centerX + radius,
+        centerZ + radius,
+        [=](int x, int z) {
+            int dx = x - centerX;
+            int dz = z - centerZ;
+            return dx * dx + dz * dz <= radius * radius;
+        }
+    );
+}
+
+PregenerationStats WorldPregenerator::generate(
+    int minX,
+    int minZ,
+    int maxX,
+    int maxZ,
+    const std::function<bool(int, int)>& predicate
+) {
+    timeutil::Timer timer;
+    PregenerationStats stats {};
+    stats.threads = threads;
+
+    int minRegionX = floordiv<REGION_SIZE>(minX);
+    int minRegionZ = floordiv<REGION_SIZE>(minZ);
+    int maxRegionX = floordiv<REGION_SIZE>(maxX);
+    int maxRegionZ = floordiv<REGION_SIZE>(maxZ);
+
+    logger.info() << "pregenerating area (" << minX << ", " << minZ
+                  << ") - (" << maxX << ", " << maxZ << ") using "
+                  << threads << " thread(s)";
+    // snake order keeps neighbour prototypes between regions
+    for (int rz = minRegionZ; rz <= maxRegionZ; rz++) {
+        bool reversed = (rz - minRegionZ) % 2;
+        for (int i = minRegionX; i <= maxRegionX; i++) {
+            int rx = reversed ? maxRegionX - (i - minRegionX) : i;
+            generateRegion(
+                rx, rz, minX, minZ, maxX, maxZ, predicate, stats
+            );
+        }
+    }
+    stats.totalTime = timer.stop();
+    logger.info() << stats.generatedChunks << " chunk(s) generated, "
+                  << stats.skippedChunks << " skipped in "
+                  << stats.totalTime / 1000 << " ms";
+    return stats;
+}
+
+void WorldPregenerator::generateRegion(
+    int regionX,
+    int regionZ,
+    int minX,
+    int minZ,
+    int maxX,
+    int maxZ,
+    const std::function<bool(int, int)>& predicate,
+    PregenerationStats& stats
+) {
+    VC_PROFILE_SCOPE("WorldPregenerator::generateRegion");
+    int startX = std::max<int>(minX, regionX * REGION_SIZE);
+    int startZ = std::max<int>(minZ, regionZ * REGION_SIZE);
+    int endX = std::min<int>(maxX, (regionX + 1) * REGION_SIZE - 1);
+    int endZ = std::min<int>(maxZ, (regionZ + 1) * REGION_SIZE - 1);
+
+    std::vector<EncodedChunk> chunks;
+    for (int z = startZ; z <= endZ; z++) {
+        for (int x = startX; x <= endX; x++) {
+            if (!predicate(x, z)) {
+                continue;
+            }
+            stats.totalChunks++;
+            if (regions.hasVoxels(x, z)) {
+                stats.skippedChunks++;
+                continue;
+            }
+            chunks.push_back(EncodedChunk {x, z, nullptr});
+        }
+    }
+    if (chunks.empty()) {
+        return;
+    }
+
+    timeutil::Timer prototypesTimer;
+    int centerX = (startX + endX) / 2;
+    int centerZ = (startZ + endZ) / 2;
+    int radius = std::max(endX - startX, endZ - startZ) / 2 + 1;
+    generator.update(centerX, centerZ, radius);
+    for (const auto& chunk : chunks) {
+        generator.prepare(chunk.x, chunk.z);
+    }
+    stats.prototypesTime += prototypesTimer.stop();
+
+    auto compression = regions.getCompression(REGION_LAYER_VOXELS);
+    std::atomic<size_t> nextIndex = 0;
+    std::atomic<int64_t> generateTime = 0;
+    std::atomic<int64_t> encodeTime = 0;
+    std::mutex errorMutex;
+    std::exception_ptr error;
+
+    auto work = [&]() {
+        auto chunk = std::make_unique<Chunk>(0, 0);
+        int64_t generateMcs = 0;
+        int64_t encodeMcs = 0;
+        try {
+            size_t index;
+            while ((index = nextIndex++) < chunks.size()) {
+                auto& entry = chunks[index];
+                timeutil::Timer timer;
+                {
+                    VC_PROFILE_SCOPE("WorldPregenerator::generate");
+                    generator.generateVoxels(chunk->voxels, entry.x, entry.z);
+                }
+                generateMcs += timer.stop();
+
+                timeutil::Timer encodeTimer;
+                VC_PROFILE_SCOPE("WorldPregenerator::encode");
+                auto bytes = chunk->encode();
+                entry.data = compression::compress(
+                    bytes.get(), CHUNK_DATA_LEN, entry.size, compression
+                );
+                encodeMcs += encodeTimer.stop();
+            }
+        } catch (...) {
+            std::lock_guard lock(errorMutex);
+            if (error == nullptr) {
+                error = std::current_exception();
+            }
+            nextIndex = chunks.size();
+        }
+        generateTime += generateMcs;
+        encodeTime += encodeMcs;
+    };
+
+    uint workersCount = std::min<size_t>(threads, chunks.size());
+    std::vector<std::thread> workers;
+    for (uint i = 1; i < workersCount; i++) {
+        workers.emplace_back(work);
+    }
+    work();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    stats.generateTime += generateTime;
+    stats.encodeTime += encodeTime;
+
+    timeutil::Timer writeTimer;
+    for (auto& chunk : chunks) {
+        regions.putCompressed(
+            chunk.x,
+            chunk.z,
+            REGION_LAYER_VOXELS,
+            std::move(chunk.data),
+            chunk.size,
+            CHUNK_DATA_LEN
+        );
+        regions.markPregenerated(chunk.x, chunk.z);
+    }
+    regions.unloadRegion(regionX, regionZ);
+    regions.writePregenerated();
+    stats.writeTime += writeTimer.stop();
+    stats.generatedChunks += chunks.size();
+}
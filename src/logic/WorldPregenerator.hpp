@@ -0,0 +1,79 @@
+#pragma once
+
+#include <functional>
+
+#include "typedefs.hpp"
+
+class WorldGenerator;
+class WorldRegions;
+
+struct PregenerationStats {
+    /// @brief Number of chunks in the area
+    size_t totalChunks = 0;
+    /// @brief Number of generated and saved chunks
+    size_t generatedChunks = 0;
+    /// @brief Number of chunks found already saved
+    size_t skippedChunks = 0;
+    /// @brief Number of worker threads used
+    uint threads = 0;
+
+    /// @brief Chunk prototypes generation time (microseconds)
+    int64_t prototypesTime = 0;
+    /// @brief Voxels generation time summed over threads (microseconds)
+    int64_t generateTime = 0;
+    /// @brief Encoding and compression time summed over threads
+    /// (microseconds)
+    int64_t encodeTime = 0;
+    /// @brief Region files writing time (microseconds)
+    int64_t writeTime = 0;
+    /// @brief Total time (microseconds)
+    int64_t totalTime = 0;
+};
+
+/// @brief Generates and saves world area without loading chunks to the level.
+/// Area is processed region by region: prototypes are completed in the
+/// calling thread (generator script), then voxels generation and encoding
+/// are spread over worker threads. Each region file is written when done,
+/// so interrupted pregeneration continues from the saved chunks.
+class WorldPregenerator {
+    WorldGenerator& generator;
+    WorldRegions& regions;
+    uint threads;
+
+    PregenerationStats generate(
+        int minX,
+        int minZ,
+        int maxX,
+        int maxZ,
+        const std::function<bool(int, int)>& predicate
+    );
+
+    void generateRegion(
+        int regionX,
+        int regionZ,
+        int minX,
+        int minZ,
+        int maxX,
+        int maxZ,
+        const std::function<bool(int, int)>& predicate,
+        PregenerationStats& stats
+    );
+public:
+    /// @param threads number of worker threads (0 - hardware concurrency)
+    WorldPregenerator(
+        WorldGenerator& generator, WorldRegions& regions, uint threads = 0
+    );
+
+    /// @brief Generate missing chunks of the rectangular area
+    /// @param x first chunk X
+    /// @param z first chunk Z
+    /// @param width area width in chunks
+    /// @param depth area depth in chunks
+    PregenerationStats generateRect(int x, int z, int width, int depth);
+
+    /// @brief Generate missing chunks in the radius
+    /// @param centerX center chunk X
+    /// @param centerZ center chunk Z
+    /// @param radius radius in chunks
+    PregenerationStats generateRadial(int centerX, int centerZ, int radius);
+};
@@ -4,6 +4,7 @@
 #include "devtools/Project.hpp"
 #include "engine/Engine.hpp"
 #include "engine/EnginePaths.hpp"
+#include "engine/TickScheduler.hpp"
 #include "frontend/locale.hpp"
 #include "graphics/ui/elements/Menu.hpp"
 #include "graphics/ui/gui_util.hpp"
@@ -370,6 +371,34 @@ static int l_start_debug_instance(lua::State* L) {
     return lua::pushinteger(L, port);
 }
 
+/// @brief Get server ticks timing statistics (headless mode only)
+/// @return table with durations in milliseconds or nil
+static int l_get_tick_stats(lua::State* L) {
+    auto scheduler = engine->getTickScheduler();
+    if (scheduler == nullptr) {
+        return 0;
+    }
+    auto stats = scheduler->getStats();
+    lua::createtable(L, 0, 8);
+    lua::pushinteger(L, scheduler->getTps());
+    lua::setfield(L, "target_tps");
+    lua::pushnumber(L, stats.tps);
+    lua::setfield(L, "tps");
+    lua::pushinteger(L, stats.ticks);
+    lua::setfield(L, "ticks");
+    lua::pushinteger(L, stats.overruns);
+    lua::setfield(L, "overruns");
+    lua::pushinteger(L, stats.skipped);
+    lua::setfield(L, "skipped");
+    lua::pushnumber(L, stats.p50 / 1000.0);
+    lua::setfield(L, "p50");
+    lua::pushnumber(L, stats.p99 / 1000.0);
+    lua::setfield(L, "p99");
+    lua::pushnumber(L, stats.max / 1000.0);
+    lua::setfield(L, "max");
+    return 1;
+}
+
 const luaL_Reg applib[] = {
     /// content
     {"is_content_loaded", lua::wrap<l_is_content_loaded>},
@@ -402,5 +431,6 @@ const luaL_Reg applib[] = {
     {"get_version", lua::wrap<l_get_version>},
     {"create_memory_device", lua::wrap<l_create_memory_device>},
     {"start_debug_instance", lua::wrap<l_start_debug_instance>},
+    {"get_tick_stats", lua::wrap<l_get_tick_stats>},
     {nullptr, nullptr}
 };
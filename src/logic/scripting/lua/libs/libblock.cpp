@@ -234,6 +234,7 @@ static int l_set_states(lua::State* L) {
     int lz = z - cz * CHUNK_D;
     chunk->voxels[vox_index(lx, y, lz)].state = int2blockstate(states);
     chunk->setModifiedAndUnsaved();
+    chunk->journal.recordVoxel(vox_index(lx, y, lz));
     return 0;
 }
 
@@ -332,6 +333,7 @@ static int l_set_user_bits(lua::State* L) {
     }
     vox->state.userbits = (vox->state.userbits & (~mask)) | value;
     chunk->setModifiedAndUnsaved();
+    chunk->journal.recordVoxel(vox - chunk->voxels);
     return 0;
 }
 
@@ -379,6 +381,7 @@ static int l_set_variant(lua::State* L) {
     }
     vox->state.userbits = (vox->state.userbits & (~mask)) | value;
     chunk->setModifiedAndUnsaved();
+    chunk->journal.recordVoxel(vox - chunk->voxels);
     return 0;
 }
 
@@ -542,6 +545,58 @@ static int l_destruct(lua::State* L) {
     return 0;
 }
 
+static std::set<blockid_t> read_blocks_filter(lua::State* L, int idx) {
+    if (!lua::istable(L, idx)) {
+        throw std::runtime_error("table expected for filter");
+    }
+    std::set<blockid_t> filteredBlocks;
+    int addLen = lua::objlen(L, idx);
+    for (int i = 0; i < addLen; i++) {
+        lua::rawgeti(L, i + 1, idx);
+        auto blockName = std::string(lua::tostring(L, -1));
+        const Block* block = content->blocks.find(blockName);
+        if (block != nullptr) {
+            filteredBlocks.insert(block->rt.id);
+        }
+        lua::pop(L);
+    }
+    return filteredBlocks;
+}
+
+/// @brief Fill raycast result table on top of the stack
+static void set_raycast_result(
+    lua::State* L,
+    const glm::vec3& start,
+    const glm::vec3& end,
+    const glm::ivec3& normal,
+    const glm::ivec3& iend,
+    blockid_t id
+) {
+    lua::pushvec3(L, end);
+    lua::setfield(L, "endpoint");
+
+    lua::pushvec3(L, normal);
+    lua::setfield(L, "normal");
+
+    lua::pushnumber(L, glm::distance(start, end));
+    lua::setfield(L, "length");
+
+    lua::pushvec3(L, iend);
+    lua::setfield(L, "iendpoint");
+
+    lua::pushinteger(L, id);
+    lua::setfield(L, "block");
+}
+
+/// @brief Remove fields set by set_raycast_result from the table on top
+static void clear_raycast_result(lua::State* L) {
+    for (const char* name :
+         {"endpoint", "normal", "length", "iendpoint", "block"}) {
+        lua::pushnil(L);
+        lua::setfield(L, name);
+    }
+}
+
 static int l_raycast(lua::State* L) {
     auto& level = require_level();
 
@@ -552,20 +607,7 @@ static int l_raycast(lua::State* L) {
     std::set<blockid_t> filteredBlocks {};
     const int luaStackSize = lua::gettop(L);
     if (luaStackSize >= 5) {
-        if (lua::istable(L, 5)) {
-            int addLen = lua::objlen(L, 5);
-            for (int i = 0; i < addLen; i++) {
-                lua::rawgeti(L, i + 1, 5);
-                auto blockName = std::string(lua::tostring(L, -1));
-                const Block* block = content->blocks.find(blockName);
-                if (block != nullptr) {
-                    filteredBlocks.insert(block->rt.id);
-                }
-                lua::pop(L);
-            }
-        } else {
-            throw std::runtime_error("table expected for filter");
-        }
+        filteredBlocks = read_blocks_filter(L, 5);
     }
     if (luaStackSize >= 6) {
         includeNonSelectable = lua::toboolean(L, 6);
@@ -589,26 +631,82 @@ static int l_raycast(lua::State* L) {
         } else {
             lua::createtable(L, 0, 5);
         }
-
-        lua::pushvec3(L, end);
-        lua::setfield(L, "endpoint");
-
-        lua::pushvec3(L, normal);
-        lua::setfield(L, "normal");
-
-        lua::pushnumber(L, glm::distance(start, end));
-        lua::setfield(L, "length");
-
-        lua::pushvec3(L, iend);
-        lua::setfield(L, "iendpoint");
-
-        lua::pushinteger(L, voxel->id);
-        lua::setfield(L, "block");
+        set_raycast_result(L, start, end, normal, iend, voxel->id);
         return 1;
     }
     return 0;
 }
 
+static int l_raycast_batch(lua::State* L) {
+    auto& level = require_level();
+
+    if (!lua::istable(L, 1) || !lua::istable(L, 2)) {
+        throw std::runtime_error("tables of vectors expected");
+    }
+    int count = lua::objlen(L, 2);
+    if (lua::objlen(L, 1) != static_cast<size_t>(count)) {
+        throw std::runtime_error("starts and dirs lengths mismatch");
+    }
+    auto maxDistance = lua::tonumber(L, 3);
+    std::vector<blocks_agent::RaycastQuery> queries(count);
+    for (int i = 0; i < count; i++) {
+        auto& query = queries[i];
+        lua::rawgeti(L, i + 1, 1);
+        query.start = lua::tovec<3>(L, -1);
+        lua::pop(L);
+        lua::rawgeti(L, i + 1, 2);
+        query.dir = lua::tovec<3>(L, -1);
+        lua::pop(L);
+        query.maxDist = maxDistance;
+    }
+    bool includeNonSelectable = false;
+    std::set<blockid_t> filteredBlocks {};
+    const int luaStackSize = lua::gettop(L);
+    if (luaStackSize >= 5) {
+        filteredBlocks = read_blocks_filter(L, 5);
+    }
+    if (luaStackSize >= 6) {
+        includeNonSelectable = lua::toboolean(L, 6);
+    }
+    auto hits = blocks_agent::raycast(
+        *level.chunks, queries, filteredBlocks, includeNonSelectable
+    );
+    if (luaStackSize >= 4 && !lua::isnil(L, 4)) {
+        lua::pushvalue(L, 4);
+    } else {
+        lua::createtable(L, count, 0);
+    }
+    for (int i = 0; i < count; i++) {
+        const auto& hit = hits[i];
+        // reuse result tables of the destination list
+        lua::rawgeti(L, i + 1);
+        bool reused = lua::istable(L, -1);
+        if (hit.vox == nullptr) {
+            if (reused) {
+                clear_raycast_result(L);
+            } else {
+                lua::pop(L);
+                lua::pushboolean(L, false);
+            }
+        } else {
+            if (!reused) {
+                lua::pop(L);
+                lua::createtable(L, 0, 5);
+            }
+            set_raycast_result(
+                L, queries[i].start, hit.end, hit.norm, hit.iend, hit.vox->id
+            );
+        }
+        lua::rawseti(L, i + 1);
+    }
+    // trim results left from a previous larger batch
+    for (int i = static_cast<int>(lua::objlen(L, -1)); i > count; i--) {
+        lua::pushnil(L);
+        lua::rawseti(L, i);
+    }
+    return 1;
+}
+
 static int l_compose_state(lua::State* L) {
     if (!lua::istable(L, 1) || lua::objlen(L, 1) < 3) {
         throw std::runtime_error("expected array of 3 integers");
@@ -780,6 +878,7 @@ static int l_set_field(lua::State* L) {
     if (dst == nullptr) {
         dst = chunk->blocksMetadata.allocate(voxelIndex, dataStruct.size());
     }
+    chunk->journal.recordMetadata(voxelIndex);
     chunk->flags.unsaved = true;
     chunk->flags.blocksData = true;
     return set_field(L, dst, *field, index, dataStruct, value);
@@ -873,6 +972,7 @@ const luaL_Reg blocklib[] = {
     {"place", lua::wrap<l_place>},
     {"destruct", lua::wrap<l_destruct>},
     {"raycast", lua::wrap<l_raycast>},
+    {"raycast_batch", lua::wrap<l_raycast_batch>},
     {"compose_state", lua::wrap<l_compose_state>},
     {"decompose_state", lua::wrap<l_decompose_state>},
     {"get_field", lua::wrap<l_get_field>},
@@ -24,6 +24,11 @@ static int l_find(lua::State* L) {
     }
 }
 
+/// @brief Resources index is dropped when files in the packs are modified
+static void on_modified(const io::path& path) {
+    engine->getResPaths().onModified(path);
+}
+
 static int l_resolve(lua::State* L) {
     io::path path = lua::require_string(L, 1);
     return lua::pushstring(L, path.string());
@@ -66,6 +71,7 @@ static int l_write(lua::State* L) {
     io::path path = get_writeable_path(L);
     std::string text = lua::require_string(L, 2);
     io::write_string(path, text);
+    on_modified(path);
     return 1;
 }
 
@@ -75,7 +81,9 @@ static int l_remove(lua::State* L) {
     if (!is_writeable(entryPoint)) {
         throw std::runtime_error("access denied");
     }
-    return lua::pushboolean(L, io::remove(path));
+    bool removed = io::remove(path);
+    on_modified(path);
+    return lua::pushboolean(L, removed);
 }
 
 static int l_remove_tree(lua::State* L) {
@@ -84,7 +92,9 @@ static int l_remove_tree(lua::State* L) {
     if (!is_writeable(entryPoint)) {
         throw std::runtime_error("access denied");
     }
-    return lua::pushinteger(L, io::remove_all(path));
+    auto removed = io::remove_all(path);
+    on_modified(path);
+    return lua::pushinteger(L, removed);
 }
 
 static int l_exists(lua::State* L) {
@@ -110,12 +120,16 @@ static int l_length(lua::State* L) {
 
 static int l_mkdir(lua::State* L) {
     io::path path = lua::require_string(L, 1);
-    return lua::pushboolean(L, io::create_directory(path));
+    bool created = io::create_directory(path);
+    on_modified(path);
+    return lua::pushboolean(L, created);
 }
 
 static int l_mkdirs(lua::State* L) {
     io::path path = lua::require_string(L, 1);
-    return lua::pushboolean(L, io::create_directories(path));
+    bool created = io::create_directories(path);
+    on_modified(path);
+    return lua::pushboolean(L, created);
 }
 
 static int l_read_bytes(lua::State* L) {
@@ -150,6 +164,7 @@ static int l_write_bytes(lua::State* L) {
     bool res = io::write_bytes(
         path, reinterpret_cast<const ubyte*>(string.data()), string.size()
     );
+    on_modified(path);
     lua::pop(L);
     return lua::pushboolean(L, res);
 }
@@ -286,6 +301,9 @@ static int l_open_descriptor(lua::State* L) {
     if(descriptor == -1) {
         throw std::runtime_error("failed to open descriptor");
     }
+    if (write) {
+        on_modified(path);
+    }
 
     if(wplusMode) {
         auto* out_stream = scripting::descriptors_manager::get_output(descriptor);
@@ -16,10 +16,11 @@ using namespace scripting;
 
 static int l_save_fragment(lua::State* L) {
     auto fragment = lua::touserdata<lua::LuaVoxelFragment>(L, 1);
-    auto file = lua::require_string(L, 2);
+    io::path file = lua::require_string(L, 2);
     auto map = fragment->getFragment(0)->serialize();
     auto bytes = json::to_binary(map, true);
     io::write_bytes(file, bytes.data(), bytes.size());
+    engine->getResPaths().onModified(file);
     return 0;
 }
 
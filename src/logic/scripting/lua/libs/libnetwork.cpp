@@ -4,8 +4,11 @@
 #include "network/Network.hpp"
 #include "devtools/Project.hpp"
 
+#include <atomic>
+#include <memory>
 #include <variant>
 #include <utility>
+#include <unordered_map>
 
 using namespace scripting;
 
@@ -23,6 +26,80 @@ struct ConnectionEventDto {
     std::string comment {};
 };
 
+/// @brief Reference-counted native bytes storage handed to Lua as
+/// Bytearray view without copying. Returned to the pool when the last
+/// reference is released
+struct EventBuffer {
+    std::atomic<int> refs = 0;
+    std::vector<char> bytes;
+    /// @brief Packed datagrams start offsets
+    std::vector<uint32_t> offsets;
+    /// @brief Packed datagrams senders addresses
+    std::vector<std::string> addresses;
+    /// @brief Packed datagrams senders ports
+    std::vector<int> ports;
+
+    void clear() {
+        bytes.clear();
+        offsets.clear();
+        addresses.clear();
+        ports.clear();
+    }
+};
+
+/// @brief Max number of idle buffers kept in the pool
+static constexpr size_t EVENT_BUFFERS_POOL_MAX = 64;
+/// @brief Buffers with larger capacity are not kept allocated in the pool
+static constexpr size_t EVENT_BUFFER_KEEP_CAPACITY = 1024 * 1024;
+
+static std::vector<std::unique_ptr<EventBuffer>> event_buffers_pool;
+static std::mutex event_buffers_pool_mutex;
+
+/// @return buffer with single reference
+static EventBuffer* acquire_event_buffer() {
+    std::unique_ptr<EventBuffer> buffer;
+    {
+        std::lock_guard lock(event_buffers_pool_mutex);
+        if (!event_buffers_pool.empty()) {
+            buffer = std::move(event_buffers_pool.back());
+            event_buffers_pool.pop_back();
+        }
+    }
+    if (buffer == nullptr) {
+        buffer = std::make_unique<EventBuffer>();
+    }
+    buffer->refs = 1;
+    return buffer.release();
+}
+
+static void release_event_buffer(void* ptr) noexcept {
+    auto buffer = reinterpret_cast<EventBuffer*>(ptr);
+    if (--buffer->refs > 0) {
+        return;
+    }
+    std::unique_ptr<EventBuffer> owned(buffer);
+    owned->clear();
+    if (owned->bytes.capacity() > EVENT_BUFFER_KEEP_CAPACITY) {
+        owned->bytes = {};
+    }
+    std::lock_guard lock(event_buffers_pool_mutex);
+    if (event_buffers_pool.size() < EVENT_BUFFERS_POOL_MAX) {
+        event_buffers_pool.push_back(std::move(owned));
+    }
+}
+
+/// @brief Push Bytearray view sharing the buffer bytes
+static void push_event_buffer_view(lua::State* L, EventBuffer* buffer) {
+    buffer->refs++;
+    lua::create_bytearray_view(
+        L,
+        buffer->bytes.data(),
+        buffer->bytes.size(),
+        buffer,
+        release_event_buffer
+    );
+}
+
 struct ResponseEventDto {
     int status;
     bool binary;
@@ -35,20 +112,21 @@ enum NetworkDatagramSide {
     ON_CLIENT
 };
 
-struct NetworkDatagramEventDto {
+/// @brief All datagrams received by a socket since the previous pull
+/// packed into one buffer
+struct NetworkDatagramsEventDto {
     NetworkDatagramSide side;
     u64id_t server;
     u64id_t client;
-    std::string addr;
-    int port;
-    std::vector<char> buffer;
+    /// @brief Buffer reference owned by the event
+    EventBuffer* buffer;
 };
 
 struct NetworkEvent {
     using Payload = std::variant<
         ConnectionEventDto,
         ResponseEventDto,
-        NetworkDatagramEventDto
+        NetworkDatagramsEventDto
     >;
     NetworkEventType type;
 
@@ -64,12 +142,50 @@ struct NetworkEvent {
 
 static std::vector<NetworkEvent> events_queue {};
 static std::mutex events_queue_mutex;
+/// @brief Indices of the current frame datagrams events in the queue
+/// by server id (ON_SERVER) or connection id (ON_CLIENT)
+static std::unordered_map<u64id_t, size_t> server_datagrams_events;
+static std::unordered_map<u64id_t, size_t> client_datagrams_events;
 
 static void push_event(NetworkEvent&& event) {
     std::lock_guard lock(events_queue_mutex);
     events_queue.push_back(std::move(event));
 }
 
+static void push_datagram(
+    NetworkDatagramSide side,
+    u64id_t sid,
+    u64id_t cid,
+    const std::string& addr,
+    int port,
+    const char* data,
+    size_t length
+) {
+    std::lock_guard lock(events_queue_mutex);
+    auto& indices =
+        side == ON_SERVER ? server_datagrams_events : client_datagrams_events;
+    u64id_t id = side == ON_SERVER ? sid : cid;
+
+    EventBuffer* buffer;
+    const auto& found = indices.find(id);
+    if (found == indices.end()) {
+        buffer = acquire_event_buffer();
+        indices[id] = events_queue.size();
+        events_queue.emplace_back(
+            DATAGRAM, NetworkDatagramsEventDto {side, sid, cid, buffer}
+        );
+    } else {
+        const auto& event = events_queue[found->second];
+        buffer = std::get<NetworkDatagramsEventDto>(event.payload).buffer;
+    }
+    buffer->offsets.push_back(buffer->bytes.size());
+    buffer->bytes.insert(buffer->bytes.end(), data, data + length);
+    if (side == ON_SERVER) {
+        buffer->addresses.push_back(addr);
+        buffer->ports.push_back(port);
+    }
+}
+
 static std::vector<std::string> read_headers(lua::State* L, int index) {
     std::vector<std::string> headers;
     if (lua::istable(L, index)) {
@@ -319,13 +435,7 @@ static int l_connect_udp(lua::State* L, network::Network& network) {
         const char* buffer,
         size_t length
     ) {
-        push_event(NetworkEvent(
-            DATAGRAM,
-            NetworkDatagramEventDto {
-                ON_CLIENT, 0, cid,
-                address, port, std::vector<char>(buffer, buffer + length)
-            }
-        ));
+        push_datagram(ON_CLIENT, 0, cid, address, port, buffer, length);
     });
     return lua::pushinteger(L, id);
 }
@@ -338,15 +448,7 @@ static int l_open_udp(lua::State* L, network::Network& network) {
         int port,
         const char* buffer,
         size_t length) {
-        push_event(
-            NetworkEvent(
-                DATAGRAM,
-                NetworkDatagramEventDto {
-                    ON_SERVER, sid, 0,
-                    addr, port, std::vector<char>(buffer, buffer + length)
-                }
-            )
-        );
+        push_datagram(ON_SERVER, sid, 0, addr, port, buffer, length);
     });
     return lua::pushinteger(L, id);
 }
@@ -440,27 +542,114 @@ static int l_is_nodelay(lua::State* L, network::Network& network) {
     return lua::pushboolean(L, false);
 }
 
+/// @brief Push table stored at index n of the table on top of the stack
+/// to reuse it or create a new one
+static void push_reused_table(lua::State* L, int n, int narr) {
+    lua::rawgeti(L, n);
+    if (!lua::istable(L, -1)) {
+        lua::pop(L);
+        lua::createtable(L, narr, 0);
+    }
+}
+
+/// @brief Remove array entries after the given size from the table on top
+/// of the stack
+static void trim_table(lua::State* L, int size) {
+    for (int i = lua::objlen(L, -1); i > size; i--) {
+        lua::pushnil(L);
+        lua::rawseti(L, i);
+    }
+}
+
+static void push_datagrams_event(
+    lua::State* L, const NetworkDatagramsEventDto& dto
+) {
+    const auto& buffer = *dto.buffer;
+    int count = buffer.offsets.size();
+
+    lua::pushinteger(L, dto.server);
+    lua::rawseti(L, 2);
+
+    lua::pushinteger(L, dto.client);
+    lua::rawseti(L, 3);
+
+    push_reused_table(L, 4, count);
+    for (int i = 0; i < buffer.addresses.size(); i++) {
+        lua::pushlstring(L, buffer.addresses[i]);
+        lua::rawseti(L, i + 1);
+    }
+    trim_table(L, buffer.addresses.size());
+    lua::rawseti(L, 4);
+
+    push_reused_table(L, 5, count);
+    for (int i = 0; i < buffer.ports.size(); i++) {
+        lua::pushinteger(L, buffer.ports[i]);
+        lua::rawseti(L, i + 1);
+    }
+    trim_table(L, buffer.ports.size());
+    lua::rawseti(L, 5);
+
+    lua::pushinteger(L, dto.side);
+    lua::rawseti(L, 6);
+
+    push_event_buffer_view(L, dto.buffer);
+    lua::rawseti(L, 7);
+
+    // 1-based start positions with end position of the last datagram
+    push_reused_table(L, 8, count + 1);
+    for (int i = 0; i < count; i++) {
+        lua::pushinteger(L, buffer.offsets[i] + 1);
+        lua::rawseti(L, i + 1);
+    }
+    lua::pushinteger(L, buffer.bytes.size() + 1);
+    lua::rawseti(L, count + 1);
+    trim_table(L, count + 1);
+    lua::rawseti(L, 8);
+}
+
+/// @brief Moves queued events to Lua. Tables passed as the first argument
+/// (result of the previous call) are reused.
 static int l_pull_events(lua::State* L) {
     std::vector<NetworkEvent> local_queue;
     {
         std::lock_guard lock(events_queue_mutex);
         local_queue.swap(events_queue);
+        server_datagrams_events.clear();
+        client_datagrams_events.clear();
     }
+    // release buffers references owned by events even if conversion fails
+    struct BuffersGuard {
+        std::vector<NetworkEvent>& events;
+
+        ~BuffersGuard() {
+            for (auto& event : events) {
+                auto& payload = event.payload;
+                if (auto dto = std::get_if<NetworkDatagramsEventDto>(&payload)) {
+                    release_event_buffer(dto->buffer);
+                }
+            }
+        }
+    } guard {local_queue};
 
-    lua::createtable(L, local_queue.size(), 0);
+    if (lua::istable(L, 1)) {
+        lua::pushvalue(L, 1);
+    } else {
+        lua::createtable(L, local_queue.size(), 0);
+    }
 
     for (size_t i = 0; i < local_queue.size(); i++) {
-        lua::createtable(L, 7, 0);
+        push_reused_table(L, i + 1, 8);
+
+        auto& event = local_queue[i];
+        lua::pushinteger(L, event.type);
+        lua::rawseti(L, 1);
 
-        const auto& event = local_queue[i];
+        int fieldsCount = 4;
         switch (event.type) {
             case CLIENT_CONNECTED:
             case CONNECTED_TO_SERVER:
             case CONNECTION_ERROR: {
                 const auto& dto = std::get<ConnectionEventDto>(event.payload);
-                lua::pushinteger(L, event.type);
-                lua::rawseti(L, 1);
-
                 lua::pushinteger(L, dto.server);
                 lua::rawseti(L, 2);
 
@@ -472,34 +661,14 @@ static int l_pull_events(lua::State* L) {
                 break;
             }
             case DATAGRAM: {
-                const auto& dto = std::get<NetworkDatagramEventDto>(event.payload);
-                lua::pushinteger(L, event.type);
-                lua::rawseti(L, 1);
-
-                lua::pushinteger(L, dto.server);
-                lua::rawseti(L, 2);
-
-                lua::pushinteger(L, dto.client);
-                lua::rawseti(L, 3);
-
-                lua::pushstring(L, dto.addr);
-                lua::rawseti(L, 4);
-
-                lua::pushinteger(L, dto.port);
-                lua::rawseti(L, 5);
-
-                lua::pushinteger(L, dto.side);
-                lua::rawseti(L, 6);
-
-                lua::create_bytearray(L, dto.buffer.data(), dto.buffer.size());
-                lua::rawseti(L, 7);
+                push_datagrams_event(
+                    L, std::get<NetworkDatagramsEventDto>(event.payload)
+                );
+                fieldsCount = 8;
                 break;
             }
             case RESPONSE: {
-                const auto& dto = std::get<ResponseEventDto>(event.payload);
-                lua::pushinteger(L, event.type);
-                lua::rawseti(L, 1);
-
+                auto& dto = std::get<ResponseEventDto>(event.payload);
                 lua::pushinteger(L, dto.status);
                 lua::rawseti(L, 2);
 
@@ -507,7 +676,10 @@ static int l_pull_events(lua::State* L) {
                 lua::rawseti(L, 3);
 
                 if (dto.binary) {
-                    lua::create_bytearray(L, dto.bytes.data(), dto.bytes.size());
+                    auto buffer = acquire_event_buffer();
+                    buffer->bytes.swap(dto.bytes);
+                    push_event_buffer_view(L, buffer);
+                    release_event_buffer(buffer);
                 } else {
                     lua::pushlstring(L, std::string_view(dto.bytes.data(), dto.bytes.size()));
                 }
@@ -515,8 +687,10 @@ static int l_pull_events(lua::State* L) {
                 break;
             }
         }
+        trim_table(L, fieldsCount);
         lua::rawseti(L, i + 1);
     }
+    trim_table(L, local_queue.size());
     return 1;
 }
 
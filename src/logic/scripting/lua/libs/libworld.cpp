@@ -21,6 +21,8 @@
 #include "world/World.hpp"
 #include "logic/LevelController.hpp"
 #include "logic/ChunksController.hpp"
+#include "logic/WorldPregenerator.hpp"
+#include "world/generator/WorldGenerator.hpp"
 
 using namespace scripting;
 namespace fs = std::filesystem;
@@ -199,6 +201,69 @@ static int l_set_chunk_data(lua::State* L) {
     return lua::pushboolean(L, true);
 }
 
+static int l_get_chunk_delta(lua::State* L) {
+    int x = static_cast<int>(lua::tointeger(L, 1));
+    int z = static_cast<int>(lua::tointeger(L, 2));
+    uint64_t since = lua::tointeger(L, 3);
+    auto chunk = require_level().chunks->getChunk(x, z);
+    if (chunk == nullptr) {
+        // stored chunk data, no revision
+        if (l_get_chunk_data(L) == 0) {
+            return 0;
+        }
+        lua::pushnil(L);
+        lua::pushboolean(L, true);
+        return 3;
+    }
+    auto bytes = compressed_chunks::encode_delta(*chunk, since);
+    bool full = bytes.empty();
+    if (full) {
+        bytes = compressed_chunks::encode(*chunk);
+    }
+    lua::create_bytearray(L, std::move(bytes));
+    lua::pushinteger(L, chunk->journal.getRevision());
+    lua::pushboolean(L, full);
+    return 3;
+}
+
+static void mark_neighbour_modified(int cx, int cz) {
+    if (auto chunk = level->chunks->getChunk(cx, cz)) {
+        chunk->flags.modified = true;
+    }
+}
+
+static int l_apply_chunk_delta(lua::State* L) {
+    int x = static_cast<int>(lua::tointeger(L, 1));
+    int z = static_cast<int>(lua::tointeger(L, 2));
+    auto buffer = lua::bytearray_as_string(L, 3);
+    auto data = reinterpret_cast<const ubyte*>(buffer.data());
+    if (!compressed_chunks::is_delta(data, buffer.size())) {
+        return l_set_chunk_data(L);
+    }
+    auto chunk = require_level().chunks->getChunk(x, z);
+    if (chunk == nullptr) {
+        return lua::pushboolean(L, false);
+    }
+    auto changes = compressed_chunks::decode_delta(
+        *chunk, data, buffer.size(), *content->getIndices()
+    );
+    auto lighting = controller->getChunksController()->lighting.get();
+    for (const auto& change : changes) {
+        int lx = change.index % CHUNK_W;
+        int lz = change.index / CHUNK_W % CHUNK_D;
+        int y = change.index / (CHUNK_D * CHUNK_W);
+        blockid_t id = chunk->voxels[change.index].id;
+        if (lighting && id != change.prevId) {
+            lighting->onBlockSet(x * CHUNK_W + lx, y, z * CHUNK_D + lz, id);
+        }
+        if (lx == 0) mark_neighbour_modified(x - 1, z);
+        if (lz == 0) mark_neighbour_modified(x, z - 1);
+        if (lx == CHUNK_W - 1) mark_neighbour_modified(x + 1, z);
+        if (lz == CHUNK_D - 1) mark_neighbour_modified(x, z + 1);
+    }
+    return lua::pushboolean(L, true);
+}
+
 static int l_save_chunk_data(lua::State* L) {
     if (level == nullptr) {
         throw std::runtime_error("no open world");
@@ -227,6 +292,64 @@ static int l_count_chunks(lua::State* L) {
     return lua::pushinteger(L, level->chunks->size());
 }
 
+static void push_phase_stats(
+    lua::State* L, const char* name, int64_t time, size_t chunks
+) {
+    lua::createtable(L, 0, 2);
+    lua::pushnumber(L, time / 1e6);
+    lua::setfield(L, "time");
+    lua::pushnumber(L, time > 0 ? chunks * 1e6 / time : 0.0);
+    lua::setfield(L, "speed");
+    lua::setfield(L, name);
+}
+
+static int l_pregenerate(lua::State* L) {
+    auto& level = require_level();
+    int x = static_cast<int>(lua::tointeger(L, 1));
+    int z = static_cast<int>(lua::tointeger(L, 2));
+    int size = static_cast<int>(lua::tointeger(L, 3));
+
+    const auto& world = *level.getWorld();
+    WorldGenerator generator(
+        level.content.generators.require(world.getGenerator()),
+        level.content,
+        world.getSeed()
+    );
+    WorldPregenerator pregenerator(generator, world.wfile->getRegions());
+    PregenerationStats stats;
+    if (lua::isnumber(L, 4)) {
+        int depth = static_cast<int>(lua::tointeger(L, 4));
+        stats = pregenerator.generateRect(x, z, size, depth);
+    } else {
+        stats = pregenerator.generateRadial(x, z, size);
+    }
+    size_t generated = stats.generatedChunks;
+
+    lua::createtable(L, 0, 7);
+    lua::pushinteger(L, stats.totalChunks);
+    lua::setfield(L, "chunks");
+    lua::pushinteger(L, generated);
+    lua::setfield(L, "generated");
+    lua::pushinteger(L, stats.skippedChunks);
+    lua::setfield(L, "skipped");
+    lua::pushinteger(L, stats.threads);
+    lua::setfield(L, "threads");
+    lua::pushnumber(L, stats.totalTime / 1e6);
+    lua::setfield(L, "time");
+    lua::pushnumber(
+        L, stats.totalTime > 0 ? generated * 1e6 / stats.totalTime : 0.0
+    );
+    lua::setfield(L, "speed");
+
+    lua::createtable(L, 0, 4);
+    push_phase_stats(L, "prototypes", stats.prototypesTime, generated);
+    push_phase_stats(L, "generate", stats.generateTime, generated);
+    push_phase_stats(L, "encode", stats.encodeTime, generated);
+    push_phase_stats(L, "write", stats.writeTime, generated);
+    lua::setfield(L, "phases");
+    return 1;
+}
+
 static int l_reload_script(lua::State* L) {
     auto packid = lua::require_string(L, 1);
     if (content == nullptr) {
@@ -254,7 +377,10 @@ const luaL_Reg worldlib[] = {
     {"get_chunk_data", lua::wrap<l_get_chunk_data>},
     {"set_chunk_data", lua::wrap<l_set_chunk_data>},
     {"save_chunk_data", lua::wrap<l_save_chunk_data>},
+    {"get_chunk_delta", lua::wrap<l_get_chunk_delta>},
+    {"apply_chunk_delta", lua::wrap<l_apply_chunk_delta>},
     {"count_chunks", lua::wrap<l_count_chunks>},
+    {"pregenerate", lua::wrap<l_pregenerate>},
     {"reload_script", lua::wrap<l_reload_script>},
     {nullptr, nullptr}
 };
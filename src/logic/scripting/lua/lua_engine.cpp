@@ -6,6 +6,7 @@
 #include "io/io.hpp"
 #include "engine/EnginePaths.hpp"
 #include "debug/Logger.hpp"
+#include "debug/Profiler.hpp"
 #include "util/stringutil.hpp"
 #include "libs/api_lua.hpp"
 #include "usertypes/lua_type_heightmap.hpp"
@@ -169,6 +170,7 @@ void lua::finalize() {
 bool lua::emit_event(
     State* L, const std::string& name, std::function<int(State*)> args
 ) {
+    VC_PROFILE_SCOPE("lua::emit_event");
     getglobal(L, "events");
     getfield(L, "emit");
     pushstring(L, name);
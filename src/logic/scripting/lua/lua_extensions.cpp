@@ -5,6 +5,7 @@
 
 #include "libs/api_lua.hpp"
 #include "debug/Logger.hpp"
+#include "debug/Profiler.hpp"
 #include "engine/Engine.hpp"
 #include "devtools/DebuggingServer.hpp"
 #include "logic/scripting/scripting.hpp"
@@ -381,6 +382,26 @@ static int l_debug_is_debugging(lua::State* L) {
     return lua::pushboolean(L, engine->getDebuggingServer() != nullptr);
 }
 
+static int l_debug_profiler_start(lua::State*) {
+    debug::Profiler::start();
+    return 0;
+}
+
+static int l_debug_profiler_stop(lua::State* L) {
+    debug::Profiler::stop();
+    lua::pushinteger(L, debug::Profiler::getZonesCount());
+    lua::pushinteger(L, debug::Profiler::getDroppedCount());
+    return 2;
+}
+
+static int l_debug_profiler_export(lua::State* L) {
+    return lua::pushstring(L, debug::Profiler::exportChromeTrace());
+}
+
+static int l_debug_is_profiling(lua::State* L) {
+    return lua::pushboolean(L, debug::Profiler::isCapturing());
+}
+
 void initialize_libs_extends(lua::State* L) {
     if (lua::getglobal(L, "debug")) {
         lua::pushcfunction(L, lua::wrap<l_debug_error>);
@@ -407,6 +428,18 @@ void initialize_libs_extends(lua::State* L) {
         lua::pushcfunction(L, lua::wrap<l_debug_is_debugging>);
         lua::setfield(L, "is_debugging");
 
+        lua::pushcfunction(L, lua::wrap<l_debug_profiler_start>);
+        lua::setfield(L, "profiler_start");
+
+        lua::pushcfunction(L, lua::wrap<l_debug_profiler_stop>);
+        lua::setfield(L, "profiler_stop");
+
+        lua::pushcfunction(L, lua::wrap<l_debug_profiler_export>);
+        lua::setfield(L, "profiler_export");
+
+        lua::pushcfunction(L, lua::wrap<l_debug_is_profiling>);
+        lua::setfield(L, "is_profiling");
+
         lua::pop(L);
     }
     if (lua::getglobal(L, "math")) {
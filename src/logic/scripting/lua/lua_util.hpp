@@ -828,6 +828,25 @@ namespace lua {
         return create_bytearray(L, bytes.data(), bytes.size());
     }
 
+    /// @brief Create Bytearray view over native memory without copying.
+    /// Size of the view is fixed.
+    /// @param owner opaque pointer passed to release
+    /// @param release called once the view is collected by GC
+    inline int create_bytearray_view(
+        lua::State* L,
+        void* bytes,
+        size_t size,
+        void* owner,
+        void (*release)(void*)
+    ) {
+        requireglobal(L, "Bytearray_view");
+        pushlightuserdata(L, bytes);
+        pushinteger(L, size);
+        pushlightuserdata(L, owner);
+        pushlightuserdata(L, reinterpret_cast<void*>(release));
+        return call(L, 4, 1);
+    }
+
     inline std::string_view bytearray_as_string(lua::State* L, int idx) {
         if (type(L, idx) == LUA_TSTRING) {
             return tolstring(L, idx);
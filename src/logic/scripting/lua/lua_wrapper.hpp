@@ -94,4 +94,9 @@ namespace lua {
         return 1;
     }
 
+    inline int pushlightuserdata(lua::State* L, void* ptr) {
+        lua_pushlightuserdata(L, ptr);
+        return 1;
+    }
+
 }
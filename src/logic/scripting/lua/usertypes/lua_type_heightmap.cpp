@@ -1,8 +1,8 @@
 #include "lua_type_heightmap.hpp"
 
 #include "util/functional_util.hpp"
-#define FNL_IMPL
 #include "maths/FastNoiseLite.h"
+#include "maths/noise.hpp"
 #include "coders/imageio.hpp"
 #include "io/util.hpp"
 #include "graphics/core/ImageData.hpp"
@@ -70,6 +70,7 @@ static int l_dump(lua::State* L) {
             }
         }
         imageio::write(file, &image);
+        scripting::engine->getResPaths().onModified(file);
     }
     return 0;
 }
@@ -86,52 +87,38 @@ static int l_at(lua::State* L) {
 template<fnl_noise_type noise_type>
 static int l_noise(lua::State* L) {
     if (auto heightmap = touserdata<LuaHeightmap>(L, 1)) {
-        uint w = heightmap->getWidth();
-        uint h = heightmap->getHeight();
-        auto heights = heightmap->getValues();
         auto noise = heightmap->getNoise();
 
         auto offset = tovec<2>(L, 2);
 
-        float s = tonumber(L, 3);
-        int octaves = 1;
-        float multiplier = 1.0f;
+        noise::FractalParams params {};
+        params.offsetX = offset.x;
+        params.offsetY = offset.y;
+        params.scale = tonumber(L, 3);
         if (gettop(L) > 3) {
-            octaves = tointeger(L, 4);
+            params.octaves = tointeger(L, 4);
         }
         if (gettop(L) > 4) {
-            multiplier = tonumber(L, 5);
+            params.multiplier = tonumber(L, 5);
         }
-        const LuaHeightmap* shiftMapX = nullptr;
-        const LuaHeightmap* shiftMapY = nullptr;
         if (gettop(L) > 5) {
-            shiftMapX = touserdata<LuaHeightmap>(L, 6);
+            if (auto shiftMap = touserdata<LuaHeightmap>(L, 6)) {
+                params.shiftX = shiftMap->getValues();
+            }
         }
         if (gettop(L) > 6) {
-            shiftMapY = touserdata<LuaHeightmap>(L, 7);
-        }
-        noise->noise_type = noise_type;
-        for (uint y = 0; y < h; y++) {
-            for (uint x = 0; x < w; x++) {
-                uint i = y * w + x;
-                for (uint c = 0; c < octaves; c++) {
-                    float m = s * (1 << c);
-                    float value = heights[i];
-                    float u = (x + offset.x) * m;
-                    float v = (y + offset.y) * m;
-                    if (shiftMapX) {
-                        u += shiftMapX->getValues()[i];
-                    }
-                    if (shiftMapY) {
-                        v += shiftMapY->getValues()[i];
-                    }
-
-                    value += fnlGetNoise2D(noise, u, v) /
-                            static_cast<float>(1 << c) * multiplier;
-                    heights[i] = value;
-                }
+            if (auto shiftMap = touserdata<LuaHeightmap>(L, 7)) {
+                params.shiftY = shiftMap->getValues();
             }
         }
+        noise->noise_type = noise_type;
+        noise::add_fractal_2d(
+            *noise,
+            heightmap->getValues(),
+            heightmap->getWidth(),
+            heightmap->getHeight(),
+            params
+        );
     }
     return 0;
 }
@@ -7,18 +7,18 @@
 
 static inline float sample_at(
     const float* buffer,
-    uint width,
+    uint stride,
     uint x, uint y
 ) {
-    return buffer[y*width+x];
+    return buffer[y*stride+x];
 }
 
 static inline float sample_at(
     const float* buffer,
-    uint width, uint height,
+    uint stride, uint width, uint height,
     uint x, uint y
 ) {
-    return buffer[(y >= height ? height-1 : y)*width+(x >= width ? width-1 : x)];
+    return buffer[(y >= height ? height-1 : y)*stride+(x >= width ? width-1 : x)];
 }
 
 static inline float interpolate_cubic(float p[4], float x) {
@@ -36,14 +36,14 @@ static inline float interpolate_bicubic(float p[4][4], float x, float y) {
 
 static inline float sample_at(
     const float* buffer,
-    uint width, uint height,
+    uint stride, uint width, uint height,
     float x, float y,
     InterpolationType interp
 ) {
     // std::floor is redundant here because x and y are positive values
     uint ix = static_cast<uint>(x);
     uint iy = static_cast<uint>(y);
-    float val = buffer[iy*width+ix];
+    float val = buffer[iy*stride+ix];
     if (interp == InterpolationType::NEAREST) {
         return val;
     }
@@ -53,11 +53,11 @@ static inline float sample_at(
     switch (interp) {
         case InterpolationType::LINEAR: {
             float s00 = val;
-            float s10 = sample_at(buffer, width, 
+            float s10 = sample_at(buffer, stride, 
                 ix + 1 < width ? ix + 1 : ix, iy);
-            float s01 = sample_at(buffer, width, ix, 
+            float s01 = sample_at(buffer, stride, ix, 
                 iy + 1 < height ? iy + 1 : iy);
-            float s11 = sample_at(buffer, width, 
+            float s11 = sample_at(buffer, stride, 
                 ix + 1 < width ? ix + 1 : ix, iy + 1 < height ? iy + 1 : iy);
 
             float a00 = s00;
@@ -72,7 +72,7 @@ static inline float sample_at(
             for (int i = 0; i < 4; i++) {
                 for (int j = 0; j < 4; j++) {
                     p[i][j] = sample_at(
-                        buffer, width, height, ix + j - 1, iy + i - 1
+                        buffer, stride, width, height, ix + j - 1, iy + i - 1
                     );
                 }
             }
@@ -84,6 +84,32 @@ static inline float sample_at(
     return val;
 }
 
+/// @brief Resize the area of the buffer writing only top-left part of
+/// the result
+static void resize_area(
+    const float* src,
+    uint stride,
+    uint srcwidth,
+    uint srcheight,
+    uint dstwidth,
+    uint dstheight,
+    float* dst,
+    uint outwidth,
+    uint outheight,
+    InterpolationType interp
+) {
+    uint index = 0;
+    for (uint y = 0; y < outheight; y++) {
+        for (uint x = 0; x < outwidth; x++, index++) {
+            float sx = static_cast<float>(x) / dstwidth * srcwidth;
+            float sy = static_cast<float>(y) / dstheight * srcheight;
+            dst[index] = sample_at(
+                src, stride, srcwidth, srcheight, sx, sy, interp
+            );
+        }
+    }
+}
+
 void Heightmap::resize(
     uint dstwidth, uint dstheight, InterpolationType interp
 ) {
@@ -93,20 +119,66 @@ void Heightmap::resize(
     std::vector<float> dst;
     dst.resize(dstwidth*dstheight);
 
-    uint index = 0;
-    for (uint y = 0; y < dstheight; y++) {
-        for (uint x = 0; x < dstwidth; x++, index++) {
-            float sx = static_cast<float>(x) / dstwidth * width;
-            float sy = static_cast<float>(y) / dstheight * height;
-            dst[index] = sample_at(buffer.data(), width, height, sx, sy, interp);
-        }
-    }
+    resize_area(
+        buffer.data(),
+        width,
+        width,
+        height,
+        dstwidth,
+        dstheight,
+        dst.data(),
+        dstwidth,
+        dstheight,
+        interp
+    );
 
     width = dstwidth;
     height = dstheight;
     buffer = std::move(dst);
 }
 
+std::shared_ptr<Heightmap> Heightmap::sampleArea(
+    uint srcX,
+    uint srcY,
+    uint areaWidth,
+    uint areaHeight,
+    uint scaledWidth,
+    uint scaledHeight,
+    uint dstWidth,
+    uint dstHeight,
+    InterpolationType interp
+) const {
+    if (srcX + areaWidth > width || srcY + areaHeight > height ||
+        dstWidth > scaledWidth || dstHeight > scaledHeight) {
+        throw std::runtime_error("sample area is out of the map");
+    }
+    auto dst = std::make_shared<Heightmap>(dstWidth, dstHeight);
+    const float* src = buffer.data() + srcY * width + srcX;
+    if (areaWidth == scaledWidth && areaHeight == scaledHeight) {
+        for (uint y = 0; y < dstHeight; y++) {
+            std::memcpy(
+                dst->buffer.data() + y * dstWidth,
+                src + y * width,
+                dstWidth * sizeof(float)
+            );
+        }
+        return dst;
+    }
+    resize_area(
+        src,
+        width,
+        areaWidth,
+        areaHeight,
+        scaledWidth,
+        scaledHeight,
+        dst->buffer.data(),
+        dstWidth,
+        dstHeight,
+        interp
+    );
+    return dst;
+}
+
 void Heightmap::crop(
     uint srcx, uint srcy, uint dstwidth, uint dstheight
 ) {
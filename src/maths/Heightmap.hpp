@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include <vector>
 #include <string>
 #include <optional>
@@ -38,6 +39,21 @@ public:
 
     void crop(uint srcX, uint srcY, uint dstWidth, uint dstHeight);
 
+    /// @brief Get the area of the map resized to scaledWidth x scaledHeight
+    /// and cropped to dstWidth x dstHeight at (0, 0). Result is the same
+    /// as of crop + resize + crop of a copy, without intermediate copies
+    std::shared_ptr<Heightmap> sampleArea(
+        uint srcX,
+        uint srcY,
+        uint areaWidth,
+        uint areaHeight,
+        uint scaledWidth,
+        uint scaledHeight,
+        uint dstWidth,
+        uint dstHeight,
+        InterpolationType interpolation
+    ) const;
+
     void clamp();
 
     uint getWidth() const {
@@ -0,0 +1,489 @@
+#include "noise.hpp"
+
+#include <cfloat>
+#include <cstdint>
+#include <type_traits>
+
+#define FNL_IMPL
+#include "FastNoiseLite.h"
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+    #define VC_NOISE_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #ifdef __SSE4_1__
+        #include <smmintrin.h>
+    #endif
+    #define VC_NOISE_SSE2
+#endif
+
+using namespace noise;
+
+// Kernels below repeat FastNoiseLite operations in the same order,
+// so results are bit-identical to the scalar implementation. The file
+// is compiled without floating point contraction (see CMakeLists.txt)
+// as the compiler could fuse multiply-adds differently in both paths.
+
+static constexpr int32_t HASH_MULTIPLIER = 0x27d4eb2d;
+
+namespace {
+    /// @brief One lane backend used for the remaining pixels and
+    /// as the fallback if SIMD is not available
+    struct Scalar {
+        static constexpr int WIDTH = 1;
+        using F = float;
+        using I = int32_t;
+        using M = bool;
+
+        static F load(const float* src) { return *src; }
+        static void store(float* dst, F v) { *dst = v; }
+        static F set(float v) { return v; }
+        static I seti(int32_t v) { return v; }
+        static I iota(int32_t start) { return start; }
+
+        static F add(F a, F b) { return a + b; }
+        static F sub(F a, F b) { return a - b; }
+        static F mul(F a, F b) { return a * b; }
+        /// @return b if a < b is false
+        static F min(F a, F b) { return a < b ? a : b; }
+        static M gt(F a, F b) { return a > b; }
+        static M lt(F a, F b) { return a < b; }
+        static M ge(F a, F b) { return a >= b; }
+        static F select(M m, F a, F b) { return m ? a : b; }
+        static F mask(M m, F a) { return m ? a : 0.0f; }
+        static I trunc(F a) { return static_cast<int32_t>(a); }
+        static F to_float(I a) { return static_cast<float>(a); }
+        static I mask_to_int(M m) { return m ? -1 : 0; }
+
+        static I iadd(I a, I b) {
+            return static_cast<int32_t>(
+                static_cast<uint32_t>(a) + static_cast<uint32_t>(b)
+            );
+        }
+        static I imul(I a, I b) {
+            return static_cast<int32_t>(
+                static_cast<uint32_t>(a) * static_cast<uint32_t>(b)
+            );
+        }
+        static I ixor(I a, I b) { return a ^ b; }
+        static I iand(I a, I b) { return a & b; }
+        template <int N>
+        static I isra(I a) { return a >> N; }
+        static I iselect(M m, I a, I b) { return m ? a : b; }
+        static F gather(const float* table, I index) { return table[index]; }
+    };
+
+#ifdef VC_NOISE_SSE2
+    struct SSE2 {
+        static constexpr int WIDTH = 4;
+        using F = __m128;
+        using I = __m128i;
+        using M = __m128;
+
+        static F load(const float* src) { return _mm_loadu_ps(src); }
+        static void store(float* dst, F v) { _mm_storeu_ps(dst, v); }
+        static F set(float v) { return _mm_set1_ps(v); }
+        static I seti(int32_t v) { return _mm_set1_epi32(v); }
+        static I iota(int32_t start) {
+            return _mm_setr_epi32(start, start + 1, start + 2, start + 3);
+        }
+
+        static F add(F a, F b) { return _mm_add_ps(a, b); }
+        static F sub(F a, F b) { return _mm_sub_ps(a, b); }
+        static F mul(F a, F b) { return _mm_mul_ps(a, b); }
+        static F min(F a, F b) { return _mm_min_ps(a, b); }
+        static M gt(F a, F b) { return _mm_cmpgt_ps(a, b); }
+        static M lt(F a, F b) { return _mm_cmplt_ps(a, b); }
+        static M ge(F a, F b) { return _mm_cmpge_ps(a, b); }
+        static F select(M m, F a, F b) {
+#ifdef __SSE4_1__
+            return _mm_blendv_ps(b, a, m);
+#else
+            return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b));
+#endif
+        }
+        static F mask(M m, F a) { return _mm_and_ps(m, a); }
+        static I trunc(F a) { return _mm_cvttps_epi32(a); }
+        static F to_float(I a) { return _mm_cvtepi32_ps(a); }
+        static I mask_to_int(M m) { return _mm_castps_si128(m); }
+
+        static I iadd(I a, I b) { return _mm_add_epi32(a, b); }
+        static I imul(I a, I b) {
+#ifdef __SSE4_1__
+            return _mm_mullo_epi32(a, b);
+#else
+            I even = _mm_mul_epu32(a, b);
+            I odd = _mm_mul_epu32(_mm_srli_si128(a, 4), _mm_srli_si128(b, 4));
+            return _mm_unpacklo_epi32(
+                _mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0))
+            );
+#endif
+        }
+        static I ixor(I a, I b) { return _mm_xor_si128(a, b); }
+        static I iand(I a, I b) { return _mm_and_si128(a, b); }
+        template <int N>
+        static I isra(I a) { return _mm_srai_epi32(a, N); }
+        static I iselect(M m, I a, I b) {
+            return _mm_castps_si128(
+                select(m, _mm_castsi128_ps(a), _mm_castsi128_ps(b))
+            );
+        }
+        static F gather(const float* table, I index) {
+            alignas(16) int32_t indices[WIDTH];
+            _mm_store_si128(reinterpret_cast<__m128i*>(indices), index);
+            return _mm_setr_ps(
+                table[indices[0]],
+                table[indices[1]],
+                table[indices[2]],
+                table[indices[3]]
+            );
+        }
+    };
+    using Vector = SSE2;
+#elif defined(VC_NOISE_AVX2)
+    struct AVX2 {
+        static constexpr int WIDTH = 8;
+        using F = __m256;
+        using I = __m256i;
+        using M = __m256;
+
+        static F load(const float* src) { return _mm256_loadu_ps(src); }
+        static void store(float* dst, F v) { _mm256_storeu_ps(dst, v); }
+        static F set(float v) { return _mm256_set1_ps(v); }
+        static I seti(int32_t v) { return _mm256_set1_epi32(v); }
+        static I iota(int32_t start) {
+            return _mm256_add_epi32(
+                _mm256_set1_epi32(start),
+                _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7)
+            );
+        }
+
+        static F add(F a, F b) { return _mm256_add_ps(a, b); }
+        static F sub(F a, F b) { return _mm256_sub_ps(a, b); }
+        static F mul(F a, F b) { return _mm256_mul_ps(a, b); }
+        static F min(F a, F b) { return _mm256_min_ps(a, b); }
+        static M gt(F a, F b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+        static M lt(F a, F b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+        static M ge(F a, F b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+        static F select(M m, F a, F b) { return _mm256_blendv_ps(b, a, m); }
+        static F mask(M m, F a) { return _mm256_and_ps(m, a); }
+        static I trunc(F a) { return _mm256_cvttps_epi32(a); }
+        static F to_float(I a) { return _mm256_cvtepi32_ps(a); }
+        static I mask_to_int(M m) { return _mm256_castps_si256(m); }
+
+        static I iadd(I a, I b) { return _mm256_add_epi32(a, b); }
+        static I imul(I a, I b) { return _mm256_mullo_epi32(a, b); }
+        static I ixor(I a, I b) { return _mm256_xor_si256(a, b); }
+        static I iand(I a, I b) { return _mm256_and_si256(a, b); }
+        template <int N>
+        static I isra(I a) { return _mm256_srai_epi32(a, N); }
+        static I iselect(M m, I a, I b) {
+            return _mm256_blendv_epi8(b, a, _mm256_castps_si256(m));
+        }
+        static F gather(const float* table, I index) {
+            return _mm256_i32gather_ps(table, index, 4);
+        }
+    };
+    using Vector = AVX2;
+#else
+    using Vector = Scalar;
+#endif
+
+    enum class Kernel {
+        OPENSIMPLEX2,
+        /// @brief Cellular noise with euclidean squared distance
+        CELLULAR_DISTANCE,
+        /// @brief Not supported settings, using fnlGetNoise2D
+        FALLBACK,
+    };
+
+    struct Sampler {
+        Kernel kernel;
+        fnl_state state;
+        float jitter;
+
+        Sampler(const fnl_state& state) : state(state) {
+            jitter = 0.5f * state.cellular_jitter_mod;
+            if (state.fractal_type != FNL_FRACTAL_NONE) {
+                kernel = Kernel::FALLBACK;
+            } else if (state.noise_type == FNL_NOISE_OPENSIMPLEX2) {
+                kernel = Kernel::OPENSIMPLEX2;
+            } else if (state.noise_type == FNL_NOISE_CELLULAR &&
+                       state.cellular_distance_func ==
+                           FNL_CELLULAR_DISTANCE_EUCLIDEANSQ &&
+                       state.cellular_return_type ==
+                           FNL_CELLULAR_RETURN_VALUE_DISTANCE) {
+                kernel = Kernel::CELLULAR_DISTANCE;
+            } else {
+                kernel = Kernel::FALLBACK;
+            }
+        }
+    };
+}
+
+template <class B>
+static inline typename B::I fast_floor(typename B::F f) {
+    return B::iadd(B::trunc(f), B::mask_to_int(B::lt(f, B::set(0.0f))));
+}
+
+template <class B>
+static inline typename B::I fast_round(typename B::F f) {
+    auto half = B::select(B::ge(f, B::set(0.0f)), B::set(0.5f), B::set(-0.5f));
+    return B::trunc(B::add(f, half));
+}
+
+template <class B>
+static inline typename B::I hash_2d(
+    typename B::I seed, typename B::I xPrimed, typename B::I yPrimed
+) {
+    auto hash = B::ixor(B::ixor(seed, xPrimed), yPrimed);
+    return B::imul(hash, B::seti(HASH_MULTIPLIER));
+}
+
+template <class B>
+static inline typename B::F grad_coord_2d(
+    typename B::I seed,
+    typename B::I xPrimed,
+    typename B::I yPrimed,
+    typename B::F xd,
+    typename B::F yd
+) {
+    auto hash = hash_2d<B>(seed, xPrimed, yPrimed);
+    hash = B::ixor(hash, B::template isra<15>(hash));
+    hash = B::iand(hash, B::seti(127 << 1));
+    // hash is even, so hash | 1 == hash + 1
+    auto xg = B::gather(GRADIENTS_2D, hash);
+    auto yg = B::gather(GRADIENTS_2D + 1, hash);
+    return B::add(B::mul(xd, xg), B::mul(yd, yg));
+}
+
+/// @brief _fnlSingleSimplex2D
+template <class B>
+static typename B::F simplex_2d(
+    typename B::I seed, typename B::F x, typename B::F y
+) {
+    const float SQRT3 = 1.7320508075688772935274463415059f;
+    const float G2 = (3 - SQRT3) / 6;
+    const float C_T = (float)(2 * (1 - 2 * G2) * (1 / G2 - 2));
+    const float C_A = (float)(-2 * (1 - 2 * G2) * (1 - 2 * G2));
+    const int32_t PX = PRIME_X;
+    const int32_t PY = PRIME_Y;
+
+    auto i = fast_floor<B>(x);
+    auto j = fast_floor<B>(y);
+    auto xi = B::sub(x, B::to_float(i));
+    auto yi = B::sub(y, B::to_float(j));
+
+    auto t = B::mul(B::add(xi, yi), B::set(G2));
+    auto x0 = B::sub(xi, t);
+    auto y0 = B::sub(yi, t);
+
+    i = B::imul(i, B::seti(PX));
+    j = B::imul(j, B::seti(PY));
+    auto zero = B::set(0.0f);
+
+    auto a = B::sub(B::sub(B::set(0.5f), B::mul(x0, x0)), B::mul(y0, y0));
+    auto aa = B::mul(a, a);
+    auto n0 = B::mask(
+        B::gt(a, zero),
+        B::mul(B::mul(aa, aa), grad_coord_2d<B>(seed, i, j, x0, y0))
+    );
+
+    auto c = B::add(B::mul(B::set(C_T), t), B::add(B::set(C_A), a));
+    auto x2 = B::add(x0, B::set(2 * (float)G2 - 1));
+    auto y2 = B::add(y0, B::set(2 * (float)G2 - 1));
+    auto cc = B::mul(c, c);
+    auto n2 = B::mask(
+        B::gt(c, zero),
+        B::mul(
+            B::mul(cc, cc),
+            grad_coord_2d<B>(
+                seed, B::iadd(i, B::seti(PX)), B::iadd(j, B::seti(PY)), x2, y2
+            )
+        )
+    );
+
+    auto upper = B::gt(y0, x0);
+    auto x1 = B::select(
+        upper, B::add(x0, B::set(G2)), B::add(x0, B::set(G2 - 1))
+    );
+    auto y1 = B::select(
+        upper, B::add(y0, B::set(G2 - 1)), B::add(y0, B::set(G2))
+    );
+    auto i1 = B::iselect(upper, i, B::iadd(i, B::seti(PX)));
+    auto j1 = B::iselect(upper, B::iadd(j, B::seti(PY)), j);
+    auto b = B::sub(B::sub(B::set(0.5f), B::mul(x1, x1)), B::mul(y1, y1));
+    auto bb = B::mul(b, b);
+    auto n1 = B::mask(
+        B::gt(b, zero),
+        B::mul(B::mul(bb, bb), grad_coord_2d<B>(seed, i1, j1, x1, y1))
+    );
+    return B::mul(B::add(B::add(n0, n1), n2), B::set(99.83685446303647f));
+}
+
+/// @brief _fnlSingleCellular2D with euclidean squared distance and
+/// distance return type
+template <class B>
+static typename B::F cellular_distance_2d(
+    typename B::I seed, float jitter, typename B::F x, typename B::F y
+) {
+    auto xr = fast_round<B>(x);
+    auto yr = fast_round<B>(y);
+    auto cellularJitter = B::set(jitter);
+
+    auto distance = B::set(FLT_MAX);
+    auto xPrimed = B::imul(B::iadd(xr, B::seti(-1)), B::seti(PRIME_X));
+    auto yPrimedBase = B::imul(B::iadd(yr, B::seti(-1)), B::seti(PRIME_Y));
+
+    for (int xo = -1; xo <= 1; xo++) {
+        auto yPrimed = yPrimedBase;
+        auto xd = B::sub(B::to_float(B::iadd(xr, B::seti(xo))), x);
+        for (int yo = -1; yo <= 1; yo++) {
+            auto hash = hash_2d<B>(seed, xPrimed, yPrimed);
+            auto index = B::iand(hash, B::seti(255 << 1));
+
+            auto vecX = B::add(
+                xd, B::mul(B::gather(RAND_VECS_2D, index), cellularJitter)
+            );
+            auto vecY = B::add(
+                B::sub(B::to_float(B::iadd(yr, B::seti(yo))), y),
+                B::mul(B::gather(RAND_VECS_2D + 1, index), cellularJitter)
+            );
+            auto newDistance = B::add(B::mul(vecX, vecX), B::mul(vecY, vecY));
+            distance = B::min(newDistance, distance);
+            yPrimed = B::iadd(yPrimed, B::seti(PRIME_Y));
+        }
+        xPrimed = B::iadd(xPrimed, B::seti(PRIME_X));
+    }
+    return B::sub(distance, B::set(1.0f));
+}
+
+/// @brief fnlGetNoise2D for all lanes
+template <class B>
+static inline typename B::F sample(
+    Sampler& sampler, typename B::F x, typename B::F y
+) {
+    if constexpr (std::is_same_v<B, Scalar>) {
+        if (sampler.kernel == Kernel::FALLBACK) {
+            return fnlGetNoise2D(&sampler.state, x, y);
+        }
+    }
+    const auto& state = sampler.state;
+    auto seed = B::seti(state.seed);
+    x = B::mul(x, B::set(state.frequency));
+    y = B::mul(y, B::set(state.frequency));
+
+    if (sampler.kernel == Kernel::OPENSIMPLEX2) {
+        const FNLfloat SQRT3 = (FNLfloat)1.7320508075688772935274463415059;
+        const FNLfloat F2 = 0.5f * (SQRT3 - 1);
+        auto t = B::mul(B::add(x, y), B::set(F2));
+        return simplex_2d<B>(seed, B::add(x, t), B::add(y, t));
+    }
+    return cellular_distance_2d<B>(seed, sampler.jitter, x, y);
+}
+
+template <class B>
+static size_t get_noise_lanes(
+    Sampler& sampler,
+    const float* xs,
+    const float* ys,
+    float* dst,
+    size_t index,
+    size_t count
+) {
+    for (; index + B::WIDTH <= count; index += B::WIDTH) {
+        B::store(
+            dst + index,
+            sample<B>(sampler, B::load(xs + index), B::load(ys + index))
+        );
+    }
+    return index;
+}
+
+template <class B>
+static uint add_fractal_lanes(
+    Sampler& sampler,
+    float* values,
+    uint x,
+    uint y,
+    uint width,
+    const FractalParams& params
+) {
+    auto offsetX = B::set(params.offsetX);
+    auto fy = B::set(static_cast<float>(y) + params.offsetY);
+    auto multiplier = B::set(params.multiplier);
+    for (; x + B::WIDTH <= width; x += B::WIDTH) {
+        size_t i = static_cast<size_t>(y) * width + x;
+        auto fx = B::add(B::to_float(B::iota(x)), offsetX);
+        auto value = B::load(values + i);
+        for (int c = 0; c < params.octaves; c++) {
+            auto m = B::set(params.scale * (1 << c));
+            auto u = B::mul(fx, m);
+            auto v = B::mul(fy, m);
+            if (params.shiftX) {
+                u = B::add(u, B::load(params.shiftX + i));
+            }
+            if (params.shiftY) {
+                v = B::add(v, B::load(params.shiftY + i));
+            }
+            // division by power of two is equal to multiplication
+            // by its reciprocal
+            auto weight = B::set(1.0f / static_cast<float>(1 << c));
+            value = B::add(
+                value,
+                B::mul(B::mul(sample<B>(sampler, u, v), weight), multiplier)
+            );
+        }
+        B::store(values + i, value);
+    }
+    return x;
+}
+
+void noise::get_noise_2d(
+    const fnl_state& state,
+    const float* xs,
+    const float* ys,
+    float* dst,
+    size_t count
+) {
+    Sampler sampler(state);
+    size_t index = 0;
+    if (sampler.kernel != Kernel::FALLBACK) {
+        index = get_noise_lanes<Vector>(sampler, xs, ys, dst, index, count);
+    }
+    get_noise_lanes<Scalar>(sampler, xs, ys, dst, index, count);
+}
+
+void noise::add_fractal_2d(
+    const fnl_state& state,
+    float* values,
+    uint width,
+    uint height,
+    const FractalParams& params
+) {
+    Sampler sampler(state);
+    for (uint y = 0; y < height; y++) {
+        uint x = 0;
+        if (sampler.kernel != Kernel::FALLBACK) {
+            x = add_fractal_lanes<Vector>(sampler, values, x, y, width, params);
+        }
+        add_fractal_lanes<Scalar>(sampler, values, x, y, width, params);
+    }
+}
+
+const char* noise::get_instruction_set() {
+#if defined(VC_NOISE_AVX2)
+    return "avx2";
+#elif defined(VC_NOISE_SSE2)
+    #ifdef __SSE4_1__
+    return "sse4.1";
+    #else
+    return "sse2";
+    #endif
+#else
+    return "scalar";
+#endif
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+
+#include "typedefs.hpp"
+
+struct fnl_state;
+
+/// @brief Batch noise evaluation.
+/// OpenSimplex2 and cellular (default settings) kernels process
+/// multiple pixels at once using SIMD (AVX2 or SSE2 if available at compile
+/// time) with results identical to the scalar fnlGetNoise2D.
+/// Other noise settings fall back to fnlGetNoise2D.
+namespace noise {
+    struct FractalParams {
+        float offsetX = 0.0f;
+        float offsetY = 0.0f;
+        /// @brief Coordinates scale of the first octave
+        float scale = 1.0f;
+        int octaves = 1;
+        float multiplier = 1.0f;
+        /// @brief Optional X coordinates shift map (width * height)
+        const float* shiftX = nullptr;
+        /// @brief Optional Y coordinates shift map (width * height)
+        const float* shiftY = nullptr;
+    };
+
+    /// @brief dst[i] = fnlGetNoise2D(&state, xs[i], ys[i])
+    void get_noise_2d(
+        const fnl_state& state,
+        const float* xs,
+        const float* ys,
+        float* dst,
+        size_t count
+    );
+
+    /// @brief Add octaves of noise to the map values in a single pass.
+    /// Octave c noise is sampled at ((x, y) + offset) * scale * 2^c + shift
+    /// and added multiplied by multiplier / 2^c
+    void add_fractal_2d(
+        const fnl_state& state,
+        float* values,
+        uint width,
+        uint height,
+        const FractalParams& params
+    );
+
+    /// @return name of the SIMD instruction set used by kernels
+    const char* get_instruction_set();
+}
@@ -1,4 +1,5 @@
 #include "Network.hpp"
+#include "SocketReactor.hpp"
 
 #include <stdexcept>
 #include <limits>
@@ -16,6 +17,7 @@ namespace network {
     std::unique_ptr<Requests> create_curl_requests();
 
     std::shared_ptr<TcpConnection> connect_tcp(
+        SocketReactor& reactor,
         const std::string& address,
         int port,
         runnable callback,
@@ -23,11 +25,16 @@ namespace network {
     );
 
     std::shared_ptr<TcpServer> open_tcp_server(
-        u64id_t id, Network* network, int port, ConnectCallback handler
+        u64id_t id,
+        Network* network,
+        SocketReactor& reactor,
+        int port,
+        ConnectCallback handler
     );
 
     std::shared_ptr<UdpConnection> connect_udp(
         u64id_t id,
+        SocketReactor& reactor,
         const std::string& address,
         int port,
         ClientDatagramCallback handler,
@@ -37,6 +44,7 @@ namespace network {
     std::shared_ptr<UdpServer> open_udp_server(
         u64id_t id,
         Network* network,
+        SocketReactor& reactor,
         int port,
         const ServerDatagramCallback& handler
     );
@@ -45,11 +53,28 @@ namespace network {
 }
 
 
-Network::Network(std::unique_ptr<Requests> requests)
-: requests(std::move(requests)) {
+Network::Network(
+    std::unique_ptr<Requests> requests,
+    std::unique_ptr<SocketReactor> reactor
+)
+    : requests(std::move(requests)), reactor(std::move(reactor)) {
 }
 
-Network::~Network() = default;
+Network::~Network() {
+    for (auto& [_, server] : servers) {
+        server->close();
+    }
+    servers.clear();
+    {
+        std::lock_guard lock(connectionsMutex);
+        for (auto& [_, connection] : connections) {
+            connection->close(true);
+        }
+        connections.clear();
+    }
+    // stop I/O threads after all sockets are detached
+    reactor.reset();
+}
 
 void Network::get(
     const std::string& url,
@@ -105,7 +130,7 @@ u64id_t Network::connectTcp(
     std::lock_guard lock(connectionsMutex);
     
     u64id_t id = nextConnection++;
-    auto socket = connect_tcp(address, port, [id, callback]() {
+    auto socket = connect_tcp(*reactor, address, port, [id, callback]() {
         callback(id);
     }, [id, errorCallback](auto errorMessage) {
         errorCallback(id, errorMessage);
@@ -116,7 +141,7 @@ u64id_t Network::connectTcp(
 
 u64id_t Network::openTcpServer(int port, ConnectCallback handler) {
     u64id_t id = nextServer++;
-    auto server = open_tcp_server(id, this, port, handler);
+    auto server = open_tcp_server(id, this, *reactor, port, handler);
     servers[id] = std::move(server);
     return id;
 }
@@ -130,7 +155,7 @@ u64id_t Network::connectUdp(
     std::lock_guard lock(connectionsMutex);
 
     u64id_t id = nextConnection++;
-    auto socket = connect_udp(id, address, port, std::move(handler), [id, callback]() {
+    auto socket = connect_udp(id, *reactor, address, port, std::move(handler), [id, callback]() {
         callback(id);
     });
     connections[id] = std::move(socket);
@@ -139,7 +164,7 @@ u64id_t Network::connectUdp(
 
 u64id_t Network::openUdpServer(int port, const ServerDatagramCallback& handler) {
     u64id_t id = nextServer++;
-    auto server = open_udp_server(id, this, port, handler);
+    auto server = open_udp_server(id, this, *reactor, port, handler);
     servers[id] = std::move(server);
     return id;
 }
@@ -195,5 +220,8 @@ void Network::update() {
 
 std::unique_ptr<Network> Network::create(const NetworkSettings& settings) {
     logger.info() << "initializing network";
-    return std::make_unique<Network>(network::create_curl_requests());
+    return std::make_unique<Network>(
+        network::create_curl_requests(),
+        std::make_unique<SocketReactor>(settings.ioThreads.get())
+    );
 }
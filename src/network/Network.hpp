@@ -52,8 +52,11 @@ namespace network {
         }
     };
 
+    class SocketReactor;
+
     class Network {
         std::unique_ptr<Requests> requests;
+        std::unique_ptr<SocketReactor> reactor;
 
         std::unordered_map<u64id_t, std::shared_ptr<Connection>> connections;
         std::mutex connectionsMutex {};
@@ -65,7 +68,10 @@ namespace network {
         size_t totalDownload = 0;
         size_t totalUpload = 0;
     public:
-        Network(std::unique_ptr<Requests> requests);
+        Network(
+            std::unique_ptr<Requests> requests,
+            std::unique_ptr<SocketReactor> reactor
+        );
         ~Network();
 
         void get(
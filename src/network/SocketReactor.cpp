@@ -0,0 +1,330 @@
+#include "SocketReactor.hpp"
+
+#define NOMINMAX
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <mutex>
+#include <thread>
+#include <cstring>
+#include <stdexcept>
+#include <unordered_map>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#else
+#include <poll.h>
+#include <unistd.h>
+#include <errno.h>
+#endif
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#endif
+
+#include "debug/Logger.hpp"
+
+using namespace network;
+
+static debug::Logger logger("reactor");
+
+static inline void close_descriptor(socket_t descriptor) noexcept {
+#ifdef _WIN32
+    closesocket(descriptor);
+#else
+    close(descriptor);
+#endif
+}
+
+/// @brief Single I/O thread with its own set of sockets
+class SocketReactor::Loop {
+    struct Entry {
+        std::weak_ptr<SocketHandler> handler;
+        bool read;
+        bool write;
+    };
+    std::unordered_map<socket_t, Entry> entries;
+    /// @brief Detached descriptors waiting to be closed by the I/O thread
+    std::vector<socket_t> closing;
+    std::mutex mutex;
+    std::atomic<bool> working = true;
+    std::thread thread;
+#ifdef __linux__
+    int epoll;
+    int wakeDescriptor;
+
+    static uint32_t to_epoll_events(bool read, bool write) {
+        uint32_t events = 0;
+        if (read) {
+            events |= EPOLLIN | EPOLLRDHUP;
+        }
+        if (write) {
+            events |= EPOLLOUT;
+        }
+        return events;
+    }
+
+    /// @brief Sockets with no watched events are removed from epoll set
+    /// to not receive EPOLLHUP/EPOLLERR while suspended
+    void control(socket_t descriptor, const Entry& entry, int operation) {
+        epoll_event event {};
+        event.events = to_epoll_events(entry.read, entry.write);
+        event.data.fd = descriptor;
+        if (epoll_ctl(epoll, operation, descriptor, &event) == -1) {
+            throw std::runtime_error(
+                "epoll_ctl failed: " + std::string(strerror(errno))
+            );
+        }
+    }
+
+    void wake() {
+        uint64_t value = 1;
+        [[maybe_unused]] auto _ = ::write(wakeDescriptor, &value, sizeof(value));
+    }
+#else
+    void wake() {
+        // poll-based loop uses short timeouts instead of wakeup descriptor
+    }
+#endif
+
+    std::shared_ptr<SocketHandler> getHandler(socket_t descriptor) {
+        std::lock_guard lock(mutex);
+        const auto& found = entries.find(descriptor);
+        if (found == entries.end()) {
+            return nullptr;
+        }
+        return found->second.handler.lock();
+    }
+
+    void dispatch(socket_t descriptor, bool readable, bool writable) {
+        auto handler = getHandler(descriptor);
+        if (handler == nullptr) {
+            // handler is destroyed without detaching
+            remove(descriptor);
+            return;
+        }
+        if (readable) {
+            handler->onReadable();
+        }
+        if (writable && getHandler(descriptor) != nullptr) {
+            handler->onWritable();
+        }
+    }
+
+    void closeDetached() {
+        std::vector<socket_t> descriptors;
+        {
+            std::lock_guard lock(mutex);
+            std::swap(descriptors, closing);
+        }
+        for (auto descriptor : descriptors) {
+            close_descriptor(descriptor);
+        }
+    }
+
+#ifdef __linux__
+    void run() {
+        constexpr int MAX_EVENTS = 64;
+        epoll_event events[MAX_EVENTS];
+        while (working) {
+            int count = epoll_wait(epoll, events, MAX_EVENTS, -1);
+            if (count < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                logger.error() << "epoll_wait failed: " << strerror(errno);
+                break;
+            }
+            for (int i = 0; i < count; i++) {
+                const auto& event = events[i];
+                if (event.data.fd == wakeDescriptor) {
+                    uint64_t value;
+                    [[maybe_unused]] auto _ =
+                        ::read(wakeDescriptor, &value, sizeof(value));
+                    continue;
+                }
+                dispatch(
+                    event.data.fd,
+                    event.events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR),
+                    event.events & EPOLLOUT
+                );
+            }
+            closeDetached();
+        }
+    }
+#else
+    void run() {
+        std::vector<pollfd> fds;
+        while (working) {
+            fds.clear();
+            {
+                std::lock_guard lock(mutex);
+                for (const auto& [descriptor, entry] : entries) {
+                    if (!entry.read && !entry.write) {
+                        continue;
+                    }
+                    pollfd fd {};
+                    fd.fd = descriptor;
+                    fd.events = (entry.read ? POLLIN : 0) |
+                                (entry.write ? POLLOUT : 0);
+                    fds.push_back(fd);
+                }
+            }
+            if (fds.empty()) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                closeDetached();
+                continue;
+            }
+#ifdef _WIN32
+            int count = WSAPoll(fds.data(), fds.size(), 10);
+#else
+            int count = poll(fds.data(), fds.size(), 10);
+#endif
+            if (count > 0) {
+                for (const auto& fd : fds) {
+                    if (fd.revents == 0) {
+                        continue;
+                    }
+                    dispatch(
+                        fd.fd,
+                        fd.revents & (POLLIN | POLLHUP | POLLERR),
+                        fd.revents & POLLOUT
+                    );
+                }
+            }
+            closeDetached();
+        }
+    }
+#endif
+public:
+    Loop() {
+#ifdef __linux__
+        epoll = epoll_create1(EPOLL_CLOEXEC);
+        if (epoll == -1) {
+            throw std::runtime_error(
+                "epoll_create1 failed: " + std::string(strerror(errno))
+            );
+        }
+        wakeDescriptor = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (wakeDescriptor == -1) {
+            close(epoll);
+            throw std::runtime_error(
+                "eventfd failed: " + std::string(strerror(errno))
+            );
+        }
+        epoll_event event {};
+        event.events = EPOLLIN;
+        event.data.fd = wakeDescriptor;
+        epoll_ctl(epoll, EPOLL_CTL_ADD, wakeDescriptor, &event);
+#endif
+        thread = std::thread([this]() { run(); });
+    }
+
+    ~Loop() {
+        working = false;
+        wake();
+        thread.join();
+        for (const auto& [descriptor, _] : entries) {
+            close_descriptor(descriptor);
+        }
+        closeDetached();
+#ifdef __linux__
+        close(wakeDescriptor);
+        close(epoll);
+#endif
+    }
+
+    void add(
+        socket_t descriptor,
+        std::weak_ptr<SocketHandler> handler,
+        bool read,
+        bool write
+    ) {
+        std::lock_guard lock(mutex);
+        Entry entry {std::move(handler), read, write};
+#ifdef __linux__
+        if (read || write) {
+            control(descriptor, entry, EPOLL_CTL_ADD);
+        }
+#endif
+        entries[descriptor] = std::move(entry);
+    }
+
+    void modify(socket_t descriptor, bool read, bool write) {
+        std::lock_guard lock(mutex);
+        const auto& found = entries.find(descriptor);
+        if (found == entries.end()) {
+            return;
+        }
+        auto& entry = found->second;
+        if (entry.read == read && entry.write == write) {
+            return;
+        }
+#ifdef __linux__
+        bool wasWatched = entry.read || entry.write;
+#endif
+        entry.read = read;
+        entry.write = write;
+#ifdef __linux__
+        if (!read && !write) {
+            control(descriptor, entry, EPOLL_CTL_DEL);
+        } else {
+            control(descriptor, entry, wasWatched ? EPOLL_CTL_MOD : EPOLL_CTL_ADD);
+        }
+#endif
+    }
+
+    void remove(socket_t descriptor) {
+        {
+            std::lock_guard lock(mutex);
+            const auto& found = entries.find(descriptor);
+            if (found == entries.end()) {
+                return;
+            }
+#ifdef __linux__
+            if (found->second.read || found->second.write) {
+                epoll_ctl(epoll, EPOLL_CTL_DEL, descriptor, nullptr);
+            }
+#endif
+            entries.erase(found);
+            closing.push_back(descriptor);
+        }
+        wake();
+    }
+};
+
+SocketReactor::SocketReactor(int threads) {
+    threads = std::max(1, threads);
+    for (int i = 0; i < threads; i++) {
+        loops.emplace_back(std::make_unique<Loop>());
+    }
+    logger.info() << "started " << threads << " I/O thread(s)";
+}
+
+SocketReactor::~SocketReactor() = default;
+
+SocketReactor::Loop& SocketReactor::getLoop(socket_t descriptor) const {
+    return *loops[static_cast<size_t>(descriptor) % loops.size()];
+}
+
+void SocketReactor::add(
+    socket_t descriptor,
+    std::weak_ptr<SocketHandler> handler,
+    bool read,
+    bool write
+) {
+    getLoop(descriptor).add(descriptor, std::move(handler), read, write);
+}
+
+void SocketReactor::modify(socket_t descriptor, bool read, bool write) {
+    getLoop(descriptor).modify(descriptor, read, write);
+}
+
+void SocketReactor::remove(socket_t descriptor) {
+    getLoop(descriptor).remove(descriptor);
+}
+
+size_t SocketReactor::getThreadsCount() const {
+    return loops.size();
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <cstdint>
+
+namespace network {
+#ifdef _WIN32
+    using socket_t = uintptr_t;
+#else
+    using socket_t = int;
+#endif
+
+    /// @brief Receiver of socket readiness events.
+    /// Methods are called from the I/O thread the socket is attached to.
+    class SocketHandler {
+    public:
+        virtual ~SocketHandler() = default;
+
+        /// @brief Called when socket has data to read, got closed or failed
+        virtual void onReadable() = 0;
+
+        /// @brief Called when socket is ready to accept outgoing data
+        virtual void onWritable() = 0;
+    };
+
+    /// @brief Event-driven sockets multiplexer with a fixed number of
+    /// I/O threads (epoll on Linux, poll on other platforms).
+    /// Sockets must be non-blocking.
+    class SocketReactor {
+        class Loop;
+
+        std::vector<std::unique_ptr<Loop>> loops;
+
+        Loop& getLoop(socket_t descriptor) const;
+    public:
+        /// @param threads number of I/O threads
+        SocketReactor(int threads);
+        ~SocketReactor();
+
+        /// @brief Start watching socket events
+        /// @param handler events receiver (reactor does not own it)
+        /// @param read watch for incoming data
+        /// @param write watch for outgoing data readiness
+        void add(
+            socket_t descriptor,
+            std::weak_ptr<SocketHandler> handler,
+            bool read,
+            bool write
+        );
+
+        /// @brief Change watched events of an attached socket
+        void modify(socket_t descriptor, bool read, bool write);
+
+        /// @brief Detach socket from the reactor. Descriptor is closed
+        /// by the I/O thread after current events dispatch is finished,
+        /// so it must not be used after this call
+        void remove(socket_t descriptor);
+
+        size_t getThreadsCount() const;
+    };
+}
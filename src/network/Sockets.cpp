@@ -3,10 +3,9 @@
 #pragma comment(lib, "Ws2_32.lib")
 
 #define NOMINMAX
+#include <atomic>
 #include <stdexcept>
 #include <limits>
-#include <queue>
-#include <thread>
 
 #ifdef _WIN32
 #include <curl/curl.h>
@@ -21,11 +20,14 @@
 #include <unistd.h>
 #include <fcntl.h>
 #include <errno.h>
+#include <sys/uio.h>
 
 using SOCKET = int;
 #endif // _WIN32
 
 #include "Network.hpp"
+#include "SocketReactor.hpp"
+#include "util/RingBuffer.hpp"
 #include "util/stringutil.hpp"
 #include "debug/Logger.hpp"
 
@@ -69,24 +71,116 @@ static inline std::runtime_error handle_socket_error(const std::string& message)
 }
 #endif
 
+/// @brief Initial size of TCP connection read and write buffers
+static constexpr size_t TCP_BUFFER_INIT_SIZE = 16'384;
+/// @brief Max unread bytes per TCP connection. Reading from socket is
+/// suspended when reached
+static constexpr size_t TCP_READ_BUFFER_MAX = 8 * 1024 * 1024;
+/// @brief Max bytes waiting to be sent per TCP connection.
+/// send(...) accepts less bytes than requested when reached
+static constexpr size_t TCP_WRITE_QUEUE_MAX = 16 * 1024 * 1024;
+/// @brief Max datagrams received at once to not starve other sockets
+/// of the same I/O thread
+static constexpr int UDP_MAX_DATAGRAMS_PER_EVENT = 64;
+
+#ifdef MSG_NOSIGNAL
+static constexpr int SEND_FLAGS = MSG_NOSIGNAL;
+#else
+static constexpr int SEND_FLAGS = 0;
+#endif
+
+using IOSpan = util::RingBuffer<char>::Span;
+
 static inline int connectsocket(
     int descriptor, const sockaddr* addr, socklen_t len
 ) noexcept {
     return connect(descriptor, addr, len);
 }
 
-static inline int recvsocket(
-    int descriptor, char* buf, size_t len
-) noexcept {
-    return recv(descriptor, buf, len, 0);
-}
-
 static inline int sendsocket(
     int descriptor, const char* buf, size_t len, int flags
 ) noexcept {
     return send(descriptor, buf, len, flags);
 }
 
+static inline bool is_would_block() noexcept {
+#ifdef _WIN32
+    return WSAGetLastError() == WSAEWOULDBLOCK;
+#else
+    return errno == EAGAIN || errno == EWOULDBLOCK;
+#endif
+}
+
+static inline bool is_connect_pending() noexcept {
+#ifdef _WIN32
+    return WSAGetLastError() == WSAEWOULDBLOCK;
+#else
+    return errno == EINPROGRESS;
+#endif
+}
+
+static void set_nonblocking(SOCKET descriptor) {
+#ifdef _WIN32
+    u_long mode = 1;
+    if (ioctlsocket(descriptor, FIONBIO, &mode) != 0) {
+#else
+    int flags = fcntl(descriptor, F_GETFL, 0);
+    if (flags == -1 || fcntl(descriptor, F_SETFL, flags | O_NONBLOCK) == -1) {
+#endif
+        throw handle_socket_error("could not make socket non-blocking");
+    }
+}
+
+/// @brief Scatter read into ring buffer free space
+static long recv_spans(SOCKET descriptor, const IOSpan* spans, int count) {
+#ifdef _WIN32
+    WSABUF buffers[2];
+    for (int i = 0; i < count; i++) {
+        buffers[i].buf = spans[i].data;
+        buffers[i].len = static_cast<ULONG>(spans[i].size);
+    }
+    DWORD received = 0;
+    DWORD flags = 0;
+    if (WSARecv(descriptor, buffers, count, &received, &flags, nullptr, nullptr)) {
+        return -1;
+    }
+    return received;
+#else
+    iovec vectors[2];
+    for (int i = 0; i < count; i++) {
+        vectors[i].iov_base = spans[i].data;
+        vectors[i].iov_len = spans[i].size;
+    }
+    return readv(descriptor, vectors, count);
+#endif
+}
+
+/// @brief Gather write from ring buffer stored data
+static long send_spans(SOCKET descriptor, const IOSpan* spans, int count) {
+#ifdef _WIN32
+    WSABUF buffers[2];
+    for (int i = 0; i < count; i++) {
+        buffers[i].buf = spans[i].data;
+        buffers[i].len = static_cast<ULONG>(spans[i].size);
+    }
+    DWORD sent = 0;
+    if (WSASend(descriptor, buffers, count, &sent, 0, nullptr, nullptr)) {
+        return -1;
+    }
+    return sent;
+#else
+    iovec vectors[2];
+    for (int i = 0; i < count; i++) {
+        vectors[i].iov_base = spans[i].data;
+        vectors[i].iov_len = spans[i].size;
+    }
+    msghdr message {};
+    message.msg_iov = vectors;
+    message.msg_iovlen = count;
+    return sendmsg(descriptor, &message, SEND_FLAGS);
+#endif
+}
+
 static std::string to_string(const sockaddr_in& addr, bool port=true) {
     char ip[INET_ADDRSTRLEN];
     if (inet_ntop(AF_INET, &(addr.sin_addr), ip, INET_ADDRSTRLEN)) {
@@ -96,44 +190,152 @@ static std::string to_string(const sockaddr_in& addr, bool port=true) {
     return "";
 }
 
-class SocketTcpConnection : public TcpConnection {
+class SocketTcpConnection : public TcpConnection,
+                            public SocketHandler,
+                            public std::enable_shared_from_this<SocketTcpConnection> {
+    SocketReactor& reactor;
     SOCKET descriptor;
     sockaddr_in addr;
-    size_t totalUpload = 0;
-    size_t totalDownload = 0;
-    ConnectionState state = ConnectionState::INITIAL;
-    std::unique_ptr<std::thread> thread = nullptr;
-    std::vector<char> readBatch;
-    util::Buffer<char> buffer;
+    std::atomic<size_t> totalUpload = 0;
+    std::atomic<size_t> totalDownload = 0;
+    std::atomic<ConnectionState> state = ConnectionState::INITIAL;
+    util::RingBuffer<char> readBuffer;
+    util::RingBuffer<char> writeQueue;
     std::mutex mutex;
-    std::string errorMessage;
+    /// @brief Socket is watched by the reactor
+    bool attached = false;
+    /// @brief Socket is closed or handed to the reactor for closing
+    bool released = false;
+    /// @brief Reading is suspended when read buffer is full
+    bool reading = true;
+    runnable connectCallback;
+    stringconsumer errorCallback;
+
+    /// @brief Update reactor watched events (mutex must be locked)
+    void updateInterest() {
+        if (!attached) {
+            return;
+        }
+        bool connecting = state == ConnectionState::CONNECTING;
+        reactor.modify(
+            descriptor,
+            reading && !connecting,
+            connecting || !writeQueue.empty()
+        );
+    }
+
+    /// @brief Release the socket descriptor (mutex must be locked)
+    void release() {
+        if (released) {
+            return;
+        }
+        released = true;
+        if (attached) {
+            attached = false;
+            reactor.remove(descriptor);
+        } else {
+            closesocket(descriptor);
+        }
+    }
+
+    /// @brief Mark connection as closed by error (mutex must be locked)
+    void fail(const std::string& message) {
+        logger.error() << message;
+        state = ConnectionState::CLOSED;
+        writeQueue.clear();
+        release();
+    }
+
+    /// @brief Send queued data (mutex must be locked)
+    /// @return false if connection failed
+    bool flush() {
+        size_t sent = 0;
+        while (!writeQueue.empty()) {
+            IOSpan spans[2];
+            int count = writeQueue.readable(spans);
+            long len = send_spans(descriptor, spans, count);
+            if (len < 0) {
+                if (is_would_block()) {
+                    break;
+                }
+                fail(handle_socket_error("send failed").what());
+                return false;
+            }
+            writeQueue.consume(len);
+            sent += len;
+        }
+        totalUpload += sent;
+        updateInterest();
+        return true;
+    }
+
+    void finishConnect() {
+        std::unique_lock lock(mutex);
+        if (state != ConnectionState::CONNECTING) {
+            return;
+        }
+        int error = 0;
+        socklen_t len = sizeof(error);
+        if (getsockopt(
+                descriptor, SOL_SOCKET, SO_ERROR, (char*)&error, &len
+            ) < 0) {
+            error = errno;
+        }
+        if (error) {
+            std::string errorMessage =
+                "Connect failed [error=" + std::to_string(error) +
+                "]: " + std::string(strerror(error));
+            fail(errorMessage);
+            lock.unlock();
+            if (errorCallback) {
+                errorCallback(errorMessage);
+            }
+            return;
+        }
+        logger.info() << "connected to " << to_string(addr);
+        state = ConnectionState::CONNECTED;
+        bool alive = flush();
+        lock.unlock();
+        if (alive && connectCallback) {
+            connectCallback();
+        }
+    }
 
     void connectSocket() {
+        std::unique_lock lock(mutex);
         state = ConnectionState::CONNECTING;
         logger.info() << "connecting to " << to_string(addr);
-        int res = connectsocket(descriptor, (const sockaddr*)&addr, sizeof(sockaddr_in));
-        if (res < 0) {
+        set_nonblocking(descriptor);
+        int res = connectsocket(
+            descriptor, (const sockaddr*)&addr, sizeof(sockaddr_in)
+        );
+        if (res < 0 && !is_connect_pending()) {
             auto error = handle_socket_error("Connect failed");
-            closesocket(descriptor);
-            state = ConnectionState::CLOSED;
-            errorMessage = error.what();
-            logger.error() << errorMessage;
+            fail(error.what());
+            lock.unlock();
+            if (errorCallback) {
+                errorCallback(error.what());
+            }
             return;
         }
-        logger.info() << "connected to " << to_string(addr);
-        state = ConnectionState::CONNECTED;
+        // completion is reported as writability
+        attached = true;
+        reactor.add(descriptor, weak_from_this(), false, true);
     }
 public:
-    SocketTcpConnection(SOCKET descriptor, sockaddr_in addr)
-        : descriptor(descriptor), addr(std::move(addr)), buffer(16'384) {}
+    SocketTcpConnection(SocketReactor& reactor, SOCKET descriptor, sockaddr_in addr)
+        : reactor(reactor),
+          descriptor(descriptor),
+          addr(std::move(addr)),
+          readBuffer(TCP_BUFFER_INIT_SIZE, TCP_READ_BUFFER_MAX),
+          writeQueue(TCP_BUFFER_INIT_SIZE, TCP_WRITE_QUEUE_MAX) {}
 
     ~SocketTcpConnection() {
-        if (state != ConnectionState::CLOSED) {
+        std::lock_guard lock(mutex);
+        if (state != ConnectionState::CLOSED && !released) {
             shutdown(descriptor, 2);
         }
-        if (thread) {
-            thread->join();
-        }
+        release();
     }
 
     void setNoDelay(bool noDelay) override {
@@ -152,110 +354,143 @@ public:
         return opt != 0;
     }
 
-    void startListen() {
-        while (state == ConnectionState::CONNECTED) {
-            int size = recvsocket(descriptor, buffer.data(), buffer.size());
+    void onReadable() override {
+        if (state == ConnectionState::CONNECTING) {
+            finishConnect();
+            return;
+        }
+        std::lock_guard lock(mutex);
+        if (state != ConnectionState::CONNECTED) {
+            return;
+        }
+        size_t received = 0;
+        while (true) {
+            if (readBuffer.freeSpace() == 0 && !readBuffer.grow()) {
+                reading = false;
+                updateInterest();
+                break;
+            }
+            IOSpan spans[2];
+            int count = readBuffer.writable(spans);
+            size_t space = readBuffer.freeSpace();
+            long size = recv_spans(descriptor, spans, count);
             if (size == 0) {
                 logger.info() << "closed connection with " << to_string(addr);
-                closesocket(descriptor);
                 state = ConnectionState::CLOSED;
+                writeQueue.clear();
+                release();
                 break;
             } else if (size < 0) {
+                if (is_would_block()) {
+                    break;
+                }
                 logger.warning() << "an error ocurred while receiving from "
                             << to_string(addr);
-                auto error = handle_socket_error("recv(...) error");
-                closesocket(descriptor);
-                state = ConnectionState::CLOSED;
-                logger.error() << error.what();
+                fail(handle_socket_error("recv(...) error").what());
                 break;
             }
-            {
-                std::lock_guard lock(mutex);
-                for (size_t i = 0; i < size; i++) {
-                    readBatch.emplace_back(buffer[i]);
-                }
-                totalDownload += size;
+            readBuffer.commit(size);
+            received += size;
+            if (static_cast<size_t>(size) < space) {
+                break;
             }
         }
+        totalDownload += received;
+    }
+
+    void onWritable() override {
+        if (state == ConnectionState::CONNECTING) {
+            finishConnect();
+            return;
+        }
+        std::lock_guard lock(mutex);
+        if (state == ConnectionState::CONNECTED) {
+            flush();
+        }
     }
 
     void startClient() {
+        std::lock_guard lock(mutex);
         state = ConnectionState::CONNECTED;
-        thread = std::make_unique<std::thread>([this]() { startListen();});
+        attached = true;
+        reactor.add(descriptor, weak_from_this(), true, false);
     }
 
     void connect(runnable callback, stringconsumer errorCallback) override {
-        thread = std::make_unique<std::thread>([this, callback, errorCallback]() {
-            connectSocket();
-            if (state == ConnectionState::CONNECTED) {
-                callback();
-                startListen();
-            } else {
-                errorCallback(errorMessage);
-            }
-        });
+        this->connectCallback = std::move(callback);
+        this->errorCallback = std::move(errorCallback);
+        connectSocket();
     }
 
     int recv(char* buffer, size_t length) override {
         std::lock_guard lock(mutex);
 
-        if (state != ConnectionState::CONNECTED && readBatch.empty()) {
+        if (state != ConnectionState::CONNECTED && readBuffer.empty()) {
             return -1;
         }
-        int size = std::min(readBatch.size(), length);
-        std::memcpy(buffer, readBatch.data(), size);
-        readBatch.erase(readBatch.begin(), readBatch.begin() + size);
+        size_t size = readBuffer.read(buffer, length);
+        if (!reading && size > 0 && state == ConnectionState::CONNECTED) {
+            reading = true;
+            updateInterest();
+        }
         return size;
     }
 
     int send(const char* buffer, size_t length) override {
+        std::lock_guard lock(mutex);
         if (state == ConnectionState::CLOSED) {
             return 0;
         }
-        int len = sendsocket(descriptor, buffer, length, 0);
-        if (len == -1) {
-            int err = errno;
-            close();
-            throw std::runtime_error(
-                "Send failed [errno=" + std::to_string(err) + "]: "
-                 + std::string(strerror(err))
-            );
+        size_t sent = 0;
+        if (state == ConnectionState::CONNECTED && writeQueue.empty()) {
+            int len = sendsocket(descriptor, buffer, length, SEND_FLAGS);
+            if (len < 0) {
+                if (!is_would_block()) {
+                    auto error = handle_socket_error("Send failed");
+                    fail(error.what());
+                    throw error;
+                }
+                len = 0;
+            }
+            sent = len;
+            totalUpload += sent;
         }
-        totalUpload += len;
-        return len;
+        if (sent < length) {
+            // the rest is sent by I/O thread when socket becomes writable
+            sent += writeQueue.write(buffer + sent, length - sent);
+            updateInterest();
+        }
+        return sent;
     }
 
     int available() override {
         std::lock_guard lock(mutex);
-        return readBatch.size();
+        return readBuffer.size();
     }
 
     void close(bool discardAll=false) override {
-        {
-            std::lock_guard lock(mutex);
-            readBatch.clear();
+        std::lock_guard lock(mutex);
+        readBuffer.clear();
 
-            if (state != ConnectionState::CLOSED) {
+        if (state != ConnectionState::CLOSED) {
+            if (!discardAll && state == ConnectionState::CONNECTED) {
+                flush();
+            }
+            writeQueue.clear();
+            if (!released) {
                 shutdown(descriptor, SHUT_RDWR);
-                closesocket(descriptor);
             }
+            state = ConnectionState::CLOSED;
         }
-        if (thread) {
-            thread->join();
-            thread = nullptr;
-        }
+        release();
     }
 
     size_t pullUpload() override {
-        size_t size = totalUpload;
-        totalUpload = 0;
-        return size;
+        return totalUpload.exchange(0);
     }
 
     size_t pullDownload() override {
-        size_t size = totalDownload;
-        totalDownload = 0;
-        return size;
+        return totalDownload.exchange(0);
     }
 
     int getPort() const override {
@@ -267,6 +502,7 @@ public:
     }
 
     static std::shared_ptr<SocketTcpConnection> connect(
+        SocketReactor& reactor,
         const std::string& address,
         int port,
         runnable callback,
@@ -301,7 +537,9 @@ public:
             }
             throw std::runtime_error(errorMessage);
         }
-        auto socket = std::make_shared<SocketTcpConnection>(descriptor, std::move(serverAddress));
+        auto socket = std::make_shared<SocketTcpConnection>(
+            reactor, descriptor, std::move(serverAddress)
+        );
         socket->connect(std::move(callback), std::move(errorCallback));
         return socket;
     }
@@ -311,19 +549,33 @@ public:
     }
 };
 
-class SocketTcpServer : public TcpServer {
+class SocketTcpServer : public TcpServer,
+                        public SocketHandler,
+                        public std::enable_shared_from_this<SocketTcpServer> {
     u64id_t id;
     Network* network;
+    SocketReactor& reactor;
     SOCKET descriptor;
     std::vector<u64id_t> clients;
     std::mutex clientsMutex;
-    bool open = true;
-    std::unique_ptr<std::thread> thread = nullptr;
+    std::atomic<bool> open = true;
+    bool attached = false;
     int port;
     int maxConnected = -1;
+    ConnectCallback handler;
 public:
-    SocketTcpServer(u64id_t id, Network* network, SOCKET descriptor, int port)
-    : id(id), network(network), descriptor(descriptor), port(port) {}
+    SocketTcpServer(
+        u64id_t id,
+        Network* network,
+        SocketReactor& reactor,
+        SOCKET descriptor,
+        int port
+    )
+        : id(id),
+          network(network),
+          reactor(reactor),
+          descriptor(descriptor),
+          port(port) {}
 
     ~SocketTcpServer() {
         closeSocket();
@@ -334,6 +586,7 @@ public:
     }
 
     void update() override {
+        std::lock_guard lock(clientsMutex);
         std::vector<u64id_t> clients;
         for (u64id_t cid : this->clients) {
             if (auto client = network->getConnection(cid, true)) {
@@ -346,41 +599,62 @@ public:
     }
 
     void startListen(ConnectCallback handler) override {
-        thread = std::make_unique<std::thread>([this, handler]() {
-            while (open) {
-                logger.info() << "listening for connections";
-                if (listen(descriptor, 2) < 0) {
-                    close();
-                    break;
-                }
-                socklen_t addrlen = sizeof(sockaddr_in);
-                SOCKET clientDescriptor;
-                sockaddr_in address;
-                logger.info() << "accepting clients";
-                if ((clientDescriptor = accept(descriptor, (sockaddr*)&address, &addrlen)) == -1) {
-                    close();
-                    break;
-                }
-                if (maxConnected >= 0 && clients.size() >= maxConnected) {
-                    logger.info() << "refused connection attempt from " << to_string(address);
-                    closesocket(clientDescriptor);
-                    continue;
-                }
-                logger.info() << "client connected: " << to_string(address);
-                auto socket = std::make_shared<SocketTcpConnection>(
-                    clientDescriptor, address
-                );
-                socket->startClient();
-                u64id_t id = network->addConnection(socket);
-                {
-                    std::lock_guard lock(clientsMutex);
-                    clients.push_back(id);
+        this->handler = std::move(handler);
+        logger.info() << "listening for connections";
+        if (listen(descriptor, SOMAXCONN) < 0) {
+            auto error = handle_socket_error("listen failed");
+            close();
+            throw error;
+        }
+        set_nonblocking(descriptor);
+        attached = true;
+        reactor.add(descriptor, weak_from_this(), true, false);
+    }
+
+    void onReadable() override {
+        while (open) {
+            socklen_t addrlen = sizeof(sockaddr_in);
+            SOCKET clientDescriptor;
+            sockaddr_in address;
+            if ((clientDescriptor = accept(descriptor, (sockaddr*)&address, &addrlen)) == -1) {
+                if (!is_would_block()) {
+                    logger.error() << handle_socket_error("accept failed").what();
                 }
-                handler(this->id, id);
+                break;
+            }
+            size_t clientsCount;
+            {
+                std::lock_guard lock(clientsMutex);
+                clientsCount = clients.size();
+            }
+            if (maxConnected >= 0 && clientsCount >= maxConnected) {
+                logger.info() << "refused connection attempt from " << to_string(address);
+                closesocket(clientDescriptor);
+                continue;
+            }
+            logger.info() << "client connected: " << to_string(address);
+            try {
+                set_nonblocking(clientDescriptor);
+            } catch (const std::runtime_error& err) {
+                logger.error() << err.what();
+                closesocket(clientDescriptor);
+                continue;
+            }
+            auto socket = std::make_shared<SocketTcpConnection>(
+                reactor, clientDescriptor, address
+            );
+            u64id_t id = network->addConnection(socket);
+            {
+                std::lock_guard lock(clientsMutex);
+                clients.push_back(id);
             }
-        });
+            socket->startClient();
+            handler(this->id, id);
+        }
     }
-    
+
+    void onWritable() override {}
+
     void closeSocket() {
         if (!open) {
             return;
@@ -395,12 +669,16 @@ public:
                     client->close();
                 }
             }
+            clients.clear();
         }
-        clients.clear();
 
         shutdown(descriptor, 2);
-        closesocket(descriptor);
-        thread->join();
+        if (attached) {
+            attached = false;
+            reactor.remove(descriptor);
+        } else {
+            closesocket(descriptor);
+        }
     }
 
     void close() override {
@@ -416,7 +694,11 @@ public:
     }
 
     static std::shared_ptr<SocketTcpServer> openServer(
-        u64id_t id, Network* network, int port, ConnectCallback handler
+        u64id_t id,
+        Network* network,
+        SocketReactor& reactor,
+        int port,
+        ConnectCallback handler
     ) {
         SOCKET descriptor = socket(
             AF_INET, SOCK_STREAM, 0
@@ -445,8 +727,9 @@ public:
         }
         port = ntohs(address.sin_port);
         logger.info() << "opened server at port " << port;
-        auto server =
-            std::make_shared<SocketTcpServer>(id, network, descriptor, port);
+        auto server = std::make_shared<SocketTcpServer>(
+            id, network, reactor, descriptor, port
+        );
         server->startListen(std::move(handler));
         return server;
     }
@@ -472,21 +755,42 @@ static sockaddr_in resolve_address_dgram(const std::string& address, int port) {
     return serverAddr;
 }
 
-class SocketUdpConnection : public UdpConnection {
+class SocketUdpConnection : public UdpConnection,
+                            public SocketHandler,
+                            public std::enable_shared_from_this<SocketUdpConnection> {
     u64id_t id;
+    SocketReactor& reactor;
     SOCKET descriptor;
     sockaddr_in addr{};
-    bool open = true;
-    std::unique_ptr<std::thread> thread;
+    std::atomic<bool> open = true;
+    bool attached = false;
     ClientDatagramCallback callback;
+    util::Buffer<char> buffer;
+    std::mutex mutex;
 
-    size_t totalUpload = 0;
-    size_t totalDownload = 0;
-    ConnectionState state = ConnectionState::INITIAL;
+    std::atomic<size_t> totalUpload = 0;
+    std::atomic<size_t> totalDownload = 0;
+    std::atomic<ConnectionState> state = ConnectionState::INITIAL;
 
+    /// @brief Release the socket descriptor (mutex must be locked)
+    void release() {
+        if (attached) {
+            attached = false;
+            reactor.remove(descriptor);
+        } else {
+            closesocket(descriptor);
+        }
+        state = ConnectionState::CLOSED;
+    }
 public:
-    SocketUdpConnection(u64id_t id, SOCKET descriptor, sockaddr_in addr)
-        : id(id), descriptor(descriptor), addr(std::move(addr)) {}
+    SocketUdpConnection(
+        u64id_t id, SocketReactor& reactor, SOCKET descriptor, sockaddr_in addr
+    )
+        : id(id),
+          reactor(reactor),
+          descriptor(descriptor),
+          addr(std::move(addr)),
+          buffer(16'384) {}
 
     ~SocketUdpConnection() override {
         SocketUdpConnection::close();
@@ -494,6 +798,7 @@ public:
 
     static std::shared_ptr<SocketUdpConnection> connect(
         u64id_t id,
+        SocketReactor& reactor,
         const std::string& address,
         int port,
         ClientDatagramCallback handler,
@@ -512,7 +817,9 @@ public:
             throw err;
         }
 
-        auto socket = std::make_shared<SocketUdpConnection>(id, descriptor, serverAddr);
+        auto socket = std::make_shared<SocketUdpConnection>(
+            id, reactor, descriptor, serverAddr
+        );
         socket->connect(std::move(handler));
 
         callback();
@@ -521,35 +828,51 @@ public:
     }
 
     void connect(ClientDatagramCallback handler) override {
+        std::lock_guard lock(mutex);
         callback = std::move(handler);
+        set_nonblocking(descriptor);
         state = ConnectionState::CONNECTED;
+        attached = true;
+        reactor.add(descriptor, weak_from_this(), true, false);
+    }
 
-        thread = std::make_unique<std::thread>([this]() {
-            util::Buffer<char> buffer(16'384);
-            while (open) {
-                int size = recv(descriptor, buffer.data(), buffer.size(), 0);
-                if (size <= 0) {
-                    logger.error() << "udp connection " << id
-                                   << handle_socket_error(" recv error").what();
-                    if (!open) break;
-                    closesocket(descriptor);
-                    state = ConnectionState::CLOSED;
+    void onReadable() override {
+        for (int i = 0; i < UDP_MAX_DATAGRAMS_PER_EVENT && open; i++) {
+            int size = ::recv(descriptor, buffer.data(), buffer.size(), 0);
+            if (size < 0) {
+                if (is_would_block()) {
                     break;
                 }
-                totalDownload += size;
-                if (callback) {
-                    callback(id, buffer.data(), size);
+                logger.error() << "udp connection " << id
+                               << handle_socket_error(" recv error").what();
+                std::lock_guard lock(mutex);
+                if (state != ConnectionState::CLOSED) {
+                    release();
                 }
+                break;
             }
-        });
+            totalDownload += size;
+            if (callback) {
+                callback(id, buffer.data(), size);
+            }
+        }
     }
 
+    void onWritable() override {}
+
     int send(const char* buffer, size_t length) override {
-        int len = ::send(descriptor, buffer, length, 0);
+        std::lock_guard lock(mutex);
+        if (state == ConnectionState::CLOSED) {
+            return 0;
+        }
+        int len = ::send(descriptor, buffer, length, SEND_FLAGS);
         if (len < 0) {
+            if (is_would_block()) {
+                // datagram is dropped as with a full network queue
+                return 0;
+            }
             auto err = handle_socket_error(" send failed");
-            closesocket(descriptor);
-            state = ConnectionState::CLOSED;
+            release();
             logger.error() << "udp connection " << id << err.what();
         } else totalUpload += len;
 
@@ -561,28 +884,19 @@ public:
         open = false;
         logger.info() << "closing udp connection "<< id;
 
+        std::lock_guard lock(mutex);
         if (state != ConnectionState::CLOSED) {
             shutdown(descriptor, 2);
-            closesocket(descriptor);
-        }
-
-        if (thread) {
-            thread->join();
-            thread.reset();
+            release();
         }
-        state = ConnectionState::CLOSED;
     }
 
     size_t pullUpload() override {
-        size_t s = totalUpload;
-        totalUpload = 0;
-        return s;
+        return totalUpload.exchange(0);
     }
 
     size_t pullDownload() override {
-        size_t s = totalDownload;
-        totalDownload = 0;
-        return s;
+        return totalDownload.exchange(0);
     }
 
     [[nodiscard]] int getPort() const override {
@@ -598,17 +912,30 @@ public:
     }
 };
 
-class SocketUdpServer : public UdpServer {
+class SocketUdpServer : public UdpServer,
+                        public SocketHandler,
+                        public std::enable_shared_from_this<SocketUdpServer> {
     u64id_t id;
+    SocketReactor& reactor;
     SOCKET descriptor;
-    bool open = true;
-    std::unique_ptr<std::thread> thread = nullptr;
+    std::atomic<bool> open = true;
+    bool attached = false;
     int port;
     ServerDatagramCallback callback;
-
+    util::Buffer<char> buffer;
 public:
-    SocketUdpServer(u64id_t id, Network* network, SOCKET descriptor, int port)
-        : id(id), descriptor(descriptor), port(port) {}
+    SocketUdpServer(
+        u64id_t id,
+        Network* network,
+        SocketReactor& reactor,
+        SOCKET descriptor,
+        int port
+    )
+        : id(id),
+          reactor(reactor),
+          descriptor(descriptor),
+          port(port),
+          buffer(16'384) {}
 
     ~SocketUdpServer() override {
         SocketUdpServer::close();
@@ -618,33 +945,42 @@ public:
 
     void startListen(ServerDatagramCallback handler) override {
         callback = std::move(handler);
+        set_nonblocking(descriptor);
+        attached = true;
+        reactor.add(descriptor, weak_from_this(), true, false);
+    }
 
-        thread = std::make_unique<std::thread>([this]() {
-            util::Buffer<char> buffer(16384);
-            sockaddr_in clientAddr{};
+    void onReadable() override {
+        sockaddr_in clientAddr{};
+        for (int i = 0; i < UDP_MAX_DATAGRAMS_PER_EVENT && open; i++) {
             socklen_t addrlen = sizeof(clientAddr);
-
-            while (open) {
-                int size = recvfrom(descriptor, buffer.data(), buffer.size(), 0,
-                                    reinterpret_cast<sockaddr*>(&clientAddr), &addrlen);
-                if (size <= 0) {
-                    if (!open) break;
-                    continue;
+            int size = recvfrom(descriptor, buffer.data(), buffer.size(), 0,
+                                reinterpret_cast<sockaddr*>(&clientAddr), &addrlen);
+            if (size < 0) {
+                if (!is_would_block()) {
+                    logger.error() << handle_socket_error("recvfrom").what();
                 }
-
-                std::string addrStr = to_string(clientAddr, false);
-                int port = ntohs(clientAddr.sin_port);
-
-                callback(id, addrStr, port, buffer.data(), size);
+                break;
+            }
+            if (size == 0) {
+                continue;
             }
-        });
+            std::string addrStr = to_string(clientAddr, false);
+            int port = ntohs(clientAddr.sin_port);
+
+            callback(id, addrStr, port, buffer.data(), size);
+        }
     }
 
+    void onWritable() override {}
+
     void sendTo(const std::string& addr, int port, const char* buffer, size_t length) override {
         sockaddr_in client = resolve_address_dgram(addr, port);
-        if (sendto(descriptor, buffer, length, 0,
+        if (sendto(descriptor, buffer, length, SEND_FLAGS,
                reinterpret_cast<sockaddr*>(&client), sizeof(client)) < 0) {
-            logger.error() << handle_socket_error("sendto").what();
+            if (!is_would_block()) {
+                logger.error() << handle_socket_error("sendto").what();
+            }
         }
     }
 
@@ -652,10 +988,11 @@ public:
         if (!open) return;
         open = false;
         shutdown(descriptor, 2);
-        closesocket(descriptor);
-        if (thread) {
-            thread->join();
-            thread = nullptr;
+        if (attached) {
+            attached = false;
+            reactor.remove(descriptor);
+        } else {
+            closesocket(descriptor);
         }
     }
 
@@ -663,7 +1000,11 @@ public:
     int getPort() const override { return port; }
 
     static std::shared_ptr<SocketUdpServer> openServer(
-        u64id_t id, Network* network, int port, const ServerDatagramCallback& handler
+        u64id_t id,
+        Network* network,
+        SocketReactor& reactor,
+        int port,
+        const ServerDatagramCallback& handler
     ) {
         SOCKET descriptor = socket(AF_INET, SOCK_DGRAM, 0);
         if (descriptor == -1) throw std::runtime_error("could not create udp socket");
@@ -678,7 +1019,9 @@ public:
             throw std::runtime_error("could not bind udp port " + std::to_string(port));
         }
 
-        auto server = std::make_shared<SocketUdpServer>(id, network, descriptor, port);
+        auto server = std::make_shared<SocketUdpServer>(
+            id, network, reactor, descriptor, port
+        );
         server->startListen(std::move(handler));
         return server;
     }
@@ -686,41 +1029,50 @@ public:
 
 namespace network {
     std::shared_ptr<TcpConnection> connect_tcp(
+        SocketReactor& reactor,
         const std::string& address,
         int port,
         runnable callback,
         stringconsumer errorCallback
     ) {
         return SocketTcpConnection::connect(
-            address, port, std::move(callback), std::move(errorCallback)
+            reactor, address, port, std::move(callback), std::move(errorCallback)
         );
     }
 
     std::shared_ptr<TcpServer> open_tcp_server(
-        u64id_t id, Network* network, int port, ConnectCallback handler
+        u64id_t id,
+        Network* network,
+        SocketReactor& reactor,
+        int port,
+        ConnectCallback handler
     ) {
-        return SocketTcpServer::openServer(id, network, port, std::move(handler));
+        return SocketTcpServer::openServer(
+            id, network, reactor, port, std::move(handler)
+        );
     }
 
     std::shared_ptr<UdpConnection> connect_udp(
         u64id_t id,
+        SocketReactor& reactor,
         const std::string& address,
         int port,
         ClientDatagramCallback handler,
         runnable callback
     ) {
         return SocketUdpConnection::connect(
-            id, address, port, std::move(handler), std::move(callback)
+            id, reactor, address, port, std::move(handler), std::move(callback)
         );
     }
 
     std::shared_ptr<UdpServer> open_udp_server(
         u64id_t id,
         Network* network,
+        SocketReactor& reactor,
         int port,
         const ServerDatagramCallback& handler
     ) {
-        return SocketUdpServer::openServer(id, network, port, handler);
+        return SocketUdpServer::openServer(id, network, reactor, port, handler);
     }
 
     int find_free_port() {
@@ -5,6 +5,7 @@
 #include "content/Content.hpp"
 #include "data/dv_util.hpp"
 #include "debug/Logger.hpp"
+#include "debug/Profiler.hpp"
 #include "engine/Engine.hpp"
 #include "Entity.hpp"
 #include "EntityDef.hpp"
@@ -18,6 +19,7 @@
 #include "maths/util.hpp"
 #include "physics/PhysicsSolver.hpp"
 #include "rigging.hpp"
+#include "util/parallel.hpp"
 #include "world/Level.hpp"
 
 #include <entt/entity/registry.hpp>
@@ -156,6 +158,7 @@ void Entities::loadEntity(const dv::value& map, Entity entity) {
     map.at("skeleton-name").get(skeletonName);
     if (skeletonName != skeleton->config->getName()) {
         skeleton->config = assets->getShared<rigging::SkeletonConfig>(skeletonName);
+        skeleton->dirty = true;
     }
     if (auto foundSkeleton = map.at(COMP_SKELETON)) {
         skeleton->deserialize(*foundSkeleton);
@@ -331,6 +334,7 @@ void Entities::preparePhysics(float delta) {
 }
 
 void Entities::updatePhysics(float delta) {
+    VC_PROFILE_SCOPE("Entities::updatePhysics");
     preparePhysics(delta);
 
     auto view = registry->view<EntityId, Transform, Rigidbody>();
@@ -366,6 +370,7 @@ void Entities::updatePhysics(float delta) {
 }
 
 void Entities::update(float delta) {
+    VC_PROFILE_SCOPE("Entities::update");
     if (int parts = updateTickClock.update(delta)) {
         for (int i = 0; i < parts; i++) {
             scripting::on_entities_update(
@@ -463,9 +468,11 @@ void Entities::render(
     const Frustum* frustum,
     entityid_t fpsEntity
 ) {
+    auto& visible = visibleSkeletons;
+    visible.clear();
     auto view = registry->view<EntityId, Transform, rigging::Skeleton>();
     for (auto [entity, eid, transform, skeleton] : view.each()) {
-        if (eid.uid == fpsEntity) {
+        if (eid.uid == fpsEntity || skeleton.config == nullptr) {
             continue;
         }
         const auto& pos = transform.pos;
@@ -473,13 +480,29 @@ void Entities::render(
         if (frustum && !frustum->isBoxVisible(pos - size, pos + size)) {
             continue;
         }
-
-        const auto& rigConfig = skeleton.config;
-        if (rigConfig) {
-            rigConfig->render(
-                assets, batch, skeleton, transform.rot, pos, size
-            );
+        visible.emplace_back(&transform, &skeleton);
+    }
+    // poses are evaluated first as drawing is not thread-safe
+    auto updateSkeleton = [&visible](size_t index) {
+        auto [transform, skeleton] = visible[index];
+        skeleton->config->update(
+            *skeleton, transform->rot, transform->pos, transform->size
+        );
+    };
+    if (visible.size() >= PARALLEL_MIN_SKELETONS) {
+        if (skeletonsPool == nullptr) {
+            skeletonsPool = std::make_unique<util::ParallelPool>();
         }
+        skeletonsPool->run(visible.size(), updateSkeleton);
+    } else {
+        for (size_t i = 0; i < visible.size(); i++) {
+            updateSkeleton(i);
+        }
+    }
+    for (auto [transform, skeleton] : visible) {
+        skeleton->config->render(
+            assets, batch, *skeleton, transform->rot, transform->pos, transform->size
+        );
     }
 }
 
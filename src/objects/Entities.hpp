@@ -31,6 +31,10 @@ namespace rigging {
     class SkeletonConfig;
 }
 
+namespace util {
+    class ParallelPool;
+}
+
 class Entities final {
     std::unique_ptr<entt::registry> registry;
     Level& level;
@@ -40,6 +44,13 @@ class Entities final {
     util::Clock sensorsTickClock;
     util::Clock updateTickClock;
     Assets* assets = nullptr;
+    /// @brief Skeletons passed culling in the last render call (reused)
+    std::vector<std::pair<Transform*, rigging::Skeleton*>> visibleSkeletons;
+    /// @brief Skeletons evaluation workers (created on first use)
+    std::unique_ptr<util::ParallelPool> skeletonsPool;
+
+    /// @brief Min visible skeletons count to evaluate poses in parallel
+    static constexpr size_t PARALLEL_MIN_SKELETONS = 64;
 
     void updateSensors(
         Rigidbody& body, const Transform& tsf, std::vector<Sensor*>& sensors
@@ -83,11 +83,13 @@ void Skeleton::deserialize(const dv::value& root) {
         for (size_t i = 0; i < std::min(matrices.size(), posearr.size()); i++) {
             dv::get_mat(posearr[i], pose.matrices[i]);
         }
+        dirty = true;
     }
 }
 
 void Skeleton::setConfig(std::shared_ptr<const SkeletonConfig> rigConfig) {
     config = std::move(rigConfig);
+    dirty = true;
     pose.matrices.resize(
         config->getBones().size(), glm::mat4(1.0f)
     );
@@ -103,34 +105,61 @@ static void get_all_nodes(std::vector<Bone*>& nodes, Bone* node) {
     }
 }
 
+/// @brief Flatten hierarchy in depth-first order (order of the calculation)
+static void flatten(
+    std::vector<std::pair<int, const Bone*>>& order,
+    const Bone* node,
+    int parent
+) {
+    int index = order.size();
+    order.emplace_back(parent, node);
+    for (auto& subnode : node->getBones()) {
+        flatten(order, subnode.get(), index);
+    }
+}
+
 SkeletonConfig::SkeletonConfig(
     const std::string& name, std::unique_ptr<Bone> root, size_t nodesCount
 )
     : name(name), root(std::move(root)), nodes(nodesCount) {
     assert(this->root.get() != nullptr);
     get_all_nodes(nodes, this->root.get());
+
+    std::vector<std::pair<int, const Bone*>> order;
+    order.reserve(nodesCount);
+    flatten(order, this->root.get(), -1);
+    parents.resize(order.size());
+    offsets.resize(order.size(), glm::mat4(1.0f));
+    hasOffset.resize(order.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        const auto& [parent, node] = order[i];
+        parents[i] = parent;
+        auto offset = node->getOffset();
+        if (glm::length2(offset) > 0.0f) {
+            offsets[i] = glm::translate(glm::mat4(1.0f), offset);
+            hasOffset[i] = true;
+        }
+    }
 }
 
-size_t SkeletonConfig::update(
-    size_t index, Skeleton& skeleton, Bone* node, const glm::mat4& matrix
-) const {
-    auto boneMatrix = skeleton.pose.matrices[index];
-    auto boneOffset = node->getOffset();
-    glm::mat4 baseMatrix(1.0f);
-    if (glm::length2(boneOffset) > 0.0f) {
-        baseMatrix = glm::translate(glm::mat4(1.0f), boneOffset);
+void SkeletonConfig::update(Skeleton& skeleton, const glm::mat4& matrix) const {
+    if (!skeleton.dirty && skeleton.calculatedRoot == matrix) {
+        return;
     }
-    skeleton.calculated.matrices[index] = matrix * baseMatrix * boneMatrix;
-    size_t count = 1;
-    for (auto& subnode : node->getBones()) {
-        count += update(
-            index + count,
-            skeleton,
-            subnode.get(),
-            skeleton.calculated.matrices[index]
-        );
+    const auto& pose = skeleton.pose.matrices;
+    auto& calculated = skeleton.calculated.matrices;
+    size_t count = std::min({parents.size(), pose.size(), calculated.size()});
+    for (size_t i = 0; i < count; i++) {
+        int parent = parents[i];
+        const auto& parentMatrix = parent == -1 ? matrix : calculated[parent];
+        if (hasOffset[i]) {
+            calculated[i] = parentMatrix * offsets[i] * pose[i];
+        } else {
+            calculated[i] = parentMatrix * pose[i];
+        }
     }
-    return count;
+    skeleton.calculatedRoot = matrix;
+    skeleton.dirty = false;
 }
 
 static glm::mat4 build_matrix(
@@ -152,13 +181,10 @@ void SkeletonConfig::update(
     if (skeleton.interpolation.isEnabled()) {
         const auto& interpolation = skeleton.interpolation;
         update(
-            0,
-            skeleton,
-            root.get(),
-            build_matrix(rotation, interpolation.getCurrent(), scale)
+            skeleton, build_matrix(rotation, interpolation.getCurrent(), scale)
         );
     } else {
-        update(0, skeleton, root.get(), build_matrix(rotation, position, scale));
+        update(skeleton, build_matrix(rotation, position, scale));
     }
 }
 
@@ -89,6 +89,12 @@ namespace rigging {
 
         util::VecInterpolation<3, float> interpolation {false};
 
+        /// @brief Calculated matrices are outdated regardless of the
+        /// skeleton transform (set it on pose or config change)
+        bool dirty = true;
+        /// @brief Root matrix used for the last calculation
+        glm::mat4 calculatedRoot {1.0f};
+
         Skeleton(std::shared_ptr<const SkeletonConfig> config);
 
         dv::value serialize(bool saveTextures, bool savePose) const;
@@ -110,9 +116,14 @@ namespace rigging {
         /// 3 --- sub2
         std::vector<Bone*> nodes;
 
-        size_t update(
-            size_t index, Skeleton& skeleton, Bone* node, const glm::mat4& matrix
-        ) const;
+        /// @brief Parent index of each node (-1 for the root).
+        /// Parents always precede their children
+        std::vector<int> parents;
+        /// @brief Bone offset translation matrices
+        std::vector<glm::mat4> offsets;
+        std::vector<bool> hasOffset;
+
+        void update(Skeleton& skeleton, const glm::mat4& matrix) const;
     public:
         SkeletonConfig(
             const std::string& name,
@@ -120,6 +131,9 @@ namespace rigging {
             size_t nodesCount
         );
 
+        /// @brief Calculate bone matrices. Skipped if the skeleton is not
+        /// dirty and transform is not changed since the last calculation.
+        /// Skeletons may be updated concurrently
         void update(
             Skeleton& skeleton,
             const glm::mat3& rotation,
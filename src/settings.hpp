@@ -119,6 +119,8 @@ struct UiSettings {
 };
 
 struct NetworkSettings {
+    /// @brief Number of sockets I/O threads
+    IntegerSetting ioThreads {2, 1, 16};
 };
 
 struct SystemSettings {
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include <stdexcept>
+
+namespace util {
+    /// @brief Bounded lock-free multi-producer single-consumer queue
+    /// (array of cells with sequence numbers).
+    /// Cells are reused, so element capacity (e.g. of strings) is retained
+    /// between pushes.
+    /// @tparam T element type (default-constructible)
+    template <typename T>
+    class MpscQueue {
+        struct Cell {
+            std::atomic<size_t> sequence;
+            T data;
+        };
+        std::unique_ptr<Cell[]> cells;
+        size_t mask;
+        alignas(64) std::atomic<size_t> enqueuePos {0};
+        alignas(64) size_t dequeuePos = 0;
+    public:
+        /// @param capacity max number of elements (power of 2)
+        MpscQueue(size_t capacity)
+            : cells(std::make_unique<Cell[]>(capacity)), mask(capacity - 1) {
+            if (capacity < 2 || (capacity & (capacity - 1)) != 0) {
+                throw std::invalid_argument(
+                    "capacity must be power of 2 greater than 1"
+                );
+            }
+            for (size_t i = 0; i < capacity; i++) {
+                cells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        /// @brief Reserve a cell and fill it. Thread-safe
+        /// @param fill function called with the cell element reference
+        /// @return false if the queue is full
+        template <typename Func>
+        bool push(const Func& fill) {
+            size_t pos = enqueuePos.load(std::memory_order_relaxed);
+            Cell* cell;
+            while (true) {
+                cell = &cells[pos & mask];
+                size_t sequence = cell->sequence.load(std::memory_order_acquire);
+                auto diff = static_cast<intptr_t>(sequence) -
+                            static_cast<intptr_t>(pos);
+                if (diff == 0) {
+                    if (enqueuePos.compare_exchange_weak(
+                            pos, pos + 1, std::memory_order_relaxed
+                        )) {
+                        break;
+                    }
+                } else if (diff < 0) {
+                    return false;
+                } else {
+                    pos = enqueuePos.load(std::memory_order_relaxed);
+                }
+            }
+            fill(cell->data);
+            cell->sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        /// @brief Consume the first element. Must be called by one thread
+        /// at a time
+        /// @param consume function called with the cell element reference
+        /// @return false if the queue is empty (or the first element is
+        /// not filled yet)
+        template <typename Func>
+        bool pop(const Func& consume) {
+            Cell* cell = &cells[dequeuePos & mask];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            if (sequence != dequeuePos + 1) {
+                return false;
+            }
+            consume(cell->data);
+            cell->sequence.store(
+                dequeuePos + mask + 1, std::memory_order_release
+            );
+            dequeuePos++;
+            return true;
+        }
+
+        /// @brief Check if there is no element ready to be consumed.
+        /// Must be called by the consumer
+        bool empty() const {
+            const Cell* cell = &cells[dequeuePos & mask];
+            return cell->sequence.load(std::memory_order_acquire) !=
+                   dequeuePos + 1;
+        }
+
+        size_t capacity() const {
+            return mask + 1;
+        }
+    };
+}
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <memory>
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+
+namespace util {
+    /// @brief Growable FIFO ring buffer of trivially copyable elements.
+    /// Stored data and free space are exposed as up to two contiguous spans
+    /// to be used with scatter/gather I/O (readv/writev).
+    /// Not thread-safe.
+    /// @tparam T elements type
+    template <typename T>
+    class RingBuffer {
+    public:
+        struct Span {
+            T* data;
+            size_t size;
+        };
+
+        /// @param initCapacity initial capacity (power of 2)
+        /// @param maxCapacity capacity growth limit (power of 2)
+        RingBuffer(size_t initCapacity, size_t maxCapacity)
+            : buffer(std::make_unique<T[]>(initCapacity)),
+              capacity(initCapacity),
+              maxCapacity(maxCapacity) {
+            if (initCapacity == 0 || (initCapacity & (initCapacity - 1)) != 0) {
+                throw std::invalid_argument(
+                    "initCapacity must be positive power of 2"
+                );
+            }
+            if (maxCapacity < initCapacity ||
+                (maxCapacity & (maxCapacity - 1)) != 0) {
+                throw std::invalid_argument(
+                    "maxCapacity must be power of 2 not less than initCapacity"
+                );
+            }
+        }
+
+        size_t size() const {
+            return length;
+        }
+
+        bool empty() const {
+            return length == 0;
+        }
+
+        size_t getCapacity() const {
+            return capacity;
+        }
+
+        size_t getMaxCapacity() const {
+            return maxCapacity;
+        }
+
+        size_t freeSpace() const {
+            return capacity - length;
+        }
+
+        /// @brief Double capacity if limit is not reached
+        /// @return true if buffer has grown
+        bool grow() {
+            if (capacity >= maxCapacity) {
+                return false;
+            }
+            size_t newCapacity = capacity * 2;
+            auto newBuffer = std::make_unique<T[]>(newCapacity);
+            peek(newBuffer.get(), length);
+            buffer = std::move(newBuffer);
+            capacity = newCapacity;
+            head = 0;
+            return true;
+        }
+
+        /// @brief Get spans of stored data in reading order
+        /// @return number of non-empty spans (0-2)
+        int readable(Span spans[2]) const {
+            if (length == 0) {
+                return 0;
+            }
+            size_t first = std::min(length, capacity - head);
+            spans[0] = {buffer.get() + head, first};
+            if (first == length) {
+                return 1;
+            }
+            spans[1] = {buffer.get(), length - first};
+            return 2;
+        }
+
+        /// @brief Get spans of free space in writing order.
+        /// Use commit(n) after writing
+        /// @return number of non-empty spans (0-2)
+        int writable(Span spans[2]) {
+            size_t free = freeSpace();
+            if (free == 0) {
+                return 0;
+            }
+            size_t tail = (head + length) & (capacity - 1);
+            size_t first = std::min(free, capacity - tail);
+            spans[0] = {buffer.get() + tail, first};
+            if (first == free) {
+                return 1;
+            }
+            spans[1] = {buffer.get(), free - first};
+            return 2;
+        }
+
+        /// @brief Mark n elements written to writable spans as stored
+        void commit(size_t n) {
+            length += n;
+        }
+
+        /// @brief Discard n first stored elements
+        void consume(size_t n) {
+            n = std::min(n, length);
+            head = (head + n) & (capacity - 1);
+            length -= n;
+            if (length == 0) {
+                head = 0;
+            }
+        }
+
+        /// @brief Append elements, growing buffer if needed
+        /// @return number of elements written (less than n if the capacity
+        /// limit is reached)
+        size_t write(const T* src, size_t n) {
+            while (freeSpace() < n && grow());
+            Span spans[2];
+            int count = writable(spans);
+            size_t written = 0;
+            for (int i = 0; i < count && written < n; i++) {
+                size_t part = std::min(spans[i].size, n - written);
+                std::memcpy(spans[i].data, src + written, part * sizeof(T));
+                written += part;
+            }
+            commit(written);
+            return written;
+        }
+
+        /// @brief Copy up to n first elements without consuming them
+        /// @return number of elements copied
+        size_t peek(T* dst, size_t n) const {
+            Span spans[2];
+            int count = readable(spans);
+            size_t copied = 0;
+            for (int i = 0; i < count && copied < n; i++) {
+                size_t part = std::min(spans[i].size, n - copied);
+                std::memcpy(dst + copied, spans[i].data, part * sizeof(T));
+                copied += part;
+            }
+            return copied;
+        }
+
+        /// @brief Copy and consume up to n first elements
+        /// @return number of elements read
+        size_t read(T* dst, size_t n) {
+            size_t copied = peek(dst, n);
+            consume(copied);
+            return copied;
+        }
+
+        void clear() {
+            head = 0;
+            length = 0;
+        }
+    private:
+        std::unique_ptr<T[]> buffer;
+        size_t capacity;
+        size_t maxCapacity;
+        size_t head = 0;
+        size_t length = 0;
+    };
+}
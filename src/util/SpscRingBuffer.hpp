@@ -0,0 +1,110 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+
+namespace util {
+    /// @brief Bounded lock-free single-producer single-consumer ring buffer
+    /// of trivially copyable elements.
+    /// Producer thread uses writable/commit/write, consumer thread uses
+    /// read/discard. size() and freeSpace() may be called from any thread
+    /// (the value may be outdated immediately).
+    /// @tparam T elements type
+    template <typename T>
+    class SpscRingBuffer {
+    public:
+        struct Span {
+            T* data;
+            size_t size;
+        };
+
+        /// @param capacity max number of elements (power of 2)
+        SpscRingBuffer(size_t capacity)
+            : buffer(std::make_unique<T[]>(capacity)), mask(capacity - 1) {
+            if (capacity == 0 || (capacity & (capacity - 1)) != 0) {
+                throw std::invalid_argument(
+                    "capacity must be positive power of 2"
+                );
+            }
+        }
+
+        size_t capacity() const {
+            return mask + 1;
+        }
+
+        size_t size() const {
+            return writePos.load(std::memory_order_acquire) -
+                   readPos.load(std::memory_order_acquire);
+        }
+
+        bool empty() const {
+            return size() == 0;
+        }
+
+        size_t freeSpace() const {
+            return capacity() - size();
+        }
+
+        /// @brief Get the first contiguous part of free space.
+        /// Use commit(n) after writing. Producer only
+        Span writable() {
+            size_t write = writePos.load(std::memory_order_relaxed);
+            size_t free =
+                capacity() - (write - readPos.load(std::memory_order_acquire));
+            size_t offset = write & mask;
+            return {buffer.get() + offset, std::min(free, capacity() - offset)};
+        }
+
+        /// @brief Publish n elements written to writable span. Producer only
+        void commit(size_t n) {
+            writePos.fetch_add(n, std::memory_order_release);
+        }
+
+        /// @brief Append up to n elements. Producer only
+        /// @return number of elements written
+        size_t write(const T* src, size_t n) {
+            size_t written = 0;
+            while (written < n) {
+                auto span = writable();
+                size_t part = std::min(span.size, n - written);
+                if (part == 0) {
+                    break;
+                }
+                std::memcpy(span.data, src + written, part * sizeof(T));
+                commit(part);
+                written += part;
+            }
+            return written;
+        }
+
+        /// @brief Copy and consume up to n first elements. Consumer only
+        /// @return number of elements read
+        size_t read(T* dst, size_t n) {
+            size_t read = readPos.load(std::memory_order_relaxed);
+            size_t available = writePos.load(std::memory_order_acquire) - read;
+            n = std::min(n, available);
+            size_t offset = read & mask;
+            size_t first = std::min(n, capacity() - offset);
+            std::memcpy(dst, buffer.get() + offset, first * sizeof(T));
+            std::memcpy(dst + first, buffer.get(), (n - first) * sizeof(T));
+            readPos.store(read + n, std::memory_order_release);
+            return n;
+        }
+
+        /// @brief Consume all stored elements. Consumer only
+        void discard() {
+            readPos.store(
+                writePos.load(std::memory_order_acquire),
+                std::memory_order_release
+            );
+        }
+    private:
+        std::unique_ptr<T[]> buffer;
+        size_t mask;
+        alignas(64) std::atomic<size_t> writePos {0};
+        alignas(64) std::atomic<size_t> readPos {0};
+    };
+}
@@ -11,8 +11,10 @@
 #include <utility>
 
 #include "debug/Logger.hpp"
+#include "debug/Profiler.hpp"
 #include "delegates.hpp"
 #include "interfaces/Task.hpp"
+#include "parallel.hpp"
 
 namespace util {
 
@@ -58,6 +60,10 @@ namespace util {
             std::condition_variable variable;
             std::mutex mutex;
             bool locked = false;
+            set_worker_thread(true);
+            debug::Profiler::setThreadName(
+                logger.getName() + " #" + std::to_string(index)
+            );
             while (working) {
                 T job;
                 {
@@ -74,7 +80,10 @@ namespace util {
                     busyWorkers++;
                 }
                 try {
-                    R result = (*worker)(job);
+                    R result = [&]() {
+                        VC_PROFILE_SCOPE("ThreadPool::job");
+                        return (*worker)(job);
+                    }();
                     {
                         std::lock_guard<std::mutex> lock(resultsMutex);
                         results.push(ThreadPoolResult<T, R> {
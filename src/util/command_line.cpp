@@ -9,6 +9,7 @@
 #include "engine/EnginePaths.hpp"
 #include "util/ArgsReader.hpp"
 #include "engine/Engine.hpp"
+#include "debug/Logger.hpp"
 
 namespace fs = std::filesystem;
 
@@ -78,6 +79,22 @@ static bool perform_keyword(
             params.debugServerString = reader.next();
             return true;
         }, "<serv>", "open debugging server where <serv> is {transport}:{port}"),
+        ArgC("--log-level", [&reader]() -> bool {
+            static const std::pair<const char*, debug::LogLevel> levels[] {
+                {"debug", debug::LogLevel::debug},
+                {"info", debug::LogLevel::info},
+                {"warning", debug::LogLevel::warning},
+                {"error", debug::LogLevel::error},
+            };
+            std::string name = reader.next();
+            for (const auto& [levelName, level] : levels) {
+                if (name == levelName) {
+                    debug::Logger::setLevel(level);
+                    return true;
+                }
+            }
+            throw std::runtime_error("unknown log level " + name);
+        }, "<level>", "minimal log level: debug, info, warning or error."),
         ArgC("--help", []() -> bool {
             std::cout << "VoxelCore v" << ENGINE_VERSION_STRING << "\n\n";
             std::cout << "Command-line arguments:\n";
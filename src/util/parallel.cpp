@@ -0,0 +1,99 @@
+#include "parallel.hpp"
+
+using namespace util;
+
+static thread_local bool worker_thread = false;
+
+void util::set_worker_thread(bool flag) {
+    worker_thread = flag;
+}
+
+bool util::is_worker_thread() {
+    return worker_thread;
+}
+
+ParallelPool::ParallelPool(uint threads) {
+    if (threads == 0) {
+        threads = get_hardware_threads();
+    }
+    workers.reserve(threads - 1);
+    for (uint i = 1; i < threads; i++) {
+        workers.emplace_back(&ParallelPool::threadLoop, this);
+    }
+}
+
+ParallelPool::~ParallelPool() {
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    startCondition.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void ParallelPool::work() {
+    try {
+        size_t index;
+        while ((index = nextIndex++) < count) {
+            (*func)(index);
+        }
+    } catch (...) {
+        std::lock_guard lock(mutex);
+        if (error == nullptr) {
+            error = std::current_exception();
+        }
+        nextIndex = count;
+    }
+}
+
+void ParallelPool::threadLoop() {
+    set_worker_thread(true);
+    uint64_t done = 0;
+    std::unique_lock lock(mutex);
+    while (true) {
+        startCondition.wait(lock, [this, done]() {
+            return stopping || generation != done;
+        });
+        if (stopping) {
+            return;
+        }
+        done = generation;
+        lock.unlock();
+        work();
+        lock.lock();
+        if (--active == 0) {
+            doneCondition.notify_one();
+        }
+    }
+}
+
+void ParallelPool::run(
+    size_t count, const std::function<void(size_t)>& func
+) {
+    if (workers.empty() || count <= 1) {
+        for (size_t i = 0; i < count; i++) {
+            func(i);
+        }
+        return;
+    }
+    {
+        std::lock_guard lock(mutex);
+        this->func = &func;
+        this->count = count;
+        nextIndex = 0;
+        error = nullptr;
+        active = workers.size();
+        generation++;
+    }
+    startCondition.notify_all();
+    work();
+
+    std::unique_lock lock(mutex);
+    doneCondition.wait(lock, [this]() { return active == 0; });
+    this->func = nullptr;
+    if (error) {
+        std::rethrow_exception(std::move(error));
+    }
+}
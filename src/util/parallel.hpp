@@ -0,0 +1,126 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "typedefs.hpp"
+
+namespace util {
+    /// @return number of hardware threads (at least 1)
+    inline uint get_hardware_threads() {
+        return std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    /// @brief Mark the calling thread as a worker of a thread pool
+    void set_worker_thread(bool flag);
+
+    /// @return true if the calling thread is a worker of a thread pool
+    /// or a parallel loop
+    bool is_worker_thread();
+
+    /// @brief Call func(index) for each index in [0, count) using up to
+    /// `threads` workers including the calling thread. Indices are taken
+    /// in ascending order, so results stored by index keep their order.
+    /// The first exception thrown by func is rethrown in the calling thread
+    /// after all workers are finished; remaining indices are skipped.
+    /// Loops started in worker threads run on the calling thread only,
+    /// as the hardware threads are already busy with other workers.
+    /// @param threads max workers count (0 - hardware threads)
+    template <typename Func>
+    void parallel_for(size_t count, uint threads, const Func& func) {
+        if (is_worker_thread()) {
+            threads = 1;
+        } else if (threads == 0) {
+            threads = get_hardware_threads();
+        }
+        threads = std::min<size_t>(threads, count);
+        if (threads <= 1) {
+            for (size_t i = 0; i < count; i++) {
+                func(i);
+            }
+            return;
+        }
+        std::atomic<size_t> nextIndex = 0;
+        std::mutex errorMutex;
+        std::exception_ptr error;
+
+        auto work = [&]() {
+            try {
+                size_t index;
+                while ((index = nextIndex++) < count) {
+                    func(index);
+                }
+            } catch (...) {
+                std::lock_guard lock(errorMutex);
+                if (error == nullptr) {
+                    error = std::current_exception();
+                }
+                nextIndex = count;
+            }
+        };
+        std::vector<std::thread> workers;
+        workers.reserve(threads - 1);
+        for (uint i = 1; i < threads; i++) {
+            workers.emplace_back([&work]() {
+                set_worker_thread(true);
+                work();
+            });
+        }
+        // the calling thread is not a worker here, or the loop would be serial
+        set_worker_thread(true);
+        work();
+        set_worker_thread(false);
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    /// @brief Persistent workers for parallel_for-like loops executed
+    /// often (e.g. every frame). Threads are created once and wait for the
+    /// next loop instead of being created and joined on every call.
+    /// Loops must not be run concurrently by multiple threads
+    class ParallelPool {
+    public:
+        /// @param threads max workers count including the calling thread
+        /// (0 - hardware threads)
+        explicit ParallelPool(uint threads = 0);
+        ~ParallelPool();
+
+        ParallelPool(const ParallelPool&) = delete;
+        ParallelPool& operator=(const ParallelPool&) = delete;
+
+        /// @brief Same as parallel_for, using the pool workers
+        void run(size_t count, const std::function<void(size_t)>& func);
+
+        /// @return workers count including the calling thread
+        uint getThreads() const {
+            return workers.size() + 1;
+        }
+    private:
+        std::vector<std::thread> workers;
+        std::mutex mutex;
+        std::condition_variable startCondition;
+        std::condition_variable doneCondition;
+        const std::function<void(size_t)>* func = nullptr;
+        size_t count = 0;
+        std::atomic<size_t> nextIndex = 0;
+        std::exception_ptr error;
+        /// @brief Loop number used to wake up workers
+        uint64_t generation = 0;
+        /// @brief Workers not finished the current loop yet
+        uint active = 0;
+        bool stopping = false;
+
+        void threadLoop();
+        void work();
+    };
+}
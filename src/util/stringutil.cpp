@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdio>
 #include <iomanip>
 #include <locale>
 #include <sstream>
@@ -28,56 +29,65 @@ static std::locale get_utf8_locale() {
 static std::locale locale = get_utf8_locale();
 
 std::string util::escape(std::string_view s, bool escapeUnicode) {
-    std::stringstream ss;
-    ss << '"';
+    std::string out;
+    out.reserve(s.length() + 2);
+    out += '"';
     size_t pos = 0;
     while (pos < s.length()) {
         char c = s[pos];
         switch (c) {
             case '\n':
-                ss << "\\n";
+                out += "\\n";
                 break;
             case '\r':
-                ss << "\\r";
+                out += "\\r";
                 break;
             case '\t':
-                ss << "\\t";
+                out += "\\t";
                 break;
             case '\f':
-                ss << "\\f";
+                out += "\\f";
                 break;
             case '\b':
-                ss << "\\b";
+                out += "\\b";
                 break;
             case '"':
-                ss << "\\\"";
+                out += "\\\"";
                 break;
             case '\\':
-                ss << "\\\\";
+                out += "\\\\";
                 break;
             default:
                 if (c & 0x80) {
                     uint cpsize;
                     int codepoint = decode_utf8(cpsize, s.data() + pos);
                     if (escapeUnicode) {
-                        ss << "\\u" << std::setw(4) << std::setfill('0') << std::hex << codepoint;
+                        char buffer[16];
+                        int length = std::snprintf(
+                            buffer, sizeof(buffer), "\\u%04x", codepoint
+                        );
+                        out.append(buffer, length);
                     } else {
-                        ss << std::string(s.data() + pos, cpsize);
+                        out.append(s.data() + pos, cpsize);
                     }
                     pos += cpsize-1;
                     break;
                 }
                 if (c < ' ') {
-                    ss << "\\" << std::oct << uint(ubyte(c));
+                    char buffer[8];
+                    int length = std::snprintf(
+                        buffer, sizeof(buffer), "\\%o", uint(ubyte(c))
+                    );
+                    out.append(buffer, length);
                     break;
                 }
-                ss << c;
+                out += c;
                 break;
         }
         pos++;
     }
-    ss << '"';
-    return ss.str();
+    out += '"';
+    return out;
 }
 
 std::wstring util::escape_xml(std::wstring_view s) {
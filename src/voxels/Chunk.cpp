@@ -1,13 +1,42 @@
 #include "Chunk.hpp"
 
+#include "coders/rle.hpp"
 #include "content/ContentReport.hpp"
 #include "items/Inventory.hpp"
 #include "lighting/Lightmap.hpp"
 #include "util/data_io.hpp"
 #include "voxel.hpp"
 
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
 #include <utility>
 
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define VC_CHUNK_SSE2
+#endif
+
+static_assert(sizeof(voxel) == 4);
+static_assert(CHUNK_VOL % 8 == 0);
+
+/// @return true if voxel memory is (id, state) pair of little-endian
+/// uint16 as in encoded data
+static bool is_native_layout() {
+    static const bool native = []() {
+        if (dataio::is_big_endian()) {
+            return false;
+        }
+        voxel vox {0x1234, int2blockstate(0xA5C3)};
+        uint32_t word;
+        std::memcpy(&word, &vox, sizeof(word));
+        return word == 0xA5C31234U;
+    }();
+    return native;
+}
+
 Chunk::Chunk(int xpos, int zpos, std::shared_ptr<Lightmap> lightmap)
     : x(xpos), z(zpos), lightmap(std::move(lightmap)) {
     bottom = 0;
@@ -72,7 +101,36 @@ std::shared_ptr<Inventory> Chunk::getBlockInventory(uint x, uint y, uint z)
 std::unique_ptr<ubyte[]> Chunk::encode() const {
     auto buffer = std::make_unique<ubyte[]>(CHUNK_DATA_LEN);
     auto dst = reinterpret_cast<uint16_t*>(buffer.get());
-    for (uint i = 0; i < CHUNK_VOL; i++) {
+    uint i = 0;
+    if (is_native_layout()) {
+#ifdef VC_CHUNK_SSE2
+        // deinterleave 8 voxels into 8 ids and 8 states
+        auto src = reinterpret_cast<const __m128i*>(voxels);
+        for (; i < CHUNK_VOL; i += 8, src += 2) {
+            __m128i a = _mm_loadu_si128(src);
+            __m128i b = _mm_loadu_si128(src + 1);
+            __m128i ids = _mm_packs_epi32(
+                _mm_srai_epi32(_mm_slli_epi32(a, 16), 16),
+                _mm_srai_epi32(_mm_slli_epi32(b, 16), 16)
+            );
+            __m128i states = _mm_packs_epi32(
+                _mm_srai_epi32(a, 16), _mm_srai_epi32(b, 16)
+            );
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), ids);
+            _mm_storeu_si128(
+                reinterpret_cast<__m128i*>(dst + CHUNK_VOL + i), states
+            );
+        }
+#endif
+        for (; i < CHUNK_VOL; i++) {
+            uint32_t word;
+            std::memcpy(&word, &voxels[i], sizeof(word));
+            dst[i] = static_cast<uint16_t>(word);
+            dst[CHUNK_VOL + i] = static_cast<uint16_t>(word >> 16);
+        }
+        return buffer;
+    }
+    for (; i < CHUNK_VOL; i++) {
         dst[i] = dataio::h2le(voxels[i].id);
         dst[CHUNK_VOL + i] = dataio::h2le(blockstate2int(voxels[i].state));
     }
@@ -81,15 +139,126 @@ std::unique_ptr<ubyte[]> Chunk::encode() const {
 
 bool Chunk::decode(const ubyte* data) {
     auto src = reinterpret_cast<const uint16_t*>(data);
-    for (uint i = 0; i < CHUNK_VOL; i++) {
-        voxel& vox = voxels[i];
+    uint i = 0;
+    if (is_native_layout()) {
+#ifdef VC_CHUNK_SSE2
+        // interleave 8 ids and 8 states into 8 voxels
+        auto dst = reinterpret_cast<__m128i*>(voxels);
+        for (; i < CHUNK_VOL; i += 8, dst += 2) {
+            __m128i ids = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(src + i)
+            );
+            __m128i states = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(src + CHUNK_VOL + i)
+            );
+            _mm_storeu_si128(dst, _mm_unpacklo_epi16(ids, states));
+            _mm_storeu_si128(dst + 1, _mm_unpackhi_epi16(ids, states));
+        }
+#endif
+        for (; i < CHUNK_VOL; i++) {
+            uint32_t word = src[i] |
+                            (static_cast<uint32_t>(src[CHUNK_VOL + i]) << 16);
+            std::memcpy(&voxels[i], &word, sizeof(word));
+        }
+    } else {
+        for (; i < CHUNK_VOL; i++) {
+            voxel& vox = voxels[i];
 
-        vox.id = dataio::le2h(src[i]);
-        vox.state = int2blockstate(dataio::le2h(src[CHUNK_VOL + i]));
+            vox.id = dataio::le2h(src[i]);
+            vox.state = int2blockstate(dataio::le2h(src[CHUNK_VOL + i]));
+        }
     }
+    journal.reset();
     return true;
 }
 
+/// @brief Fill voxels [start, start + count) with the block id and zero state.
+/// SIMD path may write up to 3 voxels past the end (within the chunk),
+/// they are overwritten by the next sequences
+static void fill_ids(
+    voxel* voxels, uint start, uint count, blockid_t id, bool native
+) {
+    uint i = start;
+    uint end = start + count;
+#ifdef VC_CHUNK_SSE2
+    if (native) {
+        const __m128i word = _mm_set1_epi32(id);
+        for (; i < end && i + 4 <= CHUNK_VOL; i += 4) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(voxels + i), word);
+        }
+    }
+#endif
+    for (; i < end; i++) {
+        voxels[i] = {id, {}};
+    }
+}
+
+/// @brief Set state of voxels [start, start + count) keeping ids.
+/// SIMD path may write up to 3 voxels past the end (within the chunk)
+static void fill_states(
+    voxel* voxels, uint start, uint count, blockstate_t state, bool native
+) {
+    uint i = start;
+    uint end = start + count;
+#ifdef VC_CHUNK_SSE2
+    if (native) {
+        const __m128i mask = _mm_set1_epi32(0xFFFF);
+        const __m128i high = _mm_set1_epi32(static_cast<int>(state) << 16);
+        for (; i < end && i + 4 <= CHUNK_VOL; i += 4) {
+            auto ptr = reinterpret_cast<__m128i*>(voxels + i);
+            __m128i words = _mm_and_si128(_mm_loadu_si128(ptr), mask);
+            _mm_storeu_si128(ptr, _mm_or_si128(words, high));
+        }
+    }
+#endif
+    blockstate value = int2blockstate(state);
+    for (; i < end; i++) {
+        voxels[i].state = value;
+    }
+}
+
+void Chunk::decodeExtRle16(
+    const ubyte* src, size_t size, blockid_t idsLimit
+) {
+    // check all sequences first, so corrupted data does not modify voxels
+    size_t length = extrle::for_each_sequence16(
+        src, size, [this, idsLimit](size_t offset, size_t count, uint16_t c) {
+            if (offset + count > CHUNK_VOL * 2) {
+                throw std::runtime_error("buffer overflow");
+            }
+            blockid_t id = dataio::le2h(c);
+            if (offset < CHUNK_VOL && id >= idsLimit) {
+                throw std::runtime_error(
+                    "block data corruption (chunk: " + std::to_string(x) +
+                    ", " + std::to_string(z) + ") at " +
+                    std::to_string(offset) + " id: " + std::to_string(id)
+                );
+            }
+        }
+    );
+    if (length != CHUNK_VOL * 2) {
+        throw std::runtime_error("incomplete chunk data");
+    }
+    // sequences are written in order, so overrun of the previous
+    // sequence is always overwritten by the next one
+    bool native = is_native_layout();
+    extrle::for_each_sequence16(
+        src, size, [this, native](size_t offset, size_t count, uint16_t c) {
+            c = dataio::le2h(c);
+            if (offset < CHUNK_VOL) {
+                uint idsCount = std::min<size_t>(count, CHUNK_VOL - offset);
+                fill_ids(voxels, offset, idsCount, c, native);
+                offset += idsCount;
+                count -= idsCount;
+            }
+            if (count) {
+                fill_states(voxels, offset - CHUNK_VOL, count, c, native);
+            }
+        }
+    );
+    journal.reset();
+}
+
 void Chunk::convert(ubyte* data, const ContentReport* report) {
     auto buffer = reinterpret_cast<uint16_t*>(data);
     for (uint i = 0; i < CHUNK_VOL; i++) {
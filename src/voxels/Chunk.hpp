@@ -8,6 +8,7 @@
 #include "constants.hpp"
 #include "lighting/Lightmap.hpp"
 #include "util/SmallHeap.hpp"
+#include "ChunkJournal.hpp"
 #include "maths/aabb.hpp"
 #include "voxel.hpp"
 
@@ -39,6 +40,9 @@ public:
         bool blocksData : 1;
         bool dirtyHeights : 1;
         bool inventoriesRemoved : 1;
+        /// @brief Loaded chunk was pregenerated and is presented
+        /// for the first time
+        bool pregenerated : 1;
     } flags {};
 
     uint64_t lastRandomTickId = -1;
@@ -47,6 +51,8 @@ public:
     ChunkInventoriesMap inventories;
     /// @brief Blocks metadata heap
     BlocksMetadata blocksMetadata;
+    /// @brief Recent voxels and metadata changes used for delta sync
+    ChunkJournal journal;
 
     Chunk(int x, int z, std::shared_ptr<Lightmap> lightmap=nullptr);
 
@@ -76,6 +82,14 @@ public:
     /// @return true if all is fine
     bool decode(const ubyte* data);
 
+    /// @brief Decode extRLE16-compressed encode() output directly into
+    /// voxels. Data is checked before voxels are modified
+    /// @param src compressed data
+    /// @param size compressed data size
+    /// @param idsLimit block ids must be less than the limit
+    /// @throws std::runtime_error if data is corrupted
+    void decodeExtRle16(const ubyte* src, size_t size, blockid_t idsLimit);
+
     static void convert(ubyte* data, const ContentReport* report);
 
     AABB getAABB() const {
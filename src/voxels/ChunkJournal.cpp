@@ -0,0 +1,76 @@
+#include "ChunkJournal.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+
+static uint64_t initial_revision() {
+    // revisions stay increasing between sessions
+    using namespace std::chrono;
+    return duration_cast<microseconds>(
+        system_clock::now().time_since_epoch()
+    ).count();
+}
+
+static std::atomic<uint64_t> next_revision = initial_revision();
+
+ChunkJournal::ChunkJournal() {
+    reset();
+}
+
+void ChunkJournal::record(uint32_t index) {
+    if (records == nullptr) {
+        records = std::make_unique<Record[]>(CAPACITY);
+    }
+    revision = next_revision++;
+
+    auto& record = records[written % CAPACITY];
+    if (written >= CAPACITY) {
+        firstAvailable = std::max(firstAvailable, record.revision);
+    }
+    record = {revision, index};
+    written++;
+}
+
+void ChunkJournal::recordVoxel(uint index) {
+    record(index);
+}
+
+void ChunkJournal::recordMetadata(uint index) {
+    record(index | METADATA_BIT);
+}
+
+void ChunkJournal::reset() {
+    revision = next_revision++;
+    firstAvailable = revision;
+    written = 0;
+}
+
+bool ChunkJournal::collect(
+    uint64_t since,
+    std::vector<uint>& voxels,
+    std::vector<uint>& metadata
+) const {
+    if (since < firstAvailable || since > revision) {
+        return false;
+    }
+    uint64_t count = std::min<uint64_t>(written, CAPACITY);
+    for (uint64_t i = 0; i < count; i++) {
+        const auto& record = records[(written - 1 - i) % CAPACITY];
+        if (record.revision <= since) {
+            break;
+        }
+        if (record.index & METADATA_BIT) {
+            metadata.push_back(record.index & ~METADATA_BIT);
+        } else {
+            voxels.push_back(record.index);
+        }
+    }
+    for (auto vector : {&voxels, &metadata}) {
+        std::sort(vector->begin(), vector->end());
+        vector->erase(
+            std::unique(vector->begin(), vector->end()), vector->end()
+        );
+    }
+    return true;
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <cstdint>
+
+#include "typedefs.hpp"
+
+/// @brief Bounded log of recent chunk voxels and blocks metadata changes
+/// used to build chunk deltas.
+/// Revisions are taken from a process-wide monotonic counter, so a revision
+/// obtained from an unloaded chunk is never valid for a reloaded one.
+/// Not thread-safe.
+class ChunkJournal {
+public:
+    /// @brief Max number of changes kept
+    static constexpr uint CAPACITY = 256;
+
+    ChunkJournal();
+
+    /// @brief Record voxel id or state change
+    /// @param index voxel index in chunk voxels array
+    void recordVoxel(uint index);
+
+    /// @brief Record block metadata allocation, change or removal
+    /// @param index voxel index in chunk voxels array
+    void recordMetadata(uint index);
+
+    /// @brief Invalidate all previous revisions (chunk data replaced)
+    void reset();
+
+    /// @return revision of the latest change
+    uint64_t getRevision() const {
+        return revision;
+    }
+
+    /// @brief Get indices of voxels and metadata entries changed after the
+    /// given revision (without duplicates)
+    /// @return false if the changes are not available (log overflowed,
+    /// journal reset or unknown revision)
+    bool collect(
+        uint64_t since,
+        std::vector<uint>& voxels,
+        std::vector<uint>& metadata
+    ) const;
+private:
+    static constexpr uint32_t METADATA_BIT = 0x80000000U;
+
+    struct Record {
+        uint64_t revision;
+        uint32_t index;
+    };
+    /// @brief Ring of records, allocated on the first change
+    std::unique_ptr<Record[]> records;
+    /// @brief Total number of records written since allocation
+    uint64_t written = 0;
+    uint64_t revision;
+    /// @brief Changes made before this revision are unavailable
+    uint64_t firstAvailable;
+
+    void record(uint32_t index);
+};
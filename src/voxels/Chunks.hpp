@@ -112,7 +112,7 @@ public:
         glm::vec3& end,
         glm::ivec3& norm,
         glm::ivec3& iend,
-        std::set<blockid_t> filter = {},
+        const std::set<blockid_t>& filter = {},
         bool includeNonSelectable = false
     ) const;
 
@@ -4,7 +4,6 @@
 
 #include "Block.hpp"
 #include "Chunk.hpp"
-#include "coders/json.hpp"
 #include "content/Content.hpp"
 #include "debug/Logger.hpp"
 #include "items/Inventories.hpp"
@@ -16,6 +15,7 @@
 #include "util/ObjectsPool.hpp"
 #include "voxels/blocks_agent.hpp"
 #include "world/files/WorldFiles.hpp"
+#include "world/files/chunk_records.hpp"
 #include "world/Level.hpp"
 #include "world/LevelEvents.hpp"
 #include "world/World.hpp"
@@ -93,6 +93,28 @@ static inline auto load_inventories(
 static util::ObjectsPool<Chunk> chunks_pool(1'024);
 static util::ObjectsPool<Lightmap> lightmaps_pool;
 
+static bool load_voxels(
+    WorldRegions& regions,
+    const ContentIndices& indices,
+    Chunk& chunk,
+    ubyte* buffer
+) {
+    try {
+        return regions.getVoxels(
+            chunk.x, chunk.z, chunk, indices.blocks.count()
+        );
+    } catch (const std::runtime_error& err) {
+        logger.error() << err.what();
+    }
+    // replace invalid blocks
+    if (!regions.getVoxels(chunk.x, chunk.z, buffer)) {
+        return false;
+    }
+    chunk.decode(buffer);
+    check_voxels(indices, chunk);
+    return true;
+}
+
 std::shared_ptr<Chunk> GlobalChunks::create(int x, int z, bool lighting) {
     const auto& found = chunksMap.find(keyfrom(x, z));
     if (found != chunksMap.end()) {
@@ -110,11 +132,8 @@ std::shared_ptr<Chunk> GlobalChunks::create(int x, int z, bool lighting) {
     World& world = *level.getWorld();
     auto& regions = world.wfile.get()->getRegions();
 
-    if (regions.getVoxels(chunk->x, chunk->z, voxelDataBuffer.get())) {
-        const auto& indices = *level.content.getIndices();
-
-        chunk->decode(voxelDataBuffer.get());
-        check_voxels(indices, *chunk);
+    const auto& indices = *level.content.getIndices();
+    if (load_voxels(regions, indices, *chunk, voxelDataBuffer.get())) {
 
         chunk->setBlockInventories(
             load_inventories(regions, *chunk, indices.blocks)
@@ -127,6 +146,8 @@ std::shared_ptr<Chunk> GlobalChunks::create(int x, int z, bool lighting) {
         }
 
         chunk->flags.loaded = true;
+        chunk->flags.pregenerated =
+            regions.takePregenerated(chunk->x, chunk->z);
         for (auto& entry : chunk->inventories) {
             level.inventories->store(entry.second);
         }
@@ -199,7 +220,7 @@ void GlobalChunks::save(Chunk* chunk) {
     }
     level.getWorld()->wfile->getRegions().put(
         chunk,
-        chunk->flags.entities ? json::to_binary(root, true)
+        chunk->flags.entities ? chunk_records::encode_entities(root)
                                 : std::vector<ubyte>()
     );
 }
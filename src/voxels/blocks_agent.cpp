@@ -118,6 +118,7 @@ static void finalize_block(
     if (def.dataStruct) {
         if (auto found = chunk.blocksMetadata.find(index)) {
             chunk.blocksMetadata.free(found);
+            chunk.journal.recordMetadata(index);
             chunk.flags.unsaved = true;
             chunk.flags.blocksData = true;
         }
@@ -148,6 +149,7 @@ static void initialize_block(
     vox.id = id;
     vox.state = state;
     chunk.setModifiedAndUnsaved();
+    chunk.journal.recordVoxel(vox_index(lx, y, lz));
     if (!state.segment && def.rt.extended) {
         restore_segments(chunks, def, state, x, y, z);
     }
@@ -214,19 +216,55 @@ bool blocks_agent::set(
     return set_block(chunks, x, y, z, id, state);
 }
 
-template <class Storage>
+namespace {
+    /// @brief Voxels access with the last chunk cached.
+    /// Rays cross chunk borders rarely, so most steps skip chunk lookup
+    template <class Storage>
+    class CachedVoxels {
+    public:
+        const Storage& chunks;
+
+        CachedVoxels(const Storage& chunks) : chunks(chunks) {
+        }
+
+        voxel* get(int32_t x, int32_t y, int32_t z) {
+            if (y < 0 || y >= CHUNK_H) {
+                return nullptr;
+            }
+            int cx = floordiv<CHUNK_W>(x);
+            int cz = floordiv<CHUNK_D>(z);
+            if (chunk == nullptr || cx != chunkX || cz != chunkZ) {
+                chunk = get_chunk(chunks, cx, cz);
+                chunkX = cx;
+                chunkZ = cz;
+                if (chunk == nullptr) {
+                    return nullptr;
+                }
+            }
+            int lx = x - cx * CHUNK_W;
+            int lz = z - cz * CHUNK_D;
+            return &chunk->voxels[(y * CHUNK_D + lz) * CHUNK_W + lx];
+        }
+    private:
+        Chunk* chunk = nullptr;
+        int chunkX = 0;
+        int chunkZ = 0;
+    };
+}
+
+/// @param isTarget voxel predicate: will ray stop on the block
+template <class Storage, class Predicate>
 static inline voxel* raycast_blocks(
-    const Storage& chunks,
+    CachedVoxels<Storage>& voxels,
     const glm::vec3& start,
     const glm::vec3& dir,
     float maxDist,
     glm::vec3& end,
     glm::ivec3& norm,
     glm::ivec3& iend,
-    std::set<blockid_t> filter,
-    bool includeNonSelectable
+    const Predicate& isTarget
 ) {
-    const auto& blocks = chunks.getContentIndices().blocks;
+    const auto& blocks = voxels.chunks.getContentIndices().blocks;
     float px = start.x;
     float py = start.y;
     float pz = start.z;
@@ -261,14 +299,12 @@ static inline voxel* raycast_blocks(
     int steppedIndex = -1;
 
     while (t <= maxDist) {
-        voxel* voxel = get(chunks, ix, iy, iz);
+        voxel* voxel = voxels.get(ix, iy, iz);
         if (voxel == nullptr) {
             return nullptr;
         }
-
-        const auto& def = blocks.require(voxel->id);
-        if (voxel->id != BLOCK_AIR && (def.selectable || includeNonSelectable) &&
-            (filter.empty() || filter.find(def.rt.id) == filter.end())) {
+        if (isTarget(*voxel)) {
+            const auto& def = blocks.require(voxel->id);
             end.x = px + t * dx;
             end.y = py + t * dy;
             end.z = pz + t * dz;
@@ -288,7 +324,7 @@ static inline voxel* raycast_blocks(
 
                 glm::vec3 offset {};
                 if (voxel->state.segment) {
-                    offset = seek_origin(chunks, iend, def, voxel->state) - iend;
+                    offset = seek_origin(voxels.chunks, iend, def, voxel->state) - iend;
                 }
 
                 for (auto box : hitboxes) {
@@ -357,6 +393,70 @@ static inline voxel* raycast_blocks(
     return nullptr;
 }
 
+template <class Storage>
+static inline voxel* raycast_blocks(
+    const Storage& chunks,
+    const glm::vec3& start,
+    const glm::vec3& dir,
+    float maxDist,
+    glm::vec3& end,
+    glm::ivec3& norm,
+    glm::ivec3& iend,
+    const std::set<blockid_t>& filter,
+    bool includeNonSelectable
+) {
+    const auto& blocks = chunks.getContentIndices().blocks;
+    CachedVoxels<Storage> voxels(chunks);
+    return raycast_blocks(
+        voxels, start, dir, maxDist, end, norm, iend, [&](const voxel& vox) {
+            if (vox.id == BLOCK_AIR) {
+                return false;
+            }
+            const auto& def = blocks.require(vox.id);
+            return (def.selectable || includeNonSelectable) &&
+                   (filter.empty() || filter.find(def.rt.id) == filter.end());
+        }
+    );
+}
+
+template <class Storage>
+static inline std::vector<RaycastHit> raycast_blocks(
+    const Storage& chunks,
+    const std::vector<RaycastQuery>& queries,
+    const std::set<blockid_t>& filter,
+    bool includeNonSelectable
+) {
+    // flattened predicate shared by all rays
+    const auto& blocks = chunks.getContentIndices().blocks;
+    std::vector<uint8_t> targets(blocks.count());
+    for (size_t id = 0; id < targets.size(); id++) {
+        const auto& def = *blocks.get(id);
+        targets[id] = id != BLOCK_AIR &&
+                      (def.selectable || includeNonSelectable) &&
+                      filter.find(id) == filter.end();
+    }
+    CachedVoxels<Storage> voxels(chunks);
+    std::vector<RaycastHit> hits(queries.size());
+    for (size_t i = 0; i < queries.size(); i++) {
+        const auto& query = queries[i];
+        auto& hit = hits[i];
+        hit.vox = raycast_blocks(
+            voxels,
+            query.start,
+            query.dir,
+            query.maxDist,
+            hit.end,
+            hit.norm,
+            hit.iend,
+            [&](const voxel& vox) {
+                // invalid ids are passed to be reported by require
+                return vox.id >= targets.size() || targets[vox.id];
+            }
+        );
+    }
+    return hits;
+}
+
 voxel* blocks_agent::raycast(
     const Chunks& chunks,
     const glm::vec3& start,
@@ -365,7 +465,7 @@ voxel* blocks_agent::raycast(
     glm::vec3& end,
     glm::ivec3& norm,
     glm::ivec3& iend,
-    std::set<blockid_t> filter,
+    const std::set<blockid_t>& filter,
     bool includeNonSelectable
 ) {
     return raycast_blocks(chunks, start, dir, maxDist, end, norm, iend, filter, includeNonSelectable);
@@ -379,12 +479,30 @@ voxel* blocks_agent::raycast(
     glm::vec3& end,
     glm::ivec3& norm,
     glm::ivec3& iend,
-    std::set<blockid_t> filter,
+    const std::set<blockid_t>& filter,
     bool includeNonSelectable
 ) {
     return raycast_blocks(chunks, start, dir, maxDist, end, norm, iend, filter, includeNonSelectable);
 }
 
+std::vector<RaycastHit> blocks_agent::raycast(
+    const Chunks& chunks,
+    const std::vector<RaycastQuery>& queries,
+    const std::set<blockid_t>& filter,
+    bool includeNonSelectable
+) {
+    return raycast_blocks(chunks, queries, filter, includeNonSelectable);
+}
+
+std::vector<RaycastHit> blocks_agent::raycast(
+    const GlobalChunks& chunks,
+    const std::vector<RaycastQuery>& queries,
+    const std::set<blockid_t>& filter,
+    bool includeNonSelectable
+) {
+    return raycast_blocks(chunks, queries, filter, includeNonSelectable);
+}
+
 // reduce nesting on next modification
 // 25.06.2024: not now
 // 11.11.2024: not now
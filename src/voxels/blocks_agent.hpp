@@ -353,6 +353,9 @@ inline void set_rotation_extended(
                     auto chunk = get_chunk(chunks, cx, cz);
                     assert(chunk != nullptr);
                     chunk->setModifiedAndUnsaved();
+                    chunk->journal.recordVoxel(vox_index(
+                        pos.x - cx * CHUNK_W, pos.y, pos.z - cz * CHUNK_D
+                    ));
                     segmentBlocks.emplace_back(pos);
                 }
             }
@@ -409,6 +412,9 @@ inline void set_rotation(
         auto chunk = get_chunk(chunks, cx, cz);
         assert(chunk != nullptr);
         chunk->setModifiedAndUnsaved();
+        chunk->journal.recordVoxel(
+            vox_index(x - cx * CHUNK_W, y, z - cz * CHUNK_D)
+        );
     }
 }
 
@@ -431,7 +437,7 @@ voxel* raycast(
     glm::vec3& end,
     glm::ivec3& norm,
     glm::ivec3& iend,
-    std::set<blockid_t> filter,
+    const std::set<blockid_t>& filter,
     bool includeNonSelectable
 );
 
@@ -454,10 +460,58 @@ voxel* raycast(
     glm::vec3& end,
     glm::ivec3& norm,
     glm::ivec3& iend,
-    std::set<blockid_t> filter,
+    const std::set<blockid_t>& filter,
     bool includeNonSelectable
 );
 
+struct RaycastQuery {
+    glm::vec3 start;
+    /// @brief normalized ray direction vector
+    glm::vec3 dir;
+    float maxDist;
+};
+
+struct RaycastHit {
+    /// @brief voxel pointer or nullptr
+    voxel* vox = nullptr;
+    /// @brief ray end position
+    glm::vec3 end {};
+    /// @brief surface normal vector
+    glm::ivec3 norm {};
+    /// @brief ray end integer position
+    glm::ivec3 iend {};
+};
+
+/// @brief Cast multiple rays to selectable blocks. Chunk lookups and
+/// block properties checks are shared between the rays, so it's faster than
+/// casting them one by one.
+/// @param chunks chunks storage
+/// @param queries rays
+/// @param filter filtered ids
+/// @param includeNonSelectable will non-selectable blocks be included
+/// @return results in the queries order
+std::vector<RaycastHit> raycast(
+    const Chunks& chunks,
+    const std::vector<RaycastQuery>& queries,
+    const std::set<blockid_t>& filter = {},
+    bool includeNonSelectable = false
+);
+
+/// @brief Cast multiple rays to selectable blocks. Chunk lookups and
+/// block properties checks are shared between the rays, so it's faster than
+/// casting them one by one.
+/// @param chunks chunks storage
+/// @param queries rays
+/// @param filter filtered ids
+/// @param includeNonSelectable will non-selectable blocks be included
+/// @return results in the queries order
+std::vector<RaycastHit> raycast(
+    const GlobalChunks& chunks,
+    const std::vector<RaycastQuery>& queries,
+    const std::set<blockid_t>& filter = {},
+    bool includeNonSelectable = false
+);
+
 void get_voxels(
     const Chunks& chunks, VoxelsVolume* volume, bool backlight = false
 );
@@ -5,9 +5,14 @@
 
 #include "world/files/WorldFiles.hpp"
 #include "content/Content.hpp"
+#include "Block.hpp"
+
+#include <algorithm>
+#include <cstring>
 
 inline constexpr int HAS_VOXELS = 0x1;
 inline constexpr int HAS_METADATA = 0x2;
+inline constexpr int IS_DELTA = 0x4;
 
 std::vector<ubyte> compressed_chunks::encode(
     const ubyte* data,
@@ -58,22 +63,13 @@ void compressed_chunks::decode(
     reader.skip(1); // reserved byte
 
     if (flags & HAS_VOXELS) {
-        /// world.get_chunk_data is only available in the main Lua state
-        static util::Buffer<ubyte> voxelData (CHUNK_DATA_LEN);
-        read_voxel_data(reader, voxelData);
-        // TODO: move somewhere in Chunk
-        auto src = reinterpret_cast<const uint16_t*>(voxelData.data());
-        for (size_t i = 0; i < CHUNK_VOL; i++) {
-            blockid_t id = dataio::le2h(src[i]);;
-            if (indices.blocks.get(id) == nullptr) {
-                throw std::runtime_error(
-                    "block data corruption (chunk: " + std::to_string(chunk.x) +
-                    ", " + std::to_string(chunk.z) + ") at " +
-                    std::to_string(i) + " id: " + std::to_string(id)
-                );
-            }
-        }
-        chunk.decode(voxelData.data());
+        size_t gzipCompressedSize = reader.getInt32();
+        auto rleData = gzip::decompress(reader.pointer(), gzipCompressedSize);
+        reader.skip(gzipCompressedSize);
+
+        chunk.decodeExtRle16(
+            rleData.data(), rleData.size(), indices.blocks.count()
+        );
         chunk.updateHeights();
     }
     if (flags & HAS_METADATA) {
@@ -81,7 +77,167 @@ void compressed_chunks::decode(
         chunk.blocksMetadata.deserialize(reader.pointer(), metadataSize);
         reader.skip(metadataSize);
     }
+    chunk.journal.reset();
+    chunk.setModifiedAndUnsaved();
+}
+
+/**
+  Chunk delta format:
+    - byte-order: little-endian
+
+    ```cpp
+    uint8_t flags; // IS_DELTA
+    uint8_t reserved;
+    uint32_t voxels_count;
+    struct {
+        uint16_t index;
+        uint16_t id;
+        uint16_t states;
+    } voxels[voxels_count];
+    uint32_t metadata_count;
+    struct {
+        uint16_t index;
+        uint8_t size; // 0 if metadata is removed
+        uint8_t bytes[size];
+    } metadata[metadata_count];
+    ```
+*/
+std::vector<ubyte> compressed_chunks::encode_delta(
+    Chunk& chunk, uint64_t since
+) {
+    static_assert(CHUNK_VOL <= 0x10000, "voxel index must fit uint16");
+
+    std::vector<uint> voxels;
+    std::vector<uint> metadata;
+    if (!chunk.journal.collect(since, voxels, metadata)) {
+        return {};
+    }
+    ByteBuilder builder(2 + 8 + voxels.size() * 6);
+    builder.put(IS_DELTA); // flags
+    builder.put(0); // reserved
+    builder.putInt32(voxels.size());
+    for (uint index : voxels) {
+        const auto& vox = chunk.voxels[index];
+        builder.putInt16(index);
+        builder.putInt16(vox.id);
+        builder.putInt16(blockstate2int(vox.state));
+    }
+    builder.putInt32(metadata.size());
+    for (uint index : metadata) {
+        builder.putInt16(index);
+        auto data = chunk.blocksMetadata.find(index);
+        auto size = chunk.blocksMetadata.sizeOf(data);
+        builder.put(size);
+        if (size) {
+            builder.put(data, size);
+        }
+    }
+    return builder.build();
+}
+
+bool compressed_chunks::is_delta(const ubyte* src, size_t size) {
+    return size > 0 && (src[0] & IS_DELTA);
+}
+
+static void delta_corruption(const Chunk& chunk, uint index, int id) {
+    throw std::runtime_error(
+        "block data corruption (chunk: " + std::to_string(chunk.x) + ", " +
+        std::to_string(chunk.z) + ") at " + std::to_string(index) +
+        " id: " + std::to_string(id)
+    );
+}
+
+std::vector<compressed_chunks::VoxelChange> compressed_chunks::decode_delta(
+    Chunk& chunk, const ubyte* src, size_t size, const ContentIndices& indices
+) {
+    ByteReader reader(src, size);
+    if (!(reader.get() & IS_DELTA)) {
+        throw std::runtime_error("chunk delta expected");
+    }
+    reader.skip(1); // reserved byte
+
+    struct VoxelEntry {
+        uint index;
+        voxel vox;
+    };
+    struct MetadataEntry {
+        uint index;
+        ubyte size;
+        const ubyte* data;
+    };
+    // parse and validate the whole delta before modifying the chunk
+    size_t voxelsCount = static_cast<uint32_t>(reader.getInt32());
+    if (voxelsCount > reader.remaining() / 6) {
+        throw std::runtime_error("buffer underflow");
+    }
+    std::vector<VoxelEntry> voxels(voxelsCount);
+    for (auto& entry : voxels) {
+        entry.index = static_cast<uint16_t>(reader.getInt16());
+        entry.vox.id = static_cast<blockid_t>(reader.getInt16());
+        entry.vox.state =
+            int2blockstate(static_cast<blockstate_t>(reader.getInt16()));
+        if (entry.index >= CHUNK_VOL ||
+            indices.blocks.get(entry.vox.id) == nullptr) {
+            delta_corruption(chunk, entry.index, entry.vox.id);
+        }
+    }
+    size_t metadataCount = static_cast<uint32_t>(reader.getInt32());
+    if (metadataCount > reader.remaining() / 3) {
+        throw std::runtime_error("buffer underflow");
+    }
+    std::vector<MetadataEntry> metadata(metadataCount);
+    for (auto& entry : metadata) {
+        entry.index = static_cast<uint16_t>(reader.getInt16());
+        entry.size = reader.get();
+        entry.data = reader.pointer();
+        if (entry.index >= CHUNK_VOL) {
+            delta_corruption(chunk, entry.index, -1);
+        }
+        // ByteReader::skip does not check bounds
+        if (entry.size > reader.remaining()) {
+            throw std::runtime_error("buffer underflow");
+        }
+        reader.skip(entry.size);
+    }
+
+    std::vector<VoxelChange> changes;
+    changes.reserve(voxels.size());
+    for (const auto& entry : voxels) {
+        auto& vox = chunk.voxels[entry.index];
+        int lx = entry.index % CHUNK_W;
+        int lz = entry.index / CHUNK_W % CHUNK_D;
+        int y = entry.index / (CHUNK_D * CHUNK_W);
+        changes.push_back({entry.index, vox.id});
+        if (vox.id != entry.vox.id) {
+            if (indices.blocks.require(vox.id).inventorySize != 0) {
+                chunk.removeBlockInventory(lx, y, lz);
+            }
+        }
+        vox = entry.vox;
+        chunk.journal.recordVoxel(entry.index);
+
+        if (vox.id != BLOCK_AIR) {
+            chunk.bottom = std::min(chunk.bottom, y);
+            chunk.top = std::max(chunk.top, y + 1);
+        } else {
+            chunk.flags.dirtyHeights = true;
+        }
+    }
+    auto& blocksMetadata = chunk.blocksMetadata;
+    for (const auto& entry : metadata) {
+        if (entry.size == 0) {
+            blocksMetadata.free(blocksMetadata.find(entry.index));
+        } else {
+            auto dst = blocksMetadata.allocate(entry.index, entry.size);
+            std::memcpy(dst, entry.data, entry.size);
+        }
+        chunk.journal.recordMetadata(entry.index);
+    }
+    if (metadataCount) {
+        chunk.flags.blocksData = true;
+    }
     chunk.setModifiedAndUnsaved();
+    return changes;
 }
 
 void compressed_chunks::save(
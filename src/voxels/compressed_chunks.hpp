@@ -23,4 +23,27 @@ namespace compressed_chunks {
         const ContentIndices& indices
     );
     void save(int x, int z, std::vector<ubyte> bytes, WorldRegions& regions);
+
+    struct VoxelChange {
+        uint index;
+        blockid_t prevId;
+    };
+
+    /// @brief Encode voxels and blocks metadata changed after the given
+    /// chunk journal revision
+    /// @return empty vector if the changes are not available
+    /// (full data must be used instead)
+    std::vector<ubyte> encode_delta(Chunk& chunk, uint64_t since);
+
+    /// @return true if data is produced by encode_delta
+    bool is_delta(const ubyte* src, size_t size);
+
+    /// @brief Apply chunk delta. Lighting is not updated
+    /// @return applied voxel changes
+    std::vector<VoxelChange> decode_delta(
+        Chunk& chunk,
+        const ubyte* src,
+        size_t size,
+        const ContentIndices& indices
+    );
 }
@@ -180,6 +180,38 @@ WorldRegion* RegionsLayer::getOrCreateRegion(int x, int z) {
     return region;
 }
 
+bool RegionsLayer::hasData(int x, int z) {
+    int regionX, regionZ, localX, localZ;
+    calc_reg_coords(x, z, regionX, regionZ, localX, localZ);
+
+    if (auto region = getRegion(regionX, regionZ)) {
+        if (region->getChunkData(localX, localZ)) {
+            return true;
+        }
+    }
+    auto regfile = getRegFile({regionX, regionZ});
+    if (regfile == nullptr) {
+        return false;
+    }
+    return regfile.get()->offsets[localZ * REGION_SIZE + localX] != 0;
+}
+
+void RegionsLayer::unloadRegion(int x, int z) {
+    std::unique_ptr<WorldRegion> region;
+    {
+        std::lock_guard lock(mapMutex);
+        auto found = regions.find({x, z});
+        if (found == regions.end()) {
+            return;
+        }
+        region = std::move(found->second);
+        regions.erase(found);
+    }
+    if (region->isUnsaved()) {
+        writeRegion(x, z, region.get());
+    }
+}
+
 ubyte* RegionsLayer::getData(int x, int z, uint32_t& size, uint32_t& srcSize) {
     int regionX, regionZ, localX, localZ;
     calc_reg_coords(x, z, regionX, regionZ, localX, localZ);
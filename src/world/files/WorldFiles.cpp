@@ -11,6 +11,7 @@
 
 #include "coders/byte_utils.hpp"
 #include "coders/json.hpp"
+#include "coders/json_reader.hpp"
 #include "constants.hpp"
 #include "content/Content.hpp"
 #include "core_defs.hpp"
@@ -159,18 +160,43 @@ std::optional<WorldInfo> WorldFiles::readWorldInfo() {
     return info;
 }
 
+/// @brief Read resources list without building the whole document tree
 static void read_resources_data(
-    const Content& content, const dv::value& list, ResourceType type
+    const Content& content, json::Reader& reader, ResourceType type
 ) {
+    if (reader.getToken() != json::token::list_begin) {
+        reader.skip();
+        return;
+    }
     const auto& indices = content.getIndices(type);
-    for (size_t i = 0; i < list.size(); i++) {
-        auto& map = list[i];
-        const auto& name = map["name"].asString();
+    while (reader.next() != json::token::list_end) {
+        if (reader.getToken() == json::token::end) {
+            throw std::runtime_error("unexpected end of resources list");
+        }
+        if (reader.getToken() != json::token::object_begin) {
+            logger.warning() << "invalid resource entry skipped";
+            reader.skip();
+            continue;
+        }
+        std::string name;
+        dv::value saved = nullptr;
+        while (reader.next() == json::token::key) {
+            auto key = reader.getKey();
+            if (key == "name") {
+                reader.next();
+                name = reader.getString();
+            } else if (key == "saved") {
+                reader.next();
+                saved = reader.read();
+            } else {
+                reader.skip();
+            }
+        }
         size_t index = indices.indexOf(name);
         if (index == ResourceIndices::MISSING) {
             logger.warning() << "discard " << name;
         } else {
-            indices.saveData(index, map["saved"]);
+            indices.saveData(index, std::move(saved));
         }
     }
 }
@@ -181,13 +207,20 @@ bool WorldFiles::readResourcesData(const Content& content) {
         logger.warning() << "resources.json does not exists";
         return false;
     }
-    auto root = io::read_json(file);
-    for (const auto& [key, arr] : root.asObject()) {
+    auto text = io::read_string(file);
+    auto reader = json::create_reader(file.string(), text);
+    if (reader->next() != json::token::object_begin) {
+        throw std::runtime_error("object expected in " + file.string());
+    }
+    while (reader->next() == json::token::key) {
+        std::string key(reader->getKey());
         ResourceType type;
+        reader->next();
         if (ResourceTypeMeta.getItem(key, type)) {
-            read_resources_data(content, arr, type);
+            read_resources_data(content, *reader, type);
         } else {
             logger.warning() << "unknown resource type: " << key;
+            reader->skip();
         }
     }
     return true;
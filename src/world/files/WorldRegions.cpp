@@ -5,13 +5,12 @@
 #include <vector>
 
 #include "debug/Logger.hpp"
-#include "coders/json.hpp"
 #include "coders/byte_utils.hpp"
 #include "coders/rle.hpp"
-#include "coders/binary_json.hpp"
 #include "items/Inventory.hpp"
 #include "maths/voxmaths.hpp"
 #include "util/data_io.hpp"
+#include "chunk_records.hpp"
 
 #define REGION_FORMAT_MAGIC ".VOXREG"
 
@@ -117,41 +116,38 @@ void WorldRegions::put(
     region->put(localX, localZ, std::move(data), size, srcSize);
 }
 
+void WorldRegions::putCompressed(
+    int x,
+    int z,
+    RegionLayerIndex layerid,
+    std::unique_ptr<ubyte[]> data,
+    size_t size,
+    size_t srcSize
+) {
+    int regionX, regionZ, localX, localZ;
+    calc_reg_coords(x, z, regionX, regionZ, localX, localZ);
+
+    WorldRegion* region = layers[layerid].getOrCreateRegion(regionX, regionZ);
+    region->setUnsaved(true);
+    region->put(localX, localZ, std::move(data), size, srcSize);
+}
+
+compression::Method WorldRegions::getCompression(
+    RegionLayerIndex layerid
+) const {
+    return layers[layerid].compression;
+}
+
 static std::unique_ptr<ubyte[]> write_inventories(
     const ChunkInventoriesMap& inventories, uint32_t& datasize
 ) {
-    ByteBuilder builder;
-    builder.putInt32(inventories.size());
-    for (auto& entry : inventories) {
-        builder.putInt32(entry.first);
-        auto map = entry.second->serialize();
-        auto bytes = json::to_binary(map, true);
-        builder.putInt32(bytes.size());
-        builder.put(bytes.data(), bytes.size());
-    }
-    auto datavec = builder.data();
-    datasize = builder.size();
+    auto bytes = chunk_records::encode_inventories(inventories);
+    datasize = bytes.size();
     auto data = std::make_unique<ubyte[]>(datasize);
-    std::memcpy(data.get(), datavec, datasize);
+    std::memcpy(data.get(), bytes.data(), datasize);
     return data;
 }
 
-static ChunkInventoriesMap load_inventories(const ubyte* src, uint32_t size) {
-    ChunkInventoriesMap inventories;
-    ByteReader reader(src, size);
-    auto count = reader.getInt32();
-    for (int i = 0; i < count; i++) {
-        uint index = reader.getInt32();
-        uint size = reader.getInt32();
-        auto map = json::from_binary(reader.pointer(), size);
-        reader.skip(size);
-        auto inv = std::make_shared<Inventory>(0, 0);
-        inv->deserialize(map);
-        inventories[index] = std::move(inv);
-    }
-    return inventories;
-}
-
 void WorldRegions::put(Chunk* chunk, std::vector<ubyte> entitiesData) {
     if (generatorTestMode) {
         return;
@@ -195,9 +191,7 @@ void WorldRegions::put(Chunk* chunk, std::vector<ubyte> entitiesData) {
     // Writing entities
     if (!entitiesData.empty()) {
         auto data = std::make_unique<ubyte[]>(entitiesData.size());
-        for (size_t i = 0; i < entitiesData.size(); i++) {
-            data[i] = entitiesData[i];
-        }
+        std::memcpy(data.get(), entitiesData.data(), entitiesData.size());
         put(chunk->x,
             chunk->z,
             REGION_LAYER_ENTITIES,
@@ -215,6 +209,10 @@ void WorldRegions::put(Chunk* chunk, std::vector<ubyte> entitiesData) {
     }
 }
 
+bool WorldRegions::hasVoxels(int x, int z) {
+    return layers[REGION_LAYER_VOXELS].hasData(x, z);
+}
+
 bool WorldRegions::getVoxels(int x, int z, ubyte* dst) {
     uint32_t size;
     uint32_t srcSize;
@@ -228,6 +226,33 @@ bool WorldRegions::getVoxels(int x, int z, ubyte* dst) {
     return true;
 }
 
+bool WorldRegions::getVoxels(
+    int x, int z, Chunk& chunk, blockid_t idsLimit
+) {
+    uint32_t size;
+    uint32_t srcSize;
+    auto& layer = layers[REGION_LAYER_VOXELS];
+    auto* data = layer.getData(x, z, size, srcSize);
+    if (data == nullptr) {
+        return false;
+    }
+    if (layer.compression == compression::Method::EXTRLE16) {
+        chunk.decodeExtRle16(data, size, idsLimit);
+        return true;
+    }
+    auto bytes = compression::decompress(
+        data, size, CHUNK_DATA_LEN, layer.compression
+    );
+    auto ids = reinterpret_cast<const uint16_t*>(bytes.get());
+    for (size_t i = 0; i < CHUNK_VOL; i++) {
+        if (dataio::le2h(ids[i]) >= idsLimit) {
+            throw std::runtime_error("block data corruption");
+        }
+    }
+    chunk.decode(bytes.get());
+    return true;
+}
+
 bool WorldRegions::getLights(int x, int z, ubyte* dst) {
     uint32_t size;
     uint32_t srcSize;
@@ -247,7 +272,7 @@ ChunkInventoriesMap WorldRegions::fetchInventories(int x, int z) {
     if (bytes == nullptr) {
         return {};
     }
-    return load_inventories(bytes, bytesSize);
+    return chunk_records::decode_inventories(bytes, bytesSize);
 }
 
 BlocksMetadata WorldRegions::getBlocksData(int x, int z) {
@@ -265,7 +290,7 @@ BlocksMetadata WorldRegions::getBlocksData(int x, int z) {
 void WorldRegions::processInventories(int x, int z, const InventoryProc& func) {
     processRegion(x, z, REGION_LAYER_INVENTORIES,
     [=](std::unique_ptr<ubyte[]> data, uint32_t* size) {
-        auto inventories = load_inventories(data.get(), *size);
+        auto inventories = chunk_records::decode_inventories(data.get(), *size);
         for (const auto& [_, inventory] : inventories) {
             func(inventory.get());
         }
@@ -343,7 +368,7 @@ dv::value WorldRegions::fetchEntities(int x, int z) {
     if (data == nullptr) {
         return nullptr;
     }
-    auto map = json::from_binary(data, bytesSize);
+    auto map = chunk_records::decode_entities(data, bytesSize);
     if (map.empty()) {
         return nullptr;
     }
@@ -399,6 +424,82 @@ void WorldRegions::writeAll() {
         io::create_directories(layer.folder);
         layer.writeAll();
     }
+    writePregenerated();
+}
+
+/**
+  Pregenerated chunks marks file format:
+    - byte-order: little-endian
+
+    ```cpp
+    uint32_t count;
+    struct {
+        int32_t x;
+        int32_t z;
+    } chunks[count];
+    ```
+*/
+void WorldRegions::readPregenerated() {
+    if (pregeneratedRead) {
+        return;
+    }
+    pregeneratedRead = true;
+    auto file = directory / "pregenerated.bin";
+    if (!io::is_regular_file(file)) {
+        return;
+    }
+    auto bytes = io::read_bytes(file);
+    ByteReader reader(bytes);
+    size_t count = static_cast<uint32_t>(reader.getInt32());
+    for (size_t i = 0; i < count; i++) {
+        int x = reader.getInt32();
+        int z = reader.getInt32();
+        pregenerated.insert({x, z});
+    }
+}
+
+void WorldRegions::markPregenerated(int x, int z) {
+    readPregenerated();
+    pregenerated.insert({x, z});
+    pregeneratedUnsaved = true;
+}
+
+bool WorldRegions::takePregenerated(int x, int z) {
+    readPregenerated();
+    if (pregenerated.erase({x, z})) {
+        pregeneratedUnsaved = true;
+        return true;
+    }
+    return false;
+}
+
+void WorldRegions::writePregenerated() {
+    if (!pregeneratedUnsaved || generatorTestMode) {
+        return;
+    }
+    auto file = directory / "pregenerated.bin";
+    if (pregenerated.empty()) {
+        if (io::exists(file)) {
+            io::remove(file);
+        }
+    } else {
+        ByteBuilder builder(4 + pregenerated.size() * 8);
+        builder.putInt32(pregenerated.size());
+        for (const auto& pos : pregenerated) {
+            builder.putInt32(pos.x);
+            builder.putInt32(pos.y);
+        }
+        auto bytes = builder.build();
+        io::write_bytes(file, bytes.data(), bytes.size());
+    }
+    pregeneratedUnsaved = false;
+}
+
+void WorldRegions::unloadRegion(int x, int z) {
+    for (auto& layer : layers) {
+        io::create_directories(layer.folder);
+        layer.unloadRegion(x, z);
+    }
 }
 
 void WorldRegions::deleteRegion(RegionLayerIndex layerid, int x, int z) {
@@ -7,6 +7,7 @@
 #include <memory>
 #include <mutex>
 #include <unordered_map>
+#include <unordered_set>
 
 #include "coders/compression.hpp"
 #include "io/io.hpp"
@@ -146,6 +147,17 @@ struct RegionsLayer {
     WorldRegion* getRegion(int x, int z);
     WorldRegion* getOrCreateRegion(int x, int z);
 
+    /// @brief Check if chunk data is present without reading it
+    /// @param x chunk x coord
+    /// @param z chunk z coord
+    bool hasData(int x, int z);
+
+    /// @brief Write region file if it has unsaved changes and remove
+    /// the region from memory
+    /// @param x region X
+    /// @param z region Z
+    void unloadRegion(int x, int z);
+
     io::path getRegionFilePath(int x, int z) const;
 
     /// @brief Get chunk data. Read from file if not loaded yet.
@@ -181,6 +193,13 @@ class WorldRegions {
     io::path directory;
 
     RegionsLayer layers[REGION_LAYERS_COUNT] {};
+
+    /// @brief Saved pregenerated chunks not presented in a level yet
+    std::unordered_set<glm::ivec2> pregenerated;
+    bool pregeneratedRead = false;
+    bool pregeneratedUnsaved = false;
+
+    void readPregenerated();
 public:
     bool generatorTestMode = false;
     bool doWriteLights = true;
@@ -206,12 +225,43 @@ public:
         size_t size
     );
 
+    /// @brief Store data already compressed with the layer compression method
+    /// @param x chunk.x
+    /// @param z chunk.z
+    /// @param layer regions layer
+    /// @param data compressed data
+    /// @param size compressed data size
+    /// @param srcSize source data size
+    void putCompressed(
+        int x,
+        int z,
+        RegionLayerIndex layer,
+        std::unique_ptr<ubyte[]> data,
+        size_t size,
+        size_t srcSize
+    );
+
+    /// @return compression method used for the layer
+    compression::Method getCompression(RegionLayerIndex layerid) const;
+
+    /// @brief Check if chunk voxels are saved
+    /// @param x chunk.x
+    /// @param z chunk.z
+    bool hasVoxels(int x, int z);
+
     /// @brief Get chunk voxels data
     /// @param x chunk.x
     /// @param z chunk.z
     /// @return true if data read
     bool getVoxels(int x, int z, ubyte* dst);
 
+    /// @brief Decode saved chunk voxels directly into the chunk
+    /// @param idsLimit block ids must be less than the limit
+    /// @return true if data read
+    /// @throws std::runtime_error if data is corrupted or contains
+    /// invalid block ids (chunk voxels are not modified)
+    bool getVoxels(int x, int z, Chunk& chunk, blockid_t idsLimit);
+
     /// @brief Get cached lights for chunk at x,z
     /// @return true if data read
     bool getLights(int x, int z, ubyte* dst);
@@ -248,6 +298,25 @@ public:
     /// @brief Write all region layers
     void writeAll();
 
+    /// @brief Mark saved chunk as pregenerated (not presented in a level yet)
+    /// @param x chunk.x
+    /// @param z chunk.z
+    void markPregenerated(int x, int z);
+
+    /// @brief Remove chunk pregenerated mark
+    /// @param x chunk.x
+    /// @param z chunk.z
+    /// @return true if the chunk was marked
+    bool takePregenerated(int x, int z);
+
+    /// @brief Write pregenerated chunks marks if changed
+    void writePregenerated();
+
+    /// @brief Write region of all layers and remove it from memory
+    /// @param x region X
+    /// @param z region Z
+    void unloadRegion(int x, int z);
+
     void deleteRegion(RegionLayerIndex layerid, int x, int z);
 
     /// @brief Extract X and Z from 'X_Z.bin' region file name.
@@ -0,0 +1,115 @@
+#include "chunk_records.hpp"
+
+#include <stdexcept>
+#include <unordered_map>
+
+#include "coders/binary_json.hpp"
+#include "coders/byte_utils.hpp"
+#include "coders/compact_binary.hpp"
+#include "items/Inventory.hpp"
+
+std::vector<ubyte> chunk_records::encode_inventories(
+    const ChunkInventoriesMap& inventories
+) {
+    std::vector<itemid_t> palette;
+    std::unordered_map<itemid_t, uint> paletteIndices;
+    for (const auto& [_, inventory] : inventories) {
+        for (size_t i = 0; i < inventory->size(); i++) {
+            itemid_t id = inventory->getSlot(i).getItemId();
+            if (paletteIndices.find(id) == paletteIndices.end()) {
+                paletteIndices[id] = palette.size();
+                palette.push_back(id);
+            }
+        }
+    }
+    compact::Encoder encoder;
+    encoder.putVarUInt(palette.size());
+    for (itemid_t id : palette) {
+        encoder.putVarUInt(id);
+    }
+    encoder.putVarUInt(inventories.size());
+    for (const auto& [index, inventory] : inventories) {
+        encoder.putVarUInt(index);
+        encoder.putVarInt(inventory->getId());
+        encoder.putVarUInt(inventory->size());
+        for (size_t i = 0; i < inventory->size(); i++) {
+            const auto& slot = inventory->getSlot(i);
+            bool hasFields = slot.hasFields();
+            encoder.putVarUInt(
+                (paletteIndices[slot.getItemId()] << 1) | hasFields
+            );
+            encoder.putVarUInt(slot.getCount());
+            if (hasFields) {
+                encoder.putValue(slot.getFields());
+            }
+        }
+    }
+    return encoder.build();
+}
+
+static ChunkInventoriesMap decode_inventories_legacy(
+    const ubyte* src, size_t size
+) {
+    ChunkInventoriesMap inventories;
+    ByteReader reader(src, size);
+    auto count = reader.getInt32();
+    for (int i = 0; i < count; i++) {
+        uint index = reader.getInt32();
+        uint size = reader.getInt32();
+        auto map = json::from_binary(reader.pointer(), size);
+        reader.skip(size);
+        auto inv = std::make_shared<Inventory>(0, 0);
+        inv->deserialize(map);
+        inventories[index] = std::move(inv);
+    }
+    return inventories;
+}
+
+ChunkInventoriesMap chunk_records::decode_inventories(
+    const ubyte* src, size_t size
+) {
+    if (!compact::is_compact(src, size)) {
+        return decode_inventories_legacy(src, size);
+    }
+    compact::Decoder decoder(src, size);
+    std::vector<itemid_t> palette(decoder.getVarUInt());
+    for (auto& id : palette) {
+        id = decoder.getVarUInt();
+    }
+    ChunkInventoriesMap inventories;
+    size_t count = decoder.getVarUInt();
+    for (size_t i = 0; i < count; i++) {
+        uint index = decoder.getVarUInt();
+        int64_t id = decoder.getVarInt();
+        size_t slotsCount = decoder.getVarUInt();
+        auto inv = std::make_shared<Inventory>(id, slotsCount);
+        for (size_t slotIndex = 0; slotIndex < slotsCount; slotIndex++) {
+            uint64_t header = decoder.getVarUInt();
+            uint64_t paletteIndex = header >> 1;
+            if (paletteIndex >= palette.size()) {
+                throw std::runtime_error("invalid item palette index");
+            }
+            itemcount_t itemCount = decoder.getVarUInt();
+            dv::value fields = nullptr;
+            if (header & 1) {
+                fields = decoder.getValue();
+            }
+            inv->getSlot(slotIndex).set(
+                ItemStack(palette[paletteIndex], itemCount, std::move(fields))
+            );
+        }
+        inventories[index] = std::move(inv);
+    }
+    return inventories;
+}
+
+std::vector<ubyte> chunk_records::encode_entities(const dv::value& root) {
+    return compact::to_binary(root);
+}
+
+dv::value chunk_records::decode_entities(const ubyte* src, size_t size) {
+    if (compact::is_compact(src, size)) {
+        return compact::from_binary(src, size);
+    }
+    return json::from_binary(src, size);
+}
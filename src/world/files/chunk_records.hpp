@@ -0,0 +1,28 @@
+#pragma once
+
+#include <vector>
+
+#include "data/dv.hpp"
+#include "typedefs.hpp"
+#include "voxels/Chunk.hpp"
+
+/// @brief Block inventories and entities records of region layers.
+/// Records are written in the compact binary format (one compression pass
+/// per chunk layer record), legacy binary json records are still readable.
+/// @see /doc/specs/chunk_records_spec.md
+namespace chunk_records {
+    /// @brief Encode chunk block inventories.
+    /// Item ids are stored as indices in the record palette
+    std::vector<ubyte> encode_inventories(
+        const ChunkInventoriesMap& inventories
+    );
+
+    /// @brief Decode compact or legacy block inventories record
+    ChunkInventoriesMap decode_inventories(const ubyte* src, size_t size);
+
+    /// @brief Encode chunk entities record (root object with "data" list)
+    std::vector<ubyte> encode_entities(const dv::value& root);
+
+    /// @brief Decode compact or legacy (binary json) entities record
+    dv::value decode_entities(const ubyte* src, size_t size);
+}
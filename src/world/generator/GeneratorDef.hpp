@@ -223,6 +223,11 @@ struct GeneratorDef {
     /// @brief Height maps interpolation method
     InterpolationType heightsInterpolation = InterpolationType::LINEAR;
 
+    /// @brief Size of square of chunks (in chunks) parameter maps and
+    /// heightmaps are requested from the script for at once.
+    /// 1 is a separate script call per chunk
+    uint regionSize = 1;
+
     /// @brief Number of chunks must be generated before and after wide
     /// structures placement triggered
     uint wideStructsChunksRadius = 3;
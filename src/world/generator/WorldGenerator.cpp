@@ -23,6 +23,9 @@ static inline constexpr uint MAX_PARAMETERS = 4;
 /// @brief Initial + wide_structs + biomes + heightmaps + complete
 static inline constexpr uint BASIC_PROTOTYPE_LAYERS = 5;
 
+/// @brief Max number of kept generator regions
+static inline constexpr uint MAX_REGIONS = 128;
+
 WorldGenerator::WorldGenerator(
     const GeneratorDef& def, const Content& content, uint64_t seed
 )
@@ -84,6 +87,14 @@ ChunkPrototype& WorldGenerator::requirePrototype(int x, int z) {
     return *found->second;
 }
 
+const ChunkPrototype& WorldGenerator::requirePrototype(int x, int z) const {
+    const auto& found = prototypes.find({x, z});
+    if (found == prototypes.end()) {
+        throw std::runtime_error("prototype not found");
+    }
+    return *found->second;
+}
+
 static inline void generate_pole(
     const BlocksLayers& layers,
     int top, int bottom,
@@ -336,6 +347,67 @@ void WorldGenerator::generateStructures(
     prototype.level = ChunkPrototypeLevel::STRUCTURES;
 }
 
+/// @brief Position of the chunk area in a map with the given bpd
+static inline glm::ivec2 area_offset(int chunkX, int chunkZ, uint bpd) {
+    return {floordiv(chunkX * CHUNK_W, bpd), floordiv(chunkZ * CHUNK_D, bpd)};
+}
+
+/// @brief Size of a chunk area map with the given bpd
+static inline glm::ivec2 area_size(uint bpd) {
+    return {floordiv(CHUNK_W, bpd) + 1, floordiv(CHUNK_D, bpd) + 1};
+}
+
+/// @brief Size of a region map containing areas of all region chunks
+static inline glm::ivec2 region_size(
+    int chunkX, int chunkZ, uint regionSize, uint bpd
+) {
+    auto offset = area_offset(chunkX, chunkZ, bpd);
+    auto last = area_offset(
+        chunkX + regionSize - 1, chunkZ + regionSize - 1, bpd
+    );
+    return last - offset + area_size(bpd);
+}
+
+bool WorldGenerator::isRegionHeightmapSupported() const {
+    return def.heightmapInputs.empty() || def.biomesBPD == def.heightsBPD;
+}
+
+GeneratorRegion& WorldGenerator::requireRegion(int chunkX, int chunkZ) {
+    int size = def.regionSize;
+    glm::ivec2 key(floordiv(chunkX, size), floordiv(chunkZ, size));
+    const auto& found = regions.find(key);
+    if (found != regions.end()) {
+        return *found->second;
+    }
+    if (regions.size() >= MAX_REGIONS) {
+        // release the farthest region
+        auto farthest = regions.begin();
+        int maxDistance = -1;
+        for (auto it = regions.begin(); it != regions.end(); ++it) {
+            auto delta = glm::abs(it->first * size + size / 2 - center);
+            int distance = std::max(delta.x, delta.y);
+            if (distance > maxDistance) {
+                maxDistance = distance;
+                farthest = it;
+            }
+        }
+        regions.erase(farthest);
+    }
+    int originX = key.x * size;
+    int originZ = key.y * size;
+    uint bpd = def.biomesBPD;
+
+    auto region = std::make_unique<GeneratorRegion>();
+    region->parameters = def.script->generateParameterMaps(
+        area_offset(originX, originZ, bpd),
+        region_size(originX, originZ, size, bpd),
+        bpd
+    );
+    auto& ref = *region;
+    regions[key] = std::move(region);
+    return ref;
+}
+
 void WorldGenerator::generateBiomes(
     ChunkPrototype& prototype, int chunkX, int chunkZ
 ) {
@@ -343,26 +415,46 @@ void WorldGenerator::generateBiomes(
         return;
     }
     uint bpd = def.biomesBPD;
-    auto biomeParams = def.script->generateParameterMaps(
-        {floordiv(chunkX * CHUNK_W, bpd), floordiv(chunkZ * CHUNK_D, bpd)},
-        {floordiv(CHUNK_W, bpd)+1, floordiv(CHUNK_D, bpd)+1},
-        bpd
-    );
-    for (auto index : def.heightmapInputs) {
-        // copy non-scaled maps
-        auto copy = std::make_shared<Heightmap>(*biomeParams[index]);
-        copy->resize(
-            floordiv(CHUNK_W, def.heightsBPD) + 1,
-            floordiv(CHUNK_D, def.heightsBPD) + 1,
-            def.heightsInterpolation
+    auto areaSize = area_size(bpd);
+    // chunk area position in parameter maps
+    glm::ivec2 areaPos {};
+
+    std::vector<std::shared_ptr<Heightmap>> biomeParams;
+    if (def.regionSize > 1) {
+        int size = def.regionSize;
+        biomeParams = requireRegion(chunkX, chunkZ).parameters;
+        areaPos = area_offset(chunkX, chunkZ, bpd) -
+                  area_offset(floordiv(chunkX, size) * size,
+                              floordiv(chunkZ, size) * size, bpd);
+    } else {
+        biomeParams = def.script->generateParameterMaps(
+            area_offset(chunkX, chunkZ, bpd), areaSize, bpd
         );
-        prototype.heightmapInputs.push_back(std::move(copy));
+        if (!biomeParams.empty()) {
+            const auto& map = *biomeParams[0];
+            areaSize = {map.getWidth(), map.getHeight()};
+        }
     }
-    for (const auto& map : biomeParams) {
-        map->resize(
-            CHUNK_W + bpd, CHUNK_D + bpd, def.biomesInterpolation
+    if (def.regionSize == 1 || !isRegionHeightmapSupported()) {
+        auto heightsSize = area_size(def.heightsBPD);
+        for (auto index : def.heightmapInputs) {
+            prototype.heightmapInputs.push_back(biomeParams[index]->sampleArea(
+                areaPos.x, areaPos.y,
+                areaSize.x, areaSize.y,
+                heightsSize.x, heightsSize.y,
+                heightsSize.x, heightsSize.y,
+                def.heightsInterpolation
+            ));
+        }
+    }
+    for (auto& map : biomeParams) {
+        map = map->sampleArea(
+            areaPos.x, areaPos.y,
+            areaSize.x, areaSize.y,
+            CHUNK_W + bpd, CHUNK_D + bpd,
+            CHUNK_W, CHUNK_D,
+            def.biomesInterpolation
         );
-        map->crop(0, 0, CHUNK_W, CHUNK_D);
     }
     const auto& biomes = def.biomes;
 
@@ -384,21 +476,63 @@ void WorldGenerator::generateHeightmap(
         return;
     }
     uint bpd = def.heightsBPD;
-    prototype.heightmap = def.script->generateHeightmap(
-        {floordiv(chunkX * CHUNK_W, bpd), floordiv(chunkZ * CHUNK_D, bpd)},
-        {floordiv(CHUNK_W, bpd)+1, floordiv(CHUNK_D, bpd)+1},
-        bpd,
-        prototype.heightmapInputs
-    );
-    prototype.heightmap->clamp();
-    prototype.heightmap->resize(
-        CHUNK_W + bpd, CHUNK_D + bpd, def.heightsInterpolation
-    );
-    prototype.heightmap->crop(0, 0, CHUNK_W, CHUNK_D);
+    auto areaSize = area_size(bpd);
+    if (def.regionSize > 1 && isRegionHeightmapSupported()) {
+        int size = def.regionSize;
+        int originX = floordiv(chunkX, size) * size;
+        int originZ = floordiv(chunkZ, size) * size;
+        auto& region = requireRegion(chunkX, chunkZ);
+        if (region.heightmap == nullptr) {
+            // copies: scripts may modify inputs, while region parameters
+            // are still sampled by generateBiomes of other chunks
+            std::vector<std::shared_ptr<Heightmap>> inputs;
+            for (auto index : def.heightmapInputs) {
+                inputs.push_back(
+                    std::make_shared<Heightmap>(*region.parameters[index])
+                );
+            }
+            region.heightmap = def.script->generateHeightmap(
+                area_offset(originX, originZ, bpd),
+                region_size(originX, originZ, size, bpd),
+                bpd,
+                inputs
+            );
+            region.heightmap->clamp();
+        }
+        auto areaPos = area_offset(chunkX, chunkZ, bpd) -
+                       area_offset(originX, originZ, bpd);
+        prototype.heightmap = region.heightmap->sampleArea(
+            areaPos.x, areaPos.y,
+            areaSize.x, areaSize.y,
+            CHUNK_W + bpd, CHUNK_D + bpd,
+            CHUNK_W, CHUNK_D,
+            def.heightsInterpolation
+        );
+        if (++region.used == static_cast<uint>(size * size)) {
+            regions.erase({floordiv(chunkX, size), floordiv(chunkZ, size)});
+        }
+    } else {
+        auto heightmap = def.script->generateHeightmap(
+            area_offset(chunkX, chunkZ, bpd),
+            areaSize,
+            bpd,
+            prototype.heightmapInputs
+        );
+        heightmap->clamp();
+        prototype.heightmap = heightmap->sampleArea(
+            0, 0,
+            heightmap->getWidth(), heightmap->getHeight(),
+            CHUNK_W + bpd, CHUNK_D + bpd,
+            CHUNK_W, CHUNK_D,
+            def.heightsInterpolation
+        );
+    }
+    prototype.heightmapInputs.clear();
     prototype.level = ChunkPrototypeLevel::HEIGHTMAP;
 }
 
 void WorldGenerator::update(int centerX, int centerY, int loadDistance) {
+    center = {centerX, centerY};
     surroundMap.setCenter(centerX, centerY);
     surroundMap.resize(loadDistance);
     surroundMap.setCenter(centerX, centerY);
@@ -411,7 +545,7 @@ void WorldGenerator::generatePlants(
     int chunkX,
     int chunkZ,
     const Biome** biomes
-) {
+) const {
     const auto& indices = content.getIndices()->blocks;
     util::PseudoRandom plantsRand;
     plantsRand.setSeed(chunkX, chunkZ);
@@ -453,7 +587,7 @@ void WorldGenerator::generateLand(
     int chunkX,
     int chunkZ,
     const Biome** biomes
-) {
+) const {
     uint seaLevel = def.seaLevel;
     for (uint z = 0; z < CHUNK_D; z++) {
         for (uint x = 0; x < CHUNK_W; x++) {
@@ -472,8 +606,17 @@ void WorldGenerator::generateLand(
 }
 
 void WorldGenerator::generate(voxel* voxels, int chunkX, int chunkZ) {
+    prepare(chunkX, chunkZ);
+    generateVoxels(voxels, chunkX, chunkZ);
+}
+
+void WorldGenerator::prepare(int chunkX, int chunkZ) {
     surroundMap.completeAt(chunkX, chunkZ);
+}
 
+void WorldGenerator::generateVoxels(
+    voxel* voxels, int chunkX, int chunkZ
+) const {
     const auto& prototype = requirePrototype(chunkX, chunkZ);
     const auto values = prototype.heightmap->getValues();
 
@@ -515,7 +658,7 @@ void WorldGenerator::generate(voxel* voxels, int chunkX, int chunkZ) {
 
 void WorldGenerator::generatePlacements(
     const ChunkPrototype& prototype, voxel* voxels, int chunkX, int chunkZ
-) {
+) const {
     auto placements = prototype.placements;
     std::stable_sort(
         placements.begin(),
@@ -540,7 +683,7 @@ void WorldGenerator::generateStructure(
     const StructurePlacement& placement,
     voxel* voxels, 
     int chunkX, int chunkZ
-) {
+) const {
     if (placement.structure < 0 || placement.structure >= def.structures.size()) {
         logger.error() << "invalid structure index " << placement.structure;
         return;
@@ -581,7 +724,7 @@ void WorldGenerator::generateLine(
     const LinePlacement& line,
     voxel* voxels, 
     int chunkX, int chunkZ
-) {
+) const {
     const auto& indices = content.getIndices()->blocks;
 
     int cgx = chunkX * CHUNK_W;
@@ -642,7 +785,7 @@ void WorldGenerator::generateBlock(
     const BlockPlacement& placement,
     voxel* voxels,
     int chunkX, int chunkZ
-) {
+) const {
     const auto& indices = content.getIndices()->blocks;
     const auto& def = indices.require(placement.block);
 
@@ -37,6 +37,17 @@ struct ChunkPrototype {
     std::vector<std::shared_ptr<Heightmap>> heightmapInputs {};
 };
 
+/// @brief Script maps generated for a square of chunks at once
+/// (see GeneratorDef::regionSize)
+struct GeneratorRegion {
+    /// @brief Biome parameter maps
+    std::vector<std::shared_ptr<Heightmap>> parameters;
+    /// @brief Region heightmap (generated with the first chunk heightmap)
+    std::shared_ptr<Heightmap> heightmap;
+    /// @brief Number of chunks heightmaps taken from the region
+    uint used = 0;
+};
+
 struct WorldGenDebugInfo {
     int areaOffsetX;
     int areaOffsetY;
@@ -57,6 +68,10 @@ class WorldGenerator {
     std::unordered_map<glm::ivec2, std::unique_ptr<ChunkPrototype>> prototypes;
     /// @brief Chunk prototypes loading surround map
     SurroundMap surroundMap;
+    /// @brief Generated regions storage (used if region size > 1)
+    std::unordered_map<glm::ivec2, std::unique_ptr<GeneratorRegion>> regions;
+    /// @brief Last loading center chunk position
+    glm::ivec2 center {};
 
     /// @brief Generate chunk prototype (see ChunkPrototype)
     /// @param x chunk position X divided by CHUNK_W
@@ -64,6 +79,14 @@ class WorldGenerator {
     std::unique_ptr<ChunkPrototype> generatePrototype(int x, int z);
 
     ChunkPrototype& requirePrototype(int x, int z);
+    const ChunkPrototype& requirePrototype(int x, int z) const;
+
+    /// @brief Get or generate region containing the chunk
+    GeneratorRegion& requireRegion(int x, int z);
+
+    /// @brief Check if heightmaps can be generated for whole region
+    /// with the same result
+    bool isRegionHeightmapSupported() const;
 
     void generateStructuresWide(ChunkPrototype& prototype, int x, int z);
 
@@ -83,25 +106,25 @@ class WorldGenerator {
 
     void generatePlacements(
         const ChunkPrototype& prototype, voxel* voxels, int x, int z
-    );
+    ) const;
     void generateLine(
         const ChunkPrototype& prototype, 
         const LinePlacement& placement,
         voxel* voxels, 
         int x, int z
-    );
+    ) const;
     void generateBlock(
         const ChunkPrototype& prototype,
         const BlockPlacement& placement,
         voxel* voxels,
         int x, int z
-    );
+    ) const;
     void generateStructure(
         const ChunkPrototype& prototype, 
         const StructurePlacement& placement,
         voxel* voxels, 
         int x, int z
-    );
+    ) const;
     void generatePlants(
         const ChunkPrototype& prototype,
         float* values,
@@ -109,7 +132,7 @@ class WorldGenerator {
         int x,
         int z,
         const Biome** biomes
-    );
+    ) const;
     void generateLand(
         const ChunkPrototype& prototype,
         float* values,
@@ -117,7 +140,7 @@ class WorldGenerator {
         int x,
         int z,
         const Biome** biomes
-    );
+    ) const;
 
     void placeStructures(
         const std::vector<Placement>& placements,
@@ -140,6 +163,20 @@ public:
     /// @param z chunk position Y divided by CHUNK_D
     void generate(voxel* voxels, int x, int z);
 
+    /// @brief Complete chunk prototype (runs generator script).
+    /// Chunk must be inside of the area set with update
+    /// @param x chunk position X divided by CHUNK_W
+    /// @param z chunk position Y divided by CHUNK_D
+    void prepare(int x, int z);
+
+    /// @brief Generate chunk voxels from the prototype completed with
+    /// prepare. May be called from multiple threads until the next
+    /// update/prepare call
+    /// @param voxels destination chunk voxels buffer
+    /// @param x chunk position X divided by CHUNK_W
+    /// @param z chunk position Y divided by CHUNK_D
+    void generateVoxels(voxel* voxels, int x, int z) const;
+
     WorldGenDebugInfo createDebugInfo() const;
 
     uint64_t getSeed() const;
@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include "assets/assets_cache.hpp"
+#include "coders/byte_utils.hpp"
+#include "graphics/commons/Model.hpp"
+#include "graphics/core/Atlas.hpp"
+#include "graphics/core/ImageData.hpp"
+
+static std::unique_ptr<ImageData> make_image(uint width, uint height) {
+    auto image = std::make_unique<ImageData>(
+        ImageFormat::RGBA8888, width, height
+    );
+    for (uint i = 0; i < width * height * 4; i++) {
+        image->getData()[i] = static_cast<ubyte>(i * 7);
+    }
+    return image;
+}
+
+TEST(assets_cache, PackUnpack) {
+    std::vector<ubyte> payload {1, 2, 3, 4, 5};
+    auto entry = assets_cache::pack(42, payload);
+    EXPECT_EQ(assets_cache::unpack(42, entry), payload);
+    EXPECT_TRUE(assets_cache::unpack(43, entry).empty());
+
+    entry[entry.size() - 1] ^= 0xFF;
+    EXPECT_TRUE(assets_cache::unpack(42, entry).empty());
+    entry.resize(entry.size() - 1);
+    EXPECT_TRUE(assets_cache::unpack(42, entry).empty());
+}
+
+TEST(assets_cache, Key) {
+    assets_cache::Key a("atlas");
+    assets_cache::Key b("atlas");
+    assets_cache::Key c("font");
+    EXPECT_EQ(a.get(), b.get());
+    EXPECT_NE(a.get(), c.get());
+    a.update("blocks/grass.png");
+    b.update("blocks/grass");
+    EXPECT_NE(a.get(), b.get());
+}
+
+TEST(assets_cache, Atlas) {
+    std::unordered_map<std::string, UVRegion> regions {
+        {"stone", UVRegion(0.0f, 0.0f, 0.5f, 0.5f)},
+        {"grass", UVRegion(0.5f, 0.0f, 1.0f, 0.5f)},
+    };
+    Atlas atlas(make_image(13, 7), regions, false);
+
+    auto decoded = assets_cache::decode_atlas(assets_cache::encode_atlas(atlas));
+    EXPECT_EQ(decoded->getNames(), atlas.getNames());
+    EXPECT_EQ(decoded->get("grass").u1, 0.5f);
+    EXPECT_EQ(decoded->get("stone").v2, 0.5f);
+
+    auto image = decoded->getImage();
+    ASSERT_EQ(image->getWidth(), 13);
+    ASSERT_EQ(image->getHeight(), 7);
+    EXPECT_EQ(
+        std::memcmp(image->getData(), atlas.getImage()->getData(), 13 * 7 * 4),
+        0
+    );
+    auto payload = assets_cache::encode_atlas(atlas);
+    payload.resize(payload.size() - 1);
+    EXPECT_THROW(assets_cache::decode_atlas(payload), std::runtime_error);
+}
+
+TEST(assets_cache, Images) {
+    std::vector<std::unique_ptr<ImageData>> images;
+    images.push_back(make_image(4, 4));
+    images.push_back(nullptr);
+    images.push_back(make_image(3, 1));
+
+    auto decoded =
+        assets_cache::decode_images(assets_cache::encode_images(images));
+    ASSERT_EQ(decoded.size(), 3);
+    EXPECT_EQ(decoded[1], nullptr);
+    ASSERT_NE(decoded[2], nullptr);
+    EXPECT_EQ(decoded[2]->getWidth(), 3);
+    EXPECT_EQ(std::memcmp(decoded[0]->getData(), images[0]->getData(), 64), 0);
+}
+
+TEST(assets_cache, Model) {
+    model::Model model;
+    model.addMesh("blocks:stone").addBox({0, 0, 0}, {1, 1, 1});
+    model.addMesh("blocks:grass", false).addBox({1, 0, 0}, {0.5f, 1, 1});
+
+    auto decoded =
+        assets_cache::decode_model(assets_cache::encode_model(model));
+    ASSERT_EQ(decoded->meshes.size(), 2);
+    for (size_t i = 0; i < model.meshes.size(); i++) {
+        const auto& src = model.meshes[i];
+        const auto& dst = decoded->meshes[i];
+        EXPECT_EQ(src.texture, dst.texture);
+        EXPECT_EQ(src.shading, dst.shading);
+        ASSERT_EQ(src.vertices.size(), dst.vertices.size());
+        for (size_t j = 0; j < src.vertices.size(); j++) {
+            EXPECT_EQ(src.vertices[j].coord, dst.vertices[j].coord);
+            EXPECT_EQ(src.vertices[j].uv, dst.vertices[j].uv);
+        }
+    }
+}
+
+TEST(assets_cache, CorruptModel) {
+    ByteBuilder builder;
+    builder.putInt32(1);
+    builder.put(std::string("blocks:stone"));
+    builder.put(1);
+    // vertices count is not limited by the payload size
+    builder.putInt32(-1);
+    for (int i = 0; i < 32; i++) {
+        builder.put(0);
+    }
+    EXPECT_THROW(
+        assets_cache::decode_model(builder.build()), std::runtime_error
+    );
+}
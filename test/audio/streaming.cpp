@@ -0,0 +1,292 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "audio/AudioWorker.hpp"
+#include "audio/BufferedPCMStream.hpp"
+#include "audio/PCMCache.hpp"
+#include "coders/byte_utils.hpp"
+#include "io/devices/StdfsDevice.hpp"
+#include "io/io.hpp"
+#include "settings.hpp"
+
+using namespace audio;
+
+namespace fs = std::filesystem;
+
+/// @brief Seekable 8 bit mono stream of bytes (index % 251)
+class CounterStream : public PCMStream {
+    size_t totalSamples;
+    size_t position = 0;
+    bool open = true;
+public:
+    CounterStream(size_t totalSamples) : totalSamples(totalSamples) {
+    }
+
+    size_t read(char* buffer, size_t bufferSize) override {
+        // decoders return data in small pieces
+        size_t count = std::min({bufferSize, totalSamples - position, size_t(1000)});
+        for (size_t i = 0; i < count; i++) {
+            buffer[i] = static_cast<char>((position + i) % 251);
+        }
+        position += count;
+        return count;
+    }
+
+    void close() override {
+        open = false;
+    }
+
+    bool isOpen() const override {
+        return open;
+    }
+
+    size_t getTotalSamples() const override {
+        return totalSamples;
+    }
+
+    duration_t getTotalDuration() const override {
+        return totalSamples / 8000.0;
+    }
+
+    uint getChannels() const override {
+        return 1;
+    }
+
+    uint getSampleRate() const override {
+        return 8000;
+    }
+
+    uint getBitsPerSample() const override {
+        return 8;
+    }
+
+    bool isSeekable() const override {
+        return true;
+    }
+
+    void seek(size_t position) override {
+        this->position = std::min(position, totalSamples);
+    }
+};
+
+static void expect_counter_data(
+    const std::vector<char>& data, size_t size, size_t start
+) {
+    ASSERT_GE(data.size(), size);
+    for (size_t i = 0; i < size; i++) {
+        ASSERT_EQ(data[i], static_cast<char>((start + i) % 251)) << i;
+    }
+}
+
+/// @brief Read until bufferSize bytes received or the stream end
+/// (buffered stream reads do not wait for the producer)
+static size_t read_buffered(
+    BufferedPCMStream& stream, char* buffer, size_t bufferSize, bool loop
+) {
+    size_t total = 0;
+    while (total < bufferSize) {
+        size_t read =
+            stream.readFully(buffer + total, bufferSize - total, loop);
+        total += read;
+        if (read == 0 && !stream.isBuffering()) {
+            break;
+        }
+        std::this_thread::yield();
+    }
+    return total;
+}
+
+TEST(BufferedPCMStream, Read) {
+    AudioWorker worker;
+    auto stream = std::make_shared<BufferedPCMStream>(
+        std::make_unique<CounterStream>(100000), 4096
+    );
+    worker.add(stream);
+
+    std::vector<char> data(30000);
+    EXPECT_EQ(read_buffered(*stream, data.data(), 30000, false), 30000);
+    expect_counter_data(data, 30000, 0);
+
+    stream->seek(90000);
+    EXPECT_EQ(read_buffered(*stream, data.data(), 30000, false), 10000);
+    expect_counter_data(data, 10000, 90000);
+    EXPECT_EQ(read_buffered(*stream, data.data(), 30000, false), 0);
+    EXPECT_FALSE(stream->isBuffering());
+}
+
+TEST(BufferedPCMStream, Underrun) {
+    // no worker: data is decoded by fill() calls only
+    BufferedPCMStream stream(std::make_unique<CounterStream>(3000), 4096);
+
+    std::vector<char> data(2000);
+    EXPECT_EQ(stream.readFully(data.data(), 2000, false), 0);
+    EXPECT_TRUE(stream.isBuffering());
+    EXPECT_EQ(stream.getUnderruns(), 1);
+
+    EXPECT_EQ(stream.fill(), 1000);
+    EXPECT_EQ(stream.readFully(data.data(), 2000, false), 1000);
+    expect_counter_data(data, 1000, 0);
+    EXPECT_EQ(stream.getUnderruns(), 2);
+
+    while (stream.fill()) {
+    }
+    EXPECT_EQ(stream.readFully(data.data(), 2000, false), 2000);
+    expect_counter_data(data, 2000, 1000);
+    // the stream end is not an underrun
+    EXPECT_EQ(stream.readFully(data.data(), 2000, false), 0);
+    EXPECT_FALSE(stream.isBuffering());
+    EXPECT_EQ(stream.getUnderruns(), 2);
+}
+
+TEST(BufferedPCMStream, Loop) {
+    AudioWorker worker;
+    auto stream = std::make_shared<BufferedPCMStream>(
+        std::make_unique<CounterStream>(5000), 8192
+    );
+    worker.add(stream);
+    // whole source is buffered before the loop mode is enabled
+    while (stream->available() < 5000) {
+        std::this_thread::yield();
+    }
+    std::vector<char> data(12000);
+    EXPECT_EQ(read_buffered(*stream, data.data(), 12000, true), 12000);
+    for (size_t i = 0; i < 12000; i++) {
+        ASSERT_EQ(data[i], static_cast<char>((i % 5000) % 251)) << i;
+    }
+}
+
+TEST(AudioWorker, ReleasesStreams) {
+    AudioWorker worker;
+    auto stream = std::make_shared<BufferedPCMStream>(
+        std::make_unique<CounterStream>(100000), 4096
+    );
+    worker.add(stream);
+    worker.add(std::make_shared<BufferedPCMStream>(
+        std::make_unique<CounterStream>(100000), 4096
+    ));
+    stream->close();
+    while (worker.count() > 0) {
+        std::this_thread::yield();
+    }
+}
+
+static std::shared_ptr<PCM> create_pcm(size_t size) {
+    return std::make_shared<PCM>(std::vector<char>(size), size, 1, 8, 8000, true);
+}
+
+TEST(PCMCache, Eviction) {
+    PCMCache cache(1000);
+    int loads = 0;
+    auto loader = [&loads]() {
+        loads++;
+        return create_pcm(400);
+    };
+    auto a = cache.get("a", loader);
+    cache.get("b", loader);
+    EXPECT_EQ(cache.get("a", loader), a);
+    EXPECT_EQ(loads, 2);
+
+    // 'b' is the least recently used
+    cache.get("c", loader);
+    EXPECT_EQ(cache.find("b"), nullptr);
+    EXPECT_NE(cache.find("a"), nullptr);
+    EXPECT_NE(cache.find("c"), nullptr);
+
+    // too large to be cached
+    cache.get("d", []() { return create_pcm(2000); });
+    EXPECT_EQ(cache.find("d"), nullptr);
+
+    auto stats = cache.getStats();
+    EXPECT_EQ(stats.hits, 1);
+    EXPECT_EQ(stats.misses, 4);
+    EXPECT_EQ(stats.evictions, 1);
+    EXPECT_EQ(stats.bytes, 800);
+}
+
+TEST(PCMCache, ConcurrentLoad) {
+    PCMCache cache(1000);
+    std::atomic<int> loads = 0;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; i++) {
+        threads.emplace_back([&]() {
+            cache.get("a", [&loads]() {
+                loads++;
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                return create_pcm(100);
+            });
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(loads, 1);
+}
+
+static void write_wav(const io::path& file, size_t samples) {
+    ByteBuilder builder;
+    builder.put(reinterpret_cast<const ubyte*>("RIFF"), 4);
+    builder.putInt32(36 + samples);
+    builder.put(reinterpret_cast<const ubyte*>("WAVEfmt "), 8);
+    builder.putInt32(16);
+    builder.putInt16(1); // PCM format
+    builder.putInt16(1); // channels
+    builder.putInt32(8000); // sample rate
+    builder.putInt32(8000); // byte rate
+    builder.putInt16(1); // block align
+    builder.putInt16(8); // bits per sample
+    builder.put(reinterpret_cast<const ubyte*>("data"), 4);
+    builder.putInt32(samples);
+    for (size_t i = 0; i < samples; i++) {
+        builder.put(i % 251);
+    }
+    io::write_bytes(file, builder.data(), builder.size());
+}
+
+TEST(NoAudio, DecodingStream) {
+    auto folder = fs::temp_directory_path() / "vctest_audio";
+    fs::create_directories(folder);
+    io::set_device("tmp", std::make_shared<io::StdfsDevice>(folder));
+    write_wav("tmp:test.wav", 40000);
+
+    AudioSettings settings;
+    audio::initialize(false, false, settings, true);
+    auto id = audio::play_stream(
+        "tmp:test.wav", {}, true, 1.0f, 1.0f, false, audio::get_channel_index("music")
+    );
+    ASSERT_NE(id, 0);
+    auto stream = audio::get_associated_stream(id);
+    ASSERT_NE(stream, nullptr);
+    stream->setStopOnEnd(true);
+    // reads do not wait for the background decoding
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    audio::update(1.0);
+    EXPECT_DOUBLE_EQ(stream->getTime(), 1.0);
+    EXPECT_EQ(audio::count_streams(), 1);
+    for (int i = 0; i < 5; i++) {
+        audio::update(1.0);
+    }
+    EXPECT_EQ(audio::count_streams(), 0);
+    audio::close();
+}
+
+TEST(NoAudio, ChangedSoundReload) {
+    auto folder = fs::temp_directory_path() / "vctest_audio";
+    fs::create_directories(folder);
+    io::set_device("tmp", std::make_shared<io::StdfsDevice>(folder));
+    write_wav("tmp:reload.wav", 8000);
+
+    AudioSettings settings;
+    audio::initialize(false, false, settings, true);
+    auto sound = audio::load_sound("tmp:reload.wav", true);
+    EXPECT_EQ(sound->getPCM()->totalSamples, 8000);
+    // cached PCM is shared
+    EXPECT_EQ(audio::load_sound("tmp:reload.wav", true)->getPCM(), sound->getPCM());
+
+    // file changed since caching
+    write_wav("tmp:reload.wav", 16000);
+    auto reloaded = audio::load_sound("tmp:reload.wav", true);
+    EXPECT_EQ(reloaded->getPCM()->totalSamples, 16000);
+    audio::close();
+}
@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+
+#include "audio/NoAudio.hpp"
+#include "audio/Voice.hpp"
+#include "settings.hpp"
+
+using namespace audio;
+
+class VoicesTest : public ::testing::Test {
+protected:
+    AudioSettings settings;
+    NoAudio* backend;
+    std::unique_ptr<Sound> sound;
+    int channel;
+
+    void SetUp() override {
+        auto noaudio = std::make_unique<NoAudio>(true, 2);
+        backend = noaudio.get();
+        audio::initialize(std::move(noaudio), false, settings);
+        // 10 seconds of silence
+        auto pcm = std::make_shared<PCM>(
+            std::vector<char>(80000), 80000, 1, 8, 8000, false
+        );
+        sound = audio::create_sound(pcm, false);
+        channel = audio::get_channel_index("regular");
+        audio::set_listener({}, {}, {0, 0, -1}, {0, 1, 0});
+    }
+
+    void TearDown() override {
+        sound = nullptr;
+        audio::close();
+    }
+
+    speakerid_t play(glm::vec3 position, int priority = PRIORITY_NORMAL) {
+        return audio::play(
+            sound.get(), position, false, 1.0f, 1.0f, false, priority, channel
+        );
+    }
+
+    Voice* get_voice(speakerid_t id) {
+        return dynamic_cast<Voice*>(audio::get_speaker(id));
+    }
+};
+
+TEST_F(VoicesTest, DistantSoundIsVirtual) {
+    auto id = play({1000, 0, 0});
+    ASSERT_NE(id, 0);
+    EXPECT_TRUE(get_voice(id)->isVirtual());
+    EXPECT_EQ(backend->getSpeakersCount(), 0);
+
+    audio::update(2.0);
+    EXPECT_DOUBLE_EQ(get_voice(id)->getTime(), 2.0);
+
+    // listener came closer: playback is resumed at the offset
+    audio::set_listener({999, 0, 0}, {}, {0, 0, -1}, {0, 1, 0});
+    audio::update(1.0);
+    auto voice = get_voice(id);
+    EXPECT_FALSE(voice->isVirtual());
+    EXPECT_DOUBLE_EQ(voice->getTime(), 3.0);
+
+    // virtual voice stops at the end of the sound
+    audio::set_listener({}, {}, {0, 0, -1}, {0, 1, 0});
+    audio::update(1.0);
+    EXPECT_TRUE(voice->isVirtual());
+    for (int i = 0; i < 7; i++) {
+        audio::update(1.0);
+    }
+    EXPECT_EQ(audio::get_speaker(id), nullptr);
+}
+
+TEST_F(VoicesTest, PriorityStealing) {
+    auto a = play({1, 0, 0}, PRIORITY_LOW);
+    auto b = play({5, 0, 0}, PRIORITY_LOW);
+    EXPECT_EQ(backend->getSpeakersCount(), 2);
+
+    // louder sound takes speaker from the quietest one
+    auto c = play({0, 2, 0}, PRIORITY_LOW);
+    EXPECT_FALSE(get_voice(a)->isVirtual());
+    EXPECT_TRUE(get_voice(b)->isVirtual());
+    EXPECT_FALSE(get_voice(c)->isVirtual());
+
+    // more important sound takes speaker regardless of the distance
+    auto d = play({20, 0, 0}, PRIORITY_HIGH);
+    EXPECT_FALSE(get_voice(d)->isVirtual());
+    EXPECT_TRUE(get_voice(c)->isVirtual());
+    EXPECT_EQ(audio::count_virtual_speakers(), 2);
+
+    // speaker is given back when released
+    audio::get_speaker(d)->stop();
+    audio::update(0.5);
+    EXPECT_FALSE(get_voice(c)->isVirtual());
+    EXPECT_EQ(audio::count_virtual_speakers(), 1);
+}
+
+TEST_F(VoicesTest, SameFrameCoalescing) {
+    auto a = play({10, 0, 0});
+    EXPECT_EQ(play({10.5f, 0, 0}), a);
+    EXPECT_NE(play({20, 0, 0}), a);
+    EXPECT_EQ(audio::count_speakers(), 2);
+
+    audio::update(0.1);
+    EXPECT_NE(play({10, 0, 0}), a);
+}
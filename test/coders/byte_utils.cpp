@@ -18,3 +18,28 @@ TEST(byte_utils, BytesBuildAndRead) {
     EXPECT_EQ(reader.getInt32(), 123456789);
     EXPECT_EQ(reader.getInt64(), 98765432123456789LL);
 }
+
+TEST(byte_utils, VarInts) {
+    const int64_t values[] {
+        0, 1, -1, 63, -64, 64, 127, 128, 300, -300, 65535,
+        INT32_MIN, INT32_MAX, INT64_MIN, INT64_MAX
+    };
+    ByteBuilder builder;
+    for (auto value : values) {
+        builder.putVarInt(value);
+        builder.putVarUInt(static_cast<uint64_t>(value));
+    }
+    auto data = builder.build();
+
+    ByteReader reader(data.data(), data.size());
+    for (auto value : values) {
+        EXPECT_EQ(reader.getVarInt(), value);
+        EXPECT_EQ(reader.getVarUInt(), static_cast<uint64_t>(value));
+    }
+    EXPECT_FALSE(reader.hasNext());
+
+    ByteBuilder small;
+    small.putVarUInt(127);
+    small.putVarInt(-64);
+    EXPECT_EQ(small.size(), 2);
+}
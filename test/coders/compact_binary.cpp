@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+
+#include <iostream>
+
+#include "coders/binary_json.hpp"
+#include "coders/compact_binary.hpp"
+#include "util/Buffer.hpp"
+
+static dv::value make_entity(int i) {
+    auto entity = dv::object();
+    entity["def"] = "base:drop";
+    entity["uid"] = 1000 + i;
+    auto& transform = entity.object("transform");
+    transform["pos"] = dv::list({i * 0.5, 64.25, -i * 0.125});
+    auto& body = entity.object("rigidbody");
+    body["vel"] = dv::list({0.0, -9.8, 0.0});
+    body["type"] = "dynamic";
+    body["crouch"] = i % 2 == 0;
+    auto& comps = entity.object("comps");
+    auto& drop = comps.object("base:drop");
+    drop["item"] = "base:stone.item";
+    drop["count"] = i;
+    return entity;
+}
+
+TEST(CompactBinary, EncodeDecode) {
+    dv::objects::Bytes srcBytes(100);
+    for (int i = 0; i < srcBytes.size(); i++) {
+        srcBytes[i] = rand();
+    }
+    auto root = dv::object();
+    auto& list = root.list("data");
+    for (int i = 0; i < 50; i++) {
+        list.add(make_entity(i));
+    }
+    root["bytes"] = srcBytes;
+    root["big"] = INT64_MIN;
+    root["pi"] = 3.141592653589793;
+
+    auto bytes = compact::to_binary(root);
+    EXPECT_TRUE(compact::is_compact(bytes.data(), bytes.size()));
+    auto decoded = compact::from_binary(bytes.data(), bytes.size());
+
+    EXPECT_EQ(decoded["big"].asInteger(), INT64_MIN);
+    EXPECT_EQ(decoded["pi"].asNumber(), 3.141592653589793);
+    const auto& bytesValue = decoded["bytes"].asBytes();
+    ASSERT_EQ(bytesValue.size(), srcBytes.size());
+    for (int i = 0; i < srcBytes.size(); i++) {
+        EXPECT_EQ(bytesValue[i], srcBytes[i]);
+    }
+    const auto& entities = decoded["data"];
+    ASSERT_EQ(entities.size(), 50);
+    for (int i = 0; i < 50; i++) {
+        const auto& entity = entities[i];
+        EXPECT_EQ(entity["def"].asString(), "base:drop");
+        EXPECT_EQ(entity["uid"].asInteger(), 1000 + i);
+        EXPECT_TRUE(entity["uid"].isInteger());
+        const auto& pos = entity["transform"]["pos"];
+        ASSERT_EQ(pos.size(), 3);
+        EXPECT_TRUE(pos[0].isNumber());
+        EXPECT_EQ(pos[0].asNumber(), i * 0.5);
+        EXPECT_EQ(pos[2].asNumber(), -i * 0.125);
+        EXPECT_EQ(entity["rigidbody"]["vel"][1].asNumber(), -9.8);
+        EXPECT_EQ(entity["rigidbody"]["crouch"].asBoolean(), i % 2 == 0);
+        const auto& drop = entity["comps"]["base:drop"];
+        EXPECT_EQ(drop["count"].asInteger(), i);
+    }
+
+    auto bjson = json::to_binary(root, true);
+    std::cout << "compact: " << bytes.size() << " bytes, bjson: "
+              << bjson.size() << " bytes" << std::endl;
+    EXPECT_LT(bytes.size(), bjson.size());
+}
+
+TEST(CompactBinary, Null) {
+    auto bytes = compact::to_binary(dv::list({nullptr, true}));
+    auto list = compact::from_binary(bytes.data(), bytes.size());
+    ASSERT_EQ(list.size(), 2);
+    EXPECT_TRUE(list[0] == nullptr);
+    EXPECT_TRUE(list[1].asBoolean());
+}
+
+TEST(CompactBinary, InvalidData) {
+    auto bjson = json::to_binary(dv::object(), true);
+    EXPECT_FALSE(compact::is_compact(bjson.data(), bjson.size()));
+    EXPECT_THROW(
+        compact::from_binary(bjson.data(), bjson.size()), std::runtime_error
+    );
+
+    auto bytes = compact::to_binary(dv::list({1, 2, 3}));
+    bytes[sizeof(compact::SIGNATURE)] = compact::VERSION + 1;
+    EXPECT_THROW(
+        compact::from_binary(bytes.data(), bytes.size()), std::runtime_error
+    );
+}
@@ -0,0 +1,232 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <iostream>
+
+#include "coders/commons.hpp"
+#include "coders/json.hpp"
+#include "coders/json_reader.hpp"
+#include "util/timeutil.hpp"
+
+static dv::value make_document(int count) {
+    auto root = dv::object();
+    auto& list = root.list("blocks");
+    for (int i = 0; i < count; i++) {
+        auto& block = list.object();
+        block["name"] = "base:block_" + std::to_string(i);
+        block["hardness"] = i * 0.25;
+        block["light"] = i % 16;
+        block["solid"] = i % 3 != 0;
+        block["texture"] = "blocks/texture \"" + std::to_string(i) + "\"";
+        auto& saved = block.object("saved");
+        saved["counter"] = i;
+        saved["tags"] =
+            dv::list({dv::value("a"), dv::value("b"), dv::value("c")});
+    }
+    root["version"] = 3;
+    return root;
+}
+
+static void expect_tokens(json::Reader& reader) {
+    ASSERT_EQ(reader.next(), json::token::object_begin);
+    int entries = 0;
+    while (reader.next() == json::token::key) {
+        std::string key(reader.getKey());
+        reader.next();
+        if (key == "version") {
+            EXPECT_EQ(reader.getInteger(), 3);
+        } else if (key == "blocks") {
+            ASSERT_EQ(reader.getToken(), json::token::list_begin);
+            int index = 0;
+            while (reader.next() == json::token::object_begin) {
+                while (reader.next() == json::token::key) {
+                    auto name = reader.getKey();
+                    if (name == "name") {
+                        reader.next();
+                        EXPECT_EQ(
+                            reader.getString(),
+                            "base:block_" + std::to_string(index)
+                        );
+                    } else if (name == "hardness") {
+                        reader.next();
+                        EXPECT_EQ(reader.getNumber(), index * 0.25);
+                    } else if (name == "solid") {
+                        reader.next();
+                        EXPECT_EQ(reader.getBoolean(), index % 3 != 0);
+                    } else if (name == "saved") {
+                        reader.next();
+                        auto saved = reader.read();
+                        EXPECT_EQ(saved["counter"].asInteger(), index);
+                        EXPECT_EQ(saved["tags"][2].asString(), "c");
+                    } else {
+                        reader.skip();
+                    }
+                }
+                index++;
+            }
+            EXPECT_EQ(index, 10);
+        }
+        entries++;
+    }
+    EXPECT_EQ(entries, 2);
+    EXPECT_EQ(reader.next(), json::token::end);
+}
+
+TEST(JsonReader, Text) {
+    auto text = json::stringify(make_document(10), true);
+    auto reader = json::create_reader("[string]", text);
+    expect_tokens(*reader);
+}
+
+TEST(JsonReader, Binary) {
+    auto document = make_document(10);
+    for (bool compress : {false, true}) {
+        auto bytes = json::to_binary(document, compress);
+        auto reader = json::create_binary_reader(bytes.data(), bytes.size());
+        expect_tokens(*reader);
+    }
+}
+
+TEST(JsonReader, ReadTree) {
+    auto text = "{\"a\": [1, 2.5, 'x', true, null,],\n"
+                "# comment\n\"b\": {\"c\": inf}}";
+    auto reader = json::create_reader("[string]", text);
+    reader->next();
+    auto value = reader->read();
+    EXPECT_EQ(value["a"].size(), 5);
+    EXPECT_EQ(value["a"][1].asNumber(), 2.5);
+    EXPECT_EQ(value["a"][2].asString(), "x");
+    EXPECT_TRUE(value["a"][4] == nullptr);
+    EXPECT_EQ(value["b"]["c"].asNumber(), INFINITY);
+    EXPECT_EQ(reader->next(), json::token::end);
+
+    auto invalid = json::create_reader("[string]", "{\"a\": 1 \"b\": 2}");
+    invalid->next();
+    EXPECT_THROW(invalid->read(), parsing_error);
+}
+
+TEST(JsonReader, ReadDocument) {
+    auto source = make_document(10);
+    auto text = json::stringify(source, false);
+    auto bytes = json::to_binary(source);
+    std::unique_ptr<json::Reader> readers[] {
+        json::create_reader("[string]", text),
+        json::create_binary_reader(bytes.data(), bytes.size())};
+    for (auto& reader : readers) {
+        reader->next();
+        auto document = reader->readDocument();
+        EXPECT_EQ(reader->next(), json::token::end);
+
+        const auto& root = document.root();
+        ASSERT_TRUE(root.isObject());
+        EXPECT_EQ(root["version"].asInteger(), 3);
+        EXPECT_EQ(root.at("missing"), nullptr);
+        EXPECT_THROW(root["missing"], std::out_of_range);
+
+        const auto& blocks = root["blocks"];
+        ASSERT_EQ(blocks.size(), 10);
+        const auto& block = blocks[7];
+        EXPECT_EQ(block["name"].asString(), "base:block_7");
+        EXPECT_EQ(block["texture"].asString(), "blocks/texture \"7\"");
+        EXPECT_EQ(block["hardness"].asNumber(), 7 * 0.25);
+        EXPECT_EQ(block["light"].asInteger(), 7);
+        EXPECT_TRUE(block["solid"].asBoolean());
+        EXPECT_EQ(block["saved"]["tags"][2].asString(), "c");
+        // keys are stored once per document
+        EXPECT_EQ(document.getKeysCount(), 10);
+        EXPECT_EQ(
+            blocks[0].asObject()[0].key.data(),
+            blocks[1].asObject()[0].key.data()
+        );
+
+        auto value = root.toValue();
+        EXPECT_EQ(value["blocks"][7]["name"].asString(), "base:block_7");
+        EXPECT_EQ(value["blocks"][7]["saved"]["counter"].asInteger(), 7);
+    }
+
+    // repeated keys: the last one is kept
+    auto reader = json::create_reader(
+        "[string]", "{\"b\": 1, \"a\": 'short', \"b\": [null, 2]}"
+    );
+    reader->next();
+    auto document = reader->readDocument();
+    const auto& root = document.root();
+    ASSERT_EQ(root.size(), 2);
+    EXPECT_EQ(root.asObject()[0].key, "a");
+    EXPECT_EQ(root["a"].asString(), "short");
+    EXPECT_TRUE(root["b"][0] == nullptr);
+    EXPECT_EQ(root["b"][1].asInteger(), 2);
+    EXPECT_THROW(root["a"].asInteger(), std::runtime_error);
+}
+
+TEST(JsonReader, Throughput) {
+    const int iterations = 20;
+    auto document = make_document(5000);
+    auto text = json::stringify(document, true);
+    auto bytes = json::to_binary(document);
+    double textMB = text.size() * iterations / 1e6;
+    double bytesMB = bytes.size() * iterations / 1e6;
+
+    auto measure = [](auto func) {
+        timeutil::Timer timer;
+        func();
+        return timer.stop() / 1e6;
+    };
+    size_t tokens = 0;
+    auto count_tokens = [&tokens](json::Reader& reader) {
+        while (reader.next() != json::token::end) {
+            tokens++;
+        }
+    };
+    double stringifyTime = measure([&]() {
+        for (int i = 0; i < iterations; i++) {
+            text = json::stringify(document, true);
+        }
+    });
+    double parseTime = measure([&]() {
+        for (int i = 0; i < iterations; i++) {
+            json::parse(text);
+        }
+    });
+    double readTime = measure([&]() {
+        for (int i = 0; i < iterations; i++) {
+            count_tokens(*json::create_reader("[string]", text));
+        }
+    });
+    size_t arenaSize = 0;
+    double documentTime = measure([&]() {
+        for (int i = 0; i < iterations; i++) {
+            auto reader = json::create_reader("[string]", text);
+            reader->next();
+            arenaSize = reader->readDocument().getArenaSize();
+        }
+    });
+    double fromBinaryTime = measure([&]() {
+        for (int i = 0; i < iterations; i++) {
+            json::from_binary(bytes.data(), bytes.size());
+        }
+    });
+    double binaryDocumentTime = measure([&]() {
+        for (int i = 0; i < iterations; i++) {
+            auto reader = json::create_binary_reader(bytes.data(), bytes.size());
+            reader->next();
+            reader->readDocument();
+        }
+    });
+    double readBinaryTime = measure([&]() {
+        for (int i = 0; i < iterations; i++) {
+            count_tokens(
+                *json::create_binary_reader(bytes.data(), bytes.size())
+            );
+        }
+    });
+    EXPECT_GT(tokens, 0);
+    EXPECT_GT(arenaSize, 0);
+    std::cout << "json (MB/s): stringify " << textMB / stringifyTime
+              << ", parse " << textMB / parseTime << ", pull reader "
+              << textMB / readTime << ", document "
+              << textMB / documentTime << std::endl;
+    std::cout << "bjson (MB/s): from_binary " << bytesMB / fromBinaryTime
+              << ", pull reader " << bytesMB / readBinaryTime
+              << ", document " << bytesMB / binaryDocumentTime << std::endl;
+}
@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include "coders/png.hpp"
+#include "graphics/core/ImageData.hpp"
+
+static std::unique_ptr<ImageData> make_image(uint width, uint height) {
+    auto image = std::make_unique<ImageData>(
+        ImageFormat::RGBA8888, width, height
+    );
+    for (uint i = 0; i < width * height * 4; i++) {
+        image->getData()[i] = static_cast<ubyte>(i * 31 + i / 7);
+    }
+    return image;
+}
+
+TEST(png, ReadSize) {
+    auto image = make_image(17, 5);
+    auto bytes = png::encode_image(*image);
+    auto size = png::read_size(bytes.data(), bytes.size());
+    EXPECT_EQ(size.x, 17);
+    EXPECT_EQ(size.y, 5);
+    EXPECT_THROW(png::read_size(bytes.data(), 10), std::runtime_error);
+}
+
+TEST(png, DecodeInPlace) {
+    const uint width = 17;
+    const uint height = 5;
+    auto image = make_image(width, height);
+    auto bytes = png::encode_image(*image);
+    auto decoded = png::load_image(bytes.data(), bytes.size());
+    ASSERT_EQ(decoded->getWidth(), width);
+    ASSERT_EQ(decoded->getHeight(), height);
+
+    // decode into region (3, 2) of a larger raster
+    const uint canvasWidth = 32;
+    ImageData canvas(ImageFormat::RGBA8888, canvasWidth, 16);
+    std::memset(canvas.getData(), 0, canvasWidth * 16 * 4);
+    png::decode_rgba(
+        bytes.data(),
+        bytes.size(),
+        canvas.getData() + (2 * canvasWidth + 3) * 4,
+        canvasWidth * 4,
+        {width, height}
+    );
+    for (uint y = 0; y < height; y++) {
+        EXPECT_EQ(
+            std::memcmp(
+                canvas.getData() + ((y + 2) * canvasWidth + 3) * 4,
+                decoded->getData() + y * width * 4,
+                width * 4
+            ),
+            0
+        );
+    }
+    EXPECT_EQ(canvas.getData()[(2 * canvasWidth + 2) * 4 + 3], 0);
+    EXPECT_EQ(canvas.getData()[(2 * canvasWidth + 3 + width) * 4 + 3], 0);
+
+    EXPECT_THROW(
+        png::decode_rgba(
+            bytes.data(), bytes.size(), canvas.getData(), 0, {width, 4}
+        ),
+        std::runtime_error
+    );
+}
@@ -1,7 +1,12 @@
 #include <gtest/gtest.h>
 
+#include <iostream>
+#include <vector>
+
 #include "typedefs.hpp"
 #include "coders/rle.hpp"
+#include "util/timeutil.hpp"
+#include "voxels/Chunk.hpp"
 
 static void test_encode_decode(
     size_t(*encodefunc)(const ubyte*, size_t, ubyte*),
@@ -48,3 +53,152 @@ TEST(ExtRLE16, EncodeDecode) {
     test_encode_decode(extrle::encode16, extrle::decode16, 13);
     test_encode_decode(extrle::encode16, extrle::decode16, 90123);
 }
+
+/// @brief Byte-at-a-time extRLE16 encoder used as the output reference
+static size_t encode16_reference(const ubyte* src8, size_t srclen, ubyte* dst) {
+    auto src = reinterpret_cast<const uint16_t*>(src8);
+    size_t offset = 0;
+    uint counter = 0;
+    uint16_t c = src[0];
+    auto put = [&]() {
+        if (counter >= 0x40) {
+            dst[offset++] = 0x80 | ((c > 255) << 6) | (counter & 0x3F);
+            dst[offset++] = counter >> 6;
+        } else {
+            dst[offset++] = counter | ((c > 255) << 6);
+        }
+        if (c > 255) {
+            dst[offset++] = c & 0xFF;
+            dst[offset++] = c >> 8;
+        } else {
+            dst[offset++] = c;
+        }
+    };
+    for (size_t i = 1; i < srclen / 2; i++) {
+        uint16_t cnext = src[i];
+        if (cnext != c || counter == extrle::max_sequence16) {
+            put();
+            c = cnext;
+            counter = 0;
+        } else {
+            counter++;
+        }
+    }
+    put();
+    return offset;
+}
+
+/// @brief Chunk-like data: long runs of a few values
+static std::vector<uint16_t> generate_runs(size_t count, int maxRun) {
+    std::vector<uint16_t> data(count);
+    for (size_t i = 0; i < count;) {
+        uint16_t value = rand() % 4 == 0 ? rand() % 0x8000 : rand() % 8;
+        size_t run = 1 + rand() % maxRun;
+        for (size_t j = 0; j < run && i < count; j++) {
+            data[i++] = value;
+        }
+    }
+    return data;
+}
+
+TEST(ExtRLE16, SameAsReference) {
+    for (int maxRun : {1, 3, 17, 100, 0x4000, 0x10000}) {
+        auto data = generate_runs(100'000, maxRun);
+        auto src = reinterpret_cast<const ubyte*>(data.data());
+        size_t srclen = data.size() * 2;
+
+        std::vector<ubyte> expected(srclen * 2);
+        std::vector<ubyte> actual(srclen * 2);
+        size_t expectedSize = encode16_reference(src, srclen, expected.data());
+        size_t actualSize = extrle::encode16(src, srclen, actual.data());
+        ASSERT_EQ(expectedSize, actualSize);
+        expected.resize(expectedSize);
+        actual.resize(actualSize);
+        EXPECT_EQ(expected, actual);
+    }
+}
+
+TEST(ExtRLE16, Overflow) {
+    std::vector<uint16_t> data(1000, 5);
+    std::vector<ubyte> encoded(data.size() * 4);
+    size_t size = extrle::encode16(
+        reinterpret_cast<const ubyte*>(data.data()),
+        data.size() * 2,
+        encoded.data()
+    );
+    std::vector<ubyte> decoded(data.size() * 2);
+    EXPECT_THROW(
+        extrle::decode16(encoded.data(), size, decoded.data(), 1000),
+        std::runtime_error
+    );
+    EXPECT_THROW(
+        extrle::decode16(encoded.data(), size - 1, decoded.data(), 2000),
+        std::runtime_error
+    );
+}
+
+TEST(ExtRLE16, Throughput) {
+    const int iterations = 200;
+    auto data = generate_runs(CHUNK_VOL * 2, 64);
+    auto src = reinterpret_cast<const ubyte*>(data.data());
+    std::vector<ubyte> encoded(CHUNK_DATA_LEN * 2);
+    std::vector<ubyte> decoded(CHUNK_DATA_LEN);
+
+    timeutil::Timer timer;
+    size_t size = 0;
+    for (int i = 0; i < iterations; i++) {
+        size = encode16_reference(src, CHUNK_DATA_LEN, encoded.data());
+    }
+    int64_t referenceMcs = timer.stop();
+
+    timer = {};
+    for (int i = 0; i < iterations; i++) {
+        size = extrle::encode16(src, CHUNK_DATA_LEN, encoded.data());
+    }
+    int64_t encodeMcs = timer.stop();
+
+    timer = {};
+    for (int i = 0; i < iterations; i++) {
+        extrle::decode16(encoded.data(), size, decoded.data(), CHUNK_DATA_LEN);
+    }
+    int64_t decodeMcs = timer.stop();
+
+    // region voxels loading: decompress, validate ids, decode
+    Chunk chunk(0, 0);
+    const blockid_t idsLimit = 0x8000;
+    bool valid = true;
+    timer = {};
+    for (int i = 0; i < iterations; i++) {
+        extrle::decode16(encoded.data(), size, decoded.data(), CHUNK_DATA_LEN);
+        auto ids = reinterpret_cast<const uint16_t*>(decoded.data());
+        for (uint j = 0; j < CHUNK_VOL; j++) {
+            valid &= ids[j] < idsLimit;
+        }
+        chunk.decode(decoded.data());
+    }
+    int64_t separateMcs = timer.stop();
+    EXPECT_TRUE(valid);
+
+    timer = {};
+    for (int i = 0; i < iterations; i++) {
+        chunk.decodeExtRle16(encoded.data(), size, idsLimit);
+    }
+    int64_t fusedMcs = timer.stop();
+
+    timer = {};
+    for (int i = 0; i < iterations; i++) {
+        chunk.encode();
+    }
+    int64_t chunkEncodeMcs = timer.stop();
+
+    double megabytes = CHUNK_DATA_LEN * iterations / 1e6;
+    auto speed = [megabytes](int64_t mcs) {
+        return megabytes / std::max<int64_t>(mcs, 1) * 1e6;
+    };
+    std::cout << "extrle16 (MB/s): encode reference " << speed(referenceMcs)
+              << ", encode " << speed(encodeMcs)
+              << ", decode " << speed(decodeMcs) << std::endl;
+    std::cout << "chunk (MB/s): encode " << speed(chunkEncodeMcs)
+              << ", decode + validate " << speed(separateMcs)
+              << ", fused decode " << speed(fusedMcs) << std::endl;
+}
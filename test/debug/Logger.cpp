@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "debug/Logger.hpp"
+
+using namespace debug;
+
+namespace fs = std::filesystem;
+
+static std::vector<std::string> read_lines(
+    const fs::path& file, const std::string& filter
+) {
+    std::ifstream stream(file);
+    std::vector<std::string> lines;
+    std::string line;
+    while (std::getline(stream, line)) {
+        if (line.find(filter) != std::string::npos) {
+            lines.push_back(line);
+        }
+    }
+    return lines;
+}
+
+TEST(Logger, ProducersOrderAndFlush) {
+    const int threadsCount = 4;
+    const int messagesCount = 500;
+    auto file = fs::temp_directory_path() / "vctest_logger.log";
+    Logger::init(file.string());
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadsCount; t++) {
+        threads.emplace_back([t, messagesCount]() {
+            Logger logger("logger-test-" + std::to_string(t));
+            for (int i = 0; i < messagesCount; i++) {
+                // warnings are never dropped
+                logger.warning() << "message " << i;
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    Logger::flush();
+
+    for (int t = 0; t < threadsCount; t++) {
+        auto lines =
+            read_lines(file, "logger-test-" + std::to_string(t) + "] ");
+        ASSERT_EQ(lines.size(), messagesCount);
+        for (int i = 0; i < messagesCount; i++) {
+            auto suffix = "] message " + std::to_string(i);
+            ASSERT_EQ(
+                lines[i].compare(
+                    lines[i].length() - suffix.length(), suffix.length(), suffix
+                ),
+                0
+            ) << lines[i];
+        }
+    }
+
+    // errors are written with all messages queued before
+    Logger logger("logger-test-sync");
+    logger.info() << "queued";
+    logger.error() << "failure";
+    auto lines = read_lines(file, "logger-test-sync] ");
+    ASSERT_EQ(lines.size(), 2);
+    EXPECT_NE(lines[0].find("] queued"), std::string::npos);
+    EXPECT_NE(lines[1].find("] failure"), std::string::npos);
+
+    // the writer thread is woken up by producers, no flush needed
+    logger.warning() << "async";
+    bool written = false;
+    for (int i = 0; i < 500 && !written; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        written = read_lines(file, "logger-test-sync] ").size() == 3;
+    }
+    EXPECT_TRUE(written);
+
+    // filtered out messages are not written
+    Logger::setLevel(LogLevel::warning);
+    EXPECT_FALSE(Logger::isEnabled(LogLevel::info));
+    EXPECT_TRUE(Logger::isEnabled(LogLevel::print));
+    logger.info() << "filtered";
+    logger.warning() << "passed";
+    Logger::flush();
+    Logger::setLevel(LogLevel::debug);
+    lines = read_lines(file, "logger-test-sync] ");
+    ASSERT_EQ(lines.size(), 4);
+    EXPECT_NE(lines[3].find("] passed"), std::string::npos);
+}
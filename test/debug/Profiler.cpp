@@ -0,0 +1,44 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "debug/Profiler.hpp"
+
+using namespace debug;
+
+TEST(Profiler, IgnoredWhenNotCapturing) {
+    Profiler::start();
+    Profiler::stop();
+    {
+        VC_PROFILE_SCOPE("ignored");
+    }
+    EXPECT_EQ(Profiler::getZonesCount(), 0);
+}
+
+TEST(Profiler, CaptureThreads) {
+    Profiler::start();
+    {
+        VC_PROFILE_SCOPE("outer");
+        VC_PROFILE_SCOPE("inner");
+    }
+    std::thread thread([]() {
+        Profiler::setThreadName("worker");
+        for (int i = 0; i < 10; i++) {
+            VC_PROFILE_SCOPE("job");
+        }
+    });
+    thread.join();
+    Profiler::stop();
+
+    EXPECT_EQ(Profiler::getZonesCount(), 12);
+    EXPECT_EQ(Profiler::getDroppedCount(), 0);
+
+    auto trace = Profiler::exportChromeTrace();
+    EXPECT_NE(trace.find("\"name\":\"outer\""), std::string::npos);
+    EXPECT_NE(trace.find("\"name\":\"worker\""), std::string::npos);
+
+    // previous results are discarded
+    Profiler::start();
+    Profiler::stop();
+    EXPECT_EQ(Profiler::getZonesCount(), 0);
+}
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+
+#include "coders/syntax_parser.hpp"
+#include "devtools/SyntaxProcessor.hpp"
+#include "graphics/core/Font.hpp"
+
+using namespace devtools;
+
+static std::unique_ptr<Syntax> create_lua_syntax() {
+    auto syntax = std::make_unique<Syntax>();
+    syntax->language = "Lua";
+    syntax->extensions = {"lua"};
+    syntax->lineComment = L"--";
+    syntax->multilineCommentStart = L"[==[";
+    syntax->multilineCommentEnd = L"]==]";
+    syntax->multilineStringStart = L"[[";
+    syntax->multilineStringEnd = L"]]";
+    syntax->keywords = {L"local", L"function", L"return", L"end", L"if", L"then"};
+    return syntax;
+}
+
+static std::wstring generate_source(int lines) {
+    std::wstring source;
+    for (int i = 0; i < lines; i++) {
+        auto n = std::to_wstring(i);
+        switch (i % 5) {
+            case 0: source += L"local value" + n + L" = " + n + L" + 0.5 -- note"; break;
+            case 1: source += L"function f" + n + L"(a, b) return a .. \"s\" end"; break;
+            case 2: source += L"[==[ comment " + n; break;
+            case 3: source += L"  still comment ]==] if x then"; break;
+            case 4: source += L"local s = [[text " + n + L"]] end"; break;
+        }
+        source += L"\n";
+    }
+    return source;
+}
+
+class SyntaxHighlightingTest : public ::testing::Test {
+protected:
+    SyntaxProcessor processor;
+    FontStylesScheme colorScheme;
+    std::wstring source;
+    std::unique_ptr<SyntaxHighlighting> highlighting;
+
+    void SetUp() override {
+        processor.addSyntax(create_lua_syntax());
+        colorScheme.palette.resize(8);
+        source = generate_source(10000);
+        highlighting = processor.createHighlighting("lua");
+        ASSERT_NE(highlighting, nullptr);
+        highlighting->reset(source);
+    }
+
+    void insert(size_t position, const std::wstring& text) {
+        source.insert(position, text);
+        highlighting->update(source, position, 0, text.length());
+    }
+
+    void erase(size_t position, size_t length) {
+        source.erase(position, length);
+        highlighting->update(source, position, length, 0);
+    }
+
+    /// @brief Compare with styles of the whole text tokenized at once
+    void expectSameAsFull() {
+        auto expected = processor.highlight(colorScheme, "lua", source);
+        ASSERT_NE(expected, nullptr);
+        auto actual = highlighting->build(colorScheme);
+        ASSERT_EQ(actual->map.size(), source.length() + 1);
+        const auto& map = expected->map;
+        for (size_t i = 0; i < source.length(); i++) {
+            ASSERT_EQ(actual->map[i], map[std::min(i, map.size() - 1)]) << i;
+        }
+    }
+};
+
+TEST_F(SyntaxHighlightingTest, Reset) {
+    EXPECT_EQ(highlighting->getLinesCount(), 10001);
+    expectSameAsFull();
+    EXPECT_EQ(processor.createHighlighting("xml"), nullptr);
+}
+
+TEST_F(SyntaxHighlightingTest, LocalEdits) {
+    size_t position = source.find(L"local value5000");
+    insert(position, L"local x = 1 ");
+    EXPECT_EQ(highlighting->getTokenizedLines(), 1);
+    insert(position, L"end\nlocal y = 2\n");
+    EXPECT_EQ(highlighting->getTokenizedLines(), 3);
+    erase(position, 20);
+    EXPECT_EQ(highlighting->getTokenizedLines(), 1);
+    EXPECT_EQ(highlighting->getLinesCount(), 10001);
+    expectSameAsFull();
+}
+
+TEST_F(SyntaxHighlightingTest, MultilineStateChange) {
+    // opened string continues until ']]' at the line 5004
+    size_t position = source.find(L"local value5000");
+    insert(position, L"[[");
+    EXPECT_EQ(highlighting->getTokenizedLines(), 5);
+    expectSameAsFull();
+
+    erase(position, 2);
+    EXPECT_EQ(highlighting->getTokenizedLines(), 5);
+    expectSameAsFull();
+
+    // line inside the multiline comment
+    position = source.find(L"comment 5002");
+    insert(position, L"local ");
+    EXPECT_EQ(highlighting->getTokenizedLines(), 1);
+
+    // erase multiple lines including the comment end
+    erase(position, source.find(L"function f5011") - position);
+    expectSameAsFull();
+}
+
+TEST_F(SyntaxHighlightingTest, ReplacedText) {
+    source = L"local a = 1";
+    highlighting->update(source, 0, 0, 0);
+    EXPECT_EQ(highlighting->getLinesCount(), 1);
+    expectSameAsFull();
+}
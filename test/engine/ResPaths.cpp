@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+
+#include "engine/ResPaths.hpp"
+#include "io/devices/MemoryDevice.hpp"
+
+static void create_roots() {
+    io::set_device("mem", std::make_shared<io::MemoryDevice>());
+    io::create_directories("mem:core/textures/blocks");
+    io::create_directories("mem:packs/a/textures/blocks");
+    io::create_directories("mem:packs/b/textures");
+    io::write_string("mem:core/textures/blocks/stone.png", "core");
+    io::write_string("mem:core/textures/blocks/dirt.png", "core");
+    io::write_string("mem:packs/a/textures/blocks/stone.png", "a");
+    io::write_string("mem:packs/b/textures/blocks", "not a folder");
+    io::write_string("mem:core/list.json", "[1, 2]");
+    io::write_string("mem:packs/b/list.json", "[3]");
+}
+
+static ResPaths create_paths() {
+    return ResPaths({
+        {"core", "mem:core"}, {"a", "mem:packs/a"}, {"b", "mem:packs/b"}
+    });
+}
+
+TEST(ResPaths, Find) {
+    create_roots();
+    auto paths = create_paths();
+
+    EXPECT_EQ(paths.find("textures/blocks/stone.png"), "mem:packs/a/textures/blocks/stone.png");
+    EXPECT_EQ(paths.find("textures/blocks/dirt.png"), "mem:core/textures/blocks/dirt.png");
+    EXPECT_EQ(paths.find("./textures//blocks/dirt.png"), "mem:core/./textures//blocks/dirt.png");
+    EXPECT_EQ(paths.find("textures/blocks"), "mem:packs/b/textures/blocks");
+    EXPECT_EQ(paths.find("missing.png"), "res:missing.png");
+    EXPECT_EQ(paths.find("b:list.json"), "b:list.json");
+
+    EXPECT_EQ(paths.findRaw("textures/blocks/stone.png"), "a:textures/blocks/stone.png");
+    EXPECT_THROW(paths.findRaw("missing.png"), std::runtime_error);
+
+    EXPECT_TRUE(paths.exists("textures/blocks/dirt.png"));
+    EXPECT_FALSE(paths.exists("textures/blocks/grass.png"));
+    EXPECT_FALSE(paths.exists("../core/list.json"));
+}
+
+TEST(ResPaths, Case) {
+    create_roots();
+    auto paths = create_paths();
+
+    // keys follow the platform file system case sensitivity
+    bool sensitive = ResPaths::CASE_SENSITIVE;
+    EXPECT_EQ(paths.exists("Textures/Blocks/Dirt.png"), !sensitive);
+    EXPECT_EQ(
+        paths.find("textures/blocks/Stone.png"),
+        sensitive ? "res:textures/blocks/Stone.png"
+                  : "mem:packs/a/textures/blocks/Stone.png"
+    );
+    EXPECT_EQ(paths.isFile("mem:core/TEXTURES/blocks/dirt.png"), !sensitive);
+}
+
+TEST(ResPaths, List) {
+    create_roots();
+    auto paths = create_paths();
+
+    // later roots first, files ('b' textures/blocks) are skipped
+    auto entries = paths.listdirRaw("textures/blocks");
+    ASSERT_EQ(entries.size(), 3);
+    EXPECT_EQ(entries[0], "a:textures/blocks/stone.png");
+    EXPECT_EQ(entries[1].substr(0, 5), "core:");
+
+    auto files = paths.listdir("textures");
+    ASSERT_EQ(files.size(), 3);
+    EXPECT_EQ(files[0], "mem:packs/b/textures/blocks");
+
+    EXPECT_TRUE(paths.isDirectory("mem:packs/a/textures"));
+    EXPECT_TRUE(paths.isDirectory("mem:packs/a"));
+    EXPECT_FALSE(paths.isDirectory("mem:packs/b/textures/blocks"));
+    EXPECT_TRUE(paths.isFile("mem:packs/b/textures/blocks"));
+    EXPECT_FALSE(paths.isFile("mem:packs/b/missing.json"));
+    // not indexed paths are checked directly
+    EXPECT_TRUE(paths.isDirectory("mem:packs"));
+
+    auto list = paths.list("mem:core/textures/blocks");
+    ASSERT_EQ(list.size(), 2);
+    EXPECT_EQ(list[0].parent(), "mem:core/textures/blocks");
+}
+
+TEST(ResPaths, CombinedList) {
+    create_roots();
+    auto paths = create_paths();
+
+    auto list = paths.readCombinedList("list.json");
+    ASSERT_EQ(list.size(), 3);
+    EXPECT_EQ(list[0].asInteger(), 1);
+    EXPECT_EQ(list[2].asInteger(), 3);
+}
+
+TEST(ResPaths, Invalidate) {
+    create_roots();
+    auto paths = create_paths();
+
+    EXPECT_FALSE(paths.exists("scripts/hud.lua"));
+    io::create_directories("mem:packs/b/scripts");
+    io::write_string("mem:packs/b/scripts/hud.lua", "");
+    // paths outside roots entry points are ignored
+    paths.onModified("user:scripts/hud.lua");
+    EXPECT_FALSE(paths.exists("scripts/hud.lua"));
+
+    paths.onModified("mem:packs/b/scripts/hud.lua");
+    EXPECT_EQ(paths.findRaw("scripts/hud.lua"), "b:scripts/hud.lua");
+}
+
+TEST(ResPaths, Stats) {
+    create_roots();
+    auto paths = create_paths();
+
+    paths.find("textures/blocks/dirt.png");
+    paths.find("missing.png");
+    auto stats = paths.getStats();
+    EXPECT_EQ(stats.lookups, 2);
+    // core is the first of three roots
+    EXPECT_EQ(stats.legacyQueries, 6);
+    EXPECT_GT(stats.queries, 0);
+
+    size_t queries = stats.queries;
+    for (int i = 0; i < 100; i++) {
+        paths.find("textures/blocks/stone.png");
+    }
+    EXPECT_EQ(paths.getStats().queries, queries);
+}
@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+
+#include "engine/TickScheduler.hpp"
+
+using namespace std::chrono;
+
+TEST(TickScheduler, FixedTicks) {
+    TickScheduler scheduler(20);
+    auto start = TickScheduler::clock::now();
+    scheduler.reset(start);
+
+    EXPECT_EQ(scheduler.poll(start), 1);
+    EXPECT_EQ(scheduler.poll(start + milliseconds(10)), 0);
+    EXPECT_EQ(scheduler.poll(start + milliseconds(50)), 1);
+    EXPECT_EQ(
+        scheduler.getTimeToNextTick(start + milliseconds(60)), 40000
+    );
+    // one tick late: the missed one is caught up
+    EXPECT_EQ(scheduler.poll(start + milliseconds(160)), 2);
+    // the next tick is on schedule, not an interval after the late one
+    EXPECT_EQ(
+        scheduler.getTimeToNextTick(start + milliseconds(170)), 30000
+    );
+    EXPECT_EQ(scheduler.poll(start + milliseconds(190)), 0);
+    EXPECT_EQ(scheduler.poll(start + milliseconds(200)), 1);
+    EXPECT_EQ(scheduler.getStats().skipped, 0);
+}
+
+TEST(TickScheduler, BoundedCatchUp) {
+    TickScheduler scheduler(20, 5);
+    auto start = TickScheduler::clock::now();
+    scheduler.reset(start);
+
+    EXPECT_EQ(scheduler.poll(start), 1);
+    // 20 ticks due after a second stall
+    EXPECT_EQ(scheduler.poll(start + milliseconds(1000)), 5);
+    EXPECT_EQ(scheduler.getStats().skipped, 15);
+    // schedule continues from the current time
+    EXPECT_EQ(scheduler.poll(start + milliseconds(1010)), 0);
+    EXPECT_EQ(scheduler.poll(start + milliseconds(1050)), 1);
+
+    EXPECT_THROW(TickScheduler(0), std::invalid_argument);
+}
+
+TEST(TickScheduler, Stats) {
+    TickScheduler scheduler(20);
+    auto start = TickScheduler::clock::now();
+    // 100 ticks: 1..100 ms durations
+    for (int i = 0; i < 100; i++) {
+        scheduler.record(start + milliseconds(i * 50), (i + 1) * 1000);
+    }
+    auto stats = scheduler.getStats();
+    EXPECT_EQ(stats.ticks, 100);
+    EXPECT_EQ(stats.overruns, 50);
+    EXPECT_EQ(stats.p50, 50000);
+    EXPECT_EQ(stats.p99, 99000);
+    EXPECT_EQ(stats.max, 100000);
+    EXPECT_NEAR(stats.tps, 20.0, 1e-6);
+
+    // only the recent ticks are used
+    for (int i = 0; i < 2000; i++) {
+        scheduler.record(start + milliseconds((i + 100) * 50), 1000);
+    }
+    stats = scheduler.getStats();
+    EXPECT_EQ(stats.ticks, 2100);
+    EXPECT_EQ(stats.max, 1000);
+    EXPECT_EQ(stats.p99, 1000);
+}
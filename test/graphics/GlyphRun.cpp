@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+
+#include "graphics/core/FontMetics.hpp"
+#include "graphics/core/GlyphRun.hpp"
+
+static FontMetrics metrics {std::nullopt, 16, 4};
+
+TEST(GlyphRun, LayoutWithoutFont) {
+    auto run = GlyphRun::layout(metrics, L"ab c\u0416d", nullptr, 0);
+    ASSERT_EQ(run.glyphs.size(), 5);
+    ASSERT_EQ(run.segments.size(), 2);
+    EXPECT_EQ(run.segments[0].page, 0);
+    EXPECT_EQ(run.segments[0].count, 4);
+    EXPECT_EQ(run.segments[1].page, 0x4);
+    EXPECT_EQ(run.segments[1].count, 1);
+
+    // glyphs are grouped by page keeping the text positions
+    uint codepoints[] {'a', 'b', 'c', 'd', 0x416};
+    int cells[] {0, 1, 3, 5, 4};
+    for (size_t i = 0; i < run.glyphs.size(); i++) {
+        EXPECT_EQ(run.glyphs[i].codepoint, codepoints[i]);
+        EXPECT_EQ(run.glyphs[i].cells, cells[i]);
+        EXPECT_EQ(run.glyphs[i].pixels, 0);
+        EXPECT_EQ(run.glyphs[i].yOffset, 0);
+    }
+}
+
+TEST(GlyphRun, Decorations) {
+    FontStylesScheme styles {
+        {FontStyle(), FontStyle(false, true, true, true, glm::vec4(1))},
+        {0, 0, 1, 1, 0}
+    };
+    auto run = GlyphRun::layout(metrics, L"abc", &styles, 1);
+    ASSERT_EQ(run.segments.size(), 2);
+    EXPECT_EQ(run.segments[0].count, 3);
+    EXPECT_FALSE(run.glyphs[0].style.italic);
+    EXPECT_TRUE(run.glyphs[1].style.italic);
+    EXPECT_TRUE(run.glyphs[2].style.italic);
+
+    // decorations are drawn after all glyphs using page 0
+    EXPECT_EQ(run.segments[1].page, 0);
+    ASSERT_EQ(run.segments[1].count, 4);
+    for (size_t i = 3; i < run.glyphs.size(); i++) {
+        const auto& glyph = run.glyphs[i];
+        EXPECT_EQ(glyph.cells, 1 + (i - 3) / 2);
+        EXPECT_TRUE(glyph.style.bold);
+    }
+    EXPECT_EQ(run.glyphs[3].codepoint, '-');
+    EXPECT_EQ(run.glyphs[4].codepoint, '_');
+
+    GlyphRunMesh<Batch2DVertex> mesh;
+    GlyphRunPlacement placement {{8, 0, 0}, {0, 16, 0}, glm::vec4(1)};
+    run.build(mesh, placement, 16, 0.5f, {UVRegion(), UVRegion()});
+    EXPECT_TRUE(mesh.matches(placement));
+    ASSERT_EQ(mesh.counts.size(), 2);
+    EXPECT_EQ(mesh.counts[0], 3 * 6);
+    // bold glyphs are drawn twice
+    EXPECT_EQ(mesh.counts[1], 4 * 6 * 2);
+    EXPECT_EQ(mesh.vertices.size(), mesh.counts[0] + mesh.counts[1]);
+}
+
+TEST(GlyphRun, OriginRelativeMesh) {
+    auto run = GlyphRun::layout(metrics, L"ab", nullptr, 0);
+    GlyphRunMesh<Batch2DVertex> mesh;
+    GlyphRunPlacement placement {{8, 0, 0}, {0, 16, 0}, glm::vec4(1)};
+    run.build(mesh, placement, 16, 0.5f, {UVRegion()});
+    ASSERT_EQ(mesh.vertices.size(), 2 * 6);
+    // text position is applied when drawing, so the mesh is reused
+    // for the same text drawn at other positions
+    EXPECT_EQ(mesh.vertices[0].position, glm::vec2(0, 0));
+    EXPECT_EQ(mesh.vertices[6].position, glm::vec2(8, 0));
+    EXPECT_EQ(mesh.vertices[1].position, glm::vec2(16, 16));
+}
+
+TEST(GlyphRunCache, HitsAndInvalidation) {
+    GlyphRunCache cache(64);
+    FontStylesScheme styles {{FontStyle(), FontStyle()}, {0, 0, 1}};
+
+    cache.get(nullptr, L"text", &styles, 0);
+    cache.get(nullptr, L"text", &styles, 0);
+    EXPECT_EQ(cache.getHits(), 1);
+    EXPECT_EQ(cache.getMisses(), 1);
+
+    // same text with other styles
+    cache.get(nullptr, L"text", &styles, 1);
+    styles.palette[1].bold = true;
+    auto& run = cache.get(nullptr, L"text", &styles, 0);
+    EXPECT_EQ(cache.getHits(), 1);
+    EXPECT_EQ(cache.getMisses(), 3);
+    EXPECT_TRUE(run.glyphs[2].style.bold);
+    EXPECT_EQ(cache.size(), 3);
+
+    cache.clear();
+    EXPECT_EQ(cache.size(), 0);
+    cache.get(nullptr, L"text", &styles, 0);
+    EXPECT_EQ(cache.getMisses(), 4);
+}
+
+TEST(GlyphRunCache, Eviction) {
+    GlyphRunCache cache(8);
+    cache.get(nullptr, L"aaaa", nullptr, 0);
+    cache.get(nullptr, L"bbbb", nullptr, 0);
+    cache.get(nullptr, L"aaaa", nullptr, 0);
+    // least recently used is evicted
+    cache.get(nullptr, L"cccc", nullptr, 0);
+    EXPECT_EQ(cache.size(), 2);
+    cache.get(nullptr, L"aaaa", nullptr, 0);
+    EXPECT_EQ(cache.getHits(), 2);
+    cache.get(nullptr, L"bbbb", nullptr, 0);
+    EXPECT_EQ(cache.getMisses(), 4);
+
+    // texts longer than capacity are not cached
+    auto& run = cache.get(nullptr, L"0123456789", nullptr, 0);
+    EXPECT_EQ(run.glyphs.size(), 10);
+    EXPECT_EQ(cache.size(), 2);
+}
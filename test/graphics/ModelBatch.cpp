@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "graphics/commons/Model.hpp"
+#include "graphics/render/MainBatch.hpp"
+#include "graphics/render/ModelBatch.hpp"
+#include "maths/util.hpp"
+
+static const glm::vec3 SUN_VECTOR {0.411934f, 0.863868f, -0.279161f};
+
+/// @brief Vertices generation as done via MainBatch::vertex
+static void generate_reference(
+    const model::Mesh& mesh,
+    const glm::mat4& matrix,
+    const glm::mat3& rotation,
+    const glm::vec3& tint,
+    const glm::vec4& lights,
+    const UVRegion& region,
+    MainBatchVertex* dst
+) {
+    for (size_t i = 0; i < mesh.vertices.size(); i++) {
+        const auto& vert = mesh.vertices[i];
+        auto norm = rotation * vert.normal;
+        float d = 1.0f;
+        if (mesh.shading) {
+            d = glm::dot(norm, SUN_VECTOR);
+            d = 0.8f + d * 0.2f;
+        }
+        MainBatch::write(
+            dst[i],
+            matrix * glm::vec4(vert.coord, 1.0f),
+            {vert.uv.x * region.getWidth() + region.u1,
+             vert.uv.y * region.getHeight() + region.v1},
+            lights * d,
+            tint,
+            norm,
+            mesh.shading ? 0.0f : 1.0f
+        );
+    }
+}
+
+TEST(ModelBatch, GenerateVertices) {
+    util::PseudoRandom random(42);
+    model::Mesh mesh;
+    for (int i = 0; i < 300; i++) {
+        mesh.vertices.push_back({
+            {random.randFloat() * 4 - 2, random.randFloat() * 4 - 2, random.randFloat() * 4 - 2},
+            {random.randFloat(), random.randFloat()},
+            glm::normalize(glm::vec3(random.randFloat() - 0.5f, random.randFloat() - 0.5f, 0.5f))
+        });
+    }
+    glm::mat4 matrix = glm::translate(glm::mat4(1.0f), {100.5f, 64.0f, -30.25f});
+    matrix = glm::rotate(matrix, 0.7f, glm::normalize(glm::vec3(1, 2, 3)));
+    matrix = glm::scale(matrix, {1.5f, 0.5f, 2.0f});
+    glm::mat3 rotation = glm::rotate(glm::mat4(1.0f), 0.7f, glm::normalize(glm::vec3(1, 2, 3)));
+    glm::vec3 tint(0.9f, 0.8f, 0.7f);
+    glm::vec4 lights(0.2f, 0.4f, 0.6f, 0.8f);
+    UVRegion region(0.25f, 0.5f, 0.375f, 0.625f);
+
+    for (bool shading : {true, false}) {
+        mesh.shading = shading;
+        size_t count = mesh.vertices.size();
+        std::vector<MainBatchVertex> expected(count);
+        std::vector<MainBatchVertex> actual(count);
+        generate_reference(
+            mesh, matrix, rotation, tint, lights, region, expected.data()
+        );
+        // generate in two slices
+        size_t first = count / 3;
+        ModelBatch::generateVertices(
+            mesh, 0, first, matrix, rotation, tint, lights, region, actual.data()
+        );
+        ModelBatch::generateVertices(
+            mesh, first, count - first, matrix, rotation, tint, lights, region,
+            actual.data() + first
+        );
+        EXPECT_EQ(
+            std::memcmp(
+                expected.data(), actual.data(), count * sizeof(MainBatchVertex)
+            ),
+            0
+        );
+    }
+}
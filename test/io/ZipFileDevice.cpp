@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+
+#include "coders/byte_utils.hpp"
+#include "io/devices/MemoryDevice.hpp"
+#include "io/devices/StdfsDevice.hpp"
+#include "io/devices/ZipFileDevice.hpp"
+#include "io/io.hpp"
+#include "io/mapped_file.hpp"
+
+namespace fs = std::filesystem;
+
+static io::ZipFileDevice create_zip() {
+    auto folder = fs::temp_directory_path() / "vctest_zip";
+    io::set_device("tmp", std::make_shared<io::StdfsDevice>(folder));
+    io::set_device("memsrc", std::make_shared<io::MemoryDevice>());
+    io::create_directories("memsrc:textures/blocks");
+    io::create_directories("memsrc:scripts");
+    io::write_string("memsrc:package.json", "{\"id\": \"test\"}");
+    io::write_string("memsrc:textures/blocks/stone.png", "stone");
+    io::write_string("memsrc:scripts/world.lua", std::string(10000, 'x'));
+    io::write_zip("memsrc:", "tmp:test.zip");
+    return io::ZipFileDevice(
+        std::make_shared<io::mapped_file>(folder / "test.zip")
+    );
+}
+
+/// @brief Single stored (not compressed) file without directory entries
+static util::Buffer<ubyte> create_stored_zip(
+    const std::string& name, const std::string& content
+) {
+    ByteBuilder builder;
+    builder.putInt32(0x04034b50);
+    builder.putInt16(10); // version
+    builder.putInt16(0); // flags
+    builder.putInt16(0); // compression method
+    builder.putInt32(0); // last modification datetime
+    builder.putInt32(0); // crc32
+    builder.putInt32(content.length());
+    builder.putInt32(content.length());
+    builder.putInt16(name.length());
+    builder.putInt16(0); // extra field length
+    builder.put(reinterpret_cast<const ubyte*>(name.data()), name.length());
+    builder.put(reinterpret_cast<const ubyte*>(content.data()), content.length());
+
+    size_t centralDirOffset = builder.size();
+    builder.putInt32(0x02014b50);
+    builder.putInt16(10); // version made by
+    builder.putInt16(10); // version needed
+    builder.putInt16(0); // flags
+    builder.putInt16(0); // compression method
+    builder.putInt32(0); // last modification datetime
+    builder.putInt32(0); // crc32
+    builder.putInt32(content.length());
+    builder.putInt32(content.length());
+    builder.putInt16(name.length());
+    builder.putInt16(0); // extra field length
+    builder.putInt16(0); // file comment length
+    builder.putInt16(0); // disk number start
+    builder.putInt16(0); // internal attributes
+    builder.putInt32(0); // external attributes
+    builder.putInt32(0); // local header offset
+    builder.put(reinterpret_cast<const ubyte*>(name.data()), name.length());
+    size_t centralDirSize = builder.size() - centralDirOffset;
+
+    builder.putInt32(0x06054b50);
+    builder.putInt16(0); // disk number
+    builder.putInt16(0); // central dir disk
+    builder.putInt16(1); // num entries
+    builder.putInt16(1); // total entries
+    builder.putInt32(centralDirSize);
+    builder.putInt32(centralDirOffset);
+    builder.putInt16(0); // comment length
+    auto bytes = builder.build();
+    return util::Buffer<ubyte>(bytes.data(), bytes.size());
+}
+
+static std::string to_string(const util::Buffer<ubyte>& buffer) {
+    return std::string(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+}
+
+TEST(ZipFileDevice, Read) {
+    auto zip = create_zip();
+    EXPECT_TRUE(zip.isdir("textures/blocks"));
+    EXPECT_TRUE(zip.isfile("textures/blocks/stone.png"));
+    EXPECT_FALSE(zip.exists("textures/blocks/dirt.png"));
+    EXPECT_EQ(zip.size("scripts/world.lua"), 10000);
+
+    auto stream = zip.read("package.json");
+    std::string content(std::istreambuf_iterator<char>(*stream), {});
+    EXPECT_EQ(content, "{\"id\": \"test\"}");
+    EXPECT_THROW(zip.read("textures"), std::runtime_error);
+    EXPECT_THROW(zip.read("missing.txt"), std::runtime_error);
+}
+
+TEST(ZipFileDevice, List) {
+    auto zip = create_zip();
+    std::vector<std::string> names;
+    auto generator = zip.list("");
+    io::path name;
+    while (generator->next(name)) {
+        names.push_back(name.string());
+    }
+    EXPECT_EQ(names, (std::vector<std::string> {"package.json", "scripts", "textures"}));
+
+    generator = zip.list("textures/blocks");
+    ASSERT_TRUE(generator->next(name));
+    EXPECT_EQ(name, "stone.png");
+    EXPECT_FALSE(generator->next(name));
+}
+
+TEST(ZipFileDevice, ReadAll) {
+    auto zip = create_zip();
+    auto files = zip.readAll(
+        {"textures/blocks/stone.png", "scripts/world.lua", "package.json"}, 2
+    );
+    ASSERT_EQ(files.size(), 3);
+    EXPECT_EQ(to_string(files[0]), "stone");
+    EXPECT_EQ(to_string(files[1]), std::string(10000, 'x'));
+    EXPECT_EQ(to_string(files[2]), "{\"id\": \"test\"}");
+    EXPECT_THROW(zip.readAll({"missing.txt"}), std::runtime_error);
+}
+
+TEST(ZipFileDevice, StoredView) {
+    io::ZipFileDevice zip(create_stored_zip("data/info.txt", "stored text"));
+    EXPECT_TRUE(zip.isdir("data"));
+
+    auto view = zip.view("data/info.txt");
+    ASSERT_TRUE(view.has_value());
+    EXPECT_EQ(
+        std::string(reinterpret_cast<const char*>(view->data()), view->size()),
+        "stored text"
+    );
+    EXPECT_FALSE(zip.view("data").has_value());
+
+    auto stream = zip.read("data/info.txt");
+    stream->seekg(7);
+    std::string content(std::istreambuf_iterator<char>(*stream), {});
+    EXPECT_EQ(content, "text");
+}
+
+TEST(ZipFileDevice, DeviceBatchRead) {
+    io::set_device(
+        "zipsrc", std::make_shared<io::ZipFileDevice>(create_zip())
+    );
+    io::create_subdevice("zipsub", "zipsrc", "textures");
+    io::set_device(
+        "zipstored",
+        std::make_shared<io::ZipFileDevice>(
+            create_stored_zip("data/info.txt", "stored text")
+        )
+    );
+
+    auto files = io::read_all(
+        {"zipsub:blocks/stone.png", "memsrc:package.json", "zipsrc:package.json"}
+    );
+    ASSERT_EQ(files.size(), 3);
+    EXPECT_EQ(to_string(files[0]), "stone");
+    EXPECT_EQ(to_string(files[1]), "{\"id\": \"test\"}");
+    EXPECT_EQ(to_string(files[2]), "{\"id\": \"test\"}");
+    EXPECT_THROW(io::read_all({"zipsub:missing.png"}), std::runtime_error);
+
+    auto view = io::view("zipstored:data/info.txt");
+    ASSERT_TRUE(view.has_value());
+    EXPECT_EQ(view->size(), 11);
+    EXPECT_FALSE(io::view("memsrc:package.json").has_value());
+
+    io::remove_device("zipsub");
+    io::remove_device("zipsrc");
+    io::remove_device("zipstored");
+}
@@ -0,0 +1,40 @@
+#include <gtest/gtest.h>
+
+#include "maths/Heightmap.hpp"
+
+static void test_sample_area(
+    uint areaWidth, uint areaHeight, uint scaled, InterpolationType interp
+) {
+    Heightmap map(40, 30);
+    auto values = map.getValues();
+    for (uint i = 0; i < 40 * 30; i++) {
+        values[i] = static_cast<float>((i * 7919) % 1000) / 1000.0f;
+    }
+    const uint srcX = 11;
+    const uint srcY = 6;
+    const uint dst = 16;
+    auto area = map.sampleArea(
+        srcX, srcY, areaWidth, areaHeight, scaled, scaled, dst, dst, interp
+    );
+
+    Heightmap expected(map);
+    expected.crop(srcX, srcY, areaWidth, areaHeight);
+    expected.resize(scaled, scaled, interp);
+    expected.crop(0, 0, dst, dst);
+
+    ASSERT_EQ(area->getWidth(), dst);
+    ASSERT_EQ(area->getHeight(), dst);
+    for (uint i = 0; i < dst * dst; i++) {
+        EXPECT_EQ(area->getValues()[i], expected.getValues()[i]);
+    }
+}
+
+TEST(Heightmap, SampleArea) {
+    for (auto interp : {InterpolationType::NEAREST,
+                        InterpolationType::LINEAR,
+                        InterpolationType::CUBIC}) {
+        test_sample_area(5, 5, 20, interp);
+        test_sample_area(3, 4, 18, interp);
+        test_sample_area(17, 17, 17, interp);
+    }
+}
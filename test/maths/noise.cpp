@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include "maths/FastNoiseLite.h"
+#include "maths/noise.hpp"
+#include "util/timeutil.hpp"
+
+/// @brief Scalar reference (per-pixel fnlGetNoise2D)
+static void add_fractal_reference(
+    fnl_state& state,
+    float* values,
+    uint width,
+    uint height,
+    const noise::FractalParams& params
+) {
+    for (uint y = 0; y < height; y++) {
+        for (uint x = 0; x < width; x++) {
+            uint i = y * width + x;
+            for (int c = 0; c < params.octaves; c++) {
+                float m = params.scale * (1 << c);
+                float u = (x + params.offsetX) * m;
+                float v = (y + params.offsetY) * m;
+                if (params.shiftX) {
+                    u += params.shiftX[i];
+                }
+                if (params.shiftY) {
+                    v += params.shiftY[i];
+                }
+                values[i] += fnlGetNoise2D(&state, u, v) /
+                             static_cast<float>(1 << c) * params.multiplier;
+            }
+        }
+    }
+}
+
+static void test_fractal(fnl_noise_type type, int seed, bool shift) {
+    const uint width = 83;
+    const uint height = 47;
+    auto state = fnlCreateState();
+    state.seed = seed;
+    state.noise_type = type;
+
+    std::vector<float> shiftX(width * height);
+    std::vector<float> shiftY(width * height);
+    for (uint i = 0; i < width * height; i++) {
+        shiftX[i] = (i % 17) * 3.7f - 20.0f;
+        shiftY[i] = (i % 13) * -2.3f + 11.0f;
+    }
+    noise::FractalParams params {};
+    params.offsetX = -1234.5f;
+    params.offsetY = 731.25f;
+    params.scale = 1.7f;
+    params.octaves = 5;
+    params.multiplier = 0.75f;
+    if (shift) {
+        params.shiftX = shiftX.data();
+        params.shiftY = shiftY.data();
+    }
+    std::vector<float> expected(width * height, 0.5f);
+    std::vector<float> actual(width * height, 0.5f);
+    add_fractal_reference(state, expected.data(), width, height, params);
+    noise::add_fractal_2d(state, actual.data(), width, height, params);
+
+    for (uint i = 0; i < width * height; i++) {
+        ASSERT_EQ(
+            std::memcmp(&expected[i], &actual[i], sizeof(float)), 0
+        ) << "pixel " << i << ": " << expected[i] << " != " << actual[i];
+    }
+}
+
+TEST(noise, OpenSimplex2Fractal) {
+    test_fractal(FNL_NOISE_OPENSIMPLEX2, 1337, false);
+    test_fractal(FNL_NOISE_OPENSIMPLEX2, -90210, true);
+}
+
+TEST(noise, CellularFractal) {
+    test_fractal(FNL_NOISE_CELLULAR, 1337, false);
+    test_fractal(FNL_NOISE_CELLULAR, 42, true);
+}
+
+TEST(noise, Fallback) {
+    test_fractal(FNL_NOISE_PERLIN, 7, true);
+}
+
+TEST(noise, GetNoise2D) {
+    const size_t count = 1003;
+    std::vector<float> xs(count);
+    std::vector<float> ys(count);
+    for (size_t i = 0; i < count; i++) {
+        xs[i] = static_cast<float>(i) * 13.37f - 5000.0f;
+        ys[i] = static_cast<float>(i % 91) * -7.1f;
+    }
+    for (auto type : {FNL_NOISE_OPENSIMPLEX2, FNL_NOISE_CELLULAR}) {
+        auto state = fnlCreateState();
+        state.noise_type = type;
+        std::vector<float> values(count);
+        noise::get_noise_2d(state, xs.data(), ys.data(), values.data(), count);
+        for (size_t i = 0; i < count; i++) {
+            EXPECT_EQ(values[i], fnlGetNoise2D(&state, xs[i], ys[i]));
+        }
+    }
+}
+
+TEST(noise, Throughput) {
+    const uint width = 256;
+    const uint height = 256;
+    const int octaves = 4;
+    std::vector<float> values(width * height);
+
+    for (auto type : {FNL_NOISE_OPENSIMPLEX2, FNL_NOISE_CELLULAR}) {
+        auto state = fnlCreateState();
+        state.noise_type = type;
+        noise::FractalParams params {};
+        params.octaves = octaves;
+
+        timeutil::Timer timer;
+        add_fractal_reference(state, values.data(), width, height, params);
+        int64_t scalarMcs = timer.stop();
+
+        timer = {};
+        noise::add_fractal_2d(state, values.data(), width, height, params);
+        int64_t batchMcs = timer.stop();
+
+        double samples = static_cast<double>(width) * height * octaves;
+        std::cout << (type == FNL_NOISE_CELLULAR ? "cellular" : "opensimplex2")
+                  << " [" << noise::get_instruction_set() << "]: scalar "
+                  << samples / std::max<int64_t>(scalarMcs, 1)
+                  << " samples/mcs, batch "
+                  << samples / std::max<int64_t>(batchMcs, 1)
+                  << " samples/mcs" << std::endl;
+    }
+}
@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <iostream>
+
+#include "network/Network.hpp"
+
+using namespace network;
+using namespace std::chrono;
+
+static void wait_for(
+    const std::function<bool()>& condition,
+    const runnable& onIdle,
+    milliseconds timeout
+) {
+    auto start = steady_clock::now();
+    while (!condition()) {
+        onIdle();
+        ASSERT_LT(steady_clock::now() - start, timeout);
+        std::this_thread::sleep_for(milliseconds(1));
+    }
+}
+
+/// @brief Loopback load generator: clients send data to TCP echo server
+/// driven by the main thread as in the engine
+TEST(sockets, tcp_echo_loopback) {
+    constexpr int CLIENTS = 64;
+    constexpr size_t BYTES_PER_CLIENT = 256 * 1024;
+
+    NetworkSettings settings {};
+    auto network = Network::create(settings);
+    int port = network->findFreePort();
+    ASSERT_NE(port, -1);
+
+    std::mutex mutex;
+    std::vector<u64id_t> serverSide;
+    u64id_t serverId = network->openTcpServer(port, [&](u64id_t, u64id_t cid) {
+        std::lock_guard lock(mutex);
+        serverSide.push_back(cid);
+    });
+    ASSERT_NE(network->getServer(serverId, true), nullptr);
+
+    std::atomic<int> connected = 0;
+    std::vector<u64id_t> clients;
+    for (int i = 0; i < CLIENTS; i++) {
+        clients.push_back(network->connectTcp(
+            "127.0.0.1",
+            port,
+            [&](u64id_t) { connected++; },
+            [](u64id_t, std::string message) { FAIL() << message; }
+        ));
+    }
+
+    std::vector<char> payload(BYTES_PER_CLIENT);
+    for (size_t i = 0; i < payload.size(); i++) {
+        payload[i] = static_cast<char>(i * 31 + 7);
+    }
+    std::vector<size_t> sent(CLIENTS);
+    std::vector<size_t> received(CLIENTS);
+    std::vector<char> buffer(64 * 1024);
+
+    auto start = steady_clock::now();
+    auto pump = [&]() {
+        network->update();
+        // echo server
+        std::vector<u64id_t> ids;
+        {
+            std::lock_guard lock(mutex);
+            ids = serverSide;
+        }
+        for (u64id_t cid : ids) {
+            auto connection = dynamic_cast<TcpConnection*>(
+                network->getConnection(cid, true)
+            );
+            if (connection == nullptr) {
+                continue;
+            }
+            int size = connection->recv(buffer.data(), buffer.size());
+            if (size > 0) {
+                // write queue limit is far above the test load
+                ASSERT_EQ(connection->send(buffer.data(), size), size);
+            }
+        }
+        // clients
+        for (int i = 0; i < CLIENTS; i++) {
+            auto connection = dynamic_cast<TcpConnection*>(
+                network->getConnection(clients[i], true)
+            );
+            ASSERT_NE(connection, nullptr);
+            if (connection->getState() != ConnectionState::CONNECTED) {
+                continue;
+            }
+            if (sent[i] < payload.size()) {
+                sent[i] += connection->send(
+                    payload.data() + sent[i],
+                    std::min<size_t>(payload.size() - sent[i], 16 * 1024)
+                );
+            }
+            int size = connection->recv(buffer.data(), buffer.size());
+            for (int j = 0; j < size; j++) {
+                ASSERT_EQ(buffer[j], payload[received[i] + j]);
+            }
+            if (size > 0) {
+                received[i] += size;
+            }
+        }
+    };
+    wait_for([&]() {
+        for (size_t count : received) {
+            if (count < BYTES_PER_CLIENT) {
+                return false;
+            }
+        }
+        return true;
+    }, pump, seconds(30));
+
+    double seconds = duration<double>(steady_clock::now() - start).count();
+    double megabytes = CLIENTS * BYTES_PER_CLIENT * 2 / 1024.0 / 1024.0;
+    std::cout << CLIENTS << " clients, " << megabytes << " MiB echoed in "
+              << seconds << " s (" << megabytes / seconds << " MiB/s)"
+              << std::endl;
+    EXPECT_EQ(connected, CLIENTS);
+}
+
+TEST(sockets, udp_loopback) {
+    constexpr int DATAGRAMS = 256;
+
+    NetworkSettings settings {};
+    auto network = Network::create(settings);
+    int port = network->findFreePort();
+    ASSERT_NE(port, -1);
+
+    std::atomic<int> serverReceived = 0;
+    std::atomic<int> clientReceived = 0;
+    std::atomic<UdpServer*> server = nullptr;
+    u64id_t serverId = network->openUdpServer(
+        port,
+        [&](u64id_t, const std::string& addr, int port, const char* buffer, size_t length) {
+            serverReceived++;
+            server.load()->sendTo(addr, port, buffer, length);
+        }
+    );
+    server = dynamic_cast<UdpServer*>(network->getServer(serverId, true));
+    ASSERT_NE(server, nullptr);
+
+    u64id_t cid = network->connectUdp(
+        "127.0.0.1",
+        port,
+        [](u64id_t) {},
+        [&](u64id_t, const char*, size_t length) {
+            EXPECT_EQ(length, 4);
+            clientReceived++;
+        }
+    );
+    auto connection = network->getConnection(cid, true);
+    ASSERT_NE(connection, nullptr);
+
+    int sent = 0;
+    wait_for([&]() { return clientReceived >= DATAGRAMS / 2; }, [&]() {
+        if (sent < DATAGRAMS) {
+            connection->send("ping", 4);
+            sent++;
+        }
+    }, seconds(10));
+    EXPECT_GE(serverReceived, clientReceived);
+}
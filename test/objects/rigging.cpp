@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+
+#include <glm/ext/matrix_transform.hpp>
+
+#include "objects/rigging.hpp"
+
+using namespace rigging;
+
+/// @brief Recursive bone matrices calculation (as before flattening)
+static size_t calculate_recursive(
+    size_t index,
+    const Skeleton& skeleton,
+    const Bone& node,
+    const glm::mat4& matrix,
+    std::vector<glm::mat4>& dst
+) {
+    glm::mat4 baseMatrix(1.0f);
+    if (glm::length2(node.getOffset()) > 0.0f) {
+        baseMatrix = glm::translate(glm::mat4(1.0f), node.getOffset());
+    }
+    dst[index] = matrix * baseMatrix * skeleton.pose.matrices[index];
+    size_t count = 1;
+    for (const auto& subnode : node.getBones()) {
+        count += calculate_recursive(
+            index + count, skeleton, *subnode, dst[index], dst
+        );
+    }
+    return count;
+}
+
+static std::unique_ptr<Bone> make_bone(
+    size_t index,
+    const glm::vec3& offset,
+    std::vector<std::unique_ptr<Bone>> bones = {}
+) {
+    return std::make_unique<Bone>(
+        index, "bone" + std::to_string(index), "", std::move(bones), offset
+    );
+}
+
+/// 0 - root
+/// 1 --- arm (offset)
+/// 2 ----- hand (offset)
+/// 3 ------- finger
+/// 4 ----- elbow
+/// 5 --- leg (offset)
+/// 6 ----- foot (offset)
+static std::shared_ptr<SkeletonConfig> make_config() {
+    std::vector<std::unique_ptr<Bone>> hand;
+    hand.push_back(make_bone(3, {}));
+
+    std::vector<std::unique_ptr<Bone>> arm;
+    arm.push_back(make_bone(2, {0.0f, 0.5f, 0.25f}, std::move(hand)));
+    arm.push_back(make_bone(4, {}));
+
+    std::vector<std::unique_ptr<Bone>> leg;
+    leg.push_back(make_bone(6, {0.0f, -0.75f, 0.0f}));
+
+    std::vector<std::unique_ptr<Bone>> root;
+    root.push_back(make_bone(1, {1.0f, 0.0f, 0.0f}, std::move(arm)));
+    root.push_back(make_bone(5, {-0.5f, -1.0f, 0.0f}, std::move(leg)));
+    return std::make_shared<SkeletonConfig>(
+        "test", make_bone(0, {}, std::move(root)), 7
+    );
+}
+
+TEST(rigging, FlattenedUpdate) {
+    auto config = make_config();
+    auto skeleton = config->instance();
+    ASSERT_EQ(skeleton.pose.matrices.size(), 7);
+    for (size_t i = 0; i < skeleton.pose.matrices.size(); i++) {
+        skeleton.pose.matrices[i] = glm::translate(
+            glm::mat4(1.0f), glm::vec3(i * 0.5f, 1.0f, -0.25f * i)
+        );
+    }
+    glm::mat3 rotation(1.0f);
+    glm::vec3 position(10.0f, 20.0f, 30.0f);
+    glm::vec3 scale(2.0f);
+    config->update(skeleton, rotation, position, scale);
+
+    glm::mat4 root = glm::scale(
+        glm::translate(glm::mat4(1.0f), position) * glm::mat4(rotation), scale
+    );
+    std::vector<glm::mat4> expected(7);
+    EXPECT_EQ(
+        calculate_recursive(0, skeleton, *config->getRoot(), root, expected), 7
+    );
+    for (size_t i = 0; i < expected.size(); i++) {
+        EXPECT_EQ(skeleton.calculated.matrices[i], expected[i]) << "bone " << i;
+    }
+
+    // unchanged skeleton is not recalculated until marked dirty
+    skeleton.pose.matrices[3] = glm::mat4(2.0f);
+    config->update(skeleton, rotation, position, scale);
+    EXPECT_EQ(skeleton.calculated.matrices[3], expected[3]);
+
+    skeleton.dirty = true;
+    config->update(skeleton, rotation, position, scale);
+    calculate_recursive(0, skeleton, *config->getRoot(), root, expected);
+    EXPECT_EQ(skeleton.calculated.matrices[3], expected[3]);
+}
@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "util/MpscQueue.hpp"
+
+using namespace util;
+
+TEST(MpscQueue, PushPop) {
+    MpscQueue<int> queue(4);
+    for (int i = 0; i < 4; i++) {
+        EXPECT_TRUE(queue.push([i](int& value) { value = i; }));
+    }
+    EXPECT_FALSE(queue.push([](int& value) { value = -1; }));
+
+    int value;
+    for (int i = 0; i < 4; i++) {
+        EXPECT_TRUE(queue.pop([&value](int& x) { value = x; }));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(queue.pop([](int&) {}));
+}
+
+TEST(MpscQueue, MultipleProducers) {
+    constexpr int PRODUCERS = 4;
+    constexpr int COUNT = 100000;
+
+    MpscQueue<std::pair<int, int>> queue(1024);
+    std::vector<std::thread> threads;
+    for (int p = 0; p < PRODUCERS; p++) {
+        threads.emplace_back([&queue, p]() {
+            for (int i = 0; i < COUNT; i++) {
+                while (!queue.push([=](std::pair<int, int>& value) {
+                    value = {p, i};
+                })) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    // elements of each producer are consumed in order
+    std::vector<int> next(PRODUCERS);
+    int received = 0;
+    while (received < PRODUCERS * COUNT) {
+        std::pair<int, int> value;
+        if (!queue.pop([&value](auto& x) { value = x; })) {
+            std::this_thread::yield();
+            continue;
+        }
+        ASSERT_EQ(value.second, next[value.first]++);
+        received++;
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
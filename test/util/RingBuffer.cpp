@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+
+#include "util/RingBuffer.hpp"
+
+using namespace util;
+
+TEST(RingBuffer, WriteRead) {
+    RingBuffer<char> buffer(8, 8);
+    EXPECT_EQ(buffer.write("hello", 5), 5);
+    EXPECT_EQ(buffer.size(), 5);
+
+    char dst[8] {};
+    EXPECT_EQ(buffer.read(dst, 3), 3);
+    EXPECT_EQ(std::string(dst, 3), "hel");
+    EXPECT_EQ(buffer.size(), 2);
+
+    // wraps around the end of the storage
+    EXPECT_EQ(buffer.write("world!", 6), 6);
+    RingBuffer<char>::Span spans[2];
+    EXPECT_EQ(buffer.readable(spans), 2);
+    EXPECT_EQ(spans[0].size + spans[1].size, 8);
+
+    EXPECT_EQ(buffer.read(dst, 8), 8);
+    EXPECT_EQ(std::string(dst, 8), "loworld!");
+    EXPECT_TRUE(buffer.empty());
+}
+
+TEST(RingBuffer, Limit) {
+    RingBuffer<char> buffer(4, 16);
+    std::string data(20, 'x');
+    EXPECT_EQ(buffer.write(data.data(), data.size()), 16);
+    EXPECT_EQ(buffer.getCapacity(), 16);
+    EXPECT_EQ(buffer.freeSpace(), 0);
+    EXPECT_FALSE(buffer.grow());
+}
+
+TEST(RingBuffer, GrowPreservesOrder) {
+    RingBuffer<int> buffer(4, 64);
+    int next = 0;
+    int expected = 0;
+    for (int i = 0; i < 10; i++) {
+        int values[3] = {next++, next++, next++};
+        buffer.write(values, 3);
+        int value;
+        buffer.read(&value, 1);
+        EXPECT_EQ(value, expected++);
+    }
+    while (!buffer.empty()) {
+        int value;
+        buffer.read(&value, 1);
+        EXPECT_EQ(value, expected++);
+    }
+    EXPECT_EQ(expected, next);
+}
+
+TEST(RingBuffer, CommitWritable) {
+    RingBuffer<char> buffer(8, 8);
+    buffer.write("abcdef", 6);
+    buffer.consume(4);
+
+    RingBuffer<char>::Span spans[2];
+    int count = buffer.writable(spans);
+    EXPECT_EQ(count, 2);
+    EXPECT_EQ(spans[0].size + spans[1].size, 6);
+    std::memcpy(spans[0].data, "12", 2);
+    std::memcpy(spans[1].data, "3456", 4);
+    buffer.commit(6);
+
+    char dst[8];
+    EXPECT_EQ(buffer.read(dst, 8), 8);
+    EXPECT_EQ(std::string(dst, 8), "ef123456");
+}
@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "util/SpscRingBuffer.hpp"
+
+using namespace util;
+
+TEST(SpscRingBuffer, WriteRead) {
+    SpscRingBuffer<int> buffer(8);
+    int src[] {1, 2, 3, 4, 5, 6};
+    EXPECT_EQ(buffer.write(src, 6), 6);
+    EXPECT_EQ(buffer.write(src, 6), 2);
+    EXPECT_EQ(buffer.freeSpace(), 0);
+
+    int dst[8];
+    EXPECT_EQ(buffer.read(dst, 4), 4);
+    EXPECT_EQ(dst[3], 4);
+    // wrap-around
+    EXPECT_EQ(buffer.write(src, 3), 3);
+    EXPECT_EQ(buffer.read(dst, 8), 7);
+    int expected[] {5, 6, 1, 2, 1, 2, 3};
+    for (int i = 0; i < 7; i++) {
+        EXPECT_EQ(dst[i], expected[i]);
+    }
+    EXPECT_TRUE(buffer.empty());
+
+    buffer.write(src, 5);
+    buffer.discard();
+    EXPECT_TRUE(buffer.empty());
+    EXPECT_THROW(SpscRingBuffer<int>(6), std::invalid_argument);
+}
+
+TEST(SpscRingBuffer, Concurrent) {
+    constexpr int COUNT = 1000000;
+    SpscRingBuffer<int> buffer(1024);
+    std::thread producer([&buffer]() {
+        int value = 0;
+        while (value < COUNT) {
+            auto span = buffer.writable();
+            size_t n = std::min<size_t>(span.size, COUNT - value);
+            for (size_t i = 0; i < n; i++) {
+                span.data[i] = value++;
+            }
+            buffer.commit(n);
+        }
+    });
+    std::vector<int> dst(100);
+    int expected = 0;
+    int mismatches = 0;
+    while (expected < COUNT) {
+        size_t n = buffer.read(dst.data(), dst.size());
+        for (size_t i = 0; i < n; i++) {
+            mismatches += dst[i] != expected++;
+        }
+    }
+    producer.join();
+    EXPECT_EQ(mismatches, 0);
+}
@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "util/parallel.hpp"
+
+TEST(parallel, ParallelFor) {
+    for (uint threads : {0u, 1u, 4u}) {
+        std::vector<size_t> values(1000, 0);
+        util::parallel_for(values.size(), threads, [&values](size_t index) {
+            values[index] += index * 2;
+        });
+        for (size_t i = 0; i < values.size(); i++) {
+            EXPECT_EQ(values[i], i * 2);
+        }
+    }
+    util::parallel_for(0, 4, [](size_t) { FAIL(); });
+}
+
+TEST(parallel, NestedLoops) {
+    std::atomic<size_t> sum = 0;
+    util::parallel_for(4, 4, [&sum](size_t) {
+        EXPECT_TRUE(util::is_worker_thread());
+        auto thread = std::this_thread::get_id();
+        // nested loops do not spawn threads
+        util::parallel_for(10, 4, [&sum, thread](size_t index) {
+            EXPECT_EQ(std::this_thread::get_id(), thread);
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            sum += index;
+        });
+    });
+    EXPECT_EQ(sum, 45 * 4);
+    EXPECT_FALSE(util::is_worker_thread());
+}
+
+TEST(parallel, Exception) {
+    EXPECT_THROW(
+        util::parallel_for(
+            100,
+            4,
+            [](size_t index) {
+                if (index == 42) {
+                    throw std::runtime_error("error");
+                }
+            }
+        ),
+        std::runtime_error
+    );
+}
+
+TEST(parallel, ParallelPool) {
+    for (uint threads : {1u, 4u}) {
+        util::ParallelPool pool(threads);
+        EXPECT_EQ(pool.getThreads(), threads);
+        // workers are reused by the following loops
+        for (int iteration = 0; iteration < 100; iteration++) {
+            std::vector<size_t> values(iteration * 10, 0);
+            pool.run(values.size(), [&values](size_t index) {
+                values[index] += index * 2;
+            });
+            for (size_t i = 0; i < values.size(); i++) {
+                ASSERT_EQ(values[i], i * 2);
+            }
+        }
+        EXPECT_THROW(
+            pool.run(
+                100,
+                [](size_t index) {
+                    if (index == 42) {
+                        throw std::runtime_error("error");
+                    }
+                }
+            ),
+            std::runtime_error
+        );
+        // still usable after an exception
+        std::atomic<size_t> sum = 0;
+        pool.run(100, [&sum](size_t index) { sum += index; });
+        EXPECT_EQ(sum, 4950);
+    }
+}
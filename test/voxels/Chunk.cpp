@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 
+#include <vector>
+
+#include "coders/rle.hpp"
 #include "voxels/Chunk.hpp"
 
 TEST(Chunk, EncodeDecode) {
@@ -23,3 +26,38 @@ TEST(Chunk, EncodeDecode) {
         );
     }
 }
+
+TEST(Chunk, DecodeExtRle16) {
+    Chunk chunk1(0, 0);
+    for (uint i = 0; i < CHUNK_VOL; i++) {
+        chunk1.voxels[i].id = i / 37 % 3 == 0 ? rand() % 500 : i / 1000;
+        chunk1.voxels[i].state.rotation = i / 5000;
+        chunk1.voxels[i].state.userbits = i % 7 == 0 ? rand() : 0;
+    }
+    auto bytes = chunk1.encode();
+    std::vector<ubyte> encoded(CHUNK_DATA_LEN * 2);
+    size_t size = extrle::encode16(bytes.get(), CHUNK_DATA_LEN, encoded.data());
+
+    Chunk chunk2(0, 0);
+    chunk2.decodeExtRle16(encoded.data(), size, 500);
+    for (uint i = 0; i < CHUNK_VOL; i++) {
+        ASSERT_EQ(chunk1.voxels[i].id, chunk2.voxels[i].id);
+        ASSERT_EQ(
+            blockstate2int(chunk1.voxels[i].state),
+            blockstate2int(chunk2.voxels[i].state)
+        );
+    }
+
+    // invalid data does not modify voxels
+    Chunk chunk3(0, 0);
+    EXPECT_THROW(
+        chunk3.decodeExtRle16(encoded.data(), size, 100), std::runtime_error
+    );
+    EXPECT_THROW(
+        chunk3.decodeExtRle16(encoded.data(), size / 2, 500),
+        std::runtime_error
+    );
+    for (uint i = 0; i < CHUNK_VOL; i++) {
+        ASSERT_EQ(chunk3.voxels[i].id, 0);
+    }
+}
@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+
+#include "voxels/ChunkJournal.hpp"
+
+TEST(ChunkJournal, Collect) {
+    ChunkJournal journal;
+    auto start = journal.getRevision();
+
+    journal.recordVoxel(5);
+    journal.recordVoxel(3);
+    auto middle = journal.getRevision();
+    journal.recordVoxel(5);
+    journal.recordMetadata(3);
+
+    std::vector<uint> voxels, metadata;
+    EXPECT_TRUE(journal.collect(start, voxels, metadata));
+    EXPECT_EQ(voxels, (std::vector<uint> {3, 5}));
+    EXPECT_EQ(metadata, (std::vector<uint> {3}));
+
+    voxels.clear();
+    metadata.clear();
+    EXPECT_TRUE(journal.collect(middle, voxels, metadata));
+    EXPECT_EQ(voxels, (std::vector<uint> {5}));
+
+    voxels.clear();
+    metadata.clear();
+    EXPECT_TRUE(journal.collect(journal.getRevision(), voxels, metadata));
+    EXPECT_TRUE(voxels.empty());
+    EXPECT_TRUE(metadata.empty());
+}
+
+TEST(ChunkJournal, Overflow) {
+    ChunkJournal journal;
+    auto start = journal.getRevision();
+    for (uint i = 0; i < ChunkJournal::CAPACITY; i++) {
+        journal.recordVoxel(i);
+    }
+    std::vector<uint> voxels, metadata;
+    EXPECT_TRUE(journal.collect(start, voxels, metadata));
+    EXPECT_EQ(voxels.size(), ChunkJournal::CAPACITY);
+
+    auto afterFirst = journal.getRevision();
+    journal.recordVoxel(0);
+    EXPECT_FALSE(journal.collect(start, voxels, metadata));
+
+    voxels.clear();
+    EXPECT_TRUE(journal.collect(afterFirst, voxels, metadata));
+    EXPECT_EQ(voxels, (std::vector<uint> {0}));
+}
+
+TEST(ChunkJournal, Reset) {
+    ChunkJournal journal;
+    journal.recordVoxel(1);
+    auto revision = journal.getRevision();
+    journal.reset();
+
+    std::vector<uint> voxels, metadata;
+    EXPECT_FALSE(journal.collect(revision, voxels, metadata));
+    EXPECT_TRUE(journal.collect(journal.getRevision(), voxels, metadata));
+
+    // revisions of other journals are never valid
+    ChunkJournal other;
+    EXPECT_FALSE(other.collect(revision, voxels, metadata));
+}
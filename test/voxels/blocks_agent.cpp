@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "content/Content.hpp"
+#include "voxels/Block.hpp"
+#include "voxels/Chunk.hpp"
+#include "voxels/Chunks.hpp"
+#include "voxels/blocks_agent.hpp"
+
+class RaycastTest : public testing::Test {
+protected:
+    Block air {"core:air"};
+    Block stone {"base:stone"};
+    Block slab {"base:slab"};
+    Block glass {"base:glass"};
+    ContentIndices indices {{{&air, &stone, &slab, &glass}}, {{}}, {{}}};
+    // chunks from -2 to 1 on both axes
+    Chunks chunks {4, 4, 2, 2, nullptr, indices};
+
+    void SetUp() override {
+        Block* defs[] {&air, &stone, &slab, &glass};
+        for (blockid_t id = 0; id < 4; id++) {
+            defs[id]->rt.id = id;
+        }
+        air.rt.solid = false;
+        air.selectable = false;
+        slab.rt.solid = false;
+        slab.hitboxes = {AABB({0.0f, 0.0f, 0.0f}, {1.0f, 0.5f, 1.0f})};
+        glass.selectable = false;
+
+        std::mt19937 random(42);
+        for (int cz = -2; cz < 2; cz++) {
+            for (int cx = -2; cx < 2; cx++) {
+                auto chunk = std::make_shared<Chunk>(cx, cz);
+                for (uint i = 0; i < CHUNK_VOL; i++) {
+                    int y = i / (CHUNK_W * CHUNK_D);
+                    if (y < 60) {
+                        chunk->voxels[i].id = 1;
+                    } else if (y < 80 && random() % 20 == 0) {
+                        chunk->voxels[i].id = 1 + random() % 3;
+                    }
+                }
+                ASSERT_TRUE(chunks.putChunk(chunk));
+            }
+        }
+    }
+};
+
+TEST_F(RaycastTest, BatchMatchesSingle) {
+    std::mt19937 random(7);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    std::vector<blocks_agent::RaycastQuery> queries;
+    for (int i = 0; i < 500; i++) {
+        glm::vec3 start(dist(random) * 8.0f, 65.0f, dist(random) * 8.0f);
+        glm::vec3 dir(dist(random), dist(random), dist(random));
+        if (glm::length(dir) < 1e-3f) {
+            continue;
+        }
+        queries.push_back({start, glm::normalize(dir), 40.0f});
+    }
+    for (bool includeNonSelectable : {false, true}) {
+        for (const std::set<blockid_t>& filter :
+             {std::set<blockid_t> {}, std::set<blockid_t> {1}}) {
+            auto hits = blocks_agent::raycast(
+                chunks, queries, filter, includeNonSelectable
+            );
+            ASSERT_EQ(hits.size(), queries.size());
+
+            size_t hitsCount = 0;
+            for (size_t i = 0; i < queries.size(); i++) {
+                const auto& query = queries[i];
+                const auto& hit = hits[i];
+                glm::vec3 end;
+                glm::ivec3 norm;
+                glm::ivec3 iend;
+                auto vox = blocks_agent::raycast(
+                    chunks,
+                    query.start,
+                    query.dir,
+                    query.maxDist,
+                    end,
+                    norm,
+                    iend,
+                    filter,
+                    includeNonSelectable
+                );
+                ASSERT_EQ(hit.vox, vox) << "ray " << i;
+                if (vox == nullptr) {
+                    continue;
+                }
+                hitsCount++;
+                EXPECT_EQ(hit.vox->id, vox->id);
+                EXPECT_EQ(hit.end, end);
+                EXPECT_EQ(hit.norm, norm);
+                EXPECT_EQ(hit.iend, iend);
+                EXPECT_EQ(
+                    glm::distance(query.start, hit.end),
+                    glm::distance(query.start, end)
+                );
+            }
+            EXPECT_GT(hitsCount, queries.size() / 5);
+        }
+    }
+}
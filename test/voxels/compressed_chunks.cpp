@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+
+#include "content/Content.hpp"
+#include "voxels/Block.hpp"
+#include "voxels/Chunk.hpp"
+#include "voxels/compressed_chunks.hpp"
+
+class ChunkDeltaTest : public testing::Test {
+protected:
+    Block air {"core:air"};
+    Block stone {"base:stone"};
+    ContentIndices indices {{{&air, &stone}}, {{}}, {{}}};
+    Chunk source {0, 0};
+    Chunk target {0, 0};
+    uint64_t since = 0;
+
+    void SetUp() override {
+        since = source.journal.getRevision();
+
+        source.voxels[10].id = 1;
+        source.voxels[10].state.rotation = 3;
+        source.journal.recordVoxel(10);
+        source.voxels[CHUNK_VOL - 1].id = 1;
+        source.voxels[CHUNK_VOL - 1].state.userbits = 0x5;
+        source.journal.recordVoxel(CHUNK_VOL - 1);
+
+        ubyte* meta = source.blocksMetadata.allocate(10, 4);
+        for (int i = 0; i < 4; i++) {
+            meta[i] = i + 1;
+        }
+        source.journal.recordMetadata(10);
+    }
+};
+
+TEST_F(ChunkDeltaTest, RoundTrip) {
+    auto bytes = compressed_chunks::encode_delta(source, since);
+    ASSERT_FALSE(bytes.empty());
+    EXPECT_TRUE(compressed_chunks::is_delta(bytes.data(), bytes.size()));
+
+    auto changes = compressed_chunks::decode_delta(
+        target, bytes.data(), bytes.size(), indices
+    );
+    ASSERT_EQ(changes.size(), 2);
+    EXPECT_EQ(changes[0].prevId, BLOCK_AIR);
+
+    for (uint i = 0; i < CHUNK_VOL; i++) {
+        ASSERT_EQ(source.voxels[i].id, target.voxels[i].id);
+        ASSERT_EQ(
+            blockstate2int(source.voxels[i].state),
+            blockstate2int(target.voxels[i].state)
+        );
+    }
+    ubyte* meta = target.blocksMetadata.find(10);
+    ASSERT_NE(meta, nullptr);
+    ASSERT_EQ(target.blocksMetadata.sizeOf(meta), 4);
+    for (int i = 0; i < 4; i++) {
+        EXPECT_EQ(meta[i], i + 1);
+    }
+
+    // removed metadata is synced too
+    auto revision = source.journal.getRevision();
+    source.blocksMetadata.free(source.blocksMetadata.find(10));
+    source.journal.recordMetadata(10);
+    bytes = compressed_chunks::encode_delta(source, revision);
+    compressed_chunks::decode_delta(
+        target, bytes.data(), bytes.size(), indices
+    );
+    EXPECT_EQ(target.blocksMetadata.find(10), nullptr);
+}
+
+TEST_F(ChunkDeltaTest, TruncatedInput) {
+    auto bytes = compressed_chunks::encode_delta(source, since);
+    ASSERT_FALSE(bytes.empty());
+
+    // any truncation is rejected without modifying the chunk
+    for (size_t size = 1; size < bytes.size(); size++) {
+        EXPECT_THROW(
+            compressed_chunks::decode_delta(
+                target, bytes.data(), size, indices
+            ),
+            std::runtime_error
+        );
+        for (uint i = 0; i < CHUNK_VOL; i++) {
+            ASSERT_EQ(target.voxels[i].id, BLOCK_AIR);
+        }
+        ASSERT_EQ(target.blocksMetadata.find(10), nullptr);
+    }
+
+    // unknown block id
+    ContentIndices airOnly {{{&air}}, {{}}, {{}}};
+    EXPECT_THROW(
+        compressed_chunks::decode_delta(
+            target, bytes.data(), bytes.size(), airOnly
+        ),
+        std::runtime_error
+    );
+    EXPECT_EQ(target.voxels[10].id, BLOCK_AIR);
+}
@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+
+#include "coders/binary_json.hpp"
+#include "coders/byte_utils.hpp"
+#include "items/Inventory.hpp"
+#include "world/files/chunk_records.hpp"
+
+static ChunkInventoriesMap make_inventories() {
+    ChunkInventoriesMap inventories;
+    for (uint i = 0; i < 20; i++) {
+        auto inventory = std::make_shared<Inventory>(100 + i, 40);
+        for (size_t slot = 0; slot < inventory->size(); slot += 3) {
+            inventory->getSlot(slot).set(ItemStack(1 + slot % 5, 1 + slot));
+        }
+        auto fields = dv::object();
+        fields["durability"] = 0.75;
+        inventory->getSlot(1).set(ItemStack(42, 1, std::move(fields)));
+        inventories[i * 1000] = std::move(inventory);
+    }
+    return inventories;
+}
+
+static void expect_equal(
+    const ChunkInventoriesMap& expected, const ChunkInventoriesMap& actual
+) {
+    ASSERT_EQ(expected.size(), actual.size());
+    for (const auto& [index, inventory] : expected) {
+        const auto& found = actual.find(index);
+        ASSERT_NE(found, actual.end());
+        const auto& loaded = found->second;
+        EXPECT_EQ(loaded->getId(), inventory->getId());
+        ASSERT_EQ(loaded->size(), inventory->size());
+        for (size_t i = 0; i < inventory->size(); i++) {
+            const auto& a = inventory->getSlot(i);
+            const auto& b = loaded->getSlot(i);
+            EXPECT_EQ(a.getItemId(), b.getItemId());
+            EXPECT_EQ(a.getCount(), b.getCount());
+            EXPECT_EQ(a.hasFields(), b.hasFields());
+        }
+        EXPECT_EQ(loaded->getSlot(1).getFields()["durability"].asNumber(), 0.75);
+    }
+}
+
+TEST(ChunkRecords, Inventories) {
+    auto inventories = make_inventories();
+    auto bytes = chunk_records::encode_inventories(inventories);
+    auto loaded = chunk_records::decode_inventories(bytes.data(), bytes.size());
+    expect_equal(inventories, loaded);
+}
+
+TEST(ChunkRecords, LegacyInventories) {
+    auto inventories = make_inventories();
+
+    // previous format: bjson per inventory
+    ByteBuilder builder;
+    builder.putInt32(inventories.size());
+    for (auto& entry : inventories) {
+        builder.putInt32(entry.first);
+        auto bytes = json::to_binary(entry.second->serialize(), true);
+        builder.putInt32(bytes.size());
+        builder.put(bytes.data(), bytes.size());
+    }
+    auto legacy = builder.build();
+    auto loaded = chunk_records::decode_inventories(legacy.data(), legacy.size());
+    expect_equal(inventories, loaded);
+
+    auto bytes = chunk_records::encode_inventories(inventories);
+    EXPECT_LT(bytes.size(), legacy.size());
+}
+
+TEST(ChunkRecords, Entities) {
+    auto root = dv::object();
+    auto& list = root.list("data");
+    auto entity = dv::object();
+    entity["def"] = "base:player";
+    entity["uid"] = 7;
+    list.add(entity);
+
+    auto legacy = json::to_binary(root, true);
+    auto bytes = chunk_records::encode_entities(root);
+    for (const auto& data : {legacy, bytes}) {
+        auto loaded = chunk_records::decode_entities(data.data(), data.size());
+        EXPECT_EQ(loaded["data"][0]["def"].asString(), "base:player");
+        EXPECT_EQ(loaded["data"][0]["uid"].asInteger(), 7);
+    }
+}
@@ -0,0 +1,47 @@
+#include "common.hpp"
+
+#include <iostream>
+#include <sstream>
+
+using namespace vctest;
+
+bool vctest::check_file(const fs::path& file) {
+    if (!fs::exists(file)) {
+        std::cerr << "file " << file << " not found" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool vctest::check_dir(const fs::path& dir) {
+    if (!fs::is_directory(dir)) {
+        std::cerr << dir << " is not a directory" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+std::string vctest::fix_path(std::string s) {
+    for (char& c : s) {
+        if (c == '\\') {
+            c = '/';
+        }
+    }
+    return s;
+}
+
+std::string vctest::headless_command(
+    const fs::path& executable,
+    const fs::path& script,
+    const fs::path& resDir,
+    const fs::path& workingDir,
+    const fs::path& outputFile
+) {
+    std::stringstream ss;
+    ss << fs::canonical(executable) << " --headless";
+    ss << " --test " << fix_path(script.string());
+    ss << " --res " << fix_path(resDir.string());
+    ss << " --dir " << fix_path(workingDir.string());
+    ss << " >" << fix_path(outputFile.string()) << " 2>&1";
+    return ss.str();
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+
+#include "util/ArgsReader.hpp"
+
+/// @brief Code shared by vctest and VoxelEngineBench, running scripts
+/// with the headless engine
+namespace vctest {
+    namespace fs = std::filesystem;
+
+    /// @brief Parse command line arguments using the keyword handler
+    /// @return false if the program should stop (e.g. help displayed)
+    template <typename Config, typename Func>
+    bool parse_cmdline(
+        int argc, char** argv, Config& config, const Func& performKeyword
+    ) {
+        util::ArgsReader reader(argc, argv);
+        while (reader.hasNext()) {
+            std::string token = reader.next();
+            if (reader.isKeywordArg()) {
+                if (!performKeyword(reader, token, config)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    /// @brief Print error if the file does not exist
+    bool check_file(const fs::path& file);
+
+    /// @brief Print error if the path is not a directory
+    bool check_dir(const fs::path& dir);
+
+    /// @brief Replace backslashes with slashes
+    std::string fix_path(std::string s);
+
+    /// @brief Make command running the script with the headless engine,
+    /// engine output is redirected to the output file
+    std::string headless_command(
+        const fs::path& executable,
+        const fs::path& script,
+        const fs::path& resDir,
+        const fs::path& workingDir,
+        const fs::path& outputFile
+    );
+}
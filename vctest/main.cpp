@@ -5,10 +5,12 @@
 #include <sstream>
 #include <vector>
 
-#include "util/ArgsReader.hpp"
+#include "common.hpp"
 
 namespace fs = std::filesystem;
 
+using namespace vctest;
+
 inline fs::path TESTING_DIR = fs::u8path(".vctest");
 
 struct Config {
@@ -53,27 +55,6 @@ static bool perform_keyword(
     return true;
 }
 
-static bool parse_cmdline(int argc, char** argv, Config& config) {
-    util::ArgsReader reader(argc, argv);
-    while (reader.hasNext()) {
-        std::string token = reader.next();
-        if (reader.isKeywordArg()) {
-            if (!perform_keyword(reader, token, config)) {
-                return false;
-            }
-        }
-    }
-    return true;
-}
-
-static bool check_dir(const fs::path& dir) {
-    if (!fs::is_directory(dir)) {
-        std::cerr << dir << " is not a directory" << std::endl;
-        return false;
-    }
-    return true;
-}
-
 static void print_separator(std::ostream& stream) {
     for (int i = 0; i < 32; i++) {
         stream << "=";
@@ -82,8 +63,7 @@ static void print_separator(std::ostream& stream) {
 }
 
 static bool check_config(const Config& config) {
-    if (!fs::exists(config.executable)) {
-        std::cerr << "file " << config.executable << " not found" << std::endl;
+    if (!check_file(config.executable)) {
         return true;
     }
     if (!check_dir(config.directory)) {
@@ -163,15 +143,6 @@ static void display_segfault_valgrind(
     }
 }
 
-static std::string fix_path(std::string s) {
-    for (char& c : s) {
-        if (c == '\\') {
-            c = '/';
-        }
-    }
-    return s;
-}
-
 static bool run_test(const Config& config, const fs::path& path, bool memcheck = false) {
     using std::chrono::duration_cast;
     using std::chrono::high_resolution_clock;
@@ -186,11 +157,9 @@ static bool run_test(const Config& config, const fs::path& path, bool memcheck =
         ss << config.memchecker << " --log-file="
            << fix_path(memcheckLogFile.string()) << " ";
     }
-    ss << fs::canonical(config.executable) << " --headless";
-    ss << " --test " << fix_path(path.string());
-    ss << " --res " << fix_path(config.resDir.string());
-    ss << " --dir " << fix_path(config.workingDir.string());
-    ss << " >" << fix_path(outputFile.string()) << " 2>&1";
+    ss << headless_command(
+        config.executable, path, config.resDir, config.workingDir, outputFile
+    );
     auto command = ss.str();
 
     print_separator(std::cout);
@@ -229,7 +198,7 @@ static bool run_test(const Config& config, const fs::path& path, bool memcheck =
 int main(int argc, char** argv) {
     Config config;
     try {
-        if (!parse_cmdline(argc, argv, config)) {
+        if (!parse_cmdline(argc, argv, config, perform_keyword)) {
             return 0;
         }
     } catch (const std::runtime_error& err) {